@@ -0,0 +1,516 @@
+// Language library
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// External libraries (in Dependencies folder)
+#include "GLM/glm.hpp"
+
+// External tools (in ExternalTools folder)
+#include "JsonWriter/JsonWriter.h"
+
+// Engine files (in Source\Constants)
+#include "ProjectConstants.h"
+
+// Game files (in Source/Game)
+#include "Game/ChunkGeneration/ChunkMeshData.h"
+#include "Game/ChunkGeneration/ChunkVoxelData/ChunkVoxelData.h"
+#include "Game/ChunkGeneration/GreedyMesher/GreedyMesher.h"
+#include "Game/ChunkGeneration/GreedyMesher/MeshingContext.h"
+#include "Game/ChunkGeneration/WorldGenerator/WorldGenerator.h"
+
+// ============================================================================================ //
+// Headless world generation and meshing benchmark.
+//
+// Drives WorldGenerator::GenerateBlocks() and GreedyMesher::GenerateMesh() on a grid of chunks,
+// those two layers don't use OpenGL, so this executable does not link it and can run on build servers.
+//
+// Launch example :
+// WorldGenerationBenchmark.exe --grid 16 16 --seed 1789 --chunk-size 32 64 32 --threads 8 --iterations 3 --output Result.json
+// ============================================================================================ //
+
+#pragma region - Allocation counting -
+
+// NOTE : We replace the global new / delete operators to count the heap allocations of each phase.
+//        The counters are per thread, so the threads don't fight over one shared counter.
+
+static thread_local unsigned long long threadAllocationCount = 0;
+static thread_local unsigned long long threadAllocatedBytes = 0;
+
+void* operator new(const size_t p_size)
+{
+    threadAllocationCount++;
+    threadAllocatedBytes += p_size;
+
+    void* memory = std::malloc(p_size == 0 ? 1 : p_size);
+
+    if (memory == nullptr)
+        throw std::bad_alloc();
+
+    return memory;
+}
+
+void operator delete(void* p_memory) noexcept
+{
+    std::free(p_memory);
+}
+
+void operator delete(void* p_memory, size_t) noexcept
+{
+    std::free(p_memory);
+}
+
+#pragma endregion
+
+struct BenchmarkSettings
+{
+    Vector2Int GridSize = Vector2Int(8, 8);
+    Vector3Int ChunkSize = Vector3Int(32, 64, 32);
+
+    int WorldSeed = WORLD_SEED;
+    float NoiseFrequency = NOISE_FREQUENCY;
+
+    int ThreadCount = 1;
+    int IterationCount = 1;
+
+    /// <summary> Also runs the old per voxel generation (see GenerateBlocksLegacy()) to compare its speed and result. </summary>
+    bool IsComparingLegacyGeneration = false;
+
+    /// <summary> Fails the benchmark if the meshing allocates anything after the first iteration (the warm-up). </summary>
+    bool IsCheckingSteadyStateAllocations = false;
+
+    std::string OutputFilePath = "WorldGenerationBenchmark.json";
+};
+
+/// <summary> Everything one thread measured, merged at the end of the benchmark. </summary>
+struct ThreadResult
+{
+    unsigned long long ChunkCount = 0;
+
+    double GenerationSeconds = 0.0;
+    double MeshingSeconds = 0.0;
+
+    double LegacyGenerationSeconds = 0.0;
+    unsigned long long LegacyMismatchChunkCount = 0;
+
+    unsigned long long QuadCount = 0;
+    unsigned long long MinimumQuadCount = ~0ull;
+    unsigned long long MaximumQuadCount = 0;
+
+    unsigned long long VertexBytes = 0;
+    unsigned long long IndexBytes = 0;
+
+    unsigned long long GenerationAllocationCount = 0;
+    unsigned long long GenerationAllocatedBytes = 0;
+    unsigned long long MeshingAllocationCount = 0;
+    unsigned long long MeshingAllocatedBytes = 0;
+
+    /// <summary> The meshing allocations after the first iteration, when the meshing context of the thread is warmed up. </summary>
+    unsigned long long SteadyStateMeshingAllocationCount = 0;
+    unsigned long long SteadyStateChunkCount = 0;
+};
+
+static double GetSecondsSince(const std::chrono::high_resolution_clock::time_point& p_startTime)
+{
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - p_startTime).count();
+}
+
+static bool ParseCommandLine(const int p_argumentCount, char* p_arguments[], BenchmarkSettings& p_outSettings)
+{
+    const unsigned int hardwareThreadCount = std::thread::hardware_concurrency();
+    p_outSettings.ThreadCount = hardwareThreadCount == 0 ? 1 : static_cast<int>(hardwareThreadCount);
+
+    for (int i = 1; i < p_argumentCount; ++i)
+    {
+        const char* argument = p_arguments[i];
+        const int remainingArgumentCount = p_argumentCount - i - 1;
+
+        if (std::strcmp(argument, "--grid") == 0 && remainingArgumentCount >= 2)
+        {
+            p_outSettings.GridSize.X = std::atoi(p_arguments[++i]);
+            p_outSettings.GridSize.Y = std::atoi(p_arguments[++i]);
+        }
+        else if (std::strcmp(argument, "--chunk-size") == 0 && remainingArgumentCount >= 3)
+        {
+            p_outSettings.ChunkSize.X = std::atoi(p_arguments[++i]);
+            p_outSettings.ChunkSize.Y = std::atoi(p_arguments[++i]);
+            p_outSettings.ChunkSize.Z = std::atoi(p_arguments[++i]);
+        }
+        else if (std::strcmp(argument, "--seed") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.WorldSeed = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--frequency") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.NoiseFrequency = static_cast<float>(std::atof(p_arguments[++i]));
+
+        else if (std::strcmp(argument, "--threads") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.ThreadCount = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--iterations") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.IterationCount = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--compare-legacy") == 0)
+            p_outSettings.IsComparingLegacyGeneration = true;
+
+        else if (std::strcmp(argument, "--check-allocations") == 0)
+            p_outSettings.IsCheckingSteadyStateAllocations = true;
+
+        else if (std::strcmp(argument, "--output") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.OutputFilePath = p_arguments[++i];
+
+        else
+        {
+            std::cout << "Unknown argument '" << argument << "'\n\n"
+                << "Usage : WorldGenerationBenchmark [--grid X Z] [--chunk-size X Y Z] [--seed N] [--frequency F]\n"
+                << "                                 [--threads N] [--iterations N] [--compare-legacy] [--check-allocations]\n"
+                << "                                 [--output filePath]\n";
+            return false;
+        }
+    }
+
+    // NOTE : With several threads, a thread can get a bigger chunk than all the ones it meshed during the warm-up
+    if (p_outSettings.IsCheckingSteadyStateAllocations && (p_outSettings.ThreadCount != 1 || p_outSettings.IterationCount < 2))
+    {
+        std::cout << "--check-allocations needs exactly 1 thread and at least 2 iterations.\n";
+        return false;
+    }
+
+    if (p_outSettings.GridSize.X <= 0 || p_outSettings.GridSize.Y <= 0 ||
+        p_outSettings.ChunkSize.X <= 0 || p_outSettings.ChunkSize.Y <= 0 || p_outSettings.ChunkSize.Z <= 0 ||
+        p_outSettings.ThreadCount <= 0 || p_outSettings.IterationCount <= 0)
+    {
+        std::cout << "The grid size, chunk size, thread count and iteration count must be positive.\n";
+        return false;
+    }
+
+    return true;
+}
+
+/// <summary>
+/// The blocks generation as it was before the strata table (one if / else ladder and one write per block).
+/// <para> Kept as a reference : it must give exactly the same blocks as WorldGenerator::GenerateBlocks(). </para> </summary>
+static void GenerateBlocksLegacy(const WorldGenerator& p_worldGenerator, ChunkVoxelData& p_voxelData)
+{
+    p_voxelData.Allocate();
+
+    const Vector3Int size = p_voxelData.Size;
+
+    for (int x = 0; x < size.X; x++)
+    {
+        for (int z = 0; z < size.Z; z++)
+        {
+            const int height = p_worldGenerator.GetSurfaceHeight(
+                p_voxelData.WorldPosition.X + static_cast<float>(x), p_voxelData.WorldPosition.Z + static_cast<float>(z), size.Y);
+
+            for (int y = 0; y < height; y++)
+            {
+                BlockTypes blockType;
+
+                if (y < height - 30)        blockType = BlockTypes::ElectrifiedCloud;
+                else if (y < height - 29)   blockType = BlockTypes::DarkCloud;
+                else if (y < height - 25)   blockType = BlockTypes::VeryDarkCloud;
+                else if (y < height - 20)   blockType = BlockTypes::VeryVeryDarkCloud;
+                else if (y < height - 17)   blockType = BlockTypes::VeryDarkCloud;
+                else if (y < height - 16)   blockType = BlockTypes::DarkCloud;
+                else if (y < height - 15)   blockType = BlockTypes::NormalCloud;
+                else if (y == height - 15)  blockType = BlockTypes::HardCloud;
+                else if (y == height - 14)  blockType = BlockTypes::NormalCloud;
+                else if (y < height - 10)   blockType = BlockTypes::VeryVeryDarkCloud;
+                else if (y < height - 7)    blockType = BlockTypes::VeryDarkCloud;
+                else if (y < height - 4)    blockType = BlockTypes::DarkCloud;
+                else if (y < height - 1)    blockType = BlockTypes::NormalCloud;
+                else                        blockType = BlockTypes::LightCloud;
+
+                p_voxelData.SetBlock(Vector3Int(x, y, z), blockType);
+            }
+
+            for (int y = height; y < size.Y; y++)
+                p_voxelData.SetBlock(Vector3Int(x, y, z), BlockTypes::Air);
+        }
+    }
+}
+
+/// <summary> Generates and meshes chunks until there is no chunk left (the chunks are shared between all threads). </summary>
+static void RunWorkerThread(const BenchmarkSettings& p_settings, const WorldGenerator& p_worldGenerator,
+    std::atomic<int>& p_nextChunkIndex, const int p_totalChunkCount, ThreadResult& p_outResult)
+{
+    const int chunkCountPerIteration = p_settings.GridSize.X * p_settings.GridSize.Y;
+
+    // Like a worker of the game : one meshing context per thread, and the output mesh is re-used from a chunk to another
+    MeshingContext meshingContext;
+    ChunkMeshData meshData;
+
+    for (int chunkIndex = p_nextChunkIndex++; chunkIndex < p_totalChunkCount; chunkIndex = p_nextChunkIndex++)
+    {
+        // Every iteration re-generates the same grid
+        const int gridIndex = chunkIndex % chunkCountPerIteration;
+
+        const Vector3 worldPosition = Vector3(
+            static_cast<float>((gridIndex % p_settings.GridSize.X) * p_settings.ChunkSize.X),
+            0.0f,
+            static_cast<float>((gridIndex / p_settings.GridSize.X) * p_settings.ChunkSize.Z)
+        );
+
+        ChunkVoxelData voxelData(worldPosition, p_settings.ChunkSize);
+
+        // - Blocks generation - //
+
+        unsigned long long allocationCountBefore = threadAllocationCount;
+        unsigned long long allocatedBytesBefore = threadAllocatedBytes;
+        std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+
+        p_worldGenerator.GenerateBlocks(voxelData);
+
+        p_outResult.GenerationSeconds += GetSecondsSince(startTime);
+        p_outResult.GenerationAllocationCount += threadAllocationCount - allocationCountBefore;
+        p_outResult.GenerationAllocatedBytes += threadAllocatedBytes - allocatedBytesBefore;
+
+        // - Legacy blocks generation (optional) - //
+
+        if (p_settings.IsComparingLegacyGeneration)
+        {
+            ChunkVoxelData legacyVoxelData(worldPosition, p_settings.ChunkSize);
+
+            startTime = std::chrono::high_resolution_clock::now();
+
+            GenerateBlocksLegacy(p_worldGenerator, legacyVoxelData);
+
+            p_outResult.LegacyGenerationSeconds += GetSecondsSince(startTime);
+
+            if (!std::equal(voxelData.GetBlocks(), voxelData.GetBlocks() + voxelData.GetBlockCount(), legacyVoxelData.GetBlocks()))
+                p_outResult.LegacyMismatchChunkCount++;
+        }
+
+        // - Meshing - //
+
+        allocationCountBefore = threadAllocationCount;
+        allocatedBytesBefore = threadAllocatedBytes;
+        startTime = std::chrono::high_resolution_clock::now();
+
+        GreedyMesher::GenerateMesh(voxelData, CHUNK_BLOCK_SIZE, meshingContext, meshData);
+
+        p_outResult.MeshingSeconds += GetSecondsSince(startTime);
+        p_outResult.MeshingAllocationCount += threadAllocationCount - allocationCountBefore;
+        p_outResult.MeshingAllocatedBytes += threadAllocatedBytes - allocatedBytesBefore;
+
+        if (chunkIndex >= chunkCountPerIteration)
+        {
+            p_outResult.SteadyStateMeshingAllocationCount += threadAllocationCount - allocationCountBefore;
+            p_outResult.SteadyStateChunkCount++;
+        }
+
+        // - Mesh statistics - //
+
+        const unsigned long long quadCount = meshData.Vertices.size() / 4;
+
+        p_outResult.ChunkCount++;
+        p_outResult.QuadCount += quadCount;
+        p_outResult.MinimumQuadCount = std::min(p_outResult.MinimumQuadCount, quadCount);
+        p_outResult.MaximumQuadCount = std::max(p_outResult.MaximumQuadCount, quadCount);
+        p_outResult.VertexBytes += meshData.Vertices.size() * sizeof(Vertex);
+        p_outResult.IndexBytes += meshData.VerticesIndices.size() * sizeof(unsigned int);
+    }
+}
+
+static void PrintTableRow(const char* p_phaseName, const double p_totalMilliseconds, const double p_chunkCount, const double p_voxelCount,
+    const double p_allocationCount, const double p_allocatedBytes)
+{
+    const double seconds = p_totalMilliseconds / 1000.0;
+
+    std::printf("  %-12s | %12.2f | %10.4f | %12.1f | %14.0f | %11.1f | %12.1f\n",
+        p_phaseName,
+        p_totalMilliseconds,
+        p_totalMilliseconds / p_chunkCount,
+        seconds > 0.0 ? p_chunkCount / seconds : 0.0,
+        seconds > 0.0 ? p_voxelCount / seconds : 0.0,
+        p_allocationCount / p_chunkCount,
+        p_allocatedBytes / p_chunkCount / 1024.0
+    );
+}
+
+int main(const int p_argumentCount, char* p_arguments[])
+{
+    BenchmarkSettings settings;
+
+    if (!ParseCommandLine(p_argumentCount, p_arguments, settings))
+        return -1;
+
+    const int chunkCountPerIteration = settings.GridSize.X * settings.GridSize.Y;
+    const int totalChunkCount = chunkCountPerIteration * settings.IterationCount;
+    const double voxelCountPerChunk = static_cast<double>(settings.ChunkSize.X) * settings.ChunkSize.Y * settings.ChunkSize.Z;
+
+    // -- Running the benchmark -- //
+
+    // Like in the game, one generator is shared by all the threads
+    const WorldGenerator worldGenerator(settings.WorldSeed, settings.NoiseFrequency);
+
+    std::atomic<int> nextChunkIndex(0);
+    std::vector<ThreadResult> threadResults(settings.ThreadCount);
+    std::vector<std::thread> threads;
+    threads.reserve(settings.ThreadCount);
+
+    const std::chrono::high_resolution_clock::time_point benchmarkStartTime = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < settings.ThreadCount; ++i)
+        threads.emplace_back(RunWorkerThread, std::cref(settings), std::cref(worldGenerator), std::ref(nextChunkIndex), totalChunkCount, std::ref(threadResults[i]));
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    const double wallSeconds = GetSecondsSince(benchmarkStartTime);
+
+    // -- Merging the results -- //
+
+    ThreadResult total;
+
+    for (const ThreadResult& threadResult : threadResults)
+    {
+        total.ChunkCount += threadResult.ChunkCount;
+        total.GenerationSeconds += threadResult.GenerationSeconds;
+        total.MeshingSeconds += threadResult.MeshingSeconds;
+        total.LegacyGenerationSeconds += threadResult.LegacyGenerationSeconds;
+        total.LegacyMismatchChunkCount += threadResult.LegacyMismatchChunkCount;
+        total.QuadCount += threadResult.QuadCount;
+        total.MinimumQuadCount = std::min(total.MinimumQuadCount, threadResult.MinimumQuadCount);
+        total.MaximumQuadCount = std::max(total.MaximumQuadCount, threadResult.MaximumQuadCount);
+        total.VertexBytes += threadResult.VertexBytes;
+        total.IndexBytes += threadResult.IndexBytes;
+        total.GenerationAllocationCount += threadResult.GenerationAllocationCount;
+        total.GenerationAllocatedBytes += threadResult.GenerationAllocatedBytes;
+        total.MeshingAllocationCount += threadResult.MeshingAllocationCount;
+        total.MeshingAllocatedBytes += threadResult.MeshingAllocatedBytes;
+        total.SteadyStateMeshingAllocationCount += threadResult.SteadyStateMeshingAllocationCount;
+        total.SteadyStateChunkCount += threadResult.SteadyStateChunkCount;
+    }
+
+    const double chunkCount = static_cast<double>(total.ChunkCount);
+    const double voxelCount = chunkCount * voxelCountPerChunk;
+
+    // -- Human readable table -- //
+
+    // NOTE : The phases times are summed over all threads (CPU time), the "Wall clock" row is the real elapsed time
+    //        (that includes the legacy generation when it's compared)
+    std::printf("\n World generation and meshing benchmark\n");
+    std::printf("  Grid %d x %d (%d chunks) | chunk size %d x %d x %d | seed %d | %d threads | %d iterations\n\n",
+        settings.GridSize.X, settings.GridSize.Y, chunkCountPerIteration,
+        settings.ChunkSize.X, settings.ChunkSize.Y, settings.ChunkSize.Z,
+        settings.WorldSeed, settings.ThreadCount, settings.IterationCount);
+
+    std::printf("  %-12s | %12s | %10s | %12s | %14s | %11s | %12s\n",
+        "Phase", "Total (ms)", "ms/chunk", "Chunks/s", "Voxels/s", "Allocs/chunk", "KB/chunk");
+    std::printf("  -------------+--------------+------------+--------------+----------------+-------------+-------------\n");
+
+    PrintTableRow("Generation", total.GenerationSeconds * 1000.0, chunkCount, voxelCount,
+        static_cast<double>(total.GenerationAllocationCount), static_cast<double>(total.GenerationAllocatedBytes));
+    PrintTableRow("Meshing", total.MeshingSeconds * 1000.0, chunkCount, voxelCount,
+        static_cast<double>(total.MeshingAllocationCount), static_cast<double>(total.MeshingAllocatedBytes));
+    PrintTableRow("Wall clock", wallSeconds * 1000.0, chunkCount, voxelCount,
+        static_cast<double>(total.GenerationAllocationCount + total.MeshingAllocationCount),
+        static_cast<double>(total.GenerationAllocatedBytes + total.MeshingAllocatedBytes));
+
+    if (settings.IsComparingLegacyGeneration)
+    {
+        // NOTE : The legacy generation allocations are not counted (they would be the same as the generation ones)
+        PrintTableRow("Legacy gen.", total.LegacyGenerationSeconds * 1000.0, chunkCount, voxelCount, 0.0, 0.0);
+
+        std::printf("\n  Legacy generation    : %.2fx slower, %llu chunks with different blocks%s\n",
+            total.GenerationSeconds > 0.0 ? total.LegacyGenerationSeconds / total.GenerationSeconds : 0.0,
+            total.LegacyMismatchChunkCount, total.LegacyMismatchChunkCount == 0 ? "" : " (ERROR)");
+    }
+
+    std::printf("\n  Quads per chunk      : %.1f average (%llu minimum, %llu maximum)\n",
+        static_cast<double>(total.QuadCount) / chunkCount, total.MinimumQuadCount, total.MaximumQuadCount);
+    std::printf("  Vertex bytes / chunk : %.1f KB\n", static_cast<double>(total.VertexBytes) / chunkCount / 1024.0);
+    std::printf("  Index bytes / chunk  : %.1f KB\n", static_cast<double>(total.IndexBytes) / chunkCount / 1024.0);
+
+    if (total.SteadyStateChunkCount > 0)
+    {
+        std::printf("  Steady state meshing : %llu allocations over %llu chunks (after the first iteration)\n",
+            total.SteadyStateMeshingAllocationCount, total.SteadyStateChunkCount);
+    }
+
+    std::printf("\n");
+
+    // -- JSON -- //
+
+    JsonWriter jsonWriter;
+    jsonWriter.BeginObject();
+
+    jsonWriter.BeginObject("settings");
+    jsonWriter.Write("gridSizeX", settings.GridSize.X);
+    jsonWriter.Write("gridSizeZ", settings.GridSize.Y);
+    jsonWriter.Write("chunkSizeX", settings.ChunkSize.X);
+    jsonWriter.Write("chunkSizeY", settings.ChunkSize.Y);
+    jsonWriter.Write("chunkSizeZ", settings.ChunkSize.Z);
+    jsonWriter.Write("worldSeed", settings.WorldSeed);
+    jsonWriter.Write("noiseFrequency", static_cast<double>(settings.NoiseFrequency));
+    jsonWriter.Write("threadCount", settings.ThreadCount);
+    jsonWriter.Write("iterationCount", settings.IterationCount);
+    jsonWriter.EndObject();
+
+    jsonWriter.Write("chunkCount", total.ChunkCount);
+    jsonWriter.Write("wallSeconds", wallSeconds);
+    jsonWriter.Write("chunksPerSecond", wallSeconds > 0.0 ? chunkCount / wallSeconds : 0.0);
+    jsonWriter.Write("voxelsPerSecond", wallSeconds > 0.0 ? voxelCount / wallSeconds : 0.0);
+
+    jsonWriter.BeginObject("generation");
+    jsonWriter.Write("cpuSeconds", total.GenerationSeconds);
+    jsonWriter.Write("millisecondsPerChunk", total.GenerationSeconds * 1000.0 / chunkCount);
+    jsonWriter.Write("voxelsPerCpuSecond", total.GenerationSeconds > 0.0 ? voxelCount / total.GenerationSeconds : 0.0);
+    jsonWriter.Write("allocationsPerChunk", static_cast<double>(total.GenerationAllocationCount) / chunkCount);
+    jsonWriter.Write("allocatedBytesPerChunk", static_cast<double>(total.GenerationAllocatedBytes) / chunkCount);
+    jsonWriter.EndObject();
+
+    if (settings.IsComparingLegacyGeneration)
+    {
+        jsonWriter.BeginObject("legacyGeneration");
+        jsonWriter.Write("cpuSeconds", total.LegacyGenerationSeconds);
+        jsonWriter.Write("millisecondsPerChunk", total.LegacyGenerationSeconds * 1000.0 / chunkCount);
+        jsonWriter.Write("voxelsPerCpuSecond", total.LegacyGenerationSeconds > 0.0 ? voxelCount / total.LegacyGenerationSeconds : 0.0);
+        jsonWriter.Write("mismatchChunkCount", total.LegacyMismatchChunkCount);
+        jsonWriter.EndObject();
+    }
+
+    jsonWriter.BeginObject("meshing");
+    jsonWriter.Write("cpuSeconds", total.MeshingSeconds);
+    jsonWriter.Write("millisecondsPerChunk", total.MeshingSeconds * 1000.0 / chunkCount);
+    jsonWriter.Write("voxelsPerCpuSecond", total.MeshingSeconds > 0.0 ? voxelCount / total.MeshingSeconds : 0.0);
+    jsonWriter.Write("allocationsPerChunk", static_cast<double>(total.MeshingAllocationCount) / chunkCount);
+    jsonWriter.Write("allocatedBytesPerChunk", static_cast<double>(total.MeshingAllocatedBytes) / chunkCount);
+    jsonWriter.Write("steadyStateAllocationCount", total.SteadyStateMeshingAllocationCount);
+    jsonWriter.Write("steadyStateChunkCount", total.SteadyStateChunkCount);
+    jsonWriter.EndObject();
+
+    jsonWriter.BeginObject("mesh");
+    jsonWriter.Write("averageQuadsPerChunk", static_cast<double>(total.QuadCount) / chunkCount);
+    jsonWriter.Write("minimumQuadsPerChunk", total.MinimumQuadCount);
+    jsonWriter.Write("maximumQuadsPerChunk", total.MaximumQuadCount);
+    jsonWriter.Write("averageVertexBytesPerChunk", static_cast<double>(total.VertexBytes) / chunkCount);
+    jsonWriter.Write("averageIndexBytesPerChunk", static_cast<double>(total.IndexBytes) / chunkCount);
+    jsonWriter.EndObject();
+
+    jsonWriter.EndObject();
+
+    if (!jsonWriter.SaveToFile(settings.OutputFilePath))
+    {
+        std::cout << "Failed to write the JSON report inside '" << settings.OutputFilePath << "'\n";
+        return -1;
+    }
+
+    std::cout << "  JSON report written inside '" << settings.OutputFilePath << "'\n";
+
+    if (settings.IsCheckingSteadyStateAllocations && total.SteadyStateMeshingAllocationCount != 0)
+    {
+        std::cout << "  FAILED : the meshing still allocates once the meshing context is warmed up\n";
+        return 1;
+    }
+
+    return 0;
+}
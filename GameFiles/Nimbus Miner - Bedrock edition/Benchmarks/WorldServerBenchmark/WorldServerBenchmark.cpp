@@ -0,0 +1,597 @@
+// Language library
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// External libraries (in Dependencies folder)
+#include "GLM/glm.hpp"
+
+// External tools (in ExternalTools folder)
+#include "JsonWriter/JsonWriter.h"
+
+// Engine files (in Source\Constants)
+#include "ProjectConstants.h"
+
+// Engine files (in Source/Engine)
+#include "Engine/Benchmark/BenchmarkStatistics.h"
+
+// Game files (in Source/Game)
+#include "Game/ChunkGeneration/ChunkVoxelData/ChunkVoxelData.h"
+#include "Game/WorldServer/WorldClient.h"
+#include "Game/WorldServer/WorldServer.h"
+
+// ============================================================================================ //
+// World server streaming benchmark.
+//
+// Starts a WorldServer (without persistence) and N simulated clients on the same machine, connected
+// through real loopback sockets. Each client fills its interest area, then moves its camera in a
+// straight line while editing blocks, like a player flying over the world.
+// Measures the chunks and bytes streamed, the time to fill the interest areas, the coverage of the
+// areas while moving and the latency of the edits (from the request to the delta sent back).
+// At the end, the chunks held by several clients must have the same blocks.
+//
+// Launch example :
+// WorldServerBenchmark.exe --clients 8 --radius 8 --seconds 10 --speed 2 --edits 10 --threads 8 --output Result.json
+// ============================================================================================ //
+
+struct BenchmarkSettings
+{
+    int ClientCount = 4;
+
+    /// <summary> In chunks, see WorldClient::SetInterest(). </summary>
+    int InterestRadius = 8;
+
+    /// <summary> How long the clients move (and edit) once their first interest area is filled. </summary>
+    float MovingSeconds = 10.0f;
+
+    /// <summary> The camera speed, in chunks per second. </summary>
+    float CameraSpeed = 2.0f;
+
+    /// <summary> The edits requested per second by each client, while moving. </summary>
+    float EditsPerSecond = 10.0f;
+
+    /// <summary> The number of WorldClient::Update() calls per second of each client (its frame rate). </summary>
+    int ClientUpdateRate = 120;
+
+    unsigned short Port = WORLD_SERVER_DEFAULT_PORT + 1;
+    int WorldSeed = WORLD_SEED;
+
+    /// <summary> The server generation threads, 0 means one per hardware thread minus one. </summary>
+    unsigned int ServerThreadCount = 0;
+
+    std::string OutputFilePath = "WorldServerBenchmark.json";
+};
+
+/// <summary> Everything one client measured, merged at the end of the benchmark. </summary>
+struct ClientResult
+{
+    bool IsConnected = false;
+
+    /// <summary> From the connection to the last chunk of the first interest area, negative if it was never filled. </summary>
+    double InterestFillSeconds = -1.0;
+
+    unsigned long long ReceivedByteCount = 0;
+    unsigned long long SentByteCount = 0;
+    unsigned long long ReceivedChunkCount = 0;
+    unsigned long long UnloadedChunkCount = 0;
+    unsigned long long ReceivedDeltaCount = 0;
+    unsigned long long DamagedChunkCount = 0;
+
+    unsigned long long RequestedEditCount = 0;
+
+    /// <summary> The edits the server never sent back (the chunk was not ready on the server, or left the interest area). </summary>
+    unsigned long long LostEditCount = 0;
+
+    /// <summary> In milliseconds. </summary>
+    std::vector<double> EditLatencies;
+
+    /// <summary> The part of the interest area the client had, summed over the updates of the moving phase. </summary>
+    double CoverageSum = 0.0;
+    unsigned long long CoverageSampleCount = 0;
+
+    Vector2Int FinalInterestCenter = Vector2Int(0, 0);
+};
+
+/// <summary> An edit waiting for its delta. </summary>
+struct PendingEdit
+{
+    Vector3Int WorldBlockPosition;
+    BlockTypes NewType;
+    std::chrono::high_resolution_clock::time_point RequestTime;
+};
+
+static double GetSecondsSince(const std::chrono::high_resolution_clock::time_point& p_startTime)
+{
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - p_startTime).count();
+}
+
+static bool ParseCommandLine(const int p_argumentCount, char* p_arguments[], BenchmarkSettings& p_outSettings)
+{
+    for (int i = 1; i < p_argumentCount; ++i)
+    {
+        const char* argument = p_arguments[i];
+        const int remainingArgumentCount = p_argumentCount - i - 1;
+
+        if (std::strcmp(argument, "--clients") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.ClientCount = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--radius") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.InterestRadius = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--seconds") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.MovingSeconds = static_cast<float>(std::atof(p_arguments[++i]));
+
+        else if (std::strcmp(argument, "--speed") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.CameraSpeed = static_cast<float>(std::atof(p_arguments[++i]));
+
+        else if (std::strcmp(argument, "--edits") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.EditsPerSecond = static_cast<float>(std::atof(p_arguments[++i]));
+
+        else if (std::strcmp(argument, "--client-rate") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.ClientUpdateRate = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--port") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.Port = static_cast<unsigned short>(std::atoi(p_arguments[++i]));
+
+        else if (std::strcmp(argument, "--seed") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.WorldSeed = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--threads") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.ServerThreadCount = static_cast<unsigned int>(std::max(0, std::atoi(p_arguments[++i])));
+
+        else if (std::strcmp(argument, "--output") == 0 && remainingArgumentCount >= 1)
+            p_outSettings.OutputFilePath = p_arguments[++i];
+
+        else
+        {
+            std::cout << "Unknown argument '" << argument << "'\n\n"
+                << "Usage : WorldServerBenchmark [--clients N] [--radius N] [--seconds S] [--speed chunksPerSecond] [--edits perSecond]\n"
+                << "                             [--client-rate updatesPerSecond] [--port N] [--seed N] [--threads N] [--output filePath]\n";
+            return false;
+        }
+    }
+
+    if (p_outSettings.ClientCount <= 0 || p_outSettings.InterestRadius <= 0 || p_outSettings.MovingSeconds < 0.0f ||
+        p_outSettings.CameraSpeed < 0.0f || p_outSettings.EditsPerSecond < 0.0f || p_outSettings.ClientUpdateRate <= 0 || p_outSettings.Port == 0)
+    {
+        std::cout << "The client count, radius, client rate and port must be positive, the seconds, speed and edits can't be negative.\n";
+        return false;
+    }
+
+    if (p_outSettings.InterestRadius > WORLD_SERVER_MAXIMUM_INTEREST_RADIUS)
+    {
+        std::cout << "The radius can't be bigger than WORLD_SERVER_MAXIMUM_INTEREST_RADIUS (" << WORLD_SERVER_MAXIMUM_INTEREST_RADIUS << ").\n";
+        return false;
+    }
+
+    return true;
+}
+
+/// <summary> Returns the part of the interest area (a circle of chunks) the client has, between 0 and 1. </summary>
+static double GetInterestCoverage(const WorldClient& p_client, const Vector2Int& p_centerChunkPosition, const int p_radius)
+{
+    int chunkCount = 0;
+    int heldChunkCount = 0;
+
+    for (int x = -p_radius; x <= p_radius; ++x)
+    {
+        for (int z = -p_radius; z <= p_radius; ++z)
+        {
+            if (x * x + z * z > p_radius * p_radius)
+                continue;
+
+            chunkCount++;
+
+            if (p_client.GetChunk(Vector2Int(p_centerChunkPosition.X + x, p_centerChunkPosition.Y + z)) != nullptr)
+                heldChunkCount++;
+        }
+    }
+
+    return static_cast<double>(heldChunkCount) / static_cast<double>(chunkCount);
+}
+
+/// <summary> Moves the edits the server sent back out of p_pendingEdits, and measures their latency. </summary>
+static void MatchBlockChanges(WorldClient& p_client, std::vector<PendingEdit>& p_pendingEdits, std::vector<WorldClient::BlockChange>& p_blockChanges,
+    ClientResult& p_outResult)
+{
+    p_blockChanges.clear();
+    p_client.TakeBlockChanges(p_blockChanges);
+
+    const std::chrono::high_resolution_clock::time_point now = std::chrono::high_resolution_clock::now();
+
+    // NOTE : The changes of the other clients are received too, they match none of the pending edits
+    for (const WorldClient::BlockChange& blockChange : p_blockChanges)
+    {
+        for (size_t i = 0; i < p_pendingEdits.size(); ++i)
+        {
+            const PendingEdit& pendingEdit = p_pendingEdits[i];
+
+            if (pendingEdit.NewType != blockChange.NewType || pendingEdit.WorldBlockPosition.X != blockChange.WorldBlockPosition.X ||
+                pendingEdit.WorldBlockPosition.Y != blockChange.WorldBlockPosition.Y || pendingEdit.WorldBlockPosition.Z != blockChange.WorldBlockPosition.Z)
+                continue;
+
+            p_outResult.EditLatencies.push_back(std::chrono::duration<double, std::milli>(now - pendingEdit.RequestTime).count());
+
+            p_pendingEdits[i] = p_pendingEdits.back();
+            p_pendingEdits.pop_back();
+            break;
+        }
+    }
+}
+
+/// <summary> One simulated player : fills its interest area, moves and edits, then waits for the last deltas. </summary>
+static void RunClientThread(const BenchmarkSettings& p_settings, const int p_clientIndex, WorldClient& p_client, ClientResult& p_outResult)
+{
+    const std::chrono::high_resolution_clock::time_point connectionTime = std::chrono::high_resolution_clock::now();
+
+    if (!p_client.Connect(p_settings.Port))
+        return;
+
+    p_outResult.IsConnected = true;
+
+    const std::chrono::microseconds updateInterval(1000000 / p_settings.ClientUpdateRate);
+
+    // The clients start next to each other (their areas overlap), then move away in different directions
+    const float startX = static_cast<float>(p_clientIndex * p_settings.InterestRadius);
+    const float startZ = 0.0f;
+    const float directionAngle = 6.2831853f * static_cast<float>(p_clientIndex) / static_cast<float>(p_settings.ClientCount);
+
+    Vector2Int interestCenter = Vector2Int(static_cast<int>(std::floor(startX)), static_cast<int>(std::floor(startZ)));
+    p_client.SetInterest(interestCenter, p_settings.InterestRadius);
+
+    // - Initial interest area - //
+
+    // NOTE : The fill is given up after a minute, the server is too slow (or gone)
+    while (p_client.IsConnected() && GetSecondsSince(connectionTime) < 60.0)
+    {
+        p_client.Update();
+
+        if (GetInterestCoverage(p_client, interestCenter, p_settings.InterestRadius) >= 1.0)
+        {
+            p_outResult.InterestFillSeconds = GetSecondsSince(connectionTime);
+            break;
+        }
+
+        std::this_thread::sleep_for(updateInterval);
+    }
+
+    // - Moving and editing - //
+
+    std::mt19937 randomGenerator(static_cast<unsigned int>(p_clientIndex + 1));
+    std::vector<PendingEdit> pendingEdits;
+    std::vector<WorldClient::BlockChange> blockChanges;
+
+    const std::chrono::high_resolution_clock::time_point movingStartTime = std::chrono::high_resolution_clock::now();
+    double nextEditSeconds = 0.0;
+
+    while (p_client.IsConnected())
+    {
+        const double movingSeconds = GetSecondsSince(movingStartTime);
+
+        if (movingSeconds >= p_settings.MovingSeconds)
+            break;
+
+        const float distance = p_settings.CameraSpeed * static_cast<float>(movingSeconds);
+
+        interestCenter = Vector2Int(
+            static_cast<int>(std::floor(startX + std::cos(directionAngle) * distance)),
+            static_cast<int>(std::floor(startZ + std::sin(directionAngle) * distance))
+        );
+
+        p_client.SetInterest(interestCenter, p_settings.InterestRadius);
+
+        // The edits are made in the chunk under the camera, like a player digging around
+        const ChunkVoxelData* centerChunk = p_client.GetChunk(interestCenter);
+
+        if (p_settings.EditsPerSecond > 0.0f && movingSeconds >= nextEditSeconds && centerChunk != nullptr)
+        {
+            const Vector3Int& chunkSize = p_client.GetChunkSize();
+
+            const Vector3Int worldBlockPosition = Vector3Int(
+                interestCenter.X * chunkSize.X + static_cast<int>(randomGenerator() % static_cast<unsigned int>(chunkSize.X)),
+                static_cast<int>(randomGenerator() % static_cast<unsigned int>(chunkSize.Y)),
+                interestCenter.Y * chunkSize.Z + static_cast<int>(randomGenerator() % static_cast<unsigned int>(chunkSize.Z))
+            );
+
+            PendingEdit pendingEdit;
+            pendingEdit.WorldBlockPosition = worldBlockPosition;
+            pendingEdit.NewType = p_client.GetBlock(worldBlockPosition) == BlockTypes::Air ? BlockTypes::LightCloud : BlockTypes::Air;
+            pendingEdit.RequestTime = std::chrono::high_resolution_clock::now();
+
+            p_client.RequestBlockEdit(pendingEdit.WorldBlockPosition, pendingEdit.NewType);
+            pendingEdits.push_back(pendingEdit);
+
+            p_outResult.RequestedEditCount++;
+            nextEditSeconds += 1.0 / p_settings.EditsPerSecond;
+        }
+
+        p_client.Update();
+        MatchBlockChanges(p_client, pendingEdits, blockChanges, p_outResult);
+
+        p_outResult.CoverageSum += GetInterestCoverage(p_client, interestCenter, p_settings.InterestRadius);
+        p_outResult.CoverageSampleCount++;
+
+        std::this_thread::sleep_for(updateInterval);
+    }
+
+    // - Last deltas - //
+
+    // NOTE : Long enough for several server ticks, the deltas of the other clients arrive too
+    const std::chrono::high_resolution_clock::time_point settleStartTime = std::chrono::high_resolution_clock::now();
+
+    while (p_client.IsConnected() && GetSecondsSince(settleStartTime) < 1.0)
+    {
+        p_client.Update();
+        MatchBlockChanges(p_client, pendingEdits, blockChanges, p_outResult);
+
+        std::this_thread::sleep_for(updateInterval);
+    }
+
+    p_outResult.LostEditCount = pendingEdits.size();
+    p_outResult.FinalInterestCenter = interestCenter;
+    p_outResult.ReceivedByteCount = p_client.GetReceivedByteCount();
+    p_outResult.SentByteCount = p_client.GetSentByteCount();
+    p_outResult.ReceivedChunkCount = p_client.GetReceivedChunkCount();
+    p_outResult.UnloadedChunkCount = p_client.GetUnloadedChunkCount();
+    p_outResult.ReceivedDeltaCount = p_client.GetReceivedDeltaCount();
+    p_outResult.DamagedChunkCount = p_client.GetDamagedChunkCount();
+}
+
+int main(const int p_argumentCount, char* p_arguments[])
+{
+    BenchmarkSettings settings;
+
+    if (!ParseCommandLine(p_argumentCount, p_arguments, settings))
+        return -1;
+
+    // -- Server -- //
+
+    WorldServerSettings serverSettings;
+    serverSettings.IsEnabled = true;
+    serverSettings.Port = settings.Port;
+    serverSettings.WorldSeed = settings.WorldSeed;
+    serverSettings.NoiseFrequency = NOISE_FREQUENCY;
+    serverSettings.ThreadCount = settings.ServerThreadCount;
+
+    // NOTE : Nothing is read from the disk, every run generates the same chunks
+    serverSettings.IsPersistenceEnabled = false;
+
+    WorldServer worldServer(serverSettings);
+
+    if (!worldServer.Start())
+        return -1;
+
+    std::atomic<bool> isServerStopRequested(false);
+    std::thread serverThread([&worldServer, &isServerStopRequested]() { worldServer.Run(isServerStopRequested); });
+
+    // -- Clients -- //
+
+    std::vector<WorldClient*> clients;
+    std::vector<ClientResult> clientResults(settings.ClientCount);
+    std::vector<std::thread> clientThreads;
+    clientThreads.reserve(settings.ClientCount);
+
+    for (int i = 0; i < settings.ClientCount; ++i)
+        clients.push_back(new WorldClient());
+
+    const std::chrono::high_resolution_clock::time_point benchmarkStartTime = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < settings.ClientCount; ++i)
+        clientThreads.emplace_back(RunClientThread, std::cref(settings), i, std::ref(*clients[i]), std::ref(clientResults[i]));
+
+    for (std::thread& clientThread : clientThreads)
+        clientThread.join();
+
+    const double wallSeconds = GetSecondsSince(benchmarkStartTime);
+
+    isServerStopRequested = true;
+    serverThread.join();
+
+    // -- Consistency : the chunks held by two clients must have the same blocks -- //
+
+    unsigned long long comparedChunkCount = 0;
+    unsigned long long mismatchChunkCount = 0;
+
+    for (int i = 0; i < settings.ClientCount; ++i)
+    {
+        const Vector2Int center = clientResults[i].FinalInterestCenter;
+        const int radius = settings.InterestRadius;
+
+        for (int x = center.X - radius - 1; x <= center.X + radius + 1; ++x)
+        {
+            for (int z = center.Y - radius - 1; z <= center.Y + radius + 1; ++z)
+            {
+                const ChunkVoxelData* chunk = clients[i]->GetChunk(Vector2Int(x, z));
+
+                if (chunk == nullptr)
+                    continue;
+
+                for (int j = i + 1; j < settings.ClientCount; ++j)
+                {
+                    const ChunkVoxelData* otherChunk = clients[j]->GetChunk(Vector2Int(x, z));
+
+                    if (otherChunk == nullptr)
+                        continue;
+
+                    comparedChunkCount++;
+
+                    if (!std::equal(chunk->GetBlocks(), chunk->GetBlocks() + chunk->GetBlockCount(), otherChunk->GetBlocks()))
+                        mismatchChunkCount++;
+                }
+            }
+        }
+    }
+
+    const size_t chunkBlockByteSize = static_cast<size_t>(serverSettings.ChunkSize.X) * serverSettings.ChunkSize.Y * serverSettings.ChunkSize.Z * sizeof(BlockTypes);
+
+    for (const WorldClient* client : clients)
+        delete client;
+
+    clients.clear();
+
+    // -- Merging the results -- //
+
+    ClientResult total;
+    std::vector<double> fillSeconds;
+    int connectedClientCount = 0;
+
+    for (const ClientResult& clientResult : clientResults)
+    {
+        if (!clientResult.IsConnected)
+            continue;
+
+        connectedClientCount++;
+
+        if (clientResult.InterestFillSeconds >= 0.0)
+            fillSeconds.push_back(clientResult.InterestFillSeconds);
+
+        total.ReceivedByteCount += clientResult.ReceivedByteCount;
+        total.SentByteCount += clientResult.SentByteCount;
+        total.ReceivedChunkCount += clientResult.ReceivedChunkCount;
+        total.UnloadedChunkCount += clientResult.UnloadedChunkCount;
+        total.ReceivedDeltaCount += clientResult.ReceivedDeltaCount;
+        total.DamagedChunkCount += clientResult.DamagedChunkCount;
+        total.RequestedEditCount += clientResult.RequestedEditCount;
+        total.LostEditCount += clientResult.LostEditCount;
+        total.CoverageSum += clientResult.CoverageSum;
+        total.CoverageSampleCount += clientResult.CoverageSampleCount;
+        total.EditLatencies.insert(total.EditLatencies.end(), clientResult.EditLatencies.begin(), clientResult.EditLatencies.end());
+    }
+
+    std::sort(fillSeconds.begin(), fillSeconds.end());
+
+    const int unfilledClientCount = connectedClientCount - static_cast<int>(fillSeconds.size());
+    const double averageFillSeconds = fillSeconds.empty() ? 0.0 : std::accumulate(fillSeconds.begin(), fillSeconds.end(), 0.0) / static_cast<double>(fillSeconds.size());
+    const double maximumFillSeconds = fillSeconds.empty() ? 0.0 : fillSeconds.back();
+    const double averageCoverage = total.CoverageSampleCount > 0 ? total.CoverageSum / static_cast<double>(total.CoverageSampleCount) : 0.0;
+
+    // NOTE : Nearest-rank percentiles, like the render benchmark
+    const BenchmarkStatistics editLatencyStatistics = BenchmarkStatistics::Compute(total.EditLatencies);
+
+    const double chunkCount = static_cast<double>(total.ReceivedChunkCount);
+    const double averageChunkBytes = worldServer.GetSentChunkCount() > 0 ?
+        static_cast<double>(worldServer.GetSentChunkByteCount()) / static_cast<double>(worldServer.GetSentChunkCount()) : 0.0;
+
+    // -- Human readable table -- //
+
+    std::printf("\n World server streaming benchmark\n");
+    std::printf("  %d clients (%d connected) | radius %d chunks | %.1f s moving at %.1f chunks/s | %.1f edits/s per client | generation threads : %u (0 means automatic)\n\n",
+        settings.ClientCount, connectedClientCount, settings.InterestRadius, settings.MovingSeconds, settings.CameraSpeed,
+        settings.EditsPerSecond, serverSettings.ThreadCount);
+
+    std::printf("  Chunks streamed      : %llu (%.1f chunks/s over %.2f s, %llu unloaded by the clients)\n",
+        total.ReceivedChunkCount, wallSeconds > 0.0 ? chunkCount / wallSeconds : 0.0, wallSeconds, total.UnloadedChunkCount);
+    std::printf("  Bytes received       : %.2f MB (%.2f MB/s), %.2f KB sent by the clients\n",
+        static_cast<double>(total.ReceivedByteCount) / (1024.0 * 1024.0),
+        wallSeconds > 0.0 ? static_cast<double>(total.ReceivedByteCount) / (1024.0 * 1024.0) / wallSeconds : 0.0,
+        static_cast<double>(total.SentByteCount) / 1024.0);
+    std::printf("  Bytes per chunk      : %.0f (%.1fx smaller than the %zu bytes of blocks)\n",
+        averageChunkBytes, averageChunkBytes > 0.0 ? static_cast<double>(chunkBlockByteSize) / averageChunkBytes : 0.0, chunkBlockByteSize);
+    std::printf("  Interest area fill   : %.3f s average, %.3f s maximum%s\n",
+        averageFillSeconds, maximumFillSeconds, unfilledClientCount == 0 ? "" : " (ERROR : some areas were never filled)");
+    std::printf("  Coverage while moving: %.1f %% of the interest area\n", averageCoverage * 100.0);
+    std::printf("  Edit latency         : %.2f ms average, %.2f ms p50, %.2f ms p99, %.2f ms maximum (%zu edits, %llu lost)\n",
+        editLatencyStatistics.Average, editLatencyStatistics.Median, editLatencyStatistics.Percentile99, editLatencyStatistics.Maximum,
+        editLatencyStatistics.SampleCount, total.LostEditCount);
+    std::printf("  Deltas received      : %llu blocks (the edits of the other clients included)\n", total.ReceivedDeltaCount);
+    std::printf("  Server               : %llu chunks generated, %llu unloaded, tick %.3f ms average (%.3f ms maximum)\n",
+        worldServer.GetGeneratedChunkCount(), worldServer.GetUnloadedChunkCount(),
+        worldServer.GetAverageTickMilliseconds(), worldServer.GetMaximumTickMilliseconds());
+    std::printf("  Consistency          : %llu shared chunks compared, %llu different%s, %llu damaged\n",
+        comparedChunkCount, mismatchChunkCount, mismatchChunkCount == 0 ? "" : " (ERROR)", total.DamagedChunkCount);
+
+    std::printf("\n");
+
+    // -- JSON -- //
+
+    JsonWriter jsonWriter;
+    jsonWriter.BeginObject();
+
+    jsonWriter.BeginObject("settings");
+    jsonWriter.Write("clientCount", settings.ClientCount);
+    jsonWriter.Write("interestRadius", settings.InterestRadius);
+    jsonWriter.Write("movingSeconds", static_cast<double>(settings.MovingSeconds));
+    jsonWriter.Write("cameraSpeed", static_cast<double>(settings.CameraSpeed));
+    jsonWriter.Write("editsPerSecond", static_cast<double>(settings.EditsPerSecond));
+    jsonWriter.Write("clientUpdateRate", settings.ClientUpdateRate);
+    jsonWriter.Write("serverTicksPerSecond", WORLD_SERVER_TICKS_PER_SECOND);
+    jsonWriter.Write("serverThreadCount", serverSettings.ThreadCount);
+    jsonWriter.Write("worldSeed", settings.WorldSeed);
+    jsonWriter.EndObject();
+
+    jsonWriter.Write("connectedClientCount", connectedClientCount);
+    jsonWriter.Write("wallSeconds", wallSeconds);
+
+    jsonWriter.BeginObject("streaming");
+    jsonWriter.Write("receivedChunkCount", total.ReceivedChunkCount);
+    jsonWriter.Write("unloadedChunkCount", total.UnloadedChunkCount);
+    jsonWriter.Write("chunksPerSecond", wallSeconds > 0.0 ? chunkCount / wallSeconds : 0.0);
+    jsonWriter.Write("receivedByteCount", total.ReceivedByteCount);
+    jsonWriter.Write("receivedBytesPerSecond", wallSeconds > 0.0 ? static_cast<double>(total.ReceivedByteCount) / wallSeconds : 0.0);
+    jsonWriter.Write("clientSentByteCount", total.SentByteCount);
+    jsonWriter.Write("averageChunkBytes", averageChunkBytes);
+    jsonWriter.Write("chunkBlockBytes", static_cast<unsigned long long>(chunkBlockByteSize));
+    jsonWriter.EndObject();
+
+    jsonWriter.BeginObject("interestArea");
+    jsonWriter.Write("averageFillSeconds", averageFillSeconds);
+    jsonWriter.Write("maximumFillSeconds", maximumFillSeconds);
+    jsonWriter.Write("unfilledClientCount", unfilledClientCount);
+    jsonWriter.Write("averageCoverageWhileMoving", averageCoverage);
+    jsonWriter.EndObject();
+
+    jsonWriter.BeginObject("edits");
+    jsonWriter.Write("requestedCount", total.RequestedEditCount);
+    jsonWriter.Write("lostCount", total.LostEditCount);
+    jsonWriter.Write("receivedDeltaCount", total.ReceivedDeltaCount);
+    jsonWriter.Write("averageLatencyMilliseconds", editLatencyStatistics.Average);
+    jsonWriter.Write("p50LatencyMilliseconds", editLatencyStatistics.Median);
+    jsonWriter.Write("p99LatencyMilliseconds", editLatencyStatistics.Percentile99);
+    jsonWriter.Write("maximumLatencyMilliseconds", editLatencyStatistics.Maximum);
+    jsonWriter.EndObject();
+
+    jsonWriter.BeginObject("server");
+    jsonWriter.Write("tickCount", worldServer.GetTickCount());
+    jsonWriter.Write("averageTickMilliseconds", worldServer.GetAverageTickMilliseconds());
+    jsonWriter.Write("maximumTickMilliseconds", worldServer.GetMaximumTickMilliseconds());
+    jsonWriter.Write("generatedChunkCount", worldServer.GetGeneratedChunkCount());
+    jsonWriter.Write("unloadedChunkCount", worldServer.GetUnloadedChunkCount());
+    jsonWriter.Write("sentChunkCount", worldServer.GetSentChunkCount());
+    jsonWriter.Write("appliedEditCount", worldServer.GetAppliedEditCount());
+    jsonWriter.Write("rejectedEditCount", worldServer.GetRejectedEditCount());
+    jsonWriter.EndObject();
+
+    jsonWriter.BeginObject("consistency");
+    jsonWriter.Write("comparedChunkCount", comparedChunkCount);
+    jsonWriter.Write("mismatchChunkCount", mismatchChunkCount);
+    jsonWriter.Write("damagedChunkCount", total.DamagedChunkCount);
+    jsonWriter.EndObject();
+
+    jsonWriter.EndObject();
+
+    if (!jsonWriter.SaveToFile(settings.OutputFilePath))
+    {
+        std::cout << "Failed to write the JSON report inside '" << settings.OutputFilePath << "'\n";
+        return -1;
+    }
+
+    std::cout << "  JSON report written inside '" << settings.OutputFilePath << "'\n";
+
+    if (mismatchChunkCount != 0 || total.DamagedChunkCount != 0 || unfilledClientCount != 0)
+    {
+        std::cout << "  FAILED : the clients did not all get the same world\n";
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "JsonWriter.h"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+JsonWriter::JsonWriter()
+{
+    // Enough precision for milliseconds timings without printing noise
+    _stream << std::setprecision(9);
+}
+
+#pragma region // -=- Scopes -=- //
+
+void JsonWriter::BeginObject()
+{
+    BeginValue();
+    _stream << '{';
+    _scopeHasValues.push_back(false);
+}
+
+void JsonWriter::BeginObject(const std::string& p_key)
+{
+    WriteKey(p_key);
+    _stream << '{';
+    _scopeHasValues.push_back(false);
+}
+
+void JsonWriter::EndObject()
+{
+    const bool hasValues = _scopeHasValues.back();
+    _scopeHasValues.pop_back();
+
+    if (hasValues)
+    {
+        _stream << '\n';
+        WriteIndentation();
+    }
+
+    _stream << '}';
+}
+
+void JsonWriter::BeginArray()
+{
+    BeginValue();
+    _stream << '[';
+    _scopeHasValues.push_back(false);
+}
+
+void JsonWriter::BeginArray(const std::string& p_key)
+{
+    WriteKey(p_key);
+    _stream << '[';
+    _scopeHasValues.push_back(false);
+}
+
+void JsonWriter::EndArray()
+{
+    const bool hasValues = _scopeHasValues.back();
+    _scopeHasValues.pop_back();
+
+    if (hasValues)
+    {
+        _stream << '\n';
+        WriteIndentation();
+    }
+
+    _stream << ']';
+}
+
+#pragma endregion
+
+#pragma region // -=- Key / value writing -=- //
+
+void JsonWriter::Write(const std::string& p_key, const std::string& p_value)
+{
+    WriteKey(p_key);
+    WriteEscapedString(p_value);
+}
+
+void JsonWriter::Write(const std::string& p_key, const char* p_value)
+{
+    Write(p_key, std::string(p_value == nullptr ? "" : p_value));
+}
+
+void JsonWriter::Write(const std::string& p_key, const double p_value)
+{
+    WriteKey(p_key);
+
+    // NaN and infinity are not valid JSON values
+    if (std::isfinite(p_value))
+        _stream << p_value;
+    else
+        _stream << "null";
+}
+
+void JsonWriter::Write(const std::string& p_key, const long long p_value)
+{
+    WriteKey(p_key);
+    _stream << p_value;
+}
+
+void JsonWriter::Write(const std::string& p_key, const int p_value)
+{
+    Write(p_key, static_cast<long long>(p_value));
+}
+
+void JsonWriter::Write(const std::string& p_key, const unsigned int p_value)
+{
+    Write(p_key, static_cast<long long>(p_value));
+}
+
+void JsonWriter::Write(const std::string& p_key, const unsigned long long p_value)
+{
+    WriteKey(p_key);
+    _stream << p_value;
+}
+
+void JsonWriter::Write(const std::string& p_key, const bool p_value)
+{
+    WriteKey(p_key);
+    _stream << (p_value ? "true" : "false");
+}
+
+void JsonWriter::WriteValue(const double p_value)
+{
+    BeginValue();
+
+    if (std::isfinite(p_value))
+        _stream << p_value;
+    else
+        _stream << "null";
+}
+
+void JsonWriter::WriteValue(const long long p_value)
+{
+    BeginValue();
+    _stream << p_value;
+}
+
+void JsonWriter::WriteValue(const std::string& p_value)
+{
+    BeginValue();
+    WriteEscapedString(p_value);
+}
+
+#pragma endregion
+
+bool JsonWriter::SaveToFile(const std::string& p_filePath) const
+{
+    std::ofstream file(p_filePath, std::ofstream::trunc);
+
+    if (!file.is_open())
+        return false;
+
+    file << _stream.str() << '\n';
+
+    return true;
+}
+
+void JsonWriter::BeginValue()
+{
+    // Root value
+    if (_scopeHasValues.empty())
+        return;
+
+    if (_scopeHasValues.back())
+        _stream << ',';
+
+    _scopeHasValues.back() = true;
+
+    _stream << '\n';
+    WriteIndentation();
+}
+
+void JsonWriter::WriteKey(const std::string& p_key)
+{
+    BeginValue();
+    WriteEscapedString(p_key);
+    _stream << ": ";
+}
+
+void JsonWriter::WriteEscapedString(const std::string& p_value)
+{
+    _stream << '"';
+
+    for (const char character : p_value)
+    {
+        switch (character)
+        {
+            case '"':  _stream << "\\\""; break;
+            case '\\': _stream << "\\\\"; break;
+            case '\n': _stream << "\\n";  break;
+            case '\r': _stream << "\\r";  break;
+            case '\t': _stream << "\\t";  break;
+
+            default:
+                _stream << character;
+                break;
+        }
+    }
+
+    _stream << '"';
+}
+
+void JsonWriter::WriteIndentation()
+{
+    for (size_t i = 0; i < _scopeHasValues.size(); ++i)
+        _stream << "    ";
+}
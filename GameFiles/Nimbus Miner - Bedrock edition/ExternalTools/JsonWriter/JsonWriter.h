@@ -0,0 +1,71 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Small streaming JSON writer, used to export benchmark results and statistics.
+///
+/// <para> Keys are only used inside objects, inside arrays use the methods without the 'p_key' parameter. </para>
+///
+/// <para> <b> Usage example: </b> </para>
+/// <code>
+/// JsonWriter jsonWriter;
+/// jsonWriter.BeginObject();
+///     jsonWriter.Write("frameCount", 500);
+///     jsonWriter.BeginArray("frameTimes");
+///         jsonWriter.WriteValue(16.6);
+///     jsonWriter.EndArray();
+/// jsonWriter.EndObject();
+///
+/// jsonWriter.SaveToFile("Result.json");
+/// </code> </summary>
+class JsonWriter
+{
+
+private:
+
+    std::ostringstream _stream;
+
+    // One entry per opened object / array, true if the scope already contains a value (so we need a comma)
+    std::vector<bool> _scopeHasValues;
+
+public:
+
+    JsonWriter();
+
+    void BeginObject();
+    void BeginObject(const std::string& p_key);
+    void EndObject();
+
+    void BeginArray();
+    void BeginArray(const std::string& p_key);
+    void EndArray();
+
+    void Write(const std::string& p_key, const std::string& p_value);
+    void Write(const std::string& p_key, const char* p_value);
+    void Write(const std::string& p_key, double p_value);
+    void Write(const std::string& p_key, long long p_value);
+    void Write(const std::string& p_key, int p_value);
+    void Write(const std::string& p_key, unsigned int p_value);
+    void Write(const std::string& p_key, unsigned long long p_value);
+    void Write(const std::string& p_key, bool p_value);
+
+    void WriteValue(double p_value);
+    void WriteValue(long long p_value);
+    void WriteValue(const std::string& p_value);
+
+    std::string ToString() const { return _stream.str(); }
+
+    /// <summary> Writes the JSON text inside the given file (the file is overridden). Returns false if the file can't be opened. </summary>
+    bool SaveToFile(const std::string& p_filePath) const;
+
+private:
+
+    /// <summary> Writes the comma (if needed) and the indentation before a new value. </summary>
+    void BeginValue();
+    void WriteKey(const std::string& p_key);
+    void WriteEscapedString(const std::string& p_value);
+    void WriteIndentation();
+};
@@ -1,4 +1,6 @@
 // Language library
+#include <atomic>
+#include <csignal>
 #include <iostream>
 
 // External libraries (in Dependencies folder)
@@ -16,11 +18,16 @@
 
 // Engine files (in Source\Engine\Rendering folder)
 #include "Camera.h"
+#include "FrameBufferObject.h"
+#include "FrameUniformData.h"
+#include "GpuTimer.h"
 #include "Renderer.h"
 #include "Vertex.h"
 #include "IndexBufferObject.h"
+#include "OverdrawCounter.h"
 #include "VertexArrayObject.h"
 #include "VertexBufferObject.h"
+#include "UniformBufferObject.h"
 #include "Shader.h"
 #include "Texture.h"
 #include "Texture/Texture2DArray.h"
@@ -28,13 +35,31 @@
 // Engine files (in Source\Engine\Inputs folder)
 #include "Engine/Inputs/InputsDetector.h"
 
+// Engine files (in Source\Engine\Benchmark folder)
+#include "Engine/Benchmark/CameraRecording.h"
+#include "Engine/Benchmark/RenderBenchmark.h"
+
+// Engine files (in Source\Engine\Culling folder)
+#include "Engine/Culling/OcclusionCuller.h"
+
+// Engine files (in Source\Engine\Memory folder)
+#include "Engine/Memory/ChunkMemoryPool.h"
+
+// Engine files (in Source\Engine\Timing folder)
+#include "Engine/Timing/FramePacer.h"
+
 // Engine files (in Source\Constants)
 #include "DebuggingConstants.h"
 #include "ProjectConstants.h"
 
 // Game files (in Source/Game)
 #include "Game/ChunkGeneration/ChunkManager/ChunkManager.h"
+#include "Game/ChunkGeneration/ChunkRenderObject/ChunkRenderObject.h"
+#include "Game/ChunkGeneration/ChunkStorage/ChunkMeshCache.h"
+#include "Game/ChunkGeneration/ChunkStorage/ChunkStorage.h"
+#include "Game/ChunkGeneration/FarTerrain/FarTerrain.h"
 #include "Game/ChunkGeneration/GreedyChunk/GreedyChunk.h"
+#include "Game/WorldServer/WorldServer.h"
 
 // Camera creation
 static Camera camera(CAMERA_SPAWN_POSITION, CAMERA_MOVEMENT_SPEED, CAMERA_ROTATION_SENSITIVITY);
@@ -61,7 +86,31 @@ void MouseCallback(GLFWwindow* p_window, const double p_xPosition, const double
     camera.ProcessMouseMovement(xOffset, yOffset);
 }
 
-int main(void)
+// Set by Ctrl+C in server mode, the server saves the world before stopping
+static std::atomic<bool> isWorldServerStopRequested(false);
+
+void RequestWorldServerStop(int /* p_signal */)
+{
+    isWorldServerStopRequested = true;
+}
+
+/// <summary> Runs the headless world server until Ctrl+C (see the WorldServer class documentation), no window is created. </summary>
+int RunWorldServer(const WorldServerSettings& p_settings)
+{
+    std::signal(SIGINT, RequestWorldServerStop);
+    std::signal(SIGTERM, RequestWorldServerStop);
+
+    WorldServer worldServer(p_settings);
+
+    if (!worldServer.Start())
+        return -1;
+
+    worldServer.Run(isWorldServerStopRequested);
+
+    return 0;
+}
+
+int main(const int p_argumentCount, char* p_arguments[])
 {
     RuntimeLogger::Log(
         "========================\n"
@@ -72,6 +121,24 @@ int main(void)
     
     MessageDebugger::TestMessageDebugger(TestOptionsEnum::NoTests);
 
+    // The server mode is enabled with the "--server" argument, it does not use OpenGL at all
+    const WorldServerSettings worldServerSettings = WorldServer::ParseCommandLine(p_argumentCount, p_arguments);
+
+    if (worldServerSettings.IsEnabled)
+        return RunWorldServer(worldServerSettings);
+
+    // The benchmark mode is enabled with the "--benchmark" argument (see the RenderBenchmark class documentation)
+    RenderBenchmark renderBenchmark(RenderBenchmark::ParseCommandLine(p_argumentCount, p_arguments));
+    const bool isBenchmarkMode = renderBenchmark.GetSettings().IsEnabled;
+
+    // NOTE : A recorded camera path gives the world seed and the frame count, it's read before the world creation
+    if (isBenchmarkMode && !renderBenchmark.LoadCameraPath())
+        return -1;
+
+    // With the "--record-camera" argument the camera of the played session is saved, for the benchmark's "--camera-path" argument
+    const std::string& cameraRecordingFilePath = renderBenchmark.GetSettings().RecordCameraFilePath;
+    const bool isRecordingCamera = !isBenchmarkMode && !cameraRecordingFilePath.empty();
+
     #pragma region - Program initialization -
 
     // Initialize the GLFW library
@@ -83,6 +150,9 @@ int main(void)
     // must be after the glfwInit() and before the glfwCreateWindow() functions
     glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, IS_GPU_IN_DEBUG_MODE);
 
+    // In benchmark mode nobody looks at the screen, so the window is hidden (we render inside a FrameBufferObject)
+    glfwWindowHint(GLFW_VISIBLE, isBenchmarkMode ? GLFW_FALSE : GLFW_TRUE);
+
     // Create a windowed mode window and its OpenGL context
     GLFWwindow* window = glfwCreateWindow(static_cast<int>(WINDOW_SIZE_X), static_cast<int>(WINDOW_SIZE_Y), "Nimbus miner - Bedrock edition", nullptr, nullptr);
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -96,8 +166,9 @@ int main(void)
     // Make the window's context current
     glfwMakeContextCurrent(window);
 
-    // Make the framerate constant
-    glfwSwapInterval(1);
+    // Decides when the frames begin (vsync, frame limiter or uncapped), the benchmark needs the real frame cost so it is never capped
+    FramePacer framePacer(isBenchmarkMode ? FramePacer::FramePacingModes::Uncapped : static_cast<FramePacer::FramePacingModes>(FRAME_PACING_DEFAULT_MODE),
+        FRAME_PACING_DEFAULT_TARGET_FRAMES_PER_SECOND);
     
     // Glew initialization
     if (glewInit() != GLEW_OK)
@@ -111,9 +182,13 @@ int main(void)
         return -1;
     }
 
-    glEnable(GL_DEBUG_OUTPUT); // Enables OpenGL to generate debug messages and send them to the callback (if not already enabled by default)
-    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS); // To force OpenGL to send the error right when it appends
-    glDebugMessageCallback(OpenGlDebugger::PrintOpenGlErrors, nullptr);
+    // NOTE : The debug output needs OpenGL 4.3 (or the KHR_debug extension), some drivers (software ones for example) don't have it
+    if (GLEW_VERSION_4_3 || GLEW_KHR_debug)
+    {
+        glEnable(GL_DEBUG_OUTPUT); // Enables OpenGL to generate debug messages and send them to the callback (if not already enabled by default)
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS); // To force OpenGL to send the error right when it appends
+        glDebugMessageCallback(OpenGlDebugger::PrintOpenGlErrors, nullptr);
+    }
     
     // NOTE : You can un-comment the code below if you need transparency
 
@@ -128,6 +203,23 @@ int main(void)
     // Tells OpenGL to not draw counterclockwise faces, it's for optimization (the 'counterclockwise' it set by default by OpenGL)
     glEnable(GL_CULL_FACE); 
 
+    // Off-screen render target of the benchmark mode
+    FrameBufferObject* benchmarkFrameBufferObject = nullptr;
+
+    if (isBenchmarkMode)
+    {
+        benchmarkFrameBufferObject = new FrameBufferObject(static_cast<int>(WINDOW_SIZE_X), static_cast<int>(WINDOW_SIZE_Y));
+
+        if (!benchmarkFrameBufferObject->IsComplete())
+        {
+            PRINT_ERROR_RUNTIME(true, "The benchmark FrameBufferObject is not complete.\nThe application has been stopped.")
+
+            delete benchmarkFrameBufferObject;
+            glfwTerminate();
+            return -1;
+        }
+    }
+
     #pragma endregion
     
     #pragma region - Inputs -
@@ -259,7 +351,9 @@ int main(void)
 
     // NOTE : Because we are using GLM we multiply all our matrix backward (the order of matrix multiplication maters)
     
-    glm::mat4 modelViewProjectionMatrix = projectionMatrix * viewMatrix * modelMatrix;
+    // The camera matrices are shared by all the shaders through a UBO, updated once per frame (see FrameUniformData.h)
+    FrameUniformData frameUniformData;
+    UniformBufferObject frameUniformBufferObject(sizeof(FrameUniformData), FrameUniformData::BindingPoint);
     
     #pragma endregion
 
@@ -267,9 +361,10 @@ int main(void)
 
     Shader defaultShader("Source/Shaders/DefaultShader.glsl");
 
-    // Passing the ModelViewProjection (MVP) to the shader (to the 'u_ModelViewProjectionMatrix' uniform variable)
+    // The view and projection matrices come from the 'FrameData' uniform block, only the model matrix is a per-shader uniform
+    defaultShader.BindUniformBlock("FrameData", FrameUniformData::BindingPoint);
     defaultShader.Bind();
-    defaultShader.SetUniformMat4f("u_ModelViewProjectionMatrix", modelViewProjectionMatrix);
+    defaultShader.SetUniformMat4f("u_ModelMatrix", modelMatrix);
     
     // Passing the texture to the shader
     Texture texture("Resources/Textures/Un-official/MoiPanPan.png");
@@ -282,9 +377,10 @@ int main(void)
     
     Shader chunkShader("Source/Shaders/ChunkShader.glsl");
     
-    // Passing the ModelViewProjection (MVP) to the shader (to the 'u_ModelViewProjectionMatrix' uniform variable)
+    // NOTE : The chunks are drawn relative to the camera, they use the 'CameraRelativeViewProjectionMatrix' of the 'FrameData' uniform block
+    chunkShader.BindUniformBlock("FrameData", FrameUniformData::BindingPoint);
     chunkShader.Bind();
-    chunkShader.SetUniformMat4f("u_ModelViewProjectionMatrix", modelViewProjectionMatrix);
+    chunkShader.SetUniformMat4f("u_ModelMatrix", modelMatrix);
 
     std::vector<std::string> texturePaths = {
         "Resources/Textures/Environment/Normals/CloudLight.png",
@@ -305,6 +401,13 @@ int main(void)
     chunkShader.Bind();
     chunkShader.SetUniform1i("u_Texture2DArray", textureSlot);
 
+    // - Far terrain shader - //
+
+    Shader farTerrainShader("Source/Shaders/FarTerrainShader.glsl");
+
+    // NOTE : Drawn relative to the camera too, its other uniforms are set by the FarTerrain
+    farTerrainShader.BindUniformBlock("FrameData", FrameUniformData::BindingPoint);
+
     #pragma region TEST : To make the defaultShader use Texture2DArray
 
     // INSTRUCTIONS : To make that code below work you will need to change some code in the DefaultShader.glsl
@@ -346,33 +449,101 @@ int main(void)
     
     // - Chunk creation - //
 
+    // NOTE : The benchmark always uses the same seed, otherwise two runs could not be compared
     ChunkManager chunkManager(
-        IS_WORLD_SEED_RANDOMIZED, WORLD_SEED,
-        NOISE_FREQUENCY, { 32, 64, 32 }, CHUNK_BLOCK_SIZE, { 5, 5 }, &chunkShader
+        IS_WORLD_SEED_RANDOMIZED && !isBenchmarkMode, isBenchmarkMode ? renderBenchmark.GetSettings().WorldSeed : WORLD_SEED,
+        NOISE_FREQUENCY, { 32, 64, 32 }, CHUNK_BLOCK_SIZE, { 5, 5 }, &chunkShader, false
+    );
+
+    // NOTE : The benchmark never loads a saved world, its seed and its blocks could be different
+    chunkManager.IsPersistenceEnabled = !isBenchmarkMode;
+    chunkManager.Init();
+
+    if (isBenchmarkMode)
+    {
+        chunkManager.IsSortingFrontToBack = renderBenchmark.GetSettings().IsSortingChunks;
+        chunkManager.IsOcclusionCullingEnabled = renderBenchmark.GetSettings().IsOcclusionCulling;
+        chunkManager.IsLevelOfDetailEnabled = renderBenchmark.GetSettings().IsLevelOfDetailEnabled;
+    }
+
+    // - Far terrain creation - //
+
+    // The terrain beyond the chunks, sampled from the same noise (only a heightmap, no voxels)
+    FarTerrain farTerrain(chunkManager.GetWorldGenerator(), &farTerrainShader, chunkManager.ChunkSize.Y,
+        FAR_TERRAIN_LEVEL_COUNT, FAR_TERRAIN_GRID_SIZE, FAR_TERRAIN_BASE_SPACING);
+
+    farTerrain.SetStrataColors(texture2DArray.GetLayerAverageColors());
+    farTerrain.SetVoxelArea(
+        glm::dvec2(static_cast<double>(-chunkManager.ChunkCount.X * chunkManager.ChunkSize.X), static_cast<double>(-chunkManager.ChunkCount.Y * chunkManager.ChunkSize.Z)),
+        glm::dvec2(static_cast<double>(chunkManager.ChunkCount.X * chunkManager.ChunkSize.X), static_cast<double>(chunkManager.ChunkCount.Y * chunkManager.ChunkSize.Z))
     );
+
+    if (isBenchmarkMode)
+        farTerrain.IsEnabled = renderBenchmark.GetSettings().IsFarTerrainEnabled;
+
+    // Measures the fragments shaded by the scene (to see what the front to back order saves)
+    OverdrawCounter overdrawCounter;
+
+    // Measures the time the GPU spends on each frame
+    GpuTimer gpuTimer;
+
+    // The bars of the frame intervals histogram (see the "Frame pacing" panel)
+    std::vector<float> frameIntervalBucketCounts;
+
+    // The chunk meshes requested and uploaded during each frame, for the benchmark
+    unsigned long long lastRequestedMeshCount = chunkManager.GetRequestedMeshCount();
+    unsigned long long lastUploadedMeshCount = chunkManager.GetUploadedMeshCount();
+
+    CameraRecording cameraRecording;
+    cameraRecording.WorldSeed = chunkManager.WorldSeed;
+
+    const double cameraRecordingStartTime = glfwGetTime();
     
     // -- Game loop -- //
     
     // Loop until the user closes the window
-    while (!glfwWindowShouldClose(window))
+    while (!glfwWindowShouldClose(window) && !(isBenchmarkMode && renderBenchmark.IsFinished()))
     {
+        // Waits for the frame limiter (nothing to wait in the other modes)
+        framePacer.BeginFrame();
+
         startTime = glfwGetTime();
 
+        // Poll for and process events
+        // NOTE : Right after the wait of the limiter, so the frame is built from the freshest inputs possible
+        glfwPollEvents();
+
+        Renderer::ResetStatistics();
+
         // - Inputs - //
 
-        InputsDetector::ProcessInputs();
+        // In benchmark mode the camera follows a fixed path instead of the player inputs
+        if (isBenchmarkMode)
+            renderBenchmark.ApplyCameraPath(camera);
+        else
+            InputsDetector::ProcessInputs();
+
+        if (isRecordingCamera)
+            cameraRecording.AddFrame(startTime - cameraRecordingStartTime, camera);
 
         // - Camera - //
 
-        camera.DeltaTime = static_cast<float>(deltaTime);
+        // NOTE : The benchmark advances by a fixed time step, so the frames do not depend on the speed of the build
+        camera.DeltaTime = static_cast<float>(isBenchmarkMode ? renderBenchmark.GetSettings().FixedTimeStep : framePacer.GetDeltaTime());
         
         // - Rendering - //
 
+        if (isBenchmarkMode)
+            benchmarkFrameBufferObject->Bind();
+
+        gpuTimer.Begin();
+
         // Framebuffer cleaning
         Renderer::Clear();
 
         // ImGui setup
-        ImGui_ImplGlfwGL3_NewFrame();
+        if (!isBenchmarkMode)
+            ImGui_ImplGlfwGL3_NewFrame();
 
         // Changing TestingQuad color
         geometryVertexData[0].Color = Vector4(testingQuadColor.x, testingQuadColor.y, testingQuadColor.z, testingQuadColor.w);
@@ -384,29 +555,54 @@ int main(void)
         
         #pragma region - Updating the MVP matrix -
 
-        // Changing the position of the drawn object
-        modelMatrix = glm::translate(glm::mat4(1), objectsPositionOffset);
         viewMatrix = camera.GetViewMatrix();
 
-        modelViewProjectionMatrix = projectionMatrix * viewMatrix * modelMatrix;
-        
-        defaultShader.Bind();
-        defaultShader.SetUniformMat4f("u_ModelViewProjectionMatrix", modelViewProjectionMatrix);
+        frameUniformData.ViewMatrix = viewMatrix;
+        frameUniformData.ProjectionMatrix = projectionMatrix;
+        frameUniformData.ViewProjectionMatrix = projectionMatrix * viewMatrix;
+        frameUniformData.CameraRelativeViewProjectionMatrix = projectionMatrix * camera.GetRotationViewMatrix();
+        frameUniformData.CameraPosition = glm::vec4(glm::vec3(camera.GetPosition()), 1.0f);
+        frameUniformData.Time = isBenchmarkMode ?
+            glm::vec4(static_cast<float>(renderBenchmark.GetPathTime()), renderBenchmark.GetSettings().FixedTimeStep, 0.0f, 0.0f) :
+            glm::vec4(static_cast<float>(glfwGetTime()), static_cast<float>(framePacer.GetDeltaTime()), 0.0f, 0.0f);
 
-        chunkShader.Bind();
-        chunkShader.SetUniformMat4f("u_ModelViewProjectionMatrix", modelViewProjectionMatrix);
+        // One upload for all the shaders (instead of one glUniform call per shader)
+        frameUniformBufferObject.SetData(&frameUniformData, sizeof(FrameUniformData));
 
         #pragma endregion
 
         // - Drawing objects - //
 
-        Renderer::Draw(vertexArrayObject, indexBufferObject, defaultShader);
-        Renderer::Draw(vertexArrayObject2, indexBufferObject, defaultShader); // Second rectangle
+        RenderQueueItem testingQuadItem;
+        testingQuadItem.VertexArray = &vertexArrayObject;
+        testingQuadItem.IndexBuffer = &indexBufferObject;
+        testingQuadItem.RenderingShader = &defaultShader;
+        testingQuadItem.TextureID = texture.GetInGpuId();
+        testingQuadItem.TextureTarget = GL_TEXTURE_2D;
+        
+        Renderer::Submit(testingQuadItem);
 
-        chunkManager.DrawChunks();
+        testingQuadItem.VertexArray = &vertexArrayObject2; // Second rectangle
+        Renderer::Submit(testingQuadItem);
+
+        // Applying the meshes finished by the worker threads
+        chunkManager.Update();
+
+        chunkManager.DrawChunks(camera.GetPosition(), frameUniformData.CameraRelativeViewProjectionMatrix);
+
+        // Only the far terrain rings that moved are re-sampled and uploaded
+        farTerrain.Update(camera.GetPosition());
+        farTerrain.Submit(camera.GetPosition());
+
+        // Sorting the queued draws (by shader, texture, depth) and drawing them, without the redundant binds
+        overdrawCounter.Begin();
+        Renderer::FlushQueue();
+        overdrawCounter.End();
 
         #pragma region - ImGui -
 
+        // NOTE : The debug UI is not drawn in benchmark mode, we only want to measure the game rendering
+        if (!isBenchmarkMode)
         {
             ImGui::Begin("Debug UI");
             
@@ -448,6 +644,178 @@ int main(void)
             if (ImGui::CollapsingHeader("Debug information :"))
             {
                 ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+
+                if (gpuTimer.IsSupported())
+                    ImGui::Text("GPU : %.3f ms/frame", gpuTimer.GetLastMilliseconds());
+                else
+                    ImGui::Text("GPU : unknown (no timer queries)");
+
+                if (isRecordingCamera)
+                    ImGui::Text("Camera recording : %zu frames (%.1f s), written inside '%s' on exit",
+                        cameraRecording.GetFrameCount(), cameraRecording.GetDuration(), cameraRecordingFilePath.c_str());
+                ImGui::Spacing();
+
+                const ChunkMemoryPool::Statistics memoryPoolStatistics = ChunkMemoryPool::GetStatistics();
+
+                ImGui::Text("Chunk memory pool :");
+                ImGui::Text("Slabs : %zu used / %zu reserved (%zu bytes each)",
+                    memoryPoolStatistics.UsedSlabCount, memoryPoolStatistics.ReservedSlabCount, memoryPoolStatistics.SlabByteSize);
+                ImGui::Text("Reserved memory : %.2f MB%s", memoryPoolStatistics.ReservedByteSize / (1024.0 * 1024.0),
+                    memoryPoolStatistics.AreHugePagesRequested ? " (huge pages requested)" : "");
+                ImGui::Text("Allocations : %llu (%llu from the thread caches, %llu oversized)",
+                    memoryPoolStatistics.AllocationCount, memoryPoolStatistics.ThreadCacheHitCount, memoryPoolStatistics.OversizedAllocationCount);
+                ImGui::Spacing();
+
+                ImGui::Text("Mesh jobs :");
+                ImGui::Text("Pending : %d, discarded (outdated) : %llu", chunkManager.GetPendingMeshJobCount(), chunkManager.GetDiscardedMeshCount());
+                ImGui::Text("Voxel data copied on write : %llu", ChunkVoxelData::GetForkCount());
+                ImGui::Spacing();
+
+                ImGui::Text("Renderer :");
+                ImGui::Text("Draw calls : %u, triangles : %llu (%llu culled by face direction)",
+                    Renderer::GetDrawCallCount(), Renderer::GetTriangleCount(), Renderer::GetCulledTriangleCount());
+                ImGui::Checkbox("Face direction culling", &ChunkRenderObject::IsFaceDirectionCullingEnabled);
+                ImGui::Text("Binds : %u issued / %u requested (%u redundant skipped)",
+                    Renderer::GetIssuedBindCount(), Renderer::GetRequestedBindCount(), Renderer::GetSkippedBindCount());
+
+                int frameBufferWidth = 0;
+                int frameBufferHeight = 0;
+                glfwGetFramebufferSize(window, &frameBufferWidth, &frameBufferHeight);
+                
+                ImGui::Text("Samples passed : %llu (overdraw : %.2f)",
+                    overdrawCounter.GetSamplesPassedCount(), overdrawCounter.GetOverdraw(frameBufferWidth * frameBufferHeight));
+                ImGui::Checkbox("Front to back chunk sorting", &chunkManager.IsSortingFrontToBack);
+                ImGui::Text("Chunks moved by the last sort : %d", chunkManager.GetLastSortMoveCount());
+                ImGui::Spacing();
+
+                OcclusionCuller* occlusionCuller = chunkManager.GetOcclusionCuller();
+
+                ImGui::Text("Cave culling :");
+                ImGui::Checkbox("Cave culling", &chunkManager.IsCaveCullingEnabled);
+                ImGui::Text("Potentially visible chunks : %d (%d section faces walked)",
+                    chunkManager.GetPotentiallyVisibleChunkCount(), chunkManager.GetVisitedSectionCount());
+                ImGui::Spacing();
+
+                ImGui::Text("Occlusion culling :");
+                ImGui::Checkbox("Occlusion culling", &chunkManager.IsOcclusionCullingEnabled);
+                ImGui::Text("Chunks occluded : %u, outside the screen : %u (%u tested)",
+                    occlusionCuller->GetOccludedCount(), occlusionCuller->GetOutsideFrustumCount(), occlusionCuller->GetTestedCount());
+                ImGui::Text("Occluders : %u (%u triangles), rasterized in %.3f ms",
+                    occlusionCuller->GetOccluderCount(), occlusionCuller->GetOccluderTriangleCount(), occlusionCuller->GetRasterizationMilliseconds());
+
+                int occlusionBufferWidth = occlusionCuller->GetWidth();
+                if (ImGui::SliderInt("Depth buffer width", &occlusionBufferWidth, 64, 1024))
+                    occlusionCuller->SetResolution(occlusionBufferWidth, occlusionBufferWidth / 2);
+                ImGui::Spacing();
+
+                ImGui::Text("Levels of detail :");
+                ImGui::Checkbox("Downsampled far chunks", &chunkManager.IsLevelOfDetailEnabled);
+                ImGui::Text("Chunks drawn : %d full resolution, %d 2x downsampled, %d 4x downsampled",
+                    chunkManager.GetLevelOfDetailChunkCount(0), chunkManager.GetLevelOfDetailChunkCount(1), chunkManager.GetLevelOfDetailChunkCount(2));
+                ImGui::Text("Level changes (re-meshed chunks) : %llu", chunkManager.GetLevelOfDetailChangeCount());
+                ImGui::Spacing();
+
+                ImGui::Text("Persistence :");
+
+                const ChunkStorage* chunkStorage = chunkManager.GetChunkStorage();
+
+                if (chunkStorage != nullptr)
+                {
+                    const ChunkEditJournal* editJournal = chunkStorage->GetEditJournal();
+
+                    ImGui::Text("Mode : %s", editJournal != nullptr ? "edit journal" : "snapshots");
+                    ImGui::Text("Startup : %d chunks loaded, %d generated in %.1f ms",
+                        chunkManager.GetLoadedChunkCount(), chunkManager.GetGeneratedChunkCount(), chunkManager.GetInitializationMilliseconds());
+                    ImGui::Text("Saved : %llu chunks (compressed to %.1f %%), %llu damaged, %d requests pending",
+                        chunkStorage->GetSavedChunkCount(), chunkStorage->GetCompressionRatio() * 100.0f,
+                        chunkStorage->GetCorruptedChunkCount(), chunkStorage->GetPendingRequestCount());
+
+                    if (editJournal != nullptr)
+                    {
+                        ImGui::Text("Edit journal : %zu edits (%.2f KB on the disk), %d replayed at startup, %llu saved",
+                            editJournal->GetEditCount(), editJournal->GetFileByteSize() / 1024.0,
+                            chunkManager.GetReplayedEditCount(), chunkStorage->GetSavedEditCount());
+                    }
+
+                    ImGui::Checkbox("Autosave", &chunkManager.IsAutosaveEnabled);
+                    ImGui::DragFloat("Autosave interval (s)", &chunkManager.AutosaveIntervalSeconds, 1.0f, 1.0f, 600.0f, "%.0f");
+                    ImGui::Text("Saves : %d autosaves, last committed save #%u (%llu failed)",
+                        chunkManager.GetAutosaveCount(), chunkStorage->GetCommittedSaveNumber(), chunkStorage->GetFailedCommitCount());
+                    ImGui::Text("Save cost : %.3f ms on the main thread (%.3f ms maximum), %.1f ms in the background",
+                        chunkManager.GetLastSaveMilliseconds(), chunkManager.GetMaximumSaveMilliseconds(), chunkStorage->GetLastCommitMilliseconds());
+
+                    ChunkMeshCache* meshCache = chunkManager.GetMeshCache();
+
+                    if (meshCache != nullptr)
+                    {
+                        const unsigned long long meshRequestCount = meshCache->GetHitCount() + meshCache->GetMissCount();
+
+                        ImGui::Text("Mesh cache : %llu hits, %llu misses (%.1f %% hits), %llu damaged, %zu meshes (%.2f MB on the disk)",
+                            meshCache->GetHitCount(), meshCache->GetMissCount(),
+                            meshRequestCount > 0 ? meshCache->GetHitCount() * 100.0 / meshRequestCount : 0.0,
+                            meshCache->GetDamagedCount(), meshCache->GetEntryCount(), meshCache->GetFileByteSize() / (1024.0 * 1024.0));
+                    }
+                    else
+                        ImGui::Text("Mesh cache : disabled");
+
+                    if (ImGui::Button("Save modified chunks"))
+                        chunkManager.SaveModifiedChunks();
+                }
+                else
+                    ImGui::Text("Disabled");
+
+                ImGui::Spacing();
+
+                ImGui::Text("Far terrain :");
+                ImGui::Checkbox("Far terrain", &farTerrain.IsEnabled);
+                ImGui::Text("View distance : %.0f blocks (%d rings, %d drawn)",
+                    farTerrain.GetViewDistance(), farTerrain.GetLevelCount(), farTerrain.GetDrawnLevelCount());
+                ImGui::Text("Last update : %d heights sampled, %d rings uploaded in %.3f ms",
+                    farTerrain.GetLastSampledHeightCount(), farTerrain.GetLastUpdatedLevelCount(), farTerrain.GetLastUpdateMilliseconds());
+                ImGui::Text("Memory : %.2f KB (CPU), %.2f KB (GPU)",
+                    farTerrain.GetMemoryUsage() / 1024.0, farTerrain.GetGpuMemoryUsage() / 1024.0);
+            }
+
+            if (ImGui::CollapsingHeader("Frame pacing :"))
+            {
+                int framePacingMode = static_cast<int>(framePacer.GetMode());
+                if (ImGui::Combo("Mode", &framePacingMode, "VSync\0Frame limiter\0Uncapped\0\0"))
+                    framePacer.SetMode(static_cast<FramePacer::FramePacingModes>(framePacingMode));
+
+                if (framePacer.GetMode() == FramePacer::FramePacingModes::FrameLimiter)
+                {
+                    int targetFramesPerSecond = framePacer.GetTargetFramesPerSecond();
+                    if (ImGui::SliderInt("Target FPS", &targetFramesPerSecond, FRAME_PACING_MINIMUM_TARGET_FRAMES_PER_SECOND, FRAME_PACING_MAXIMUM_TARGET_FRAMES_PER_SECOND))
+                        framePacer.SetTargetFramesPerSecond(targetFramesPerSecond);
+
+                    ImGui::Text("Limiter wait : %.3f ms (average %.3f ms), sleeps take up to %.3f ms",
+                        framePacer.GetLastWaitMilliseconds(), framePacer.GetAverageWaitMilliseconds(), framePacer.GetSleepEstimateMilliseconds());
+                }
+
+                const FrameTimeHistogram& frameIntervalHistogram = framePacer.GetFrameIntervalHistogram();
+                const FrameTimeHistogram& frameWorkHistogram = framePacer.GetFrameWorkHistogram();
+
+                ImGui::Text("Frame interval : %.3f ms (average %.3f ms, median %.2f ms, 99%% %.2f ms, 99.9%% %.2f ms, max %.2f ms)",
+                    framePacer.GetDeltaTime() * 1000.0, frameIntervalHistogram.GetAverage(), frameIntervalHistogram.GetPercentile(0.50),
+                    frameIntervalHistogram.GetPercentile(0.99), frameIntervalHistogram.GetPercentile(0.999), frameIntervalHistogram.GetMaximum());
+                ImGui::Text("Work : %.3f ms (average %.3f ms, 99%% %.2f ms), present : %.3f ms (average %.3f ms)",
+                    framePacer.GetLastWorkMilliseconds(), frameWorkHistogram.GetAverage(), frameWorkHistogram.GetPercentile(0.99),
+                    framePacer.GetLastPresentMilliseconds(), framePacer.GetAveragePresentMilliseconds());
+
+                // NOTE : Up to twice the 99th percentile, so the spikes can be seen without squeezing the usual frames into a few bars
+                frameIntervalHistogram.GetBucketCounts(glm::max(frameIntervalHistogram.GetPercentile(0.99) * 2.0, 1.0), frameIntervalBucketCounts);
+
+                ImGui::PlotHistogram("Frame intervals", frameIntervalBucketCounts.data(), static_cast<int>(frameIntervalBucketCounts.size()), 0,
+                    "0 ms to 2x the 99th percentile", 0.0f, FLT_MAX, ImVec2(0.0f, 80.0f));
+                ImGui::Text("%llu frames, %.2f ms per bar", frameIntervalHistogram.GetSampleCount(), frameIntervalHistogram.GetBucketMilliseconds());
+
+                if (ImGui::Button("Reset"))
+                    framePacer.ResetStatistics();
+
+                ImGui::SameLine();
+
+                if (ImGui::Button("Export histograms"))
+                    framePacer.ExportHistograms(FRAME_PACING_HISTOGRAM_FILE_PATH);
             }
 
             if (ImGui::CollapsingHeader("Object modifications :"))
@@ -479,8 +847,18 @@ int main(void)
                     ImGui::Indent();
                     
                     ImGui::Text("Objects position offset :");
-                    ImGui::DragFloat3("Position offset", &objectsPositionOffset.x);
                     // &objectsPositionOffset.x = the address of the table
+                    if (ImGui::DragFloat3("Position offset", &objectsPositionOffset.x))
+                    {
+                        // The model matrix is only uploaded when it changes
+                        modelMatrix = glm::translate(glm::mat4(1), objectsPositionOffset);
+                        
+                        defaultShader.Bind();
+                        defaultShader.SetUniformMat4f("u_ModelMatrix", modelMatrix);
+                        
+                        chunkShader.Bind();
+                        chunkShader.SetUniformMat4f("u_ModelMatrix", modelMatrix);
+                    }
 
                     ImGui::Spacing();
                     ImGui::Text("First testing quad color :");
@@ -493,22 +871,63 @@ int main(void)
             }
 
             ImGui::End();
-        }
 
-        ImGui::Render();
-        ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
+            ImGui::Render();
+            ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
+        }
         
         #pragma endregion 
 
-        // Swap front and back buffers
-        glfwSwapBuffers(window);
+        gpuTimer.End();
 
-        // Poll for and process events
-        glfwPollEvents();
+        // The CPU time of the frame, before waiting for the GPU
+        const double cpuMilliseconds = (glfwGetTime() - startTime) * 1000.0;
 
+        // Waiting for the GPU to finish the frame, otherwise we would only measure the time took to send the commands
+        if (isBenchmarkMode)
+            glFinish();
+
+        // Swap front and back buffers
+        framePacer.BeginPresent();
+        glfwSwapBuffers(window);
+        framePacer.EndFrame();
 
         double endTime = glfwGetTime();
         deltaTime = endTime - startTime;
+
+        // NOTE : In benchmark mode the GPU finished the frame (glFinish), its time is already known
+        gpuTimer.ReadResults();
+
+        const unsigned long long requestedMeshCount = chunkManager.GetRequestedMeshCount();
+        const unsigned long long uploadedMeshCount = chunkManager.GetUploadedMeshCount();
+
+        if (isBenchmarkMode)
+        {
+            renderBenchmark.RecordFrameDetails(cpuMilliseconds,
+                static_cast<unsigned int>(requestedMeshCount - lastRequestedMeshCount), static_cast<unsigned int>(uploadedMeshCount - lastUploadedMeshCount),
+                static_cast<unsigned int>(farTerrain.GetLastUpdatedLevelCount()), camera.GetPosition());
+        }
+
+        lastRequestedMeshCount = requestedMeshCount;
+        lastUploadedMeshCount = uploadedMeshCount;
+
+        if (isBenchmarkMode && overdrawCounter.HasResult())
+            renderBenchmark.RecordSamplesPassed(overdrawCounter.GetSamplesPassedCount());
+
+        if (isBenchmarkMode)
+        {
+            const OcclusionCuller* occlusionCuller = chunkManager.GetOcclusionCuller();
+            renderBenchmark.RecordOcclusionCulling(occlusionCuller->GetTestedCount(), occlusionCuller->GetOccludedCount(), occlusionCuller->GetRasterizationMilliseconds());
+        }
+        
+        if (isBenchmarkMode)
+        {
+            renderBenchmark.RecordFrame(deltaTime, Renderer::GetDrawCallCount(), Renderer::GetTriangleCount(),
+                Renderer::GetRequestedBindCount(), Renderer::GetIssuedBindCount());
+
+            if (gpuTimer.GetLastFrameNumber() >= 0)
+                renderBenchmark.RecordGpuTime(gpuTimer.GetLastFrameNumber(), gpuTimer.GetLastMilliseconds());
+        }
         
         if (IS_DEBUGGING_SECONDS_PAST_BETWEEN_FRAMES)
         {
@@ -517,6 +936,25 @@ int main(void)
         }
     }
 
+    if (isBenchmarkMode)
+    {
+        renderBenchmark.SaveReport(
+            reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+            reinterpret_cast<const char*>(glGetString(GL_VERSION)),
+            benchmarkFrameBufferObject->GetWidth(), benchmarkFrameBufferObject->GetHeight()
+        );
+
+        delete benchmarkFrameBufferObject;
+    }
+
+    if (isRecordingCamera && cameraRecording.SaveToFile(cameraRecordingFilePath))
+    {
+        PRINT_MESSAGE_RUNTIME(
+            "Camera recording written inside '" + cameraRecordingFilePath + "' (" + std::to_string(cameraRecording.GetFrameCount()) + " frames), play it with "
+            "--benchmark --camera-path " + cameraRecordingFilePath
+        )
+    }
+
     // -- Cleaning the program -- //
 
     ImGui_ImplGlfwGL3_Shutdown();
@@ -10,6 +10,6 @@ static constexpr bool IS_SHADER_LOADING_DEBUGGING_ON = false;
 // Texture.cpp constants
 static constexpr bool IS_TEXTURE_LOADING_DEBUGGING_ON = false;
 
-// GreedyChunk.cpp constants
+// ChunkRenderObject.cpp constants
 static constexpr bool IS_PRINTING_ALL_VERTICES_CREATED = false;
 static constexpr bool IS_PRINTING_ALL_VERTICES_INDICES_CREATED = false;
\ No newline at end of file
@@ -30,12 +30,140 @@ static constexpr int  WORLD_SEED			   = 1789;
 static constexpr float NOISE_FREQUENCY = 0.015f;
 static constexpr int CHUNK_BLOCK_SIZE  = 1;
 
+static constexpr const char* WORLD_SAVE_DIRECTORY_PATH = "Saves/World";
+// The region files of the saved world (relative to the working directory), a saved world overrides the seed above
+
+static constexpr int CHUNK_EDIT_JOURNAL_SNAPSHOT_EDIT_COUNT = 256;
+// Above this many edits, a chunk is saved as a snapshot instead of edits (6 bytes each, a compressed chunk takes about 1.7 KB)
+
+static constexpr float AUTOSAVE_INTERVAL_SECONDS = 30.0f;
+// The time between two saves of the modified chunks (see ChunkManager::Update())
+
+static constexpr size_t MESH_CACHE_MAXIMUM_BYTE_SIZE = 256 * 1024 * 1024;
+static constexpr double MESH_CACHE_EMPTYING_FILL_RATIO = 0.9;
+// The cached chunk meshes (see ChunkMeshCache) are not written past the maximum size, the file also keeps the old meshes of the edited chunks :
+// a file filled above 90% of it is emptied at launch, otherwise a full cache would never store a new mesh again
+
+// -- World server (launch the executable with the "--server" argument) -- //
+
+static constexpr unsigned short WORLD_SERVER_DEFAULT_PORT = 47800;
+// The loopback port the server listens on and the clients connect to (see WorldServer)
+
+static constexpr const char* WORLD_SERVER_SAVE_DIRECTORY_PATH = "Saves/ServerWorld";
+// Not the directory of the game : a game launched next to the server keeps its own world
+
+static constexpr int WORLD_SERVER_TICKS_PER_SECOND = 30;
+// The edits received during a tick are sent to the clients at its end
+
+static constexpr int WORLD_SERVER_MAXIMUM_INTEREST_RADIUS = 32;
+// In chunks, a bigger radius asked by a client is clamped to it
+
+static constexpr int WORLD_SERVER_MAXIMUM_PENDING_CHUNK_COUNT = 64;
+// The chunks generated or loaded at once, the next ones are requested when they are ready (the cameras may have moved in between)
+
+static constexpr size_t WORLD_SERVER_CLIENT_SEND_BUDGET_BYTE_SIZE = 512 * 1024;
+// No more chunks are queued for a client while this many bytes still wait for its socket, a slow client does not slow the others
+
+// -- Benchmark mode (launch the executable with the "--benchmark" argument) -- //
+
+static constexpr int BENCHMARK_DEFAULT_FRAME_COUNT = 1000;
+static constexpr int BENCHMARK_WARMUP_FRAME_COUNT  = 60;
+// Frames rendered before the measures begin (shaders compilation, driver caches, etc...)
+
+static constexpr int BENCHMARK_WORLD_SEED = 1789;
+// The benchmark never uses a random seed, otherwise two runs can't be compared
+
+static constexpr float BENCHMARK_CAMERA_PATH_RADIUS = 96.0f;
+static constexpr float BENCHMARK_CAMERA_PATH_HEIGHT = 80.0f;
+static constexpr float BENCHMARK_CAMERA_PATH_PITCH  = -25.0f;
+// The camera does one full circle around the world center during the measured frames
+
+static constexpr float BENCHMARK_FIXED_TIME_STEP = 1.0f / 60.0f;
+// A recorded camera path advances by this time each frame, whatever the real frame time, so every build renders the same frames
+
+static constexpr int BENCHMARK_PRINTED_HITCH_COUNT = 10;
+// The slowest frames printed at the end of the benchmark, the report lists all the frames as slow as the 99th percentile or slower
+
+static constexpr const char* BENCHMARK_DEFAULT_OUTPUT_FILE_PATH = "RenderBenchmark.json";
+
+// -=- FramePacer.cpp / FrameTimeHistogram.cpp constants -=- //
+
+static constexpr int FRAME_PACING_DEFAULT_MODE = 0;
+// The mode at launch (0 : vsync, 1 : frame limiter, 2 : uncapped), it can be changed in the "Frame pacing" panel. The benchmark is always uncapped
+
+static constexpr int FRAME_PACING_DEFAULT_TARGET_FRAMES_PER_SECOND = 144;
+static constexpr int FRAME_PACING_MINIMUM_TARGET_FRAMES_PER_SECOND = 10;
+static constexpr int FRAME_PACING_MAXIMUM_TARGET_FRAMES_PER_SECOND = 1000;
+
+static constexpr double FRAME_PACING_INITIAL_SLEEP_ESTIMATE_MILLISECONDS = 2.0;
+static constexpr unsigned long long FRAME_PACING_SLEEP_ESTIMATE_SAMPLE_COUNT = 1000;
+// The limiter only sleeps while the wait left is longer than a sleep of 1 ms usually takes (measured over the last sleeps), it spins the rest
+
+static constexpr double FRAME_TIME_HISTOGRAM_BUCKET_MILLISECONDS  = 0.05;
+static constexpr double FRAME_TIME_HISTOGRAM_MAXIMUM_MILLISECONDS = 100.0;
+// 2000 buckets of 50 microseconds, the frames slower than 100 ms are only counted (and kept as the maximum)
+
+static constexpr const char* FRAME_PACING_HISTOGRAM_FILE_PATH = "FrameTimeHistogram.json";
+
+// -=- ChunkMemoryPool.cpp constants -=- //
+
+static constexpr size_t CHUNK_MEMORY_POOL_REGION_BYTE_SIZE = 2 * 1024 * 1024;
+// The memory is asked to the system by regions of 2 MB (the size of a huge page), then cut into slabs
+
+// -=- OcclusionCuller.cpp / ChunkManager.cpp / GreedyChunk.cpp constants -=- //
+
+static constexpr int OCCLUSION_CULLING_DEFAULT_WIDTH  = 256;
+static constexpr int OCCLUSION_CULLING_DEFAULT_HEIGHT = 128;
+// The CPU depth buffer resolution, a lower one is faster but hides less
+
+static constexpr float OCCLUSION_CULLING_DEPTH_BIAS = 0.0001f;
+// Relative to the depth (1 / w), avoids a box being hidden by the occluders lying on its own surface
+
+static constexpr int OCCLUSION_CULLING_OCCLUDER_CHUNK_COUNT = 32;
+// Only the closest chunks are rasterized as occluders, the far ones are too small on the screen to hide anything
+
+static constexpr int OCCLUDER_BOX_COLUMN_COUNT = 8;
+// A chunk gives one occluder box per 8x8 columns, as high as the lowest of these columns
+
+// -=- ChunkVisibility.cpp constants -=- //
+
+static constexpr int CHUNK_VISIBILITY_SECTION_HEIGHT = 16;
+// The cave culling splits the chunks vertically into sections of 16 blocks, each one has its own faces connectivity
+
+// -=- ChunkManager.cpp (levels of detail) constants -=- //
+
+static constexpr int CHUNK_LEVEL_OF_DETAIL_COUNT = 3;
+// The full resolution meshes, then the 2x and the 4x downsampled ones (only the levels dividing the chunk size are used)
+
+static constexpr float CHUNK_LEVEL_OF_DETAIL_DISTANCES[CHUNK_LEVEL_OF_DETAIL_COUNT - 1] = { 96.0f, 160.0f };
+// The distance (from the camera to the chunk) from which the chunks use the next level of detail
+
+static constexpr float CHUNK_LEVEL_OF_DETAIL_HYSTERESIS = 16.0f;
+// A chunk changes its level only once it's that far past a threshold, so walking along a threshold does not re-mesh it every frame
+
+// -=- FarTerrain.cpp constants -=- //
+
+static constexpr int FAR_TERRAIN_LEVEL_COUNT = 6;
+// The number of clipmap rings, each one is twice as large (and twice as coarse) as the previous one
+
+static constexpr int FAR_TERRAIN_GRID_SIZE = 64;
+// The number of quads along one side of a ring (must be a multiple of 4, the inner ring fills the middle half)
+
+static constexpr int FAR_TERRAIN_BASE_SPACING = 2;
+// The distance (in blocks) between two vertices of the finest ring
+
+static constexpr float FAR_TERRAIN_FOG_START = 0.6f;
+// The far terrain fades into the BACKGROUND_COLOR from 60% of its view distance, so the end of the last ring can't be seen
+
 // -=- Render.cpp constants -=- //
 
 static constexpr glm::vec4 BACKGROUND_COLOR = { 0.3f, 0.3f, 0.3f, 1.0f };
 
-// -=- GreedyChunk.cpp constants -=- //
+// -=- GreedyMesher.cpp constants -=- //
 
 static constexpr glm::vec4 CHUNK_BLOCK_TOP_TEXTURE_COLOR	= { 1.00f, 1.00f, 1.00f, 1.00f };
 static constexpr glm::vec4 CHUNK_BLOCK_SIDE_TEXTURE_COLOR	= { 0.85f, 0.85f, 0.85f, 1.00f };
-static constexpr glm::vec4 CHUNK_BLOCK_BOTTOM_TEXTURE_COLOR = { 0.70f, 0.70f, 0.70f, 1.00f };
\ No newline at end of file
+static constexpr glm::vec4 CHUNK_BLOCK_BOTTOM_TEXTURE_COLOR = { 0.70f, 0.70f, 0.70f, 1.00f };
+
+static constexpr unsigned int MESH_CACHE_MESHER_VERSION = 1;
+// Increment it every time the meshes change (the mesher, the colors above, the Vertex layout...), the cached meshes are created again then
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "JsonWriter/JsonWriter.h"
+
+/// <summary> Summary of a list of samples (frame times, job durations, etc...), all values share the samples unit. </summary>
+struct BenchmarkStatistics
+{
+    size_t SampleCount = 0;
+
+    double Average = 0.0;
+    double Minimum = 0.0;
+    double Maximum = 0.0;
+
+    double Median = 0.0;
+    double Percentile95 = 0.0;
+    double Percentile99 = 0.0;
+
+    static BenchmarkStatistics Compute(std::vector<double> p_samples)
+    {
+        BenchmarkStatistics statistics;
+        statistics.SampleCount = p_samples.size();
+
+        if (p_samples.empty())
+            return statistics;
+
+        std::sort(p_samples.begin(), p_samples.end());
+
+        double sum = 0.0;
+
+        for (const double sample : p_samples)
+            sum += sample;
+
+        statistics.Average = sum / static_cast<double>(p_samples.size());
+        statistics.Minimum = p_samples.front();
+        statistics.Maximum = p_samples.back();
+
+        statistics.Median = GetPercentile(p_samples, 0.50);
+        statistics.Percentile95 = GetPercentile(p_samples, 0.95);
+        statistics.Percentile99 = GetPercentile(p_samples, 0.99);
+
+        return statistics;
+    }
+
+    /// <summary> Writes the statistics as a JSON object named 'p_key'. </summary>
+    void WriteToJson(JsonWriter& p_jsonWriter, const std::string& p_key) const
+    {
+        p_jsonWriter.BeginObject(p_key);
+        p_jsonWriter.Write("sampleCount", static_cast<unsigned long long>(SampleCount));
+        p_jsonWriter.Write("average", Average);
+        p_jsonWriter.Write("minimum", Minimum);
+        p_jsonWriter.Write("maximum", Maximum);
+        p_jsonWriter.Write("median", Median);
+        p_jsonWriter.Write("percentile95", Percentile95);
+        p_jsonWriter.Write("percentile99", Percentile99);
+        p_jsonWriter.EndObject();
+    }
+
+private:
+
+    /// <summary> Nearest-rank percentile (the smallest sample with at least p% of the samples below or equal to it), the given samples must be sorted. </summary>
+    static double GetPercentile(const std::vector<double>& p_sortedSamples, const double p_percentile)
+    {
+        // NOTE : The rank is ceil(p * n), from 1 to n, so with 100 samples the 99th percentile is the 99th sample and not the maximum
+        const double rank = std::ceil(p_percentile * static_cast<double>(p_sortedSamples.size()));
+        const size_t index = static_cast<size_t>(std::min(std::max(rank, 1.0), static_cast<double>(p_sortedSamples.size()))) - 1;
+
+        return p_sortedSamples[index];
+    }
+};
@@ -0,0 +1,147 @@
+#include "CameraRecording.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "Camera.h"
+#include "MessageDebugger/MessageDebugger.h"
+
+void CameraRecording::AddFrame(const double p_time, const Camera& p_camera)
+{
+    // NOTE : ApplyPose() searches the frames by time, they must stay sorted
+    if (!_frames.empty() && p_time < _frames.back().Time)
+        return;
+
+    Frame frame;
+    frame.Time = p_time;
+    frame.Position = p_camera.GetPosition();
+    frame.Yaw = p_camera.GetYaw();
+    frame.Pitch = p_camera.GetPitch();
+
+    _frames.push_back(frame);
+}
+
+void CameraRecording::ApplyPose(const double p_time, Camera& p_camera) const
+{
+    if (_frames.empty())
+        return;
+
+    // The first frame shown after the given time
+    const std::vector<Frame>::const_iterator nextFrame = std::upper_bound(_frames.begin(), _frames.end(), p_time,
+        [](const double p_searchedTime, const Frame& p_frame) { return p_searchedTime < p_frame.Time; });
+
+    if (nextFrame == _frames.begin() || nextFrame == _frames.end())
+    {
+        const Frame& frame = nextFrame == _frames.begin() ? _frames.front() : _frames.back();
+
+        p_camera.SetPosition(frame.Position);
+        p_camera.SetRotation(frame.Yaw, frame.Pitch);
+        return;
+    }
+
+    const Frame& previousFrame = *(nextFrame - 1);
+    const double frameDuration = nextFrame->Time - previousFrame.Time;
+    const double progress = frameDuration > 0.0 ? (p_time - previousFrame.Time) / frameDuration : 1.0;
+
+    // NOTE : The yaw is not wrapped by the mouse movements (it can go past 360), so a linear interpolation never takes the long way
+    p_camera.SetPosition(previousFrame.Position + (nextFrame->Position - previousFrame.Position) * progress);
+    p_camera.SetRotation(
+        previousFrame.Yaw + (nextFrame->Yaw - previousFrame.Yaw) * static_cast<float>(progress),
+        previousFrame.Pitch + (nextFrame->Pitch - previousFrame.Pitch) * static_cast<float>(progress)
+    );
+}
+
+bool CameraRecording::SaveToFile(const std::string& p_filePath) const
+{
+    std::ofstream stream(p_filePath, std::ios::trunc);
+
+    if (!stream.is_open())
+    {
+        PRINT_ERROR_RUNTIME(true, "The camera recording could not be written inside '" + p_filePath + "'")
+        return false;
+    }
+
+    // NOTE : Enough digits to read back the same positions, far from the world origin too
+    stream.precision(17);
+    stream << "version " << FILE_VERSION << "\n";
+    stream << "seed " << WorldSeed << "\n";
+
+    for (const Frame& frame : _frames)
+    {
+        stream << "frame " << frame.Time << " " << frame.Position.x << " " << frame.Position.y << " " << frame.Position.z << " "
+            << frame.Yaw << " " << frame.Pitch << "\n";
+    }
+
+    return static_cast<bool>(stream);
+}
+
+bool CameraRecording::LoadFromFile(const std::string& p_filePath)
+{
+    std::ifstream stream(p_filePath);
+
+    if (!stream.is_open())
+    {
+        PRINT_ERROR_RUNTIME(true, "The camera recording '" + p_filePath + "' could not be opened")
+        return false;
+    }
+
+    std::vector<Frame> frames;
+    int version = 0;
+    int worldSeed = 0;
+    bool hasWorldSeed = false;
+
+    // One "name values" pair per line
+    std::string line;
+    int lineNumber = 0;
+
+    while (getline(stream, line))
+    {
+        lineNumber++;
+
+        std::stringstream lineStream(line);
+        std::string name;
+
+        // NOTE : The empty lines are skipped
+        if (!(lineStream >> name))
+            continue;
+
+        bool isLineValid = true;
+
+        if (name == "version")
+            isLineValid = static_cast<bool>(lineStream >> version);
+
+        else if (name == "seed")
+            isLineValid = hasWorldSeed = static_cast<bool>(lineStream >> worldSeed);
+
+        else if (name == "frame")
+        {
+            Frame frame;
+            isLineValid = static_cast<bool>(lineStream >> frame.Time >> frame.Position.x >> frame.Position.y >> frame.Position.z >> frame.Yaw >> frame.Pitch);
+
+            // The playback searches the frames by time
+            if (isLineValid && !frames.empty() && frame.Time < frames.back().Time)
+                isLineValid = false;
+
+            if (isLineValid)
+                frames.push_back(frame);
+        }
+
+        if (!isLineValid)
+        {
+            PRINT_ERROR_RUNTIME(true, "The camera recording '" + p_filePath + "' is damaged at the line " + std::to_string(lineNumber))
+            return false;
+        }
+    }
+
+    if (version != FILE_VERSION || !hasWorldSeed || frames.empty())
+    {
+        PRINT_ERROR_RUNTIME(true, "The camera recording '" + p_filePath + "' has an unknown version, no seed or no frames")
+        return false;
+    }
+
+    WorldSeed = worldSeed;
+    _frames.swap(frames);
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "GLM/glm.hpp"
+
+class Camera;
+
+/// <summary>
+/// A camera flythrough : the camera pose of each frame of a played session, with the time it was shown at.
+///
+/// <para> Recorded by the game with <c> --record-camera filePath </c>, played back by the benchmark with <c> --camera-path filePath </c>
+/// (see RenderBenchmark). The poses are sampled at a fixed time step during the playback, so a slow build and a fast one
+/// render the same camera positions at the same frames. </para>
+///
+/// <para> Only the poses are kept, not the keys and the mouse movements : the inputs replayed with another time step
+/// would move the camera elsewhere. </para>
+///
+/// <para> The file is a text file with one "name values" pair per line, it can be read and edited by hand :
+/// <c> version 1 </c>, <c> seed 1789 </c>, then one <c> frame time x y z yaw pitch </c> line per frame. </para> </summary>
+class CameraRecording
+{
+
+public:
+
+    struct Frame
+    {
+        /// <summary> In seconds, since the beginning of the recording. </summary>
+        double Time = 0.0;
+
+        glm::dvec3 Position = glm::dvec3(0.0);
+
+        /// <summary> In degrees, see Camera::SetRotation(). </summary>
+        float Yaw = 0.0f;
+        float Pitch = 0.0f;
+    };
+
+    static const int FILE_VERSION = 1;
+
+    /// <summary> The seed of the recorded world : the flythrough only makes sense over the same terrain. </summary>
+    int WorldSeed = 0;
+
+private:
+
+    // NOTE : Sorted by time, AddFrame() ignores the frames older than the last one
+    std::vector<Frame> _frames;
+
+public:
+
+    /// <summary> Adds the current pose of the camera. </summary>
+    void AddFrame(double p_time, const Camera& p_camera);
+
+    /// <summary> Places the camera at the given time, between the two closest frames (clamped to the first and the last ones). </summary>
+    void ApplyPose(double p_time, Camera& p_camera) const;
+
+    /// <summary> The time of the last frame (0 if empty). </summary>
+    double GetDuration() const { return _frames.empty() ? 0.0 : _frames.back().Time; }
+
+    size_t GetFrameCount() const { return _frames.size(); }
+    bool IsEmpty() const { return _frames.empty(); }
+
+    /// <summary> Returns false if the file can't be written. </summary>
+    bool SaveToFile(const std::string& p_filePath) const;
+
+    /// <summary> Replaces the frames by the ones of the file. Returns false (and prints why) if the file can't be read or is damaged. </summary>
+    bool LoadFromFile(const std::string& p_filePath);
+};
\ No newline at end of file
@@ -0,0 +1,441 @@
+#include "RenderBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "GLM/glm.hpp"
+
+#include "BenchmarkStatistics.h"
+#include "Camera.h"
+#include "ProjectConstants.h"
+#include "JsonWriter/JsonWriter.h"
+#include "MessageDebugger/MessageDebugger.h"
+
+RenderBenchmark::RenderBenchmark(const RenderBenchmarkSettings& p_settings)
+{
+    _settings = p_settings;
+    _renderedFrameCount = 0;
+
+    _totalRequestedBindCount = 0;
+    _totalIssuedBindCount = 0;
+
+    _totalSamplesPassedCount = 0;
+    _overdrawFrameCount = 0;
+
+    _totalTestedChunkCount = 0;
+    _totalOccludedChunkCount = 0;
+    _totalOcclusionCullingMilliseconds = 0.0;
+
+    ReserveFrames();
+}
+
+RenderBenchmarkSettings RenderBenchmark::ParseCommandLine(const int p_argumentCount, char* p_arguments[])
+{
+    RenderBenchmarkSettings settings;
+    settings.WarmupFrameCount = BENCHMARK_WARMUP_FRAME_COUNT;
+    settings.WorldSeed = BENCHMARK_WORLD_SEED;
+    settings.FixedTimeStep = BENCHMARK_FIXED_TIME_STEP;
+    settings.OutputFilePath = BENCHMARK_DEFAULT_OUTPUT_FILE_PATH;
+
+    // NOTE : We begin at 1 because the first argument is the executable path
+    for (int i = 1; i < p_argumentCount; ++i)
+    {
+        const char* argument = p_arguments[i];
+        const bool hasNextArgument = i + 1 < p_argumentCount;
+
+        if (std::strcmp(argument, "--benchmark") == 0)
+            settings.IsEnabled = true;
+
+        else if (std::strcmp(argument, "--frames") == 0 && hasNextArgument)
+            settings.FrameCount = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--warmup") == 0 && hasNextArgument)
+            settings.WarmupFrameCount = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--output") == 0 && hasNextArgument)
+            settings.OutputFilePath = p_arguments[++i];
+
+        else if (std::strcmp(argument, "--camera-path") == 0 && hasNextArgument)
+            settings.CameraPathFilePath = p_arguments[++i];
+
+        else if (std::strcmp(argument, "--timestep") == 0 && hasNextArgument)
+            settings.FixedTimeStep = static_cast<float>(std::atof(p_arguments[++i]));
+
+        else if (std::strcmp(argument, "--record-camera") == 0 && hasNextArgument)
+            settings.RecordCameraFilePath = p_arguments[++i];
+
+        else if (std::strcmp(argument, "--no-chunk-sorting") == 0)
+            settings.IsSortingChunks = false;
+
+        else if (std::strcmp(argument, "--no-occlusion-culling") == 0)
+            settings.IsOcclusionCulling = false;
+
+        else if (std::strcmp(argument, "--no-far-terrain") == 0)
+            settings.IsFarTerrainEnabled = false;
+
+        else if (std::strcmp(argument, "--no-level-of-detail") == 0)
+            settings.IsLevelOfDetailEnabled = false;
+
+        else
+            PRINT_WARNING_RUNTIME(true, std::string("Unknown command line argument '") + argument + "', it has been ignored.")
+    }
+
+    if (settings.FrameCount < 0)
+    {
+        PRINT_WARNING_RUNTIME(true, "The benchmark frame count must be positive, the default value has been used.")
+        settings.FrameCount = 0;
+    }
+
+    // NOTE : Without a camera path the circle is done in the default frame count, otherwise the path gives it (see LoadCameraPath())
+    if (settings.FrameCount == 0 && settings.CameraPathFilePath.empty())
+        settings.FrameCount = BENCHMARK_DEFAULT_FRAME_COUNT;
+
+    if (settings.FixedTimeStep <= 0.0f)
+    {
+        PRINT_WARNING_RUNTIME(true, "The benchmark time step must be positive, the default value has been used.")
+        settings.FixedTimeStep = BENCHMARK_FIXED_TIME_STEP;
+    }
+
+    if (settings.WarmupFrameCount < 0)
+        settings.WarmupFrameCount = 0;
+
+    return settings;
+}
+
+bool RenderBenchmark::LoadCameraPath()
+{
+    if (_settings.CameraPathFilePath.empty())
+        return true;
+
+    if (!_cameraPath.LoadFromFile(_settings.CameraPathFilePath))
+        return false;
+
+    // NOTE : The recorded camera flew over the terrain of this seed
+    _settings.WorldSeed = _cameraPath.WorldSeed;
+
+    if (_settings.FrameCount == 0)
+        _settings.FrameCount = static_cast<int>(std::ceil(_cameraPath.GetDuration() / _settings.FixedTimeStep)) + 1;
+
+    ReserveFrames();
+
+    PRINT_MESSAGE_RUNTIME(
+        "Camera path '" + _settings.CameraPathFilePath + "' loaded : " + std::to_string(_cameraPath.GetFrameCount()) + " recorded frames (" +
+        std::to_string(_cameraPath.GetDuration()) + " s), played in " + std::to_string(_settings.FrameCount) + " frames with the seed " +
+        std::to_string(_settings.WorldSeed)
+    )
+
+    return true;
+}
+
+double RenderBenchmark::GetPathTime() const
+{
+    return GetMeasuredFrameIndex() * static_cast<double>(_settings.FixedTimeStep);
+}
+
+void RenderBenchmark::ApplyCameraPath(Camera& p_camera) const
+{
+    if (!_cameraPath.IsEmpty())
+    {
+        _cameraPath.ApplyPose(GetPathTime(), p_camera);
+        return;
+    }
+
+    const int measuredFrameIndex = GetMeasuredFrameIndex();
+
+    // One full circle around the world center (in radians)
+    const float pathProgress = static_cast<float>(measuredFrameIndex) / static_cast<float>(_settings.FrameCount);
+    const float angle = pathProgress * 2.0f * glm::pi<float>();
+
+    p_camera.SetPosition(glm::vec3(
+        std::cos(angle) * BENCHMARK_CAMERA_PATH_RADIUS,
+        BENCHMARK_CAMERA_PATH_HEIGHT,
+        std::sin(angle) * BENCHMARK_CAMERA_PATH_RADIUS
+    ));
+
+    // Looking toward the world center (the yaw is the opposite direction of the position angle)
+    p_camera.SetRotation(glm::degrees(angle) + 180.0f, BENCHMARK_CAMERA_PATH_PITCH);
+}
+
+void RenderBenchmark::RecordFrame(const double p_frameTimeInSeconds, const unsigned int p_drawCallCount, const unsigned long long p_triangleCount,
+                                  const unsigned int p_requestedBindCount, const unsigned int p_issuedBindCount)
+{
+    if (!IsWarmingUp())
+    {
+        _frameTimes.push_back(p_frameTimeInSeconds * 1000.0);
+        _drawCallCounts.push_back(p_drawCallCount);
+        _triangleCounts.push_back(p_triangleCount);
+
+        _totalRequestedBindCount += p_requestedBindCount;
+        _totalIssuedBindCount += p_issuedBindCount;
+    }
+
+    _renderedFrameCount++;
+}
+
+void RenderBenchmark::RecordFrameDetails(const double p_cpuMilliseconds, const unsigned int p_requestedMeshCount, const unsigned int p_uploadedMeshCount,
+                                         const unsigned int p_uploadedFarTerrainRingCount, const glm::dvec3& p_cameraPosition)
+{
+    if (IsWarmingUp())
+        return;
+
+    _cpuTimes.push_back(p_cpuMilliseconds);
+    _gpuTimes.push_back(-1.0);
+    _requestedMeshCounts.push_back(p_requestedMeshCount);
+    _uploadedMeshCounts.push_back(p_uploadedMeshCount);
+    _uploadedFarTerrainRingCounts.push_back(p_uploadedFarTerrainRingCount);
+    _cameraPositions.push_back(p_cameraPosition);
+}
+
+void RenderBenchmark::RecordGpuTime(const long long p_frameNumber, const double p_milliseconds)
+{
+    const long long measuredFrameIndex = p_frameNumber - _settings.WarmupFrameCount;
+
+    if (measuredFrameIndex < 0 || measuredFrameIndex >= static_cast<long long>(_gpuTimes.size()))
+        return;
+
+    _gpuTimes[static_cast<size_t>(measuredFrameIndex)] = p_milliseconds;
+}
+
+void RenderBenchmark::RecordSamplesPassed(const unsigned long long p_samplesPassedCount)
+{
+    if (IsWarmingUp())
+        return;
+
+    _totalSamplesPassedCount += p_samplesPassedCount;
+    _overdrawFrameCount++;
+}
+
+void RenderBenchmark::RecordOcclusionCulling(const unsigned int p_testedChunkCount, const unsigned int p_occludedChunkCount, const double p_rasterizationMilliseconds)
+{
+    if (IsWarmingUp())
+        return;
+
+    _totalTestedChunkCount += p_testedChunkCount;
+    _totalOccludedChunkCount += p_occludedChunkCount;
+    _totalOcclusionCullingMilliseconds += p_rasterizationMilliseconds;
+}
+
+bool RenderBenchmark::SaveReport(const std::string& p_rendererName, const std::string& p_openGlVersion, const int p_width, const int p_height) const
+{
+    const BenchmarkStatistics frameTimeStatistics = BenchmarkStatistics::Compute(_frameTimes);
+
+    double totalFrameTime = 0.0;
+    unsigned long long totalDrawCalls = 0;
+    unsigned long long totalTriangles = 0;
+
+    for (size_t i = 0; i < _frameTimes.size(); ++i)
+    {
+        totalFrameTime += _frameTimes[i];
+        totalDrawCalls += _drawCallCounts[i];
+        totalTriangles += _triangleCounts[i];
+    }
+
+    const double measuredFrameCount = _frameTimes.empty() ? 1.0 : static_cast<double>(_frameTimes.size());
+
+    // NOTE : The unknown GPU times are left out (no timer queries, or a result lost because the GPU was late)
+    std::vector<double> knownGpuTimes;
+    knownGpuTimes.reserve(_gpuTimes.size());
+
+    for (const double gpuTime : _gpuTimes)
+    {
+        if (gpuTime >= 0.0)
+            knownGpuTimes.push_back(gpuTime);
+    }
+
+    const BenchmarkStatistics cpuTimeStatistics = BenchmarkStatistics::Compute(_cpuTimes);
+    const BenchmarkStatistics gpuTimeStatistics = BenchmarkStatistics::Compute(knownGpuTimes);
+
+    unsigned long long totalRequestedMeshes = 0;
+    unsigned long long totalUploadedMeshes = 0;
+    unsigned long long totalUploadedFarTerrainRings = 0;
+
+    for (size_t i = 0; i < _requestedMeshCounts.size(); ++i)
+    {
+        totalRequestedMeshes += _requestedMeshCounts[i];
+        totalUploadedMeshes += _uploadedMeshCounts[i];
+        totalUploadedFarTerrainRings += _uploadedFarTerrainRingCounts[i];
+    }
+
+    // - Hitches : the frames as slow as the 99th percentile or slower, the slowest first - //
+
+    std::vector<size_t> hitchFrameIndices;
+
+    for (size_t i = 0; i < _frameTimes.size(); ++i)
+    {
+        if (_frameTimes[i] >= frameTimeStatistics.Percentile99)
+            hitchFrameIndices.push_back(i);
+    }
+
+    std::sort(hitchFrameIndices.begin(), hitchFrameIndices.end(),
+        [this](const size_t p_first, const size_t p_second) { return _frameTimes[p_first] > _frameTimes[p_second]; });
+
+    JsonWriter jsonWriter;
+    jsonWriter.BeginObject();
+
+    jsonWriter.BeginObject("settings");
+    jsonWriter.Write("frameCount", _settings.FrameCount);
+    jsonWriter.Write("warmupFrameCount", _settings.WarmupFrameCount);
+    jsonWriter.Write("worldSeed", _settings.WorldSeed);
+    jsonWriter.Write("cameraPath", _cameraPath.IsEmpty() ? std::string("circle") : _settings.CameraPathFilePath);
+    jsonWriter.Write("fixedTimeStep", static_cast<double>(_settings.FixedTimeStep));
+    jsonWriter.Write("width", p_width);
+    jsonWriter.Write("height", p_height);
+    jsonWriter.Write("vsync", false);
+    jsonWriter.Write("chunkSorting", _settings.IsSortingChunks);
+    jsonWriter.Write("occlusionCulling", _settings.IsOcclusionCulling);
+    jsonWriter.Write("farTerrain", _settings.IsFarTerrainEnabled);
+    jsonWriter.Write("levelOfDetail", _settings.IsLevelOfDetailEnabled);
+    jsonWriter.EndObject();
+
+    jsonWriter.BeginObject("renderer");
+    jsonWriter.Write("name", p_rendererName);
+    jsonWriter.Write("openGlVersion", p_openGlVersion);
+    jsonWriter.EndObject();
+
+    frameTimeStatistics.WriteToJson(jsonWriter, "frameTimeMilliseconds");
+    cpuTimeStatistics.WriteToJson(jsonWriter, "cpuTimeMilliseconds");
+    gpuTimeStatistics.WriteToJson(jsonWriter, "gpuTimeMilliseconds");
+    jsonWriter.Write("averageFramesPerSecond", totalFrameTime > 0.0 ? 1000.0 * measuredFrameCount / totalFrameTime : 0.0);
+
+    jsonWriter.Write("averageDrawCallsPerFrame", static_cast<double>(totalDrawCalls) / measuredFrameCount);
+    jsonWriter.Write("averageTrianglesPerFrame", static_cast<double>(totalTriangles) / measuredFrameCount);
+    jsonWriter.Write("totalDrawCalls", totalDrawCalls);
+    jsonWriter.Write("totalTriangles", totalTriangles);
+
+    // Requested = the binds done without the Renderer's state cache, issued = the ones really sent to OpenGL
+    jsonWriter.Write("averageRequestedBindsPerFrame", static_cast<double>(_totalRequestedBindCount) / measuredFrameCount);
+    jsonWriter.Write("averageIssuedBindsPerFrame", static_cast<double>(_totalIssuedBindCount) / measuredFrameCount);
+    jsonWriter.Write("averageRedundantBindsSkippedPerFrame", static_cast<double>(_totalRequestedBindCount - _totalIssuedBindCount) / measuredFrameCount);
+
+    // Fragments passing the depth test per pixel, lower with the front to back order (see OverdrawCounter)
+    const double averageSamplesPassed = _overdrawFrameCount > 0 ? static_cast<double>(_totalSamplesPassedCount) / _overdrawFrameCount : 0.0;
+    jsonWriter.Write("averageSamplesPassedPerFrame", averageSamplesPassed);
+    jsonWriter.Write("averageOverdraw", p_width * p_height > 0 ? averageSamplesPassed / (static_cast<double>(p_width) * p_height) : 0.0);
+
+    // The chunks not queued because they are hidden, and the CPU time spent to find them (see OcclusionCuller)
+    jsonWriter.Write("averageTestedChunksPerFrame", static_cast<double>(_totalTestedChunkCount) / measuredFrameCount);
+    jsonWriter.Write("averageOccludedChunksPerFrame", static_cast<double>(_totalOccludedChunkCount) / measuredFrameCount);
+    jsonWriter.Write("averageOcclusionCullingMilliseconds", _totalOcclusionCullingMilliseconds / measuredFrameCount);
+
+    // The meshes of the chunks generated, edited or changing their level of detail, and the far terrain rings re-sampled
+    jsonWriter.Write("totalRequestedMeshes", totalRequestedMeshes);
+    jsonWriter.Write("totalUploadedMeshes", totalUploadedMeshes);
+    jsonWriter.Write("totalUploadedFarTerrainRings", totalUploadedFarTerrainRings);
+
+    jsonWriter.Write("hitchThresholdMilliseconds", frameTimeStatistics.Percentile99);
+    jsonWriter.BeginArray("hitches");
+
+    for (const size_t frameIndex : hitchFrameIndices)
+    {
+        jsonWriter.BeginObject();
+        jsonWriter.Write("frame", static_cast<unsigned long long>(frameIndex));
+        jsonWriter.Write("pathTime", frameIndex * static_cast<double>(_settings.FixedTimeStep));
+        jsonWriter.Write("frameTimeMilliseconds", _frameTimes[frameIndex]);
+
+        if (frameIndex < _cpuTimes.size())
+        {
+            jsonWriter.Write("cpuTimeMilliseconds", _cpuTimes[frameIndex]);
+            jsonWriter.Write("gpuTimeMilliseconds", _gpuTimes[frameIndex]);
+            jsonWriter.Write("requestedMeshes", _requestedMeshCounts[frameIndex]);
+            jsonWriter.Write("uploadedMeshes", _uploadedMeshCounts[frameIndex]);
+            jsonWriter.Write("uploadedFarTerrainRings", _uploadedFarTerrainRingCounts[frameIndex]);
+
+            jsonWriter.BeginArray("cameraPosition");
+            jsonWriter.WriteValue(_cameraPositions[frameIndex].x);
+            jsonWriter.WriteValue(_cameraPositions[frameIndex].y);
+            jsonWriter.WriteValue(_cameraPositions[frameIndex].z);
+            jsonWriter.EndArray();
+        }
+
+        jsonWriter.EndObject();
+    }
+
+    jsonWriter.EndArray();
+
+    jsonWriter.BeginArray("frameTimesMilliseconds");
+    for (const double frameTime : _frameTimes)
+        jsonWriter.WriteValue(frameTime);
+    jsonWriter.EndArray();
+
+    jsonWriter.BeginArray("cpuTimesMilliseconds");
+    for (const double cpuTime : _cpuTimes)
+        jsonWriter.WriteValue(cpuTime);
+    jsonWriter.EndArray();
+
+    // NOTE : -1 when the GPU time of the frame is unknown
+    jsonWriter.BeginArray("gpuTimesMilliseconds");
+    for (const double gpuTime : _gpuTimes)
+        jsonWriter.WriteValue(gpuTime);
+    jsonWriter.EndArray();
+
+    jsonWriter.BeginArray("requestedMeshCounts");
+    for (const unsigned int requestedMeshCount : _requestedMeshCounts)
+        jsonWriter.WriteValue(static_cast<long long>(requestedMeshCount));
+    jsonWriter.EndArray();
+
+    jsonWriter.BeginArray("uploadedMeshCounts");
+    for (const unsigned int uploadedMeshCount : _uploadedMeshCounts)
+        jsonWriter.WriteValue(static_cast<long long>(uploadedMeshCount));
+    jsonWriter.EndArray();
+
+    jsonWriter.BeginArray("uploadedFarTerrainRingCounts");
+    for (const unsigned int uploadedFarTerrainRingCount : _uploadedFarTerrainRingCounts)
+        jsonWriter.WriteValue(static_cast<long long>(uploadedFarTerrainRingCount));
+    jsonWriter.EndArray();
+
+    jsonWriter.EndObject();
+
+    if (!jsonWriter.SaveToFile(_settings.OutputFilePath))
+    {
+        PRINT_ERROR_RUNTIME(true, "Failed to write the benchmark report inside '" + _settings.OutputFilePath + "'")
+        return false;
+    }
+
+    // The slowest hitches are printed too, the others are only inside the report
+    std::stringstream hitchList;
+
+    for (size_t i = 0; i < hitchFrameIndices.size() && i < static_cast<size_t>(BENCHMARK_PRINTED_HITCH_COUNT); ++i)
+    {
+        const size_t frameIndex = hitchFrameIndices[i];
+
+        hitchList << "\n  frame " << frameIndex << " (" << frameIndex * _settings.FixedTimeStep << " s) : " << _frameTimes[frameIndex] << " ms";
+
+        if (frameIndex < _cpuTimes.size())
+        {
+            hitchList << " (CPU " << _cpuTimes[frameIndex] << " ms, GPU " << _gpuTimes[frameIndex] << " ms, " << _requestedMeshCounts[frameIndex] <<
+                " meshes requested, " << _uploadedMeshCounts[frameIndex] << " uploaded, " << _uploadedFarTerrainRingCounts[frameIndex] << " far terrain rings)";
+        }
+    }
+
+    PRINT_MESSAGE_RUNTIME(
+        "Benchmark finished (" + std::to_string(_frameTimes.size()) + " frames), average frame time : " +
+        std::to_string(frameTimeStatistics.Average) + " ms, 99th percentile : " + std::to_string(frameTimeStatistics.Percentile99) + " ms, " +
+        std::to_string(hitchFrameIndices.size()) + " hitches" + hitchList.str() + "\nReport written inside '" + _settings.OutputFilePath + "'"
+    )
+
+    return true;
+}
+
+
+int RenderBenchmark::GetMeasuredFrameIndex() const
+{
+    // During the warmup the camera stays at the beginning of the path
+    return IsWarmingUp() ? 0 : _renderedFrameCount - _settings.WarmupFrameCount;
+}
+
+void RenderBenchmark::ReserveFrames()
+{
+    _frameTimes.reserve(_settings.FrameCount);
+    _drawCallCounts.reserve(_settings.FrameCount);
+    _triangleCounts.reserve(_settings.FrameCount);
+
+    _cpuTimes.reserve(_settings.FrameCount);
+    _gpuTimes.reserve(_settings.FrameCount);
+    _requestedMeshCounts.reserve(_settings.FrameCount);
+    _uploadedMeshCounts.reserve(_settings.FrameCount);
+    _uploadedFarTerrainRingCounts.reserve(_settings.FrameCount);
+    _cameraPositions.reserve(_settings.FrameCount);
+}
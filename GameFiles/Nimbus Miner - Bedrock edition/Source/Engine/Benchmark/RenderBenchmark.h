@@ -0,0 +1,152 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "GLM/glm.hpp"
+
+#include "CameraRecording.h"
+
+class Camera;
+
+struct RenderBenchmarkSettings
+{
+    bool IsEnabled = false;
+
+    /// <summary> The number of measured frames (the warmup frames are not counted), 0 for the whole camera path (see LoadCameraPath()). </summary>
+    int FrameCount = 0;
+    int WarmupFrameCount = 0;
+
+    int WorldSeed = 0;
+
+    /// <summary> Set with <c> --camera-path filePath </c> : the camera follows a recorded flythrough (see CameraRecording) instead of the circle. </summary>
+    std::string CameraPathFilePath;
+
+    /// <summary> In seconds, the camera path advances by this time each frame, whatever the real frame time (set with <c> --timestep seconds </c>). </summary>
+    float FixedTimeStep = 0.0f;
+
+    /// <summary> Set with <c> --record-camera filePath </c>, outside of the benchmark mode : the camera of the played session is saved inside it. </summary>
+    std::string RecordCameraFilePath;
+
+    /// <summary> False with <c> --no-chunk-sorting </c>, to measure the overdraw without the front to back order. </summary>
+    bool IsSortingChunks = true;
+
+    /// <summary> False with <c> --no-occlusion-culling </c>, to measure what the CPU occlusion culling saves. </summary>
+    bool IsOcclusionCulling = true;
+
+    /// <summary> False with <c> --no-far-terrain </c>, to compare with the results measured before the far terrain existed. </summary>
+    bool IsFarTerrainEnabled = true;
+
+    /// <summary> False with <c> --no-level-of-detail </c>, to measure what the downsampled meshes of the far chunks save. </summary>
+    bool IsLevelOfDetailEnabled = true;
+
+    std::string OutputFilePath;
+};
+
+/// <summary>
+/// Headless render benchmark : the game is rendered in a hidden window (inside an off-screen FrameBufferObject),
+/// without vsync, with a fixed world seed and a fixed camera path. After N frames the frame time statistics
+/// and the draw call / triangle counts are written inside a JSON file.
+///
+/// <para> Launch example : <c> "Nimbus Miner - Bedrock edition.exe" --benchmark --frames 500 --output Result.json </c> </para>
+///
+/// <para> The camera path can be a recorded flythrough, played at a fixed time step with the seed of the recording. Each frame's CPU,
+/// GPU and frame time are written with the meshes requested and uploaded, and the frames as slow as the 99th percentile or slower (the hitches) are listed :
+/// <c> "Nimbus Miner - Bedrock edition.exe" --record-camera Flythrough.txt </c> once, then
+/// <c> "Nimbus Miner - Bedrock edition.exe" --benchmark --camera-path Flythrough.txt --output BuildA.json </c> with each build to compare. </para>
+///
+/// <para> On a Linux machine without GPU you can run it with Mesa's software rasterizer (llvmpipe),
+/// <c> LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ./NimbusMiner --benchmark </c> (GLFW needs a display, even for a hidden window). </para> </summary>
+class RenderBenchmark
+{
+
+private:
+
+    RenderBenchmarkSettings _settings;
+
+    // Includes the warmup frames
+    int _renderedFrameCount;
+
+    std::vector<double> _frameTimes;            // In milliseconds
+    std::vector<unsigned int> _drawCallCounts;
+    std::vector<unsigned long long> _triangleCounts;
+
+    // See RecordFrameDetails(), the GPU times are -1 until RecordGpuTime() gives them
+    std::vector<double> _cpuTimes;              // In milliseconds
+    std::vector<double> _gpuTimes;              // In milliseconds
+    std::vector<unsigned int> _requestedMeshCounts;
+    std::vector<unsigned int> _uploadedMeshCounts;
+    std::vector<unsigned int> _uploadedFarTerrainRingCounts;
+    std::vector<glm::dvec3> _cameraPositions;
+
+    // Empty when the camera follows the circle
+    CameraRecording _cameraPath;
+
+    // Summed over the measured frames, see Renderer::GetRequestedBindCount()
+    unsigned long long _totalRequestedBindCount;
+    unsigned long long _totalIssuedBindCount;
+
+    // See OverdrawCounter, only the frames with a query result are counted
+    unsigned long long _totalSamplesPassedCount;
+    int _overdrawFrameCount;
+
+    // Summed over the measured frames, see OcclusionCuller
+    unsigned long long _totalTestedChunkCount;
+    unsigned long long _totalOccludedChunkCount;
+    double _totalOcclusionCullingMilliseconds;
+
+public:
+
+    explicit RenderBenchmark(const RenderBenchmarkSettings& p_settings);
+
+    /// <summary>
+    /// Reads the benchmark arguments : <c> --benchmark </c>, <c> --frames N </c>, <c> --warmup N </c>, <c> --output filePath </c>, <c> --camera-path filePath </c>, <c> --timestep seconds </c>,
+    /// <c> --no-chunk-sorting </c>, <c> --no-occlusion-culling </c>, <c> --no-far-terrain </c> and <c> --no-level-of-detail </c> (and <c> --record-camera filePath </c> for the game).
+    /// <para> The returned settings are disabled if the <c> --benchmark </c> argument is missing. </para> </summary>
+    static RenderBenchmarkSettings ParseCommandLine(const int p_argumentCount, char* p_arguments[]);
+
+    /// <summary>
+    /// Reads the settings' camera path, if there is one : the world seed becomes the recording's one, and the frame count covers the whole path
+    /// (unless it was given). Must be called before the world creation. Returns false if the file can't be read. </summary>
+    bool LoadCameraPath();
+
+    const RenderBenchmarkSettings& GetSettings() const { return _settings; }
+
+    /// <summary> The time of the current frame on the camera path (0 during the warmup), it advances by the FixedTimeStep each frame. </summary>
+    double GetPathTime() const;
+
+    bool IsWarmingUp() const { return _renderedFrameCount < _settings.WarmupFrameCount; }
+    bool IsFinished() const { return _renderedFrameCount >= _settings.WarmupFrameCount + _settings.FrameCount; }
+
+    /// <summary> Places the camera on the fixed path (or the recorded one), depending on the current frame (not on the elapsed time). </summary>
+    void ApplyCameraPath(Camera& p_camera) const;
+
+    /// <summary> Must be called once at the end of each rendered frame, warmup frames are not recorded. </summary>
+    void RecordFrame(double p_frameTimeInSeconds, unsigned int p_drawCallCount, unsigned long long p_triangleCount,
+                     unsigned int p_requestedBindCount, unsigned int p_issuedBindCount);
+
+    /// <summary> The fragments that passed the depth test during the frame (see OverdrawCounter), call it before RecordFrame(). </summary>
+    void RecordSamplesPassed(unsigned long long p_samplesPassedCount);
+
+    /// <summary> The chunks tested and hidden by the occlusion culling during the frame, call it before RecordFrame(). </summary>
+    void RecordOcclusionCulling(unsigned int p_testedChunkCount, unsigned int p_occludedChunkCount, double p_rasterizationMilliseconds);
+
+    /// <summary> What the frame cost outside of the Renderer, call it before RecordFrame(). </summary>
+    /// <param name = "p_cpuMilliseconds"> The time taken by the CPU to prepare and send the frame, without waiting for the GPU. </param>
+    void RecordFrameDetails(double p_cpuMilliseconds, unsigned int p_requestedMeshCount, unsigned int p_uploadedMeshCount,
+                            unsigned int p_uploadedFarTerrainRingCount, const glm::dvec3& p_cameraPosition);
+
+    /// <summary> The GPU time of a frame (see GpuTimer), known after its RecordFrame(). The frames are numbered from 0, the warmup frames included. </summary>
+    void RecordGpuTime(long long p_frameNumber, double p_milliseconds);
+
+    /// <summary> Writes the results in the settings' output file. Returns false if the file can't be written. </summary>
+    bool SaveReport(const std::string& p_rendererName, const std::string& p_openGlVersion, int p_width, int p_height) const;
+
+private:
+
+    /// <summary> The index of the current frame among the measured ones (0 during the warmup). </summary>
+    int GetMeasuredFrameIndex() const;
+
+    /// <summary> Reserves the per-frame vectors for the settings' frame count. </summary>
+    void ReserveFrames();
+};
@@ -0,0 +1,431 @@
+#include "OcclusionCuller.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+    #define IS_OCCLUSION_CULLER_USING_SSE2
+    #include <emmintrin.h>
+#endif
+
+#include "ProjectConstants.h"
+
+#include "../Threading/ThreadPool.h"
+
+OcclusionCuller::OcclusionCuller(const int p_width, const int p_height, const unsigned int p_threadCount)
+{
+    // Initialising class' variables
+    _width = 0;
+    _height = 0;
+
+    _viewProjectionMatrix = glm::mat4(1.0f);
+    _cameraPosition = glm::dvec3(0.0);
+
+    _occluderCount = 0;
+    _testedCount = 0;
+    _occludedCount = 0;
+    _outsideFrustumCount = 0;
+    _rasterizationMilliseconds = 0.0;
+
+    _threadPool = new ThreadPool(p_threadCount);
+
+    // The main thread rasterizes the last band
+    _bandCount = static_cast<int>(_threadPool->GetThreadCount()) + 1;
+
+    SetResolution(p_width, p_height);
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    delete _threadPool;
+}
+
+void OcclusionCuller::SetResolution(int p_width, int p_height)
+{
+    // NOTE : The rasterizer writes 4 pixels at a time, so the rows must be a multiple of 4
+    p_width = std::max(4, (p_width + 3) / 4 * 4);
+    p_height = std::max(1, p_height);
+
+    if (p_width == _width && p_height == _height)
+        return;
+
+    _width = p_width;
+    _height = p_height;
+
+    // - Allocating the depth pyramid - //
+
+    _depthPyramid.clear();
+    _depthPyramidSizes.clear();
+
+    glm::ivec2 levelSize = glm::ivec2(_width, _height);
+
+    while (true)
+    {
+        _depthPyramid.emplace_back(static_cast<size_t>(levelSize.x) * levelSize.y, 0.0f);
+        _depthPyramidSizes.push_back(levelSize);
+
+        if (levelSize.x == 1 && levelSize.y == 1)
+            break;
+
+        levelSize = glm::ivec2((levelSize.x + 1) / 2, (levelSize.y + 1) / 2);
+    }
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4& p_cameraRelativeViewProjectionMatrix, const glm::dvec3& p_cameraPosition)
+{
+    _viewProjectionMatrix = p_cameraRelativeViewProjectionMatrix;
+    _cameraPosition = p_cameraPosition;
+
+    // NOTE : clear() keeps the capacity, the triangles list does not allocate anymore after the first frames
+    _triangles.clear();
+
+    _occluderCount = 0;
+    _testedCount = 0;
+    _occludedCount = 0;
+    _outsideFrustumCount = 0;
+    _rasterizationMilliseconds = 0.0;
+}
+
+#pragma region // -=- Occluders -=- //
+
+void OcclusionCuller::AddOccluder(const OccluderBox& p_occluderBox)
+{
+    // - Projecting the 8 corners - //
+
+    // The bit 0 of the index is the X (0 = minimum, 1 = maximum), the bit 1 the Y and the bit 2 the Z
+    glm::vec3 corners[8];
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const glm::dvec3 corner = glm::dvec3(
+            (i & 1) ? p_occluderBox.Maximum.x : p_occluderBox.Minimum.x,
+            (i & 2) ? p_occluderBox.Maximum.y : p_occluderBox.Minimum.y,
+            (i & 4) ? p_occluderBox.Maximum.z : p_occluderBox.Minimum.z
+        );
+
+        // NOTE : A box crossing the near plane is simply ignored, not drawing an occluder is always safe (it only hides less)
+        if (!ProjectToScreen(corner, corners[i]))
+            return;
+    }
+
+    _occluderCount++;
+
+    // - Adding the faces (two triangles each, counter-clockwise seen from outside the box) - //
+
+    // The 4 corners of each face, in the counter-clockwise order
+    static const int FACES[6][4] = {
+        { 0, 4, 6, 2 }, // -X
+        { 1, 3, 7, 5 }, // +X
+        { 0, 1, 5, 4 }, // -Y
+        { 2, 6, 7, 3 }, // +Y
+        { 0, 2, 3, 1 }, // -Z
+        { 4, 5, 7, 6 }  // +Z
+    };
+
+    for (const int* face : FACES)
+    {
+        AddTriangle(corners[face[0]], corners[face[1]], corners[face[2]]);
+        AddTriangle(corners[face[0]], corners[face[2]], corners[face[3]]);
+    }
+}
+
+bool OcclusionCuller::ProjectToScreen(const glm::dvec3& p_worldPosition, glm::vec3& p_outScreenPosition) const
+{
+    // Relative to the camera in double precision, only the small result is used in float
+    const glm::vec3 cameraRelativePosition = glm::vec3(p_worldPosition - _cameraPosition);
+    const glm::vec4 clipPosition = _viewProjectionMatrix * glm::vec4(cameraRelativePosition, 1.0f);
+
+    if (clipPosition.w < CAMERA_FRUSTUM_NEAR)
+        return false;
+
+    const float inverseW = 1.0f / clipPosition.w;
+
+    // NOTE : The Y goes up (the row 0 is the bottom of the screen), so the counter-clockwise triangles keep facing the camera
+    p_outScreenPosition = glm::vec3(
+        (clipPosition.x * inverseW * 0.5f + 0.5f) * _width,
+        (clipPosition.y * inverseW * 0.5f + 0.5f) * _height,
+        inverseW
+    );
+
+    return true;
+}
+
+void OcclusionCuller::AddTriangle(const glm::vec3& p_vertex1, const glm::vec3& p_vertex2, const glm::vec3& p_vertex3)
+{
+    // Twice the signed area, positive when the triangle faces the camera
+    const float area = (p_vertex2.x - p_vertex1.x) * (p_vertex3.y - p_vertex1.y) - (p_vertex2.y - p_vertex1.y) * (p_vertex3.x - p_vertex1.x);
+
+    // Back faces (hidden by the front ones of the same box) and degenerate triangles
+    if (area <= 0.0f)
+        return;
+
+    ScreenTriangle triangle;
+
+    triangle.MinimumX = std::max(0, static_cast<int>(std::floor(std::min({ p_vertex1.x, p_vertex2.x, p_vertex3.x }))));
+    triangle.MaximumX = std::min(_width - 1, static_cast<int>(std::floor(std::max({ p_vertex1.x, p_vertex2.x, p_vertex3.x }))));
+    triangle.MinimumY = std::max(0, static_cast<int>(std::floor(std::min({ p_vertex1.y, p_vertex2.y, p_vertex3.y }))));
+    triangle.MaximumY = std::min(_height - 1, static_cast<int>(std::floor(std::max({ p_vertex1.y, p_vertex2.y, p_vertex3.y }))));
+
+    // Outside the screen
+    if (triangle.MinimumX > triangle.MaximumX || triangle.MinimumY > triangle.MaximumY)
+        return;
+
+    // - Edge functions - //
+
+    // Edge i goes from the vertex i to the vertex i + 1, E(x, y) = A * x + B * y + C is positive inside the triangle
+    const glm::vec3* vertices[3] = { &p_vertex1, &p_vertex2, &p_vertex3 };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const glm::vec3& edgeStart = *vertices[i];
+        const glm::vec3& edgeEnd = *vertices[(i + 1) % 3];
+
+        // NOTE : Written so the same edge walked the other way gives exactly the opposite values (even with the rounding),
+        //        a pixel on the edge shared by two triangles is always drawn by one of them (no crack between the two triangles of a face)
+        triangle.EdgeA[i] = edgeStart.y - edgeEnd.y;
+        triangle.EdgeB[i] = edgeEnd.x - edgeStart.x;
+        triangle.EdgeC[i] = edgeStart.x * edgeEnd.y - edgeEnd.x * edgeStart.y;
+    }
+
+    // - Depth plane - //
+
+    // The barycentric weight of a vertex is the edge function of the opposite edge divided by the area
+    // (edge 1 is opposite to the vertex 1, edge 2 to the vertex 2, edge 0 to the vertex 3)
+    const float inverseArea = 1.0f / area;
+
+    triangle.DepthA = (triangle.EdgeA[1] * p_vertex1.z + triangle.EdgeA[2] * p_vertex2.z + triangle.EdgeA[0] * p_vertex3.z) * inverseArea;
+    triangle.DepthB = (triangle.EdgeB[1] * p_vertex1.z + triangle.EdgeB[2] * p_vertex2.z + triangle.EdgeB[0] * p_vertex3.z) * inverseArea;
+    triangle.DepthC = (triangle.EdgeC[1] * p_vertex1.z + triangle.EdgeC[2] * p_vertex2.z + triangle.EdgeC[0] * p_vertex3.z) * inverseArea;
+
+    _triangles.push_back(triangle);
+}
+
+#pragma endregion
+
+#pragma region // -=- Rasterization -=- //
+
+void OcclusionCuller::RasterizeOccluders()
+{
+    const std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+
+    std::vector<float>& depthBuffer = _depthPyramid[0];
+
+    // Nothing drawn = infinitely far
+    std::fill(depthBuffer.begin(), depthBuffer.end(), 0.0f);
+
+    if (!_triangles.empty())
+    {
+        // NOTE : Each band only writes its own rows, so the threads never share a pixel
+        const int bandCount = std::min(_bandCount, _height);
+        const int rowsPerBand = (_height + bandCount - 1) / bandCount;
+
+        for (int band = 0; band + 1 < bandCount; ++band)
+        {
+            const int firstRow = band * rowsPerBand;
+            const int lastRow = std::min(_height, firstRow + rowsPerBand);
+
+            _threadPool->Submit([this, firstRow, lastRow]() { RasterizeBand(firstRow, lastRow); });
+        }
+
+        // The main thread does the last band instead of waiting
+        RasterizeBand(std::min(_height, (bandCount - 1) * rowsPerBand), _height);
+
+        _threadPool->WaitForIdle();
+    }
+
+    BuildDepthPyramid();
+
+    _rasterizationMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+}
+
+void OcclusionCuller::RasterizeBand(const int p_firstRow, const int p_lastRow)
+{
+    float* depthBuffer = _depthPyramid[0].data();
+
+    for (const ScreenTriangle& triangle : _triangles)
+    {
+        const int firstRow = std::max(triangle.MinimumY, p_firstRow);
+        const int lastRow = std::min(triangle.MaximumY, p_lastRow - 1);
+
+        // Aligned on 4 pixels, the pixels outside the triangle are rejected by the edge functions
+        const int firstColumn = triangle.MinimumX & ~3;
+
+        for (int y = firstRow; y <= lastRow; ++y)
+        {
+            // The functions are evaluated at the pixel centers
+            const float pixelY = static_cast<float>(y) + 0.5f;
+
+            const float edgeRow0 = triangle.EdgeB[0] * pixelY + triangle.EdgeC[0];
+            const float edgeRow1 = triangle.EdgeB[1] * pixelY + triangle.EdgeC[1];
+            const float edgeRow2 = triangle.EdgeB[2] * pixelY + triangle.EdgeC[2];
+            const float depthRow = triangle.DepthB * pixelY + triangle.DepthC;
+
+            float* depthRowPixels = depthBuffer + static_cast<size_t>(y) * _width;
+
+            #ifdef IS_OCCLUSION_CULLER_USING_SSE2
+
+            const __m128 columnOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const __m128 zero = _mm_setzero_ps();
+
+            for (int x = firstColumn; x <= triangle.MaximumX; x += 4)
+            {
+                const __m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), columnOffsets);
+
+                const __m128 edge0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.EdgeA[0]), pixelX), _mm_set1_ps(edgeRow0));
+                const __m128 edge1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.EdgeA[1]), pixelX), _mm_set1_ps(edgeRow1));
+                const __m128 edge2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.EdgeA[2]), pixelX), _mm_set1_ps(edgeRow2));
+
+                const __m128 isInside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+
+                if (_mm_movemask_ps(isInside) == 0)
+                    continue;
+
+                const __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.DepthA), pixelX), _mm_set1_ps(depthRow));
+                const __m128 currentDepth = _mm_loadu_ps(depthRowPixels + x);
+
+                // The biggest 1 / w is the closest
+                const __m128 closestDepth = _mm_max_ps(currentDepth, depth);
+
+                _mm_storeu_ps(depthRowPixels + x, _mm_or_ps(_mm_and_ps(isInside, closestDepth), _mm_andnot_ps(isInside, currentDepth)));
+            }
+
+            #else
+
+            for (int x = firstColumn; x <= triangle.MaximumX; ++x)
+            {
+                const float pixelX = static_cast<float>(x) + 0.5f;
+
+                if (triangle.EdgeA[0] * pixelX + edgeRow0 < 0.0f ||
+                    triangle.EdgeA[1] * pixelX + edgeRow1 < 0.0f ||
+                    triangle.EdgeA[2] * pixelX + edgeRow2 < 0.0f)
+                    continue;
+
+                // The biggest 1 / w is the closest
+                depthRowPixels[x] = std::max(depthRowPixels[x], triangle.DepthA * pixelX + depthRow);
+            }
+
+            #endif
+        }
+    }
+}
+
+void OcclusionCuller::BuildDepthPyramid()
+{
+    for (size_t level = 1; level < _depthPyramid.size(); ++level)
+    {
+        const std::vector<float>& previousLevel = _depthPyramid[level - 1];
+        const glm::ivec2 previousSize = _depthPyramidSizes[level - 1];
+
+        std::vector<float>& currentLevel = _depthPyramid[level];
+        const glm::ivec2 currentSize = _depthPyramidSizes[level];
+
+        for (int y = 0; y < currentSize.y; ++y)
+        {
+            // NOTE : On an odd size the last texel only has one child on that axis
+            const int childY1 = y * 2;
+            const int childY2 = std::min(childY1 + 1, previousSize.y - 1);
+
+            for (int x = 0; x < currentSize.x; ++x)
+            {
+                const int childX1 = x * 2;
+                const int childX2 = std::min(childX1 + 1, previousSize.x - 1);
+
+                // The farthest depth (the smallest 1 / w), so a texel never hides more than its pixels
+                currentLevel[static_cast<size_t>(y) * currentSize.x + x] = std::min({
+                    previousLevel[static_cast<size_t>(childY1) * previousSize.x + childX1],
+                    previousLevel[static_cast<size_t>(childY1) * previousSize.x + childX2],
+                    previousLevel[static_cast<size_t>(childY2) * previousSize.x + childX1],
+                    previousLevel[static_cast<size_t>(childY2) * previousSize.x + childX2]
+                });
+            }
+        }
+    }
+}
+
+#pragma endregion
+
+bool OcclusionCuller::IsVisible(const glm::vec3& p_minimum, const glm::vec3& p_maximum)
+{
+    _testedCount++;
+
+    // - Projecting the box - //
+
+    glm::vec2 screenMinimum = glm::vec2(std::numeric_limits<float>::max());
+    glm::vec2 screenMaximum = glm::vec2(std::numeric_limits<float>::lowest());
+    float closestDepth = 0.0f;
+
+    int cornersBehindCount = 0;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const glm::dvec3 corner = glm::dvec3(
+            (i & 1) ? p_maximum.x : p_minimum.x,
+            (i & 2) ? p_maximum.y : p_minimum.y,
+            (i & 4) ? p_maximum.z : p_minimum.z
+        );
+
+        glm::vec3 screenCorner;
+
+        if (!ProjectToScreen(corner, screenCorner))
+        {
+            cornersBehindCount++;
+            continue;
+        }
+
+        screenMinimum = glm::min(screenMinimum, glm::vec2(screenCorner));
+        screenMaximum = glm::max(screenMaximum, glm::vec2(screenCorner));
+        closestDepth = std::max(closestDepth, screenCorner.z);
+    }
+
+    // - Frustum - //
+
+    // The camera is inside the box or very close to it
+    if (cornersBehindCount > 0 && cornersBehindCount < 8)
+        return true;
+
+    if (cornersBehindCount == 8 || screenMaximum.x < 0.0f || screenMaximum.y < 0.0f || screenMinimum.x >= _width || screenMinimum.y >= _height)
+    {
+        _outsideFrustumCount++;
+        return false;
+    }
+
+    // - Depth pyramid - //
+
+    int minimumX = std::max(0, static_cast<int>(std::floor(screenMinimum.x)));
+    int maximumX = std::min(_width - 1, static_cast<int>(std::floor(screenMaximum.x)));
+    int minimumY = std::max(0, static_cast<int>(std::floor(screenMinimum.y)));
+    int maximumY = std::min(_height - 1, static_cast<int>(std::floor(screenMaximum.y)));
+
+    // Going up the pyramid until the box covers at most 4x4 texels
+    size_t level = 0;
+
+    while ((maximumX - minimumX >= 4 || maximumY - minimumY >= 4) && level + 1 < _depthPyramid.size())
+    {
+        minimumX /= 2;
+        maximumX /= 2;
+        minimumY /= 2;
+        maximumY /= 2;
+        level++;
+    }
+
+    const std::vector<float>& levelDepths = _depthPyramid[level];
+    const int levelWidth = _depthPyramidSizes[level].x;
+
+    // NOTE : The bias avoids hiding a box by the occluders lying on its own surface
+    const float biasedClosestDepth = closestDepth * (1.0f + OCCLUSION_CULLING_DEPTH_BIAS);
+
+    for (int y = minimumY; y <= maximumY; ++y)
+    {
+        for (int x = minimumX; x <= maximumX; ++x)
+        {
+            // Something behind the box's closest point can be seen through this texel
+            if (levelDepths[static_cast<size_t>(y) * levelWidth + x] <= biasedClosestDepth)
+                return true;
+        }
+    }
+
+    _occludedCount++;
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+
+#include "GLM/glm.hpp"
+
+class ThreadPool;
+
+/// <summary> An axis aligned box in world space, fully solid, used to hide what is behind it (see OcclusionCuller). </summary>
+struct OccluderBox
+{
+    glm::vec3 Minimum = glm::vec3(0.0f);
+    glm::vec3 Maximum = glm::vec3(0.0f);
+};
+
+/// <summary>
+/// Software occlusion culling : the occluders are rasterized on the CPU inside a low resolution depth buffer,
+/// then the boxes to test (e.g. the chunks' bounds) are compared against a depth pyramid (HiZ) built from it.
+///
+/// <para> <b> Usage (once per frame) : </b> BeginFrame() -> AddOccluder() for each occluder -> RasterizeOccluders() -> IsVisible() for each box. </para>
+///
+/// <para> The depth buffer stores 1 / w (w = the distance along the camera's forward axis) : it's linear in screen space and precise far away.
+/// 0 means nothing was drawn (infinitely far). </para>
+/// <para> The rows are split into bands rasterized in parallel, 4 pixels at a time with SSE2 (when available). </para>
+/// <para> Purely CPU, no OpenGL is used. </para> </summary>
+class OcclusionCuller
+{
+
+private:
+
+    /// <summary> A triangle projected on the screen, with its edge functions and its depth plane (1 / w = DepthA * x + DepthB * y + DepthC). </summary>
+    struct ScreenTriangle
+    {
+        float EdgeA[3];
+        float EdgeB[3];
+        float EdgeC[3];
+
+        float DepthA;
+        float DepthB;
+        float DepthC;
+
+        // The pixels to go through (already clamped to the screen)
+        int MinimumX;
+        int MaximumX;
+        int MinimumY;
+        int MaximumY;
+    };
+
+    int _width;
+    int _height;
+
+    ThreadPool* _threadPool;
+    int _bandCount;
+
+    // - Current frame - //
+
+    glm::mat4 _viewProjectionMatrix;
+    glm::dvec3 _cameraPosition;
+
+    std::vector<ScreenTriangle> _triangles;
+
+    // The level 0 is the depth buffer, each next level keeps the farthest depth (the smallest 1 / w) of 2x2 texels of the previous one
+    std::vector<std::vector<float>> _depthPyramid;
+    std::vector<glm::ivec2> _depthPyramidSizes;
+
+    // - Statistics of the current frame - //
+
+    unsigned int _occluderCount;
+    unsigned int _testedCount;
+    unsigned int _occludedCount;
+    unsigned int _outsideFrustumCount;
+    double _rasterizationMilliseconds;
+
+public:
+
+    /// <param name = "p_width"> The depth buffer width, rounded up to a multiple of 4 (the SIMD width) </param>
+    /// <param name = "p_threadCount"> The number of worker threads, 0 = the number of hardware threads - 1 (the main thread rasterizes a band too) </param>
+    OcclusionCuller(int p_width, int p_height, unsigned int p_threadCount = 0);
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    /// <summary> Changes the depth buffer resolution (a lower one is faster but hides less). </summary>
+    void SetResolution(int p_width, int p_height);
+
+    int GetWidth() const { return _width; }
+    int GetHeight() const { return _height; }
+
+    /// <summary> Removes the occluders of the last frame and resets the statistics. </summary>
+    /// <param name = "p_cameraRelativeViewProjectionMatrix"> The projection and the camera rotation only, the positions are made relative to p_cameraPosition (in double precision) </param>
+    void BeginFrame(const glm::mat4& p_cameraRelativeViewProjectionMatrix, const glm::dvec3& p_cameraPosition);
+
+    /// <summary> Projects the faces of the given box (world space), it must be fully solid. </summary>
+    void AddOccluder(const OccluderBox& p_occluderBox);
+
+    /// <summary> Rasterizes the added occluders (multithreaded) and builds the depth pyramid. </summary>
+    void RasterizeOccluders();
+
+    /// <summary> Returns false if the given box (world space) is fully hidden by the occluders or outside the screen. Conservative : when unsure it's visible. </summary>
+    bool IsVisible(const glm::vec3& p_minimum, const glm::vec3& p_maximum);
+
+    unsigned int GetOccluderCount() const { return _occluderCount; }
+    unsigned int GetOccluderTriangleCount() const { return static_cast<unsigned int>(_triangles.size()); }
+    unsigned int GetTestedCount() const { return _testedCount; }
+    unsigned int GetOccludedCount() const { return _occludedCount; }
+    unsigned int GetOutsideFrustumCount() const { return _outsideFrustumCount; }
+    double GetRasterizationMilliseconds() const { return _rasterizationMilliseconds; }
+
+private:
+
+    /// <summary> Projects a world position, returns false if it's behind the near plane (x, y = pixels, z = 1 / w). </summary>
+    bool ProjectToScreen(const glm::dvec3& p_worldPosition, glm::vec3& p_outScreenPosition) const;
+
+    void AddTriangle(const glm::vec3& p_vertex1, const glm::vec3& p_vertex2, const glm::vec3& p_vertex3);
+
+    /// <summary> Rasterizes all the triangles, only inside the rows [p_firstRow, p_lastRow[. </summary>
+    void RasterizeBand(int p_firstRow, int p_lastRow);
+
+    void BuildDepthPyramid();
+};
\ No newline at end of file
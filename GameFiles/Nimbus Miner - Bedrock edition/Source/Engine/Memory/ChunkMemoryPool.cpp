@@ -0,0 +1,209 @@
+#include "ChunkMemoryPool.h"
+
+#include <algorithm>
+#include <new>
+#include <sstream>
+
+#if defined(_WIN32)
+    #include <Windows.h>
+#elif defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+#include "GLM/glm.hpp"
+
+#include "ProjectConstants.h"
+#include "MessageDebugger/MessageDebugger.h"
+
+// Defining static variables
+std::mutex ChunkMemoryPool::_mutex;
+std::atomic<size_t> ChunkMemoryPool::_slabByteSize(0);
+
+std::vector<void*> ChunkMemoryPool::_freeSlabs;
+size_t ChunkMemoryPool::_reservedByteSize = 0;
+size_t ChunkMemoryPool::_reservedSlabCount = 0;
+
+std::atomic<size_t> ChunkMemoryPool::_usedSlabCount(0);
+std::atomic<unsigned long long> ChunkMemoryPool::_allocationCount(0);
+std::atomic<unsigned long long> ChunkMemoryPool::_threadCacheHitCount(0);
+std::atomic<unsigned long long> ChunkMemoryPool::_oversizedAllocationCount(0);
+
+thread_local ChunkMemoryPool::ThreadCache ChunkMemoryPool::_threadCache;
+
+// All the slabs are aligned on a cache line, so two slabs never share one
+static constexpr size_t SLAB_ALIGNMENT = 64;
+
+ChunkMemoryPool::ThreadCache::~ThreadCache()
+{
+    if (SlabCount == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _freeSlabs.insert(_freeSlabs.end(), Slabs, Slabs + SlabCount);
+    SlabCount = 0;
+}
+
+void ChunkMemoryPool::Init(const size_t p_slabByteSize)
+{
+    // Rounding up to the alignment, so all the slabs of a region stay aligned
+    const size_t slabByteSize = (p_slabByteSize + SLAB_ALIGNMENT - 1) / SLAB_ALIGNMENT * SLAB_ALIGNMENT;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_slabByteSize == 0)
+    {
+        _slabByteSize = slabByteSize;
+        return;
+    }
+
+    if (_slabByteSize != slabByteSize)
+    {
+        std::stringstream warningMessage;
+        warningMessage << "The ChunkMemoryPool is already initialized with slabs of " << _slabByteSize
+        << " bytes, the new size (" << slabByteSize << " bytes) is ignored. The bigger allocations will use the normal heap";
+
+        PRINT_WARNING_RUNTIME(true, warningMessage.str())
+    }
+}
+
+void* ChunkMemoryPool::AllocateSlab(const size_t p_byteSize)
+{
+    if (_slabByteSize == 0)
+        Init(p_byteSize);
+
+    _allocationCount++;
+
+    if (p_byteSize > _slabByteSize)
+    {
+        _oversizedAllocationCount++;
+        return ::operator new(p_byteSize);
+    }
+
+    _usedSlabCount++;
+
+    // - Fast path : the thread cache, no lock needed - //
+
+    if (_threadCache.SlabCount > 0)
+    {
+        _threadCacheHitCount++;
+        return _threadCache.Slabs[--_threadCache.SlabCount];
+    }
+
+    // - Slow path : taking several slabs from the pool at once, so the next allocations use the cache - //
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_freeSlabs.empty())
+        ReserveRegion();
+
+    while (_threadCache.SlabCount < THREAD_CACHE_SLAB_COUNT / 2 && _freeSlabs.size() > 1)
+    {
+        _threadCache.Slabs[_threadCache.SlabCount++] = _freeSlabs.back();
+        _freeSlabs.pop_back();
+    }
+
+    void* slab = _freeSlabs.back();
+    _freeSlabs.pop_back();
+
+    return slab;
+}
+
+void ChunkMemoryPool::FreeSlab(void* p_slab, const size_t p_byteSize)
+{
+    if (p_slab == nullptr)
+        return;
+
+    if (p_byteSize > _slabByteSize)
+    {
+        ::operator delete(p_slab);
+        return;
+    }
+
+    _usedSlabCount--;
+
+    if (_threadCache.SlabCount < THREAD_CACHE_SLAB_COUNT)
+    {
+        _threadCache.Slabs[_threadCache.SlabCount++] = p_slab;
+        return;
+    }
+
+    // The cache is full, we give back half of it to the pool (so the other threads can use the slabs)
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _freeSlabs.push_back(p_slab);
+
+    while (_threadCache.SlabCount > THREAD_CACHE_SLAB_COUNT / 2)
+        _freeSlabs.push_back(_threadCache.Slabs[--_threadCache.SlabCount]);
+}
+
+ChunkMemoryPool::Statistics ChunkMemoryPool::GetStatistics()
+{
+    Statistics statistics;
+
+    statistics.SlabByteSize = _slabByteSize;
+    statistics.UsedSlabCount = _usedSlabCount;
+    statistics.AllocationCount = _allocationCount;
+    statistics.ThreadCacheHitCount = _threadCacheHitCount;
+    statistics.OversizedAllocationCount = _oversizedAllocationCount;
+
+    #if defined(__linux__)
+        statistics.AreHugePagesRequested = true;
+    #endif
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    statistics.ReservedByteSize = _reservedByteSize;
+    statistics.ReservedSlabCount = _reservedSlabCount;
+
+    return statistics;
+}
+
+void ChunkMemoryPool::ReserveRegion()
+{
+    const size_t slabByteSize = _slabByteSize;
+
+    // A region contains at least one slab, even if the slabs are bigger than the default region size
+    const size_t slabCount = std::max<size_t>(1, CHUNK_MEMORY_POOL_REGION_BYTE_SIZE / slabByteSize);
+    const size_t regionByteSize = slabCount * slabByteSize;
+
+    unsigned char* regionMemory = static_cast<unsigned char*>(ReserveSystemMemory(regionByteSize));
+
+    _reservedByteSize += regionByteSize;
+    _reservedSlabCount += slabCount;
+
+    // NOTE : Pushed in reverse order, so the slabs are given from the beginning of the region
+    for (size_t i = slabCount; i > 0; --i)
+        _freeSlabs.push_back(regionMemory + (i - 1) * slabByteSize);
+}
+
+void* ChunkMemoryPool::ReserveSystemMemory(const size_t p_byteSize)
+{
+    #if defined(_WIN32)
+
+        // NOTE : Large pages on Windows need the "Lock pages in memory" privilege, so we only ask for normal pages
+        void* memory = VirtualAlloc(nullptr, p_byteSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+        if (memory == nullptr)
+            throw std::bad_alloc();
+
+        return memory;
+
+    #elif defined(__linux__)
+
+        void* memory = mmap(nullptr, p_byteSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (memory == MAP_FAILED)
+            throw std::bad_alloc();
+
+        // Only a hint, the kernel can ignore it (the transparent huge pages can be disabled)
+        madvise(memory, p_byteSize, MADV_HUGEPAGE);
+
+        return memory;
+
+    #else
+
+        return ::operator new(p_byteSize);
+
+    #endif
+}
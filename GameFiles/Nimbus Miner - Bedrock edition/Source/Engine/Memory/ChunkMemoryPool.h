@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/// <summary>
+/// Fixed-size slabs allocator used for the chunks payloads (the blocks and the occupancy of ChunkVoxelData).
+///
+/// <para> All the slabs have the same size, so a freed slab can always be re-used by the next chunk without fragmenting the heap. </para>
+/// <para> The memory is asked to the system by big regions (with transparent huge pages on Linux), and is never given back
+/// before the end of the program : the pool grows to the peak usage then stays there. </para>
+/// <para> Each thread keeps a few free slabs in its own cache, so the worker threads don't fight over the pool mutex. </para>
+///
+/// <para> It is thread safe. </para> </summary>
+class ChunkMemoryPool
+{
+
+public:
+
+    /// <summary> The number of free slabs a thread can keep for itself before giving them back to the pool. </summary>
+    static constexpr int THREAD_CACHE_SLAB_COUNT = 16;
+
+    struct Statistics
+    {
+        size_t SlabByteSize = 0;
+
+        /// <summary> The memory asked to the system (used and free slabs). </summary>
+        size_t ReservedByteSize = 0;
+        size_t ReservedSlabCount = 0;
+        size_t UsedSlabCount = 0;
+
+        unsigned long long AllocationCount = 0;
+
+        /// <summary> The allocations that did not need to lock the pool (the slab came from the thread cache). </summary>
+        unsigned long long ThreadCacheHitCount = 0;
+
+        /// <summary> The allocations bigger than a slab, they are given to the normal heap. </summary>
+        unsigned long long OversizedAllocationCount = 0;
+
+        bool AreHugePagesRequested = false;
+    };
+
+private:
+
+    /// <summary> The free slabs of one thread, given back to the pool when the thread ends. </summary>
+    struct ThreadCache
+    {
+        void* Slabs[THREAD_CACHE_SLAB_COUNT];
+        int SlabCount = 0;
+
+        ~ThreadCache();
+    };
+
+    static std::mutex _mutex;
+
+    // 0 until Init() is called
+    static std::atomic<size_t> _slabByteSize;
+
+    // - Protected by the _mutex - //
+
+    static std::vector<void*> _freeSlabs;
+    static size_t _reservedByteSize;
+    static size_t _reservedSlabCount;
+
+    // - Statistics - //
+
+    static std::atomic<size_t> _usedSlabCount;
+    static std::atomic<unsigned long long> _allocationCount;
+    static std::atomic<unsigned long long> _threadCacheHitCount;
+    static std::atomic<unsigned long long> _oversizedAllocationCount;
+
+    static thread_local ThreadCache _threadCache;
+
+public:
+
+    /// <summary>
+    /// Sets the size of all the slabs, can only be done once (the next calls are ignored with a warning if the size is different).
+    /// <para> If Init() is never called, the first AllocateSlab() call sets the slabs size. </para> </summary>
+    static void Init(const size_t p_slabByteSize);
+
+    /// <summary> Returns a memory block of at least 'p_byteSize' bytes, aligned on 64 bytes (a cache line). </summary>
+    static void* AllocateSlab(const size_t p_byteSize);
+
+    /// <summary> Gives back a memory block returned by AllocateSlab(), 'p_byteSize' must be the size given to AllocateSlab(). </summary>
+    static void FreeSlab(void* p_slab, const size_t p_byteSize);
+
+    static size_t GetSlabByteSize() { return _slabByteSize; }
+
+    static Statistics GetStatistics();
+
+private:
+
+    /// <summary> Asks a new region to the system and cuts it into free slabs. <b> The _mutex must be locked. </b> </summary>
+    static void ReserveRegion();
+
+    static void* ReserveSystemMemory(const size_t p_byteSize);
+};
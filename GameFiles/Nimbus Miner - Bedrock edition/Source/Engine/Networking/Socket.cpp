@@ -0,0 +1,284 @@
+#include "Socket.h"
+
+#include <climits>
+#include <sstream>
+
+#if defined(_WIN32)
+    // NOTE : Before any header including Windows.h, it would include the old winsock.h otherwise
+    #include <WinSock2.h>
+    #include <WS2tcpip.h>
+
+    #pragma comment(lib, "Ws2_32.lib")
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+#include "MessageDebugger/MessageDebugger.h"
+
+// The number of connections the system keeps waiting until the server accepts them
+static constexpr int LISTEN_BACKLOG = 16;
+
+Socket::Socket()
+{
+    // Initialising class' variables
+    _handle = INVALID_HANDLE;
+}
+
+Socket::~Socket()
+{
+    Close();
+}
+
+Socket::Socket(Socket&& p_other) noexcept
+{
+    _handle = p_other._handle;
+    p_other._handle = INVALID_HANDLE;
+}
+
+Socket& Socket::operator=(Socket&& p_other) noexcept
+{
+    if (this != &p_other)
+    {
+        Close();
+
+        _handle = p_other._handle;
+        p_other._handle = INVALID_HANDLE;
+    }
+
+    return *this;
+}
+
+bool Socket::Listen(const unsigned short p_port)
+{
+    Close();
+
+    if (!InitializeSockets())
+        return false;
+
+    #if defined(_WIN32)
+        const SOCKET handle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        _handle = handle == INVALID_SOCKET ? INVALID_HANDLE : static_cast<intptr_t>(handle);
+    #else
+        _handle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+        // A restarted server can listen again right away (the connections of the previous one may still be closing)
+        if (_handle != INVALID_HANDLE)
+        {
+            const int isReused = 1;
+            setsockopt(static_cast<int>(_handle), SOL_SOCKET, SO_REUSEADDR, &isReused, sizeof(isReused));
+        }
+    #endif
+
+    // NOTE : Only the loopback interface, the server must not be reachable from the network
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(p_port);
+
+    #if defined(_WIN32)
+        const bool isListening = _handle != INVALID_HANDLE &&
+            bind(static_cast<SOCKET>(_handle), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 &&
+            listen(static_cast<SOCKET>(_handle), LISTEN_BACKLOG) == 0;
+    #else
+        const bool isListening = _handle != INVALID_HANDLE &&
+            bind(static_cast<int>(_handle), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 &&
+            listen(static_cast<int>(_handle), LISTEN_BACKLOG) == 0;
+    #endif
+
+    if (!isListening || !ConfigureHandle())
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Can't listen on the port " << p_port << " (it may be used by another program)";
+
+        PRINT_ERROR_RUNTIME(true, errorMessage.str())
+
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool Socket::Connect(const unsigned short p_port)
+{
+    Close();
+
+    if (!InitializeSockets())
+        return false;
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(p_port);
+
+    // NOTE : Connected while still blocking, the loopback connections are made right away
+    #if defined(_WIN32)
+        const SOCKET handle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        _handle = handle == INVALID_SOCKET ? INVALID_HANDLE : static_cast<intptr_t>(handle);
+
+        const bool isConnected = _handle != INVALID_HANDLE &&
+            connect(static_cast<SOCKET>(_handle), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    #else
+        _handle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+        const bool isConnected = _handle != INVALID_HANDLE &&
+            connect(static_cast<int>(_handle), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    #endif
+
+    if (!isConnected || !ConfigureHandle())
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool Socket::Accept(Socket& p_outSocket) const
+{
+    if (!IsOpen())
+        return false;
+
+    #if defined(_WIN32)
+        const SOCKET handle = accept(static_cast<SOCKET>(_handle), nullptr, nullptr);
+
+        if (handle == INVALID_SOCKET)
+            return false;
+
+        p_outSocket.Close();
+        p_outSocket._handle = static_cast<intptr_t>(handle);
+    #else
+        const int handle = accept(static_cast<int>(_handle), nullptr, nullptr);
+
+        if (handle < 0)
+            return false;
+
+        p_outSocket.Close();
+        p_outSocket._handle = handle;
+    #endif
+
+    if (!p_outSocket.ConfigureHandle())
+    {
+        p_outSocket.Close();
+        return false;
+    }
+
+    return true;
+}
+
+long long Socket::Send(const uint8_t* p_bytes, const size_t p_byteCount) const
+{
+    if (!IsOpen())
+        return -1;
+
+    if (p_byteCount == 0)
+        return 0;
+
+    #if defined(_WIN32)
+        const int sentByteCount = send(static_cast<SOCKET>(_handle), reinterpret_cast<const char*>(p_bytes),
+            static_cast<int>(p_byteCount > INT_MAX ? INT_MAX : p_byteCount), 0);
+
+        if (sentByteCount == SOCKET_ERROR)
+            return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+    #else
+        // NOTE : Without MSG_NOSIGNAL a closed connection stops the whole process (SIGPIPE)
+        #if defined(MSG_NOSIGNAL)
+            const int flags = MSG_NOSIGNAL;
+        #else
+            const int flags = 0;
+        #endif
+
+        const ssize_t sentByteCount = send(static_cast<int>(_handle), p_bytes, p_byteCount, flags);
+
+        if (sentByteCount < 0)
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : -1;
+    #endif
+
+    return static_cast<long long>(sentByteCount);
+}
+
+long long Socket::Receive(uint8_t* p_outBytes, const size_t p_byteCapacity) const
+{
+    if (!IsOpen())
+        return -1;
+
+    #if defined(_WIN32)
+        const int receivedByteCount = recv(static_cast<SOCKET>(_handle), reinterpret_cast<char*>(p_outBytes),
+            static_cast<int>(p_byteCapacity > INT_MAX ? INT_MAX : p_byteCapacity), 0);
+
+        if (receivedByteCount == SOCKET_ERROR)
+            return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+    #else
+        const ssize_t receivedByteCount = recv(static_cast<int>(_handle), p_outBytes, p_byteCapacity, 0);
+
+        if (receivedByteCount < 0)
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : -1;
+    #endif
+
+    // NOTE : 0 bytes means the other side closed the connection
+    if (receivedByteCount == 0)
+        return -1;
+
+    return static_cast<long long>(receivedByteCount);
+}
+
+void Socket::Close()
+{
+    if (!IsOpen())
+        return;
+
+    #if defined(_WIN32)
+        closesocket(static_cast<SOCKET>(_handle));
+    #else
+        close(static_cast<int>(_handle));
+    #endif
+
+    _handle = INVALID_HANDLE;
+}
+
+bool Socket::ConfigureHandle() const
+{
+    const int isNoDelay = 1;
+
+    #if defined(_WIN32)
+        u_long isNonBlocking = 1;
+
+        if (ioctlsocket(static_cast<SOCKET>(_handle), FIONBIO, &isNonBlocking) != 0)
+            return false;
+
+        setsockopt(static_cast<SOCKET>(_handle), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&isNoDelay), sizeof(isNoDelay));
+    #else
+        const int flags = fcntl(static_cast<int>(_handle), F_GETFL, 0);
+
+        if (flags < 0 || fcntl(static_cast<int>(_handle), F_SETFL, flags | O_NONBLOCK) < 0)
+            return false;
+
+        setsockopt(static_cast<int>(_handle), IPPROTO_TCP, TCP_NODELAY, &isNoDelay, sizeof(isNoDelay));
+    #endif
+
+    return true;
+}
+
+bool Socket::InitializeSockets()
+{
+    #if defined(_WIN32)
+        // NOTE : Started once for the whole process (thread safe), never cleaned up : the system does it when the process ends
+        static const bool isInitialized = []()
+        {
+            WSADATA data;
+            return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+        }();
+
+        if (!isInitialized)
+            PRINT_ERROR_RUNTIME(true, "Winsock could not be started, the sockets can't be used")
+
+        return isInitialized;
+    #else
+        return true;
+    #endif
+}
\ No newline at end of file
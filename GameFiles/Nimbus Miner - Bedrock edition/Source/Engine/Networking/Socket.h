@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// A TCP connection (or a listening socket) on the loopback interface, used between the world server and its clients
+/// (see WorldServer and WorldClient).
+///
+/// <para> The sockets are non-blocking : Send() and Receive() only do what can be done right away, and return 0 when they have to wait.
+/// Nagle's algorithm is disabled, the small messages (the block edits) are sent right away. </para>
+/// <para> The listening sockets only accept the connections of the same machine, the server is never reachable from the network. </para>
+/// <para> Windows sockets (Winsock 2) on Windows, BSD sockets anywhere else. A Socket must only be used by one thread at a time. </para> </summary>
+class Socket
+{
+
+private:
+
+    // NOTE : A SOCKET on Windows (an unsigned pointer-sized integer), a file descriptor anywhere else
+    intptr_t _handle;
+
+public:
+
+    static constexpr intptr_t INVALID_HANDLE = -1;
+
+    /// <summary> Creates a closed socket, see Listen(), Connect() and Accept(). </summary>
+    Socket();
+    ~Socket();
+
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+
+    Socket(Socket&& p_other) noexcept;
+    Socket& operator=(Socket&& p_other) noexcept;
+
+    /// <summary> Starts listening on the loopback interface, returns false if the port can't be used (an error is printed). </summary>
+    bool Listen(const unsigned short p_port);
+
+    /// <summary> Connects to a listening socket of the same machine (waits for the connection), returns false if nobody listens on the port. </summary>
+    bool Connect(const unsigned short p_port);
+
+    /// <summary> Gives the next waiting connection to p_outSocket, returns false if there is none. </summary>
+    bool Accept(Socket& p_outSocket) const;
+
+    /// <summary> Returns the number of bytes sent (0 if the system buffer is full), or -1 if the connection is lost. </summary>
+    long long Send(const uint8_t* p_bytes, const size_t p_byteCount) const;
+
+    /// <summary> Returns the number of bytes received (0 if none arrived yet), or -1 if the connection is closed or lost. </summary>
+    long long Receive(uint8_t* p_outBytes, const size_t p_byteCapacity) const;
+
+    void Close();
+
+    bool IsOpen() const { return _handle != INVALID_HANDLE; }
+
+private:
+
+    /// <summary> Makes the socket non-blocking and disables Nagle's algorithm. </summary>
+    bool ConfigureHandle() const;
+
+    /// <summary> Starts Winsock the first time a socket is created (nothing on the other systems). </summary>
+    static bool InitializeSockets();
+};
\ No newline at end of file
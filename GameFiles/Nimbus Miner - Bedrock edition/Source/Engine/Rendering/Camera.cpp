@@ -45,6 +45,18 @@ void Camera::SetRotationSensitivity(float p_rotationSensitivity)
     _rotationSensitivity = p_rotationSensitivity;
 }
 
+void Camera::SetRotation(const float p_yaw, float p_pitch)
+{
+    // We clamp the vertical view to avoid camera flipping
+    if (p_pitch > 89.0f) p_pitch = 89.0f;
+    if (p_pitch < -89.0f) p_pitch = -89.0f;
+
+    _yaw = p_yaw;
+    _pitch = p_pitch;
+
+    UpdateCameraDirectionVariables();
+}
+
 #pragma endregion
 
 void Camera::ProcessKeyboardMovement(CameraMovementDirectionsEnum p_direction)
@@ -54,11 +66,11 @@ void Camera::ProcessKeyboardMovement(CameraMovementDirectionsEnum p_direction)
     switch (p_direction)
     {
     case Forward:
-        _position += _frontDirection * velocity;
+        _position += glm::dvec3(_frontDirection * velocity);
         break;
 
     case Backward:
-        _position -= _frontDirection * velocity;
+        _position -= glm::dvec3(_frontDirection * velocity);
         break;
 
     case Upward:
@@ -70,11 +82,11 @@ void Camera::ProcessKeyboardMovement(CameraMovementDirectionsEnum p_direction)
         break;
 
     case Leftward:
-        _position -= _rightDirection * velocity;
+        _position -= glm::dvec3(_rightDirection * velocity);
         break;
 
     case Rightward:
-        _position += _rightDirection * velocity;
+        _position += glm::dvec3(_rightDirection * velocity);
         break;
 
     default:
@@ -100,7 +112,15 @@ void Camera::ProcessMouseMovement(float p_xOffset, float p_yOffset)
 
 glm::mat4 Camera::GetViewMatrix() const
 {
-    return glm::lookAt(_position, _position + _frontDirection, _upDirection);
+    const glm::vec3 position = glm::vec3(_position);
+
+    return glm::lookAt(position, position + _frontDirection, _upDirection);
+}
+
+glm::mat4 Camera::GetRotationViewMatrix() const
+{
+    // The camera is at the origin of the camera relative space
+    return glm::lookAt(glm::vec3(0.0f), _frontDirection, _upDirection);
 }
 
 void Camera::UpdateCameraDirectionVariables()
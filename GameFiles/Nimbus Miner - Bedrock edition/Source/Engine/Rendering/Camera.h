@@ -24,7 +24,8 @@ public:
     
 private:
     
-    glm::vec3 _position;
+    // NOTE : Double precision, so the camera does not jitter far from the world origin (see GetRotationViewMatrix())
+    glm::dvec3 _position;
 
     float _movementSpeed;
     float _rotationSensitivity;
@@ -52,14 +53,28 @@ public:
     void SetMovementSpeed(float p_movementSpeed);
     void SetRotationSensitivity(float p_rotationSensitivity);
 
+    float GetYaw() const { return _yaw; }
+    float GetPitch() const { return _pitch; }
+
+    void SetPosition(const glm::dvec3& p_position) { _position = p_position; }
+
+    /// <summary> Sets the camera orientation directly (in degrees), the pitch is clamped like with the mouse. </summary>
+    void SetRotation(float p_yaw, float p_pitch);
+
     #pragma endregion
     
     void ProcessKeyboardMovement(CameraMovementDirectionsEnum p_direction);
     void ProcessMouseMovement(float p_xOffset, float p_yOffset);
 
+    /// <summary> The full view matrix (rotation and translation), in single precision : only for the objects close to the world origin. </summary>
     glm::mat4 GetViewMatrix() const;
 
-    glm::vec3 GetPosition() const { return _position; }
+    /// <summary>
+    /// The view matrix without the translation : the objects must be placed relative to the camera (their position minus GetPosition(),
+    /// computed in double precision), that way the float precision does not depend on the distance to the world origin. </summary>
+    glm::mat4 GetRotationViewMatrix() const;
+
+    glm::dvec3 GetPosition() const { return _position; }
     
 private:
 
@@ -0,0 +1,57 @@
+#include "FrameBufferObject.h"
+
+#include <GL/glew.h>
+
+FrameBufferObject::FrameBufferObject(const int p_width, const int p_height)
+{
+    _width = p_width;
+    _height = p_height;
+
+    glGenFramebuffers(1, &_frameBufferObjectID);
+    glBindFramebuffer(GL_FRAMEBUFFER, _frameBufferObjectID);
+
+    // - Color buffer - //
+
+    // NOTE : We use render buffers and not textures because we never read the result back in a shader
+    glGenRenderbuffers(1, &_colorRenderBufferID);
+    glBindRenderbuffer(GL_RENDERBUFFER, _colorRenderBufferID);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, _width, _height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _colorRenderBufferID);
+
+    // - Depth buffer - //
+
+    glGenRenderbuffers(1, &_depthRenderBufferID);
+    glBindRenderbuffer(GL_RENDERBUFFER, _depthRenderBufferID);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, _width, _height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, _depthRenderBufferID);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+FrameBufferObject::~FrameBufferObject()
+{
+    glDeleteRenderbuffers(1, &_colorRenderBufferID);
+    glDeleteRenderbuffers(1, &_depthRenderBufferID);
+    glDeleteFramebuffers(1, &_frameBufferObjectID);
+}
+
+void FrameBufferObject::Bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, _frameBufferObjectID);
+    glViewport(0, 0, _width, _height);
+}
+
+void FrameBufferObject::Unbind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+bool FrameBufferObject::IsComplete() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, _frameBufferObjectID);
+    const bool isComplete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return isComplete;
+}
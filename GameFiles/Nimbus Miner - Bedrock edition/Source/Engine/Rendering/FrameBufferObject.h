@@ -0,0 +1,38 @@
+#pragma once
+
+/// <summary>
+/// A FBO (Frame Buffer Object)
+///
+/// <para> An off-screen render target, everything drawn while it's bound goes into its own color and depth buffers
+/// instead of the window. </para>
+///
+/// <para> Used by the benchmark mode, because the window is hidden and the pixels of a hidden window
+/// are not guaranteed to be rendered by the driver (they fail the pixel ownership test). </para> </summary>
+class FrameBufferObject
+{
+
+private:
+
+    unsigned int _frameBufferObjectID;
+    unsigned int _colorRenderBufferID;
+    unsigned int _depthRenderBufferID;
+
+    int _width;
+    int _height;
+
+public:
+
+    /// <summary> Creates a FBO with a RGBA8 color buffer and a 24 bits depth buffer of the given size (in pixels). </summary>
+    FrameBufferObject(const int p_width, const int p_height);
+    ~FrameBufferObject();
+
+    /// <summary> Binds the FBO and changes the viewport to its size. </summary>
+    void Bind() const;
+    void Unbind() const;
+
+    /// <summary> Returns true if the driver accepted the FBO configuration. </summary>
+    bool IsComplete() const;
+
+    inline int GetWidth() const { return _width; }
+    inline int GetHeight() const { return _height; }
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "GLM/glm.hpp"
+
+/// <summary>
+/// Per-frame camera data, uploaded once per frame inside a UniformBufferObject and read by every shader through the 'FrameData' uniform block.
+///
+/// <para> The layout mirrors the std140 'FrameData' block declared in the shaders, only mat4 and vec4 are used so there is no hidden padding. </para> </summary>
+struct FrameUniformData
+{
+    // The binding point shared by the UBO and the 'FrameData' uniform block of every shader
+    static const unsigned int BindingPoint = 0;
+
+    glm::mat4 ViewMatrix = glm::mat4(1.0f);
+    glm::mat4 ProjectionMatrix = glm::mat4(1.0f);
+    glm::mat4 ViewProjectionMatrix = glm::mat4(1.0f);
+
+    // Projection and camera rotation only (see Camera::GetRotationViewMatrix()), used by the camera relative chunks
+    glm::mat4 CameraRelativeViewProjectionMatrix = glm::mat4(1.0f);
+
+    // xyz = camera position (w unused)
+    glm::vec4 CameraPosition = glm::vec4(0.0f);
+
+    // x = time since the start (in seconds), y = delta time (in seconds)
+    glm::vec4 Time = glm::vec4(0.0f);
+};
+
+static_assert(sizeof(FrameUniformData) == 4 * sizeof(glm::mat4) + 2 * sizeof(glm::vec4), "FrameUniformData has to match the std140 'FrameData' uniform block");
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "GpuTimer.h"
+
+#include <GL/glew.h>
+
+GpuTimer::GpuTimer()
+{
+    // Initialising class' variables
+    _currentQueryIndex = 0;
+    _nextFrameNumber = 0;
+    _lastMilliseconds = 0.0;
+    _lastFrameNumber = -1;
+    _isSupported = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+
+    for (long long& queryFrameNumber : _queryFrameNumbers)
+        queryFrameNumber = -1;
+
+    if (_isSupported)
+        glGenQueries(QUERY_COUNT, _queryIDs);
+}
+
+GpuTimer::~GpuTimer()
+{
+    if (_isSupported)
+        glDeleteQueries(QUERY_COUNT, _queryIDs);
+}
+
+void GpuTimer::Begin()
+{
+    if (!_isSupported)
+        return;
+
+    // NOTE : If the GPU is late the oldest query is simply reused, its result is lost
+    _queryFrameNumbers[_currentQueryIndex] = _nextFrameNumber++;
+
+    glBeginQuery(GL_TIME_ELAPSED, _queryIDs[_currentQueryIndex]);
+}
+
+void GpuTimer::End()
+{
+    if (!_isSupported)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+
+    _currentQueryIndex = (_currentQueryIndex + 1) % QUERY_COUNT;
+}
+
+void GpuTimer::ReadResults()
+{
+    if (!_isSupported)
+        return;
+
+    // The oldest query is the current one in the ring (the next one to be reused)
+    for (int i = 0; i < QUERY_COUNT; ++i)
+    {
+        const int queryIndex = (_currentQueryIndex + i) % QUERY_COUNT;
+
+        if (_queryFrameNumbers[queryIndex] < 0)
+            continue;
+
+        GLint isResultAvailable = GL_FALSE;
+        glGetQueryObjectiv(_queryIDs[queryIndex], GL_QUERY_RESULT_AVAILABLE, &isResultAvailable);
+
+        // The next queries were sent after this one, they are not finished either
+        if (isResultAvailable == GL_FALSE)
+            return;
+
+        GLuint64 elapsedNanoseconds = 0;
+        glGetQueryObjectui64v(_queryIDs[queryIndex], GL_QUERY_RESULT, &elapsedNanoseconds);
+
+        _lastMilliseconds = static_cast<double>(elapsedNanoseconds) / 1000000.0;
+        _lastFrameNumber = _queryFrameNumbers[queryIndex];
+        _queryFrameNumbers[queryIndex] = -1;
+    }
+}
\ No newline at end of file
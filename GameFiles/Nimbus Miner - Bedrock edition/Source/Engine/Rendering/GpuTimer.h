@@ -0,0 +1,52 @@
+#pragma once
+
+/// <summary>
+/// Measures the time the GPU spends on the commands sent between Begin() and End() (GL_TIME_ELAPSED timer query), once per frame.
+///
+/// <para> Like the OverdrawCounter, the results are read a few frames later so the CPU never waits for the GPU :
+/// ReadResults() gives the time of the last finished frame and its number. After a glFinish() the frame just ended is finished too. </para>
+///
+/// <para> Does nothing without timer queries (OpenGL 3.3 or the ARB_timer_query extension), see IsSupported(). </para> </summary>
+class GpuTimer
+{
+
+private:
+
+    // The number of frames a query has to finish before we need its result
+    static const int QUERY_COUNT = 3;
+
+    unsigned int _queryIDs[QUERY_COUNT];
+
+    // NOTE : -1 when the query has no pending result, the frame number it measures otherwise
+    long long _queryFrameNumbers[QUERY_COUNT];
+
+    int _currentQueryIndex;
+    long long _nextFrameNumber;
+
+    double _lastMilliseconds;
+    long long _lastFrameNumber;
+
+    bool _isSupported;
+
+public:
+
+    GpuTimer();
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    /// <summary> Begins the measure of a new frame, the frames are numbered from 0 in the order of the Begin() calls. </summary>
+    void Begin();
+    void End();
+
+    /// <summary> Reads the finished queries (oldest first), the last one gives GetLastMilliseconds() and GetLastFrameNumber(). </summary>
+    void ReadResults();
+
+    double GetLastMilliseconds() const { return _lastMilliseconds; }
+
+    /// <summary> The frame of GetLastMilliseconds(), -1 until the first query is finished. </summary>
+    long long GetLastFrameNumber() const { return _lastFrameNumber; }
+
+    bool IsSupported() const { return _isSupported; }
+};
\ No newline at end of file
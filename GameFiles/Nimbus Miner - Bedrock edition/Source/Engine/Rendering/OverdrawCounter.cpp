@@ -0,0 +1,59 @@
+#include "OverdrawCounter.h"
+
+#include <GL/glew.h>
+
+OverdrawCounter::OverdrawCounter()
+{
+    // Initialising class' variables
+    _currentQueryIndex = 0;
+    _lastSamplesPassedCount = 0;
+    _hasResult = false;
+
+    glGenQueries(QUERY_COUNT, _queryIDs);
+
+    for (bool& isQueryIssued : _isQueryIssued)
+        isQueryIssued = false;
+}
+
+OverdrawCounter::~OverdrawCounter()
+{
+    glDeleteQueries(QUERY_COUNT, _queryIDs);
+}
+
+void OverdrawCounter::Begin()
+{
+    glBeginQuery(GL_SAMPLES_PASSED, _queryIDs[_currentQueryIndex]);
+}
+
+void OverdrawCounter::End()
+{
+    glEndQuery(GL_SAMPLES_PASSED);
+    _isQueryIssued[_currentQueryIndex] = true;
+
+    // The oldest query is the next one in the ring
+    _currentQueryIndex = (_currentQueryIndex + 1) % QUERY_COUNT;
+
+    if (!_isQueryIssued[_currentQueryIndex])
+        return;
+
+    GLint isResultAvailable = GL_FALSE;
+    glGetQueryObjectiv(_queryIDs[_currentQueryIndex], GL_QUERY_RESULT_AVAILABLE, &isResultAvailable);
+
+    // NOTE : If the GPU is late the query is simply reused, the last known result is kept
+    if (isResultAvailable == GL_FALSE)
+        return;
+
+    GLuint samplesPassedCount = 0;
+    glGetQueryObjectuiv(_queryIDs[_currentQueryIndex], GL_QUERY_RESULT, &samplesPassedCount);
+
+    _lastSamplesPassedCount = samplesPassedCount;
+    _hasResult = true;
+}
+
+double OverdrawCounter::GetOverdraw(const int p_pixelCount) const
+{
+    if (p_pixelCount <= 0)
+        return 0.0;
+
+    return static_cast<double>(_lastSamplesPassedCount) / p_pixelCount;
+}
\ No newline at end of file
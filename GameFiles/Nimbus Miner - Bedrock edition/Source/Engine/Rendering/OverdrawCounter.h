@@ -0,0 +1,44 @@
+#pragma once
+
+/// <summary>
+/// Counts the fragments that pass the depth test (GL_SAMPLES_PASSED occlusion query) between Begin() and End().
+///
+/// <para> Divided by the number of pixels it gives the overdraw : 1 = each pixel is shaded once,
+/// 2 = each pixel is shaded twice on average, etc... Drawing front to back lowers it (the hidden fragments are rejected by the early depth test). </para>
+///
+/// <para> The result is read a few frames later, so the CPU never waits for the GPU. </para> </summary>
+class OverdrawCounter
+{
+
+private:
+
+    // The number of frames a query has to finish before we need its result
+    static const int QUERY_COUNT = 3;
+
+    unsigned int _queryIDs[QUERY_COUNT];
+    bool _isQueryIssued[QUERY_COUNT];
+
+    int _currentQueryIndex;
+
+    unsigned long long _lastSamplesPassedCount;
+    bool _hasResult;
+
+public:
+
+    OverdrawCounter();
+    ~OverdrawCounter();
+
+    void Begin();
+    
+    /// <summary> Ends the current query, and reads the oldest one if the GPU finished it. </summary>
+    void End();
+
+    /// <summary> The samples passed during the last finished query (a few frames ago). </summary>
+    unsigned long long GetSamplesPassedCount() const { return _lastSamplesPassedCount; }
+
+    /// <summary> False until the first query is finished. </summary>
+    bool HasResult() const { return _hasResult; }
+
+    /// <summary> The average number of fragments shaded per pixel. </summary>
+    double GetOverdraw(int p_pixelCount) const;
+};
\ No newline at end of file
@@ -1,9 +1,28 @@
 #include "Renderer.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include "ProjectConstants.h"
 
+// Defining static variables
+unsigned int Renderer::_drawCallCount = 0;
+unsigned long long Renderer::_triangleCount = 0;
+unsigned long long Renderer::_culledTriangleCount = 0;
+
+unsigned int Renderer::_requestedBindCount = 0;
+unsigned int Renderer::_issuedBindCount = 0;
+
+std::vector<RenderQueueItem> Renderer::_renderQueue;
+std::vector<std::pair<uint64_t, unsigned int>> Renderer::_sortedRenderQueue;
+
+unsigned int Renderer::_boundShaderID = UNKNOWN_BINDING;
+unsigned int Renderer::_boundVertexArrayID = UNKNOWN_BINDING;
+unsigned int Renderer::_boundIndexBufferID = UNKNOWN_BINDING;
+unsigned int Renderer::_boundTexture2DID = UNKNOWN_BINDING;
+unsigned int Renderer::_boundTexture2DArrayID = UNKNOWN_BINDING;
+
 void Renderer::Clear()
 {
     glClearColor(BACKGROUND_COLOR.x, BACKGROUND_COLOR.y, BACKGROUND_COLOR.z, BACKGROUND_COLOR.w);
@@ -13,15 +32,229 @@ void Renderer::Clear()
 
 void Renderer::Draw(const VertexArrayObject& p_vertexArrayObject, const IndexBufferObject& p_indexBufferObject, const Shader& p_shader)
 {
+    // The caller may have bound things by itself, so every bind is done
+    InvalidateStateCache();
+    
     // Binding into the GPU the given data
-    p_vertexArrayObject.Bind();
-    p_indexBufferObject.Bind();
-    p_shader.Bind();
+    BindVertexArray(p_vertexArrayObject);
+    BindIndexBuffer(p_indexBufferObject);
+    BindShader(p_shader);
 
     glDrawElements(GL_TRIANGLES, p_indexBufferObject.GetIndexesCount(), GL_UNSIGNED_INT, nullptr);
     // We use nullptr because we already bind the indexBufferObjectID before
 
+    _drawCallCount++;
+    _triangleCount += p_indexBufferObject.GetIndexesCount() / 3;
+
     // NOTE :
     // If you want you can Unbind() the given data for debugging reason.
     // But always doing it, is a waste of resources because the next Draw will Bind() again (so the last data will be overridden)
+}
+
+#pragma region // -=- Render queue -=- //
+
+void Renderer::Submit(const RenderQueueItem& p_item)
+{
+    _renderQueue.push_back(p_item);
+}
+
+void Renderer::FlushQueue()
+{
+    if (_renderQueue.empty())
+        return;
+    
+    // - Sorting - //
+
+    // NOTE : Only the (key, index) pairs are sorted, the items are not moved
+    _sortedRenderQueue.clear();
+    _sortedRenderQueue.reserve(_renderQueue.size());
+    
+    for (unsigned int i = 0; i < static_cast<unsigned int>(_renderQueue.size()); ++i)
+        _sortedRenderQueue.emplace_back(ComputeSortKey(_renderQueue[i]), i);
+
+    if (!TryInsertionSortRenderQueue())
+        std::sort(_sortedRenderQueue.begin(), _sortedRenderQueue.end());
+
+    // - Drawing - //
+
+    // Since the last flush ImGui, Shader::Bind(), Texture::Bind(), etc... could have changed the bindings
+    InvalidateStateCache();
+
+    for (const std::pair<uint64_t, unsigned int>& sortedItem : _sortedRenderQueue)
+    {
+        const RenderQueueItem& item = _renderQueue[sortedItem.second];
+
+        BindShader(*item.RenderingShader);
+        
+        if (item.TextureID != 0)
+            BindTexture(item.TextureTarget, item.TextureID);
+        
+        BindVertexArray(*item.VertexArray);
+        BindIndexBuffer(*item.IndexBuffer);
+
+        // The shader is already bound, so the uniform can be set directly
+        if (item.OffsetUniformLocation != -1)
+            glUniform3f(item.OffsetUniformLocation, item.Offset.x, item.Offset.y, item.Offset.z);
+
+        if (item.IndexRangeCount == 0)
+        {
+            glDrawElements(GL_TRIANGLES, item.IndexBuffer->GetIndexesCount(), GL_UNSIGNED_INT, nullptr);
+            
+            _triangleCount += item.IndexBuffer->GetIndexesCount() / 3;
+        }
+        else
+        {
+            // The offsets are given in bytes, as pointers (like the last parameter of glDrawElements)
+            const void* indexRangeOffsets[RenderQueueItem::MaxIndexRangeCount];
+
+            for (int i = 0; i < item.IndexRangeCount; ++i)
+            {
+                indexRangeOffsets[i] = reinterpret_cast<const void*>(static_cast<uintptr_t>(item.IndexRangeOffsets[i]) * sizeof(unsigned int));
+                _triangleCount += item.IndexRangeCounts[i] / 3;
+            }
+
+            glMultiDrawElements(GL_TRIANGLES, item.IndexRangeCounts, GL_UNSIGNED_INT, indexRangeOffsets, item.IndexRangeCount);
+        }
+
+        _drawCallCount++;
+    }
+
+    // NOTE : clear() keeps the capacity, so the queue does not allocate anymore after the first frames
+    _renderQueue.clear();
+}
+
+bool Renderer::TryInsertionSortRenderQueue()
+{
+    // NOTE : The submitters keep their order from frame to frame (e.g. ChunkManager::DrawChunks() submits front to back),
+    //        so the queue is almost sorted and an insertion sort is close to O(n).
+    //        When the queue is too shuffled (more moves than the budget) we give up and let std::sort finish.
+    const size_t moveBudget = _sortedRenderQueue.size() * 4;
+    size_t moveCount = 0;
+
+    for (size_t i = 1; i < _sortedRenderQueue.size(); ++i)
+    {
+        if (_sortedRenderQueue[i - 1].first <= _sortedRenderQueue[i].first)
+            continue;
+
+        const std::pair<uint64_t, unsigned int> movedItem = _sortedRenderQueue[i];
+        size_t j = i;
+
+        while (j > 0 && _sortedRenderQueue[j - 1].first > movedItem.first)
+        {
+            _sortedRenderQueue[j] = _sortedRenderQueue[j - 1];
+            j--;
+
+            if (++moveCount > moveBudget)
+            {
+                _sortedRenderQueue[j] = movedItem;
+                return false;
+            }
+        }
+
+        _sortedRenderQueue[j] = movedItem;
+    }
+
+    return true;
+}
+
+uint64_t Renderer::ComputeSortKey(const RenderQueueItem& p_item)
+{
+    // Key layout (from the most to the least significant bits) :
+    // | Shader (12 bits) | Texture (12 bits) | Depth (24 bits) | VAO (16 bits) |
+    //
+    // NOTE : A VAO is only drawn once per frame, so the depth comes before it to draw the close objects first
+    //        (the OpenGL IDs are small integers, the masks only matter for the ordering, not for the correctness)
+
+    // A positive float keeps its order when its bits are read as an integer
+    const float depth = std::max(p_item.Depth, 0.0f);
+    uint32_t depthBits = 0;
+    std::memcpy(&depthBits, &depth, sizeof(float));
+
+    uint64_t sortKey = 0;
+    sortKey |= static_cast<uint64_t>(p_item.RenderingShader->GetID() & 0xFFF) << 52;
+    sortKey |= static_cast<uint64_t>(p_item.TextureID & 0xFFF) << 40;
+    sortKey |= static_cast<uint64_t>(depthBits >> 7 & 0xFFFFFF) << 16;
+    sortKey |= static_cast<uint64_t>(p_item.VertexArray->GetID() & 0xFFFF);
+
+    return sortKey;
+}
+
+#pragma endregion
+
+#pragma region // -=- State cache -=- //
+
+void Renderer::InvalidateStateCache()
+{
+    _boundShaderID = UNKNOWN_BINDING;
+    _boundVertexArrayID = UNKNOWN_BINDING;
+    _boundIndexBufferID = UNKNOWN_BINDING;
+    _boundTexture2DID = UNKNOWN_BINDING;
+    _boundTexture2DArrayID = UNKNOWN_BINDING;
+}
+
+void Renderer::BindShader(const Shader& p_shader)
+{
+    _requestedBindCount++;
+
+    if (_boundShaderID == p_shader.GetID())
+        return;
+
+    p_shader.Bind();
+    _boundShaderID = p_shader.GetID();
+    _issuedBindCount++;
+}
+
+void Renderer::BindVertexArray(const VertexArrayObject& p_vertexArrayObject)
+{
+    _requestedBindCount++;
+
+    if (_boundVertexArrayID == p_vertexArrayObject.GetID())
+        return;
+
+    p_vertexArrayObject.Bind();
+    _boundVertexArrayID = p_vertexArrayObject.GetID();
+    _issuedBindCount++;
+
+    // NOTE : The GL_ELEMENT_ARRAY_BUFFER binding is part of the VAO's state, so it changed too
+    _boundIndexBufferID = UNKNOWN_BINDING;
+}
+
+void Renderer::BindIndexBuffer(const IndexBufferObject& p_indexBufferObject)
+{
+    _requestedBindCount++;
+
+    if (_boundIndexBufferID == p_indexBufferObject.GetRenderingProgramID())
+        return;
+
+    p_indexBufferObject.Bind();
+    _boundIndexBufferID = p_indexBufferObject.GetRenderingProgramID();
+    _issuedBindCount++;
+}
+
+void Renderer::BindTexture(const unsigned int p_textureTarget, const unsigned int p_textureID)
+{
+    _requestedBindCount++;
+
+    // Only the texture slot 0 is cached, one binding per target
+    unsigned int* boundTextureID = p_textureTarget == GL_TEXTURE_2D_ARRAY ? &_boundTexture2DArrayID : &_boundTexture2DID;
+
+    if (*boundTextureID == p_textureID)
+        return;
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(p_textureTarget, p_textureID);
+    *boundTextureID = p_textureID;
+    _issuedBindCount++;
+}
+
+#pragma endregion
+
+void Renderer::ResetStatistics()
+{
+    _drawCallCount = 0;
+    _triangleCount = 0;
+    _culledTriangleCount = 0;
+
+    _requestedBindCount = 0;
+    _issuedBindCount = 0;
 }
\ No newline at end of file
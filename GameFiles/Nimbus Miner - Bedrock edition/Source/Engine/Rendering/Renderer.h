@@ -1,14 +1,120 @@
 #pragma once
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "GLM/glm.hpp"
+
 #include "IndexBufferObject.h"
 #include "Shader.h"
 #include "VertexArrayObject.h"
 
+/// <summary>
+/// One draw waiting inside the Renderer's queue (see Renderer::Submit()).
+/// <para> The pointed objects have to stay alive until Renderer::FlushQueue() is called. </para> </summary>
+struct RenderQueueItem
+{
+    const VertexArrayObject* VertexArray = nullptr;
+    const IndexBufferObject* IndexBuffer = nullptr;
+    const Shader* RenderingShader = nullptr;
+
+    // 0 = keep the texture currently bound (on the texture slot 0)
+    unsigned int TextureID = 0;
+    unsigned int TextureTarget = 0;
+
+    // Distance to the camera, only used to order the draws sharing the same shader and texture
+    float Depth = 0.0f;
+
+    // Optional per-draw vec3 uniform (e.g. 'u_ChunkOffset'), -1 = not used
+    int OffsetUniformLocation = -1;
+    glm::vec3 Offset = glm::vec3(0.0f);
+
+    // - Index ranges - //
+
+    static const int MaxIndexRangeCount = 6;
+
+    // The parts of the IBO to draw (with one glMultiDrawElements), 0 = the whole IBO
+    int IndexRangeCount = 0;
+    int IndexRangeCounts[MaxIndexRangeCount] = {};
+    unsigned int IndexRangeOffsets[MaxIndexRangeCount] = {};
+};
+
 class Renderer
 {
     
+private:
+
+    // Statistics of the current frame, reset with ResetStatistics()
+    static unsigned int _drawCallCount;
+    static unsigned long long _triangleCount;
+    static unsigned long long _culledTriangleCount;
+
+    // Every Bind() a draw needs (shader, texture, VAO, IBO) VS the ones really sent to OpenGL
+    static unsigned int _requestedBindCount;
+    static unsigned int _issuedBindCount;
+
+    // - Render queue - //
+
+    static std::vector<RenderQueueItem> _renderQueue;
+    
+    // (sort key, index inside _renderQueue), sorted instead of the items themselves
+    static std::vector<std::pair<uint64_t, unsigned int>> _sortedRenderQueue;
+
+    // - Shadow state - //
+    
+    // What we know is bound inside OpenGL, UNKNOWN_BINDING if something outside the Renderer may have changed it
+    static const unsigned int UNKNOWN_BINDING = 0xFFFFFFFF;
+    
+    static unsigned int _boundShaderID;
+    static unsigned int _boundVertexArrayID;
+    static unsigned int _boundIndexBufferID;
+    static unsigned int _boundTexture2DID;
+    static unsigned int _boundTexture2DArrayID;
+
 public:
 
     static void Clear();
+    
+    /// <summary> Draws immediately, always binds the given objects (the state cache is not trusted, see InvalidateStateCache()). </summary>
     static void Draw(const VertexArrayObject& p_vertexArrayObject, const IndexBufferObject& p_indexBufferObject, const Shader& p_shader);
+
+    /// <summary> Queues a draw, nothing is sent to OpenGL before FlushQueue(). </summary>
+    static void Submit(const RenderQueueItem& p_item);
+
+    /// <summary>
+    /// Sorts the queued draws (by shader, texture, depth then VAO) and draws them, the binds of an already bound object are skipped.
+    /// <para> Should be called once per frame, after all the Submit(). </para> </summary>
+    static void FlushQueue();
+
+    /// <summary> To call when something outside the Renderer changed the bound shader, VAO, IBO or textures. </summary>
+    static void InvalidateStateCache();
+
+    /// <summary> Should be called at the beginning of each frame, resets the draw call, triangle and bind counters. </summary>
+    static void ResetStatistics();
+
+    static unsigned int GetDrawCallCount() { return _drawCallCount; }
+    static unsigned long long GetTriangleCount() { return _triangleCount; }
+
+    /// <summary> For the triangles skipped before being submitted (e.g. the chunk faces facing away from the camera). </summary>
+    static void AddCulledTriangles(unsigned long long p_triangleCount) { _culledTriangleCount += p_triangleCount; }
+    static unsigned long long GetCulledTriangleCount() { return _culledTriangleCount; }
+
+    static unsigned int GetRequestedBindCount() { return _requestedBindCount; }
+    static unsigned int GetIssuedBindCount() { return _issuedBindCount; }
+    
+    /// <summary> The redundant binds avoided by the state cache during the current frame. </summary>
+    static unsigned int GetSkippedBindCount() { return _requestedBindCount - _issuedBindCount; }
+
+private:
+
+    static uint64_t ComputeSortKey(const RenderQueueItem& p_item);
+
+    /// <summary> Returns false if the queue was too shuffled to be sorted cheaply (it is then only partially sorted). </summary>
+    static bool TryInsertionSortRenderQueue();
+
+    static void BindShader(const Shader& p_shader);
+    static void BindVertexArray(const VertexArrayObject& p_vertexArrayObject);
+    static void BindIndexBuffer(const IndexBufferObject& p_indexBufferObject);
+    static void BindTexture(unsigned int p_textureTarget, unsigned int p_textureID);
 };
\ No newline at end of file
@@ -45,6 +45,16 @@ void Shader::SetUniform1i(const std::string& p_name, int p_value)
     glUniform1i(GetUniformLocation(p_name), p_value);
 }
 
+void Shader::SetUniform2f(const std::string& p_name, float p_v1, float p_v2)
+{
+    glUniform2f(GetUniformLocation(p_name), p_v1, p_v2);
+}
+
+void Shader::SetUniform3f(const std::string& p_name, float p_v1, float p_v2, float p_v3)
+{
+    glUniform3f(GetUniformLocation(p_name), p_v1, p_v2, p_v3);
+}
+
 void Shader::SetUniform4f(const std::string& p_name, float p_v1, float p_v2, float p_v3, float p_v4)
 {
     glUniform4f(GetUniformLocation(p_name), p_v1, p_v2, p_v3, p_v4);
@@ -55,6 +65,20 @@ void Shader::SetUniformMat4f(const std::string& p_name, const glm::mat4& p_matri
     glUniformMatrix4fv(GetUniformLocation(p_name), 1, GL_FALSE, &p_matrix[0][0]); // Address of the matrix
 }
 
+void Shader::BindUniformBlock(const std::string& p_blockName, const unsigned int p_bindingPoint) const
+{
+    const unsigned int blockIndex = glGetUniformBlockIndex(_shaderID, p_blockName.c_str());
+
+    if (blockIndex == GL_INVALID_INDEX)
+    {
+        PRINT_WARNING_RUNTIME(true, std::string("Failed to get uniform block index for '" + p_blockName + "'"))
+        return;
+    }
+
+    // NOTE : GLSL 330 has no 'layout(binding = x)' for uniform blocks, so the binding is done here once after linking
+    glUniformBlockBinding(_shaderID, blockIndex, p_bindingPoint);
+}
+
 #pragma endregion
 
 ShaderProgram Shader::ParseShader(const std::string& p_filePath)
@@ -164,5 +188,7 @@ int Shader::GetUniformLocation(const std::string& p_name)
     if (location == -1)
         PRINT_WARNING_RUNTIME(true, std::string("Failed to get uniform location for '" + p_name + "'"))
 
+    _uniformLocationCache[p_name] = location;
+
     return location;
 }
\ No newline at end of file
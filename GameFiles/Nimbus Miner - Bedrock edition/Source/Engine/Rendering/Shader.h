@@ -33,15 +33,23 @@ public:
     void Unbind() const;
 
     void SetUniform1i(const std::string& p_name, int p_value);
+    void SetUniform2f(const std::string& p_name, float p_v1, float p_v2);
+    void SetUniform3f(const std::string& p_name, float p_v1, float p_v2, float p_v3);
     void SetUniform4f(const std::string& p_name, float p_v1, float p_v2, float p_v3, float p_v4);
     void SetUniformMat4f(const std::string& p_name, const glm::mat4& p_matrix);
 
+    /// <summary> Links the given uniform block (e.g. 'FrameData') to a binding point, the block then reads the UBO attached to this point. </summary>
+    void BindUniformBlock(const std::string& p_blockName, unsigned int p_bindingPoint) const;
+
+    /// <summary> Cached, so it can be stored to set a uniform many times without looking for its name again (see RenderQueueItem). </summary>
+    int GetUniformLocation(const std::string& p_name);
+
+    unsigned int GetID() const { return _shaderID; }
+
 private:
 
     ShaderProgram ParseShader(const std::string& p_filePath);
     unsigned int CreateShader(const std::string& p_vertexShaderCode, const std::string& p_fragmentShaderCode);
     unsigned int  CompileShader(const unsigned int p_type, const std::string& p_filePath);
     
-    int GetUniformLocation(const std::string& p_name);
-    
 };
@@ -16,6 +16,7 @@ Texture2DArray::Texture2DArray(const std::vector<std::string>& p_filePaths)
     _height = 0; // Will be re-set in the code below
     
     std::vector<unsigned char*> layerData(_layerCount);
+    _layerAverageColors.assign(_layerCount, glm::vec4(1.0f));
 
     // Loading all images
     for (int i = 0; i < _layerCount; ++i)
@@ -64,6 +65,8 @@ Texture2DArray::Texture2DArray(const std::vector<std::string>& p_filePaths)
             i,
             _width, _height, 1, GL_RGBA, GL_UNSIGNED_BYTE, layerData[i]
         );
+
+        _layerAverageColors[i] = ComputeAverageColor(layerData[i], _width * _height);
         
         stbi_image_free(layerData[i]);
     }
@@ -104,4 +107,28 @@ void Texture2DArray::Bind(const unsigned int p_textureSlot) const
 void Texture2DArray::Unbind()
 {
     glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+glm::vec4 Texture2DArray::ComputeAverageColor(const unsigned char* p_pixels, const int p_pixelCount)
+{
+    if (p_pixelCount <= 0)
+        return glm::vec4(1.0f);
+
+    // NOTE : Summed in integers, a 4096 x 4096 texture still fits inside 64 bits
+    unsigned long long channelSums[4] = { 0, 0, 0, 0 };
+
+    for (int i = 0; i < p_pixelCount; ++i)
+    {
+        for (int channel = 0; channel < 4; ++channel)
+            channelSums[channel] += p_pixels[i * 4 + channel];
+    }
+
+    const double divisor = 255.0 * p_pixelCount;
+
+    return glm::vec4(
+        static_cast<float>(channelSums[0] / divisor),
+        static_cast<float>(channelSums[1] / divisor),
+        static_cast<float>(channelSums[2] / divisor),
+        static_cast<float>(channelSums[3] / divisor)
+    );
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 
+#include "GLM/glm.hpp"
+
 class Texture2DArray
 {
 
@@ -12,10 +14,23 @@ private:
     int _height;
     int _layerCount;
 
+    // The average color of each layer (RGBA between 0 and 1), computed while loading the images
+    std::vector<glm::vec4> _layerAverageColors;
+
 public:
     Texture2DArray(const std::vector<std::string>& p_filePaths);
     ~Texture2DArray();
 
     void Bind(const unsigned int p_textureSlot = 0) const;
     static void Unbind();
+
+    unsigned int GetInGpuId() const { return _inGpuId; }
+
+    /// <summary> The average color of each layer, for the objects too far away to show the texture details (e.g. the FarTerrain). </summary>
+    const std::vector<glm::vec4>& GetLayerAverageColors() const { return _layerAverageColors; }
+
+private:
+
+    /// <summary> The pixels are RGBA, one byte per channel. </summary>
+    static glm::vec4 ComputeAverageColor(const unsigned char* p_pixels, int p_pixelCount);
 };
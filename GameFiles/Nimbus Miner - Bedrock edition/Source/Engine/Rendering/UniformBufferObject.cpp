@@ -0,0 +1,37 @@
+#include "UniformBufferObject.h"
+
+#include <GL/glew.h>
+
+UniformBufferObject::UniformBufferObject(const unsigned int p_bytesSize, const unsigned int p_bindingPoint)
+{
+    // Initialising class' variables
+    _bindingPoint = p_bindingPoint;
+    
+    glGenBuffers(1, &_uniformBufferObjectID);
+    glBindBuffer(GL_UNIFORM_BUFFER, _uniformBufferObjectID);
+    glBufferData(GL_UNIFORM_BUFFER, p_bytesSize, nullptr, GL_DYNAMIC_DRAW);
+
+    // The buffer stays attached to its binding point, shaders only have to link their uniform block to the same point
+    glBindBufferBase(GL_UNIFORM_BUFFER, _bindingPoint, _uniformBufferObjectID);
+}
+
+UniformBufferObject::~UniformBufferObject()
+{
+    glDeleteBuffers(1, &_uniformBufferObjectID);
+}
+
+void UniformBufferObject::Bind() const
+{
+    glBindBuffer(GL_UNIFORM_BUFFER, _uniformBufferObjectID);
+}
+
+void UniformBufferObject::Unbind() const
+{
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBufferObject::SetData(const void* p_data, const unsigned int p_bytesSize, const unsigned int p_bytesOffset) const
+{
+    Bind();
+    glBufferSubData(GL_UNIFORM_BUFFER, p_bytesOffset, p_bytesSize, p_data);
+}
\ No newline at end of file
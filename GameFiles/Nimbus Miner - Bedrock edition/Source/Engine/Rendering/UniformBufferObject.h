@@ -0,0 +1,33 @@
+#pragma once
+
+/// <summary>
+/// Creating a UBO (Uniform Buffer Object).
+/// <para> Contains uniform data shared by every shader declaring the same uniform block (see Shader::BindUniformBlock()). </para> </summary>
+class UniformBufferObject
+{
+    
+private:
+    
+    unsigned int _uniformBufferObjectID;
+    unsigned int _bindingPoint;
+
+public:
+
+    /// <summary>
+    /// Will created a UBO (Uniform Buffer Object) and attach it to the given binding point.
+    ///
+    /// <para> The data is uploaded later with SetData(). </para> </summary>
+    /// <param name = "p_bytesSize"> The size (in bytes) of the uniform block, it has to follow the std140 layout </param>
+    /// <param name = "p_bindingPoint"> The binding point shared with the shaders' uniform blocks </param>
+    UniformBufferObject(unsigned int p_bytesSize, unsigned int p_bindingPoint);
+    ~UniformBufferObject();
+
+    void Bind() const;
+    void Unbind() const;
+
+    /// <summary> Overrides a part of the buffer (one glBufferSubData call, the buffer is never reallocated). </summary>
+    void SetData(const void* p_data, unsigned int p_bytesSize, unsigned int p_bytesOffset = 0) const;
+
+    unsigned int GetBindingPoint() const { return _bindingPoint; }
+    
+};
\ No newline at end of file
@@ -13,6 +13,15 @@ inline bool AreEqual(const float p_float1, const float p_float2, const float p_c
     return std::abs(p_float1 - p_float2) < p_comparisonLimit;
 }
 
+/// <summary> Rounds toward negative infinity (the integer division rounds toward 0), e.g. the chunk holding a negative block position. </summary>
+inline int FloorDivide(const int p_dividend, const int p_divisor)
+{
+    const int quotient = p_dividend / p_divisor;
+
+    // The division was rounded up for the negative results
+    return (p_dividend % p_divisor != 0 && (p_dividend < 0) != (p_divisor < 0)) ? quotient - 1 : quotient;
+}
+
 #pragma region - Float vectors -
 
 struct Vector2
@@ -54,4 +54,6 @@ public:
     
     void Bind() const;
     void Unbind() const;
+
+    unsigned int GetID() const { return _vertexArrayObjectID; }
 };
\ No newline at end of file
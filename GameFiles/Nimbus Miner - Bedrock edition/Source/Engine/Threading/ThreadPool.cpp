@@ -0,0 +1,83 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned int p_threadCount)
+{
+    // Initialising class' variables
+    _runningJobCount = 0;
+    _isStopping = false;
+
+    if (p_threadCount == 0)
+    {
+        // NOTE : hardware_concurrency() can return 0 if the number of threads is unknown
+        const unsigned int hardwareThreadCount = std::thread::hardware_concurrency();
+        p_threadCount = hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 1;
+    }
+
+    _threads.reserve(p_threadCount);
+
+    for (unsigned int i = 0; i < p_threadCount; ++i)
+        _threads.emplace_back(&ThreadPool::RunWorkerThread, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _isStopping = true;
+        _jobs.clear();
+    }
+
+    _jobAvailableCondition.notify_all();
+
+    for (std::thread& thread : _threads)
+        thread.join();
+}
+
+void ThreadPool::Submit(std::function<void()> p_job)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(p_job));
+    }
+
+    _jobAvailableCondition.notify_one();
+}
+
+void ThreadPool::WaitForIdle()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _idleCondition.wait(lock, [this] { return _jobs.empty() && _runningJobCount == 0; });
+}
+
+void ThreadPool::RunWorkerThread()
+{
+    while (true)
+    {
+        std::function<void()> job;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            _jobAvailableCondition.wait(lock, [this] { return _isStopping || !_jobs.empty(); });
+
+            if (_isStopping)
+                return;
+
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+
+            _runningJobCount++;
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _runningJobCount--;
+        }
+
+        _idleCondition.notify_all();
+    }
+}
\ No newline at end of file
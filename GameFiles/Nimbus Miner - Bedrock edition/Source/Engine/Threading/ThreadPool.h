@@ -0,0 +1,52 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// A fixed number of worker threads running the submitted jobs in order (first submitted, first started).
+///
+/// <para> The jobs must not use OpenGL (the context only exists on the main thread), they usually give their result back
+/// to the main thread through a queue protected by a mutex. </para>
+/// <para> The destructor waits for the running jobs, the jobs that did not start are dropped. </para> </summary>
+class ThreadPool
+{
+
+private:
+
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _jobAvailableCondition;
+    std::condition_variable _idleCondition;
+
+    // - Protected by the _mutex - //
+
+    std::deque<std::function<void()>> _jobs;
+    int _runningJobCount;
+    bool _isStopping;
+
+public:
+
+    /// <summary> 0 threads means one per hardware thread, minus the main thread. </summary>
+    explicit ThreadPool(unsigned int p_threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> p_job);
+
+    /// <summary> Blocks the calling thread until all the submitted jobs are finished. </summary>
+    void WaitForIdle();
+
+    unsigned int GetThreadCount() const { return static_cast<unsigned int>(_threads.size()); }
+
+private:
+
+    void RunWorkerThread();
+};
\ No newline at end of file
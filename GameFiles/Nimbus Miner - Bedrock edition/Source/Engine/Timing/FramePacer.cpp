@@ -0,0 +1,230 @@
+#include "FramePacer.h"
+
+#include <cmath>
+#include <thread>
+
+#if defined(_WIN32)
+    #include <Windows.h>
+    #include <timeapi.h>
+
+    #pragma comment(lib, "Winmm.lib")
+#endif
+
+#include "GLFW/glfw3.h"
+#include "GLM/glm.hpp"
+
+#include "ProjectConstants.h"
+#include "JsonWriter/JsonWriter.h"
+#include "MessageDebugger/MessageDebugger.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double ToMilliseconds(const Clock::duration& p_duration)
+{
+    return std::chrono::duration<double, std::milli>(p_duration).count();
+}
+
+FramePacer::FramePacer(const FramePacingModes p_mode, const int p_targetFramesPerSecond)
+{
+    // Initialising class' variables
+    _mode = p_mode;
+    _targetFramesPerSecond = glm::clamp(p_targetFramesPerSecond, FRAME_PACING_MINIMUM_TARGET_FRAMES_PER_SECOND, FRAME_PACING_MAXIMUM_TARGET_FRAMES_PER_SECOND);
+    _hasPreviousFrame = false;
+
+    // NOTE : About what a sleep of 1 ms takes with a 1 ms timer resolution, the first sleeps measured correct it
+    _sleepEstimateMilliseconds = FRAME_PACING_INITIAL_SLEEP_ESTIMATE_MILLISECONDS;
+    _sleepMeanMilliseconds = FRAME_PACING_INITIAL_SLEEP_ESTIMATE_MILLISECONDS;
+    _sleepSquaredDeviationSum = 0.0;
+    _sleepCount = 1;
+
+    _deltaTime = 0.0;
+    _lastWaitMilliseconds = 0.0;
+    _lastWorkMilliseconds = 0.0;
+    _lastPresentMilliseconds = 0.0;
+
+    _totalWaitMilliseconds = 0.0;
+    _totalPresentMilliseconds = 0.0;
+
+#if defined(_WIN32)
+    // The default timer resolution of Windows is 15.6 ms, the sleeps of the limiter need 1 ms
+    if (timeBeginPeriod(1) != TIMERR_NOERROR)
+        PRINT_WARNING_RUNTIME(true, "Failed to set the timer resolution to 1 ms, the frame limiter will spin longer")
+#endif
+
+    ApplySwapInterval();
+}
+
+FramePacer::~FramePacer()
+{
+#if defined(_WIN32)
+    timeEndPeriod(1);
+#endif
+}
+
+void FramePacer::BeginFrame()
+{
+    _lastWaitMilliseconds = 0.0;
+
+    if (_mode == FramePacingModes::FrameLimiter)
+    {
+        const Clock::duration framePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / _targetFramesPerSecond));
+        const Clock::time_point waitBeginTime = Clock::now();
+
+        // NOTE : The deadlines follow each other (instead of now + period) so the small overshoots don't add up and lower the frame rate,
+        //        but after a hitch longer than a frame the limiter starts again from now instead of running the missed frames uncapped
+        if (!_hasPreviousFrame || waitBeginTime - _nextFrameTime > framePeriod)
+            _nextFrameTime = waitBeginTime;
+        else
+            PreciseSleepUntil(_nextFrameTime);
+
+        _nextFrameTime += framePeriod;
+        _lastWaitMilliseconds = ToMilliseconds(Clock::now() - waitBeginTime);
+    }
+
+    const Clock::time_point frameBeginTime = Clock::now();
+
+    if (_hasPreviousFrame)
+    {
+        _deltaTime = std::chrono::duration<double>(frameBeginTime - _frameBeginTime).count();
+
+        _frameIntervalHistogram.Add(_deltaTime * 1000.0);
+        _totalWaitMilliseconds += _lastWaitMilliseconds;
+        _totalPresentMilliseconds += _lastPresentMilliseconds;
+    }
+
+    _frameBeginTime = frameBeginTime;
+    _presentBeginTime = frameBeginTime;
+    _hasPreviousFrame = true;
+}
+
+void FramePacer::BeginPresent()
+{
+    _presentBeginTime = Clock::now();
+
+    // NOTE : The wait of the limiter is not a part of the work, it happens before _frameBeginTime
+    _lastWorkMilliseconds = ToMilliseconds(_presentBeginTime - _frameBeginTime);
+    _frameWorkHistogram.Add(_lastWorkMilliseconds);
+}
+
+void FramePacer::EndFrame()
+{
+    _lastPresentMilliseconds = ToMilliseconds(Clock::now() - _presentBeginTime);
+}
+
+void FramePacer::SetMode(const FramePacingModes p_mode)
+{
+    if (p_mode == _mode)
+        return;
+
+    _mode = p_mode;
+
+    // The limiter starts again from the next frame instead of catching up with an old deadline
+    _nextFrameTime = Clock::now();
+
+    ApplySwapInterval();
+}
+
+void FramePacer::SetTargetFramesPerSecond(const int p_targetFramesPerSecond)
+{
+    _targetFramesPerSecond = glm::clamp(p_targetFramesPerSecond, FRAME_PACING_MINIMUM_TARGET_FRAMES_PER_SECOND, FRAME_PACING_MAXIMUM_TARGET_FRAMES_PER_SECOND);
+}
+
+double FramePacer::GetAverageWaitMilliseconds() const
+{
+    const unsigned long long frameCount = _frameIntervalHistogram.GetSampleCount();
+
+    return frameCount > 0 ? _totalWaitMilliseconds / static_cast<double>(frameCount) : 0.0;
+}
+
+double FramePacer::GetAveragePresentMilliseconds() const
+{
+    const unsigned long long frameCount = _frameIntervalHistogram.GetSampleCount();
+
+    return frameCount > 0 ? _totalPresentMilliseconds / static_cast<double>(frameCount) : 0.0;
+}
+
+void FramePacer::ResetStatistics()
+{
+    _frameIntervalHistogram.Reset();
+    _frameWorkHistogram.Reset();
+
+    _totalWaitMilliseconds = 0.0;
+    _totalPresentMilliseconds = 0.0;
+}
+
+bool FramePacer::ExportHistograms(const std::string& p_filePath) const
+{
+    JsonWriter jsonWriter;
+    jsonWriter.BeginObject();
+
+    jsonWriter.Write("mode", GetModeName(_mode));
+    jsonWriter.Write("targetFramesPerSecond", _targetFramesPerSecond);
+    jsonWriter.Write("averageWaitMilliseconds", GetAverageWaitMilliseconds());
+    jsonWriter.Write("averagePresentMilliseconds", GetAveragePresentMilliseconds());
+    jsonWriter.Write("sleepEstimateMilliseconds", _sleepEstimateMilliseconds);
+
+    _frameIntervalHistogram.WriteToJson(jsonWriter, "frameInterval");
+    _frameWorkHistogram.WriteToJson(jsonWriter, "frameWork");
+
+    jsonWriter.EndObject();
+
+    if (!jsonWriter.SaveToFile(p_filePath))
+    {
+        PRINT_ERROR_RUNTIME(true, "Failed to write the frame time histograms inside '" + p_filePath + "'")
+        return false;
+    }
+
+    PRINT_MESSAGE_RUNTIME("Frame time histograms written inside '" + p_filePath + "'")
+    return true;
+}
+
+const char* FramePacer::GetModeName(const FramePacingModes p_mode)
+{
+    switch (p_mode)
+    {
+    case FramePacingModes::VSync:
+        return "VSync";
+
+    case FramePacingModes::FrameLimiter:
+        return "FrameLimiter";
+
+    case FramePacingModes::Uncapped:
+        return "Uncapped";
+    }
+
+    return "Unknown";
+}
+
+void FramePacer::PreciseSleepUntil(const Clock::time_point& p_time)
+{
+    while (ToMilliseconds(p_time - Clock::now()) > _sleepEstimateMilliseconds)
+    {
+        const Clock::time_point sleepBeginTime = Clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        const double sleepMilliseconds = ToMilliseconds(Clock::now() - sleepBeginTime);
+
+        // NOTE : The count stops growing so the estimate keeps following the system (another program can change the timer resolution)
+        //        (the oldest sleeps fade out of the deviation sum at the same rate as out of the mean)
+        if (_sleepCount < FRAME_PACING_SLEEP_ESTIMATE_SAMPLE_COUNT)
+            _sleepCount++;
+        else
+            _sleepSquaredDeviationSum -= _sleepSquaredDeviationSum / static_cast<double>(_sleepCount);
+
+        const double deviation = sleepMilliseconds - _sleepMeanMilliseconds;
+        _sleepMeanMilliseconds += deviation / static_cast<double>(_sleepCount);
+        _sleepSquaredDeviationSum += deviation * (sleepMilliseconds - _sleepMeanMilliseconds);
+
+        // Mean plus one standard deviation, most of the sleeps end before it
+        const double variance = _sleepCount > 1 ? _sleepSquaredDeviationSum / static_cast<double>(_sleepCount - 1) : 0.0;
+        _sleepEstimateMilliseconds = _sleepMeanMilliseconds + std::sqrt(glm::max(variance, 0.0));
+    }
+
+    // The end of the wait is spun, a sleep could wake up too late
+    while (Clock::now() < p_time)
+        std::this_thread::yield();
+}
+
+void FramePacer::ApplySwapInterval() const
+{
+    glfwSwapInterval(_mode == FramePacingModes::VSync ? 1 : 0);
+}
\ No newline at end of file
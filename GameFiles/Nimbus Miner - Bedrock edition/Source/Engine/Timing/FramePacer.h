@@ -0,0 +1,125 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "FrameTimeHistogram.h"
+
+/// <summary>
+/// Decides when the frames begin, and measures where their time goes.
+///
+/// <para> Three modes (see FramePacingModes) : the vsync, a frame limiter at a target frame rate (without vsync), or nothing at all.
+/// The limiter sleeps most of the wait, then spins the end of it : a sleep can wake up late (more than 1 ms on Windows),
+/// so it only sleeps while the remaining time is longer than what the sleeps overshot until now. </para>
+///
+/// <para> Each frame is split into the work (BeginFrame() to BeginPresent(), the CPU preparing and sending the frame),
+/// the present (the buffer swap, blocked by the vsync or by a GPU late by a few frames) and the limiter wait.
+/// The frame interval (from one BeginFrame() to the next one) is what the player sees, its histogram can be exported as JSON. </para>
+///
+/// <para> The wait happens at the beginning of the frame, so the inputs polled right after it are as fresh as possible
+/// (the time between an input and its frame on the screen is shorter than waiting at the end of the frame). </para> </summary>
+class FramePacer
+{
+
+public:
+
+    enum class FramePacingModes
+    {
+        /// <summary> The buffer swap waits for the screen refresh (glfwSwapInterval(1)). </summary>
+        VSync,
+
+        /// <summary> No vsync, the frames begin every 1 / TargetFramesPerSecond seconds. </summary>
+        FrameLimiter,
+
+        /// <summary> No vsync and no wait, the frames begin as soon as the previous one is sent. </summary>
+        Uncapped
+    };
+
+private:
+
+    FramePacingModes _mode;
+    int _targetFramesPerSecond;
+
+    // NOTE : Only used by the frame limiter, the time the next frame is allowed to begin
+    std::chrono::steady_clock::time_point _nextFrameTime;
+
+    std::chrono::steady_clock::time_point _frameBeginTime;
+    std::chrono::steady_clock::time_point _presentBeginTime;
+    bool _hasPreviousFrame;
+
+    // - Sleep overshoot estimate (see PreciseSleepUntil()) - //
+
+    // NOTE : In milliseconds, the average and the variance of the 1 ms sleeps (Welford's online algorithm)
+    double _sleepEstimateMilliseconds;
+    double _sleepMeanMilliseconds;
+    double _sleepSquaredDeviationSum;
+    unsigned long long _sleepCount;
+
+    // - Last frame - //
+
+    double _deltaTime;                      // In seconds, the last frame interval
+    double _lastWaitMilliseconds;
+    double _lastWorkMilliseconds;
+    double _lastPresentMilliseconds;
+
+    FrameTimeHistogram _frameIntervalHistogram;
+    FrameTimeHistogram _frameWorkHistogram;
+
+    double _totalWaitMilliseconds;
+    double _totalPresentMilliseconds;
+
+public:
+
+    /// <summary> Must be created after the OpenGL context is made current, the swap interval is set by it. </summary>
+    FramePacer(FramePacingModes p_mode, int p_targetFramesPerSecond);
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    /// <summary> Waits for the frame limiter (in FrameLimiter mode), then measures the interval since the previous frame. </summary>
+    void BeginFrame();
+
+    /// <summary> Call it right before glfwSwapBuffers(), the work of the frame ends there. </summary>
+    void BeginPresent();
+
+    /// <summary> Call it right after glfwSwapBuffers(). </summary>
+    void EndFrame();
+
+    FramePacingModes GetMode() const { return _mode; }
+    void SetMode(FramePacingModes p_mode);
+
+    int GetTargetFramesPerSecond() const { return _targetFramesPerSecond; }
+    void SetTargetFramesPerSecond(int p_targetFramesPerSecond);
+
+    /// <summary> The last frame interval, in seconds (the time to move the camera by). </summary>
+    double GetDeltaTime() const { return _deltaTime; }
+
+    double GetLastWaitMilliseconds() const { return _lastWaitMilliseconds; }
+    double GetLastWorkMilliseconds() const { return _lastWorkMilliseconds; }
+    double GetLastPresentMilliseconds() const { return _lastPresentMilliseconds; }
+
+    /// <summary> The averages since the last ResetStatistics(), over the frames of the interval histogram. </summary>
+    double GetAverageWaitMilliseconds() const;
+    double GetAveragePresentMilliseconds() const;
+
+    /// <summary> The time a 1 ms sleep is expected to take at most, the limiter spins below it. </summary>
+    double GetSleepEstimateMilliseconds() const { return _sleepEstimateMilliseconds; }
+
+    const FrameTimeHistogram& GetFrameIntervalHistogram() const { return _frameIntervalHistogram; }
+    const FrameTimeHistogram& GetFrameWorkHistogram() const { return _frameWorkHistogram; }
+
+    void ResetStatistics();
+
+    /// <summary> Writes the mode and the two histograms inside a JSON file. Returns false if the file can't be written. </summary>
+    bool ExportHistograms(const std::string& p_filePath) const;
+
+    static const char* GetModeName(FramePacingModes p_mode);
+
+private:
+
+    /// <summary> Sleeps 1 ms at a time while the remaining time is longer than the sleep estimate, then spins until the given time. </summary>
+    void PreciseSleepUntil(const std::chrono::steady_clock::time_point& p_time);
+
+    void ApplySwapInterval() const;
+};
\ No newline at end of file
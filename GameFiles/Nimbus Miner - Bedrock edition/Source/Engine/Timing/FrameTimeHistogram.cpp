@@ -0,0 +1,100 @@
+#include "FrameTimeHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "GLM/glm.hpp"
+
+#include "ProjectConstants.h"
+#include "JsonWriter/JsonWriter.h"
+
+FrameTimeHistogram::FrameTimeHistogram()
+{
+    // Initialising class' variables
+    _bucketMilliseconds = FRAME_TIME_HISTOGRAM_BUCKET_MILLISECONDS;
+    _bucketCounts.assign(static_cast<size_t>(std::ceil(FRAME_TIME_HISTOGRAM_MAXIMUM_MILLISECONDS / _bucketMilliseconds)) + 1, 0);
+
+    Reset();
+}
+
+void FrameTimeHistogram::Add(const double p_milliseconds)
+{
+    const double milliseconds = std::max(p_milliseconds, 0.0);
+    const size_t bucketIndex = std::min(static_cast<size_t>(milliseconds / _bucketMilliseconds), _bucketCounts.size() - 1);
+
+    _bucketCounts[bucketIndex]++;
+
+    _minimumMilliseconds = _sampleCount == 0 ? milliseconds : std::min(_minimumMilliseconds, milliseconds);
+    _maximumMilliseconds = std::max(_maximumMilliseconds, milliseconds);
+    _totalMilliseconds += milliseconds;
+    _sampleCount++;
+}
+
+void FrameTimeHistogram::Reset()
+{
+    std::fill(_bucketCounts.begin(), _bucketCounts.end(), 0);
+
+    _sampleCount = 0;
+    _totalMilliseconds = 0.0;
+    _minimumMilliseconds = 0.0;
+    _maximumMilliseconds = 0.0;
+}
+
+double FrameTimeHistogram::GetPercentile(const double p_percentile) const
+{
+    if (_sampleCount == 0)
+        return 0.0;
+
+    // NOTE : Nearest-rank like BenchmarkStatistics, the rank is ceil(p * n) from 1 to n (the index of the sample is one less),
+    //        so with 100 frames the 99th percentile is the bucket of the 99th frame and not of the slowest one
+    const double rank = std::ceil(p_percentile * static_cast<double>(_sampleCount));
+    const unsigned long long sampleIndex = static_cast<unsigned long long>(glm::clamp(rank, 1.0, static_cast<double>(_sampleCount))) - 1;
+    unsigned long long countedSampleCount = 0;
+
+    for (size_t i = 0; i < _bucketCounts.size(); ++i)
+    {
+        countedSampleCount += _bucketCounts[i];
+
+        if (countedSampleCount > sampleIndex)
+            return std::min((i + 1) * _bucketMilliseconds, _maximumMilliseconds);
+    }
+
+    return _maximumMilliseconds;
+}
+
+void FrameTimeHistogram::GetBucketCounts(const double p_maximumMilliseconds, std::vector<float>& p_outBucketCounts) const
+{
+    const size_t bucketCount = std::min(static_cast<size_t>(std::max(p_maximumMilliseconds, 0.0) / _bucketMilliseconds), _bucketCounts.size());
+
+    p_outBucketCounts.resize(bucketCount);
+
+    for (size_t i = 0; i < bucketCount; ++i)
+        p_outBucketCounts[i] = static_cast<float>(_bucketCounts[i]);
+}
+
+void FrameTimeHistogram::WriteToJson(JsonWriter& p_jsonWriter, const std::string& p_key) const
+{
+    p_jsonWriter.BeginObject(p_key);
+    p_jsonWriter.Write("sampleCount", _sampleCount);
+    p_jsonWriter.Write("average", GetAverage());
+    p_jsonWriter.Write("minimum", _minimumMilliseconds);
+    p_jsonWriter.Write("maximum", _maximumMilliseconds);
+    p_jsonWriter.Write("median", GetPercentile(0.50));
+    p_jsonWriter.Write("percentile99", GetPercentile(0.99));
+    p_jsonWriter.Write("percentile999", GetPercentile(0.999));
+    p_jsonWriter.Write("bucketMilliseconds", _bucketMilliseconds);
+    p_jsonWriter.Write("overflowCount", _bucketCounts.back());
+
+    // NOTE : The empty buckets after the slowest frame are not written, the bucket i holds the times between i and i + 1 bucket widths
+    size_t usedBucketCount = _bucketCounts.size() - 1;
+
+    while (usedBucketCount > 0 && _bucketCounts[usedBucketCount - 1] == 0)
+        usedBucketCount--;
+
+    p_jsonWriter.BeginArray("buckets");
+    for (size_t i = 0; i < usedBucketCount; ++i)
+        p_jsonWriter.WriteValue(static_cast<long long>(_bucketCounts[i]));
+    p_jsonWriter.EndArray();
+
+    p_jsonWriter.EndObject();
+}
\ No newline at end of file
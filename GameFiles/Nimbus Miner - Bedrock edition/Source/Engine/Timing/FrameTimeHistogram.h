@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class JsonWriter;
+
+/// <summary>
+/// Counts the frame times inside fixed-width buckets (FRAME_TIME_HISTOGRAM_BUCKET_MILLISECONDS wide), so it never grows
+/// and its percentiles are precise to a bucket, however long the game runs.
+///
+/// <para> The times above FRAME_TIME_HISTOGRAM_MAXIMUM_MILLISECONDS all go inside the last bucket (their maximum is still exact). </para> </summary>
+class FrameTimeHistogram
+{
+
+private:
+
+    // NOTE : The last bucket holds all the times above the maximum
+    std::vector<unsigned long long> _bucketCounts;
+
+    double _bucketMilliseconds;
+
+    unsigned long long _sampleCount;
+    double _totalMilliseconds;
+    double _minimumMilliseconds;
+    double _maximumMilliseconds;
+
+public:
+
+    FrameTimeHistogram();
+
+    void Add(double p_milliseconds);
+    void Reset();
+
+    /// <summary> The upper bound of the bucket holding the given percentile (between 0 and 1), 0 without samples. </summary>
+    double GetPercentile(double p_percentile) const;
+
+    unsigned long long GetSampleCount() const { return _sampleCount; }
+    double GetAverage() const { return _sampleCount > 0 ? _totalMilliseconds / static_cast<double>(_sampleCount) : 0.0; }
+    double GetMinimum() const { return _minimumMilliseconds; }
+    double GetMaximum() const { return _maximumMilliseconds; }
+
+    double GetBucketMilliseconds() const { return _bucketMilliseconds; }
+
+    /// <summary> Fills p_outBucketCounts with the buckets between 0 and p_maximumMilliseconds (for ImGui::PlotHistogram()). </summary>
+    void GetBucketCounts(double p_maximumMilliseconds, std::vector<float>& p_outBucketCounts) const;
+
+    /// <summary> Writes the statistics and the buckets (up to the last one used) as a JSON object named 'p_key'. </summary>
+    void WriteToJson(JsonWriter& p_jsonWriter, const std::string& p_key) const;
+};
\ No newline at end of file
@@ -1,14 +1,60 @@
 #include "ChunkManager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <random>
 #include <sstream>
 
+#include "ProjectConstants.h"
+
+#include "../../../Engine/Culling/OcclusionCuller.h"
+#include "../../../Engine/Threading/ThreadPool.h"
+
+#include "../ChunkStorage/ChunkMeshCache.h"
+#include "../ChunkStorage/ChunkStorage.h"
+#include "../ChunkVisibility/ChunkVisibility.h"
+#include "../ChunkVoxelData/ChunkBorderPlanes.h"
 #include "../GreedyChunk/GreedyChunk.h"
+#include "../GreedyMesher/GreedyMesher.h"
+#include "../GreedyMesher/MeshingContext.h"
+#include "../WorldGenerator/WorldGenerator.h"
+
+#include "MessageDebugger/MessageDebugger.h"
+
+// Inside the save directory, next to the region files
+static constexpr const char* MESH_CACHE_FILE_NAME = "Meshes.cache";
 
 ChunkManager::ChunkManager(const bool p_isWorldSeedRandomized, int p_worldSeed, const float p_noiseFrequency,
     const Vector3Int& p_chunksSize, const int p_chunksBlockSize, const Vector2Int& p_chunkCount, Shader* p_renderingShader,
     const bool p_doesInit)
 {
+    // Initialising class' variables
+    _worldGenerator = nullptr;
+    _meshingThreadPool = nullptr;
+    _occlusionCuller = nullptr;
+    _chunkOffsetUniformLocation = -1;
+    _chunkStorage = nullptr;
+    _meshCache = nullptr;
+    _pendingMeshJobCount = 0;
+    _discardedMeshCount = 0;
+    _requestedMeshCount = 0;
+    _uploadedMeshCount = 0;
+    _lastSortMoveCount = 0;
+    _isSkyReached = false;
+    _potentiallyVisibleChunkCount = 0;
+    _maximumLevelOfDetail = 0;
+    _levelOfDetailChunkCounts.assign(CHUNK_LEVEL_OF_DETAIL_COUNT, 0);
+    _levelOfDetailChangeCount = 0;
+    _loadedChunkCount = 0;
+    _generatedChunkCount = 0;
+    _replayedEditCount = 0;
+    _initializationMilliseconds = 0.0;
+    _lastAutosaveTime = std::chrono::steady_clock::now();
+    _autosaveCount = 0;
+    _lastSaveMilliseconds = 0.0;
+    _maximumSaveMilliseconds = 0.0;
+
     if (p_isWorldSeedRandomized)
         p_worldSeed = GetRandomNumberInRange(0, 9999);
 
@@ -19,6 +65,8 @@ ChunkManager::ChunkManager(const bool p_isWorldSeedRandomized, int p_worldSeed,
     ChunksBlockSize = p_chunksBlockSize;
     ChunkCount = p_chunkCount;
     RenderingShader = p_renderingShader;
+    SaveDirectoryPath = WORLD_SAVE_DIRECTORY_PATH;
+    AutosaveIntervalSeconds = AUTOSAVE_INTERVAL_SECONDS;
 
     if (p_doesInit)
         Init();
@@ -26,16 +74,103 @@ ChunkManager::ChunkManager(const bool p_isWorldSeedRandomized, int p_worldSeed,
 
 ChunkManager::~ChunkManager()
 {
+    // NOTE : Its destructor waits until the edits are written (and for the loads it gave to the meshing thread pool)
+    if (_chunkStorage != nullptr)
+    {
+        SaveModifiedChunks();
+        delete _chunkStorage;
+    }
+
+    // NOTE : Deleted before the chunks, it waits for the running mesh jobs (their results are never applied)
+    delete _meshingThreadPool;
+
+    // NOTE : Deleted after the meshing thread pool, the mesh jobs use it
+    delete _meshCache;
+
     for (const GreedyChunk* chunk : _generatedChunks)
         delete chunk;
     
     _generatedChunks.clear();
+    _chunkDrawOrder.clear();
+
+    delete _occlusionCuller;
+
+    // NOTE : Deleted after the chunks, because they use it
+    delete _worldGenerator;
 }
 
 void ChunkManager::Init()
 {
+    const std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+
+    if (_meshingThreadPool == nullptr)
+        _meshingThreadPool = new ThreadPool();
+
+    if (IsPersistenceEnabled && _chunkStorage == nullptr)
+    {
+        // The loaded chunks are decompressed by the meshing threads, they are idle while the chunks are loaded
+        _chunkStorage = new ChunkStorage(SaveDirectoryPath, ChunkSize, _meshingThreadPool);
+
+        // The saved chunks were generated with the settings of their world, the new ones have to match them
+        if (_chunkStorage->LoadWorldSettings(WorldSeed, NoiseFrequency))
+        {
+            std::stringstream message;
+            message << "Loading the world saved inside '" << SaveDirectoryPath << "' (seed " << WorldSeed << ")";
+
+            PRINT_MESSAGE_RUNTIME(message.str())
+        }
+        else
+            _chunkStorage->SaveWorldSettings(WorldSeed, NoiseFrequency);
+
+        // NOTE : Opened with the final settings, its edits are only valid on the chunks generated with them
+        if (PersistenceMode == PersistenceModes::EditJournal && !_chunkStorage->OpenEditJournal(WorldSeed, NoiseFrequency))
+        {
+            PRINT_WARNING_RUNTIME(true, "The edit journal can't be used, the edited chunks will be saved as snapshots")
+            PersistenceMode = PersistenceModes::Snapshots;
+        }
+    }
+
+    if (IsMeshCacheEnabled && _chunkStorage != nullptr && _meshCache == nullptr)
+    {
+        _meshCache = new ChunkMeshCache(_chunkStorage->GetDirectoryPath() + "/" + MESH_CACHE_FILE_NAME, MESH_CACHE_MAXIMUM_BYTE_SIZE);
+
+        // The chunks are meshed as usual
+        if (!_meshCache->IsOpen())
+        {
+            delete _meshCache;
+            _meshCache = nullptr;
+        }
+    }
+
+    // One generator for the whole world, the chunks only keep a pointer to it
+    if (_worldGenerator == nullptr)
+        _worldGenerator = new WorldGenerator(WorldSeed, NoiseFrequency);
+
+    if (_occlusionCuller == nullptr)
+        _occlusionCuller = new OcclusionCuller(OCCLUSION_CULLING_DEFAULT_WIDTH, OCCLUSION_CULLING_DEFAULT_HEIGHT);
+
+    if (RenderingShader != nullptr)
+        _chunkOffsetUniformLocation = RenderingShader->GetUniformLocation("u_ChunkOffset");
+
+    // A level needs the chunk size to be divisible by its downsampling factor
+    _maximumLevelOfDetail = 0;
+
+    while (_maximumLevelOfDetail + 1 < CHUNK_LEVEL_OF_DETAIL_COUNT)
+    {
+        const int factor = 1 << (_maximumLevelOfDetail + 1);
+
+        if (ChunkSize.X % factor != 0 || ChunkSize.Y % factor != 0 || ChunkSize.Z % factor != 0)
+            break;
+
+        _maximumLevelOfDetail++;
+    }
+
     // Changing the size (in bytes) of the _generatedChunks list to the exact number we need
     _generatedChunks.reserve(static_cast<long long>(ChunkCount.X) * ChunkCount.Y);
+    _chunkDrawOrder.reserve(static_cast<long long>(ChunkCount.X) * ChunkCount.Y);
+
+    // The chunks saved in none of the region files
+    std::vector<Vector2Int> generatedChunkGridPositions;
 
     for (int x = -ChunkCount.X; x < ChunkCount.X; ++x)
     {
@@ -49,23 +184,522 @@ void ChunkManager::Init()
             );
 
             // Creating the chunk, and passing data to it
+            // NOTE : Not initialized, the mesh needs the blocks of the neighbors, so all the blocks are generated first
             GreedyChunk* newChunk = new GreedyChunk(
                 worldPosition,
-                WorldSeed,
-                NoiseFrequency,
+                _worldGenerator,
                 ChunkSize,
-                RenderingShader
+                RenderingShader,
+                ChunksBlockSize,
+                false
             );
 
+            // NOTE : The saved chunks are read by the storage's I/O thread while the main thread generates the others
+            if (_chunkStorage != nullptr && _chunkStorage->HasChunk(Vector2Int(x, z)))
+                _chunkStorage->RequestLoad(Vector2Int(x, z), worldPosition);
+            else
+            {
+                newChunk->GenerateBlocks();
+                generatedChunkGridPositions.push_back(Vector2Int(x, z));
+            }
+
             _generatedChunks.push_back(newChunk);
+
+            ChunkDrawEntry chunkDrawEntry;
+            chunkDrawEntry.Chunk = newChunk;
+            chunkDrawEntry.ChunkIndex = _generatedChunks.size() - 1;
+            _chunkDrawOrder.push_back(chunkDrawEntry);
+        }
+    }
+
+    _isChunkModified.assign(_generatedChunks.size(), 0);
+    _pendingChunkEdits.assign(_generatedChunks.size(), std::vector<ChunkEditJournal::BlockEdit>());
+
+    // - Loaded chunks - //
+
+    if (_chunkStorage != nullptr)
+    {
+        _chunkStorage->WaitForIdle();
+
+        std::vector<ChunkStorage::LoadResult> loadResults;
+        _chunkStorage->TakeFinishedLoads(loadResults);
+
+        for (ChunkStorage::LoadResult& loadResult : loadResults)
+        {
+            GreedyChunk* chunk = GetChunkAtGridPosition(loadResult.ChunkPosition);
+
+            if (loadResult.IsLoaded)
+                chunk->SetVoxelData(std::move(loadResult.VoxelData));
+            else
+            {
+                // Damaged on the disk, it's saved again below
+                chunk->GenerateBlocks();
+                generatedChunkGridPositions.push_back(loadResult.ChunkPosition);
+            }
+        }
+    }
+
+    // - Journal edits - //
+
+    if (_chunkStorage != nullptr && _chunkStorage->GetEditJournal() != nullptr && _chunkStorage->GetEditJournal()->GetEditCount() > 0)
+    {
+        std::vector<ChunkEditJournal::BlockEdit> chunkEdits;
+
+        for (size_t i = 0; i < _generatedChunks.size(); ++i)
+        {
+            chunkEdits.clear();
+            _chunkStorage->GetEditJournal()->GetChunkEdits(GetChunkGridPosition(i), chunkEdits);
+
+            // NOTE : The replayed edits are already saved, they are not added to the pending ones
+            for (const ChunkEditJournal::BlockEdit& chunkEdit : chunkEdits)
+            {
+                _generatedChunks[i]->SetBlockType(_generatedChunks[i]->GetVoxelData().GetBlockPosition(chunkEdit.BlockIndex), chunkEdit.NewType, false);
+                _replayedEditCount++;
+            }
         }
     }
+
+    _generatedChunkCount = static_cast<int>(generatedChunkGridPositions.size());
+    _loadedChunkCount = static_cast<int>(_generatedChunks.size()) - _generatedChunkCount;
+
+    for (int x = -ChunkCount.X; x < ChunkCount.X; ++x)
+    {
+        for (int z = -ChunkCount.Y; z < ChunkCount.Y; ++z)
+            RequestChunkMesh(Vector2Int(x, z));
+    }
+
+    // The world is complete on the first frame
+    WaitForMeshJobs();
+
+    _initializationMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+    // NOTE : Written in the background during the first frames, the next launches will load them instead of generating them
+    if (_chunkStorage != nullptr && PersistenceMode == PersistenceModes::Snapshots)
+    {
+        for (const Vector2Int& chunkGridPosition : generatedChunkGridPositions)
+            _chunkStorage->RequestSave(chunkGridPosition, GetChunkAtGridPosition(chunkGridPosition)->GetVoxelData());
+
+        _chunkStorage->RequestCommit();
+    }
+
+    _lastAutosaveTime = std::chrono::steady_clock::now();
 }
 
-void ChunkManager::DrawChunks() const
+void ChunkManager::Update()
 {
-    for (const GreedyChunk* chunk : _generatedChunks)
-        chunk->Draw();
+    std::vector<MeshJobResult> finishedMeshJobs;
+
+    {
+        std::lock_guard<std::mutex> lock(_finishedMeshJobsMutex);
+        finishedMeshJobs.swap(_finishedMeshJobs);
+    }
+
+    for (MeshJobResult& finishedMeshJob : finishedMeshJobs)
+    {
+        _pendingMeshJobCount--;
+
+        // The chunk was edited during the job, a newer job is already pending for it
+        if (!finishedMeshJob.Chunk->ApplyMeshData(finishedMeshJob.MeshData, finishedMeshJob.Version))
+            _discardedMeshCount++;
+        else
+            _uploadedMeshCount++;
+    }
+
+    // - Autosave - //
+
+    if (!IsAutosaveEnabled || _chunkStorage == nullptr)
+        return;
+
+    if (_chunkStorage->IsAutosaveDue(_lastAutosaveTime, AutosaveIntervalSeconds))
+    {
+        SaveModifiedChunks();
+
+        _lastAutosaveTime = std::chrono::steady_clock::now();
+        _autosaveCount++;
+    }
+}
+
+void ChunkManager::DrawChunks(const glm::dvec3& p_cameraPosition, const glm::mat4& p_cameraRelativeViewProjectionMatrix)
+{
+    UpdateLevelsOfDetail(p_cameraPosition);
+
+    if (IsCaveCullingEnabled)
+        UpdatePotentiallyVisibleChunks(p_cameraPosition);
+    else
+    {
+        _isChunkPotentiallyVisible.assign(_generatedChunks.size(), 1);
+        _visibilitySteps.clear();
+        _potentiallyVisibleChunkCount = static_cast<int>(_generatedChunks.size());
+    }
+
+    // NOTE : The occluders are the closest chunks, so the order is needed even if the chunks are drawn unsorted
+    if (IsSortingFrontToBack || IsOcclusionCullingEnabled)
+    {
+        for (ChunkDrawEntry& chunkDrawEntry : _chunkDrawOrder)
+            chunkDrawEntry.Depth = chunkDrawEntry.Chunk->GetDistanceTo(p_cameraPosition);
+
+        SortChunkDrawOrder();
+    }
+    else
+        _lastSortMoveCount = 0;
+
+    const bool isCulling = IsOcclusionCullingEnabled && _occlusionCuller != nullptr;
+
+    if (isCulling)
+    {
+        _occlusionCuller->BeginFrame(p_cameraRelativeViewProjectionMatrix, p_cameraPosition);
+
+        const size_t occluderChunkCount = std::min(_chunkDrawOrder.size(), static_cast<size_t>(OCCLUSION_CULLING_OCCLUDER_CHUNK_COUNT));
+
+        for (size_t i = 0; i < occluderChunkCount; ++i)
+        {
+            for (const OccluderBox& occluderBox : _chunkDrawOrder[i].Chunk->GetOccluderBoxes())
+                _occlusionCuller->AddOccluder(occluderBox);
+        }
+
+        _occlusionCuller->RasterizeOccluders();
+    }
+
+    glm::vec3 meshMinimumBounds;
+    glm::vec3 meshMaximumBounds;
+
+    if (!IsSortingFrontToBack)
+    {
+        // NOTE : A depth of 0 keeps the creation order inside the Renderer's queue too
+        for (size_t i = 0; i < _generatedChunks.size(); ++i)
+        {
+            const GreedyChunk* chunk = _generatedChunks[i];
+
+            if (!_isChunkPotentiallyVisible[i])
+                continue;
+
+            if (isCulling && chunk->GetMeshBounds(meshMinimumBounds, meshMaximumBounds) && !_occlusionCuller->IsVisible(meshMinimumBounds, meshMaximumBounds))
+                continue;
+
+            chunk->Draw(p_cameraPosition, 0.0f, _chunkOffsetUniformLocation);
+        }
+
+        return;
+    }
+
+    for (const ChunkDrawEntry& chunkDrawEntry : _chunkDrawOrder)
+    {
+        if (!_isChunkPotentiallyVisible[chunkDrawEntry.ChunkIndex])
+            continue;
+
+        if (isCulling && chunkDrawEntry.Chunk->GetMeshBounds(meshMinimumBounds, meshMaximumBounds) && !_occlusionCuller->IsVisible(meshMinimumBounds, meshMaximumBounds))
+            continue;
+
+        chunkDrawEntry.Chunk->Draw(p_cameraPosition, chunkDrawEntry.Depth, _chunkOffsetUniformLocation);
+    }
+}
+
+#pragma region // -=- Cave culling -=- //
+
+void ChunkManager::UpdatePotentiallyVisibleChunks(const glm::dvec3& p_cameraPosition)
+{
+    const int sectionCount = ChunkVisibility::GetSectionCount(ChunkSize);
+
+    _isChunkPotentiallyVisible.assign(_generatedChunks.size(), 0);
+    _visitedSectionFaces.assign(_generatedChunks.size() * sectionCount, 0);
+    _visibilitySteps.clear();
+    _isSkyReached = false;
+    _potentiallyVisibleChunkCount = 0;
+
+    const Vector3Int cameraBlockPosition = Vector3Int(
+        static_cast<int>(std::floor(p_cameraPosition.x / ChunksBlockSize)),
+        static_cast<int>(std::floor(p_cameraPosition.y / ChunksBlockSize)),
+        static_cast<int>(std::floor(p_cameraPosition.z / ChunksBlockSize))
+    );
+
+    const Vector2Int cameraChunkGridPosition = Vector2Int(
+        FloorDivide(cameraBlockPosition.X, ChunkSize.X),
+        FloorDivide(cameraBlockPosition.Z, ChunkSize.Z)
+    );
+
+    const long long cameraChunkIndex = GetChunkIndexAtGridPosition(cameraChunkGridPosition);
+
+    // - Starting the walk - //
+
+    // Outside the world (or under it) the sides of the world can be seen, nothing is culled
+    if (cameraChunkIndex < 0 || cameraBlockPosition.Y < 0)
+    {
+        _isChunkPotentiallyVisible.assign(_generatedChunks.size(), 1);
+        _potentiallyVisibleChunkCount = static_cast<int>(_generatedChunks.size());
+        return;
+    }
+
+    if (cameraBlockPosition.Y >= ChunkSize.Y)
+        WalkFromSky();
+    else
+    {
+        const size_t chunkIndex = static_cast<size_t>(cameraChunkIndex);
+        const int section = cameraBlockPosition.Y / CHUNK_VISIBILITY_SECTION_HEIGHT;
+
+        _isChunkPotentiallyVisible[chunkIndex] = 1;
+        _visitedSectionFaces[chunkIndex * sectionCount + section] = ChunkFaceConnectivity::ALL_FACES;
+
+        // NOTE : Only the faces reachable from the camera's own air region (a closed cave next to the camera does not count)
+        const unsigned char reachableFaces = _generatedChunks[chunkIndex]->GetFacesReachableFrom(Vector3Int(
+            cameraBlockPosition.X - cameraChunkGridPosition.X * ChunkSize.X,
+            cameraBlockPosition.Y,
+            cameraBlockPosition.Z - cameraChunkGridPosition.Y * ChunkSize.Z
+        ));
+
+        for (int face = 0; face < FaceDirectionCount; ++face)
+        {
+            if ((reachableFaces >> face) & 1)
+                WalkThroughFace(chunkIndex, section, static_cast<FaceDirections>(face), 0);
+        }
+    }
+
+    // - Walking (breadth first) - //
+
+    // NOTE : The steps are added at the end while walking, the list is read with an index (a copy is taken, the list can grow)
+    for (size_t stepIndex = 0; stepIndex < _visibilitySteps.size(); ++stepIndex)
+    {
+        const VisibilityStep step = _visibilitySteps[stepIndex];
+
+        const std::vector<ChunkFaceConnectivity>& sectionConnectivities = _generatedChunks[step.ChunkIndex]->GetSectionConnectivities();
+
+        // Not meshed yet : the connectivity is unknown, all the faces are considered connected
+        const bool isConnectivityKnown = step.Section < static_cast<int>(sectionConnectivities.size());
+
+        for (int face = 0; face < FaceDirectionCount; ++face)
+        {
+            const FaceDirections exitFace = static_cast<FaceDirections>(face);
+
+            if (isConnectivityKnown && !sectionConnectivities[step.Section].AreConnected(step.EntryFace, exitFace))
+                continue;
+
+            // Going back toward the camera, what is there was already reached by a shorter path (or hidden behind us)
+            if ((step.WalkedDirections >> ChunkFaceConnectivity::GetOppositeFace(exitFace)) & 1)
+                continue;
+
+            WalkThroughFace(step.ChunkIndex, step.Section, exitFace, step.WalkedDirections);
+        }
+    }
+
+    for (const unsigned char isChunkPotentiallyVisible : _isChunkPotentiallyVisible)
+        _potentiallyVisibleChunkCount += isChunkPotentiallyVisible;
+}
+
+void ChunkManager::WalkThroughFace(const size_t p_chunkIndex, const int p_section, const FaceDirections p_exitFace, unsigned char p_walkedDirections)
+{
+    p_walkedDirections |= 1 << p_exitFace;
+
+    size_t neighborChunkIndex = p_chunkIndex;
+    int neighborSection = p_section;
+
+    switch (p_exitFace)
+    {
+        case PositiveY:
+            // Out of the top of the world
+            if (p_section + 1 >= ChunkVisibility::GetSectionCount(ChunkSize))
+            {
+                WalkFromSky();
+                return;
+            }
+
+            neighborSection++;
+            break;
+
+        case NegativeY:
+            // Nothing under the world
+            if (p_section == 0)
+                return;
+
+            neighborSection--;
+            break;
+
+        default:
+        {
+            Vector2Int neighborGridPosition = GetChunkGridPosition(p_chunkIndex);
+
+            if (p_exitFace == PositiveX) neighborGridPosition.X++;
+            if (p_exitFace == NegativeX) neighborGridPosition.X--;
+            if (p_exitFace == PositiveZ) neighborGridPosition.Y++;
+            if (p_exitFace == NegativeZ) neighborGridPosition.Y--;
+
+            const long long gridChunkIndex = GetChunkIndexAtGridPosition(neighborGridPosition);
+
+            // The border of the world
+            if (gridChunkIndex < 0)
+                return;
+
+            neighborChunkIndex = static_cast<size_t>(gridChunkIndex);
+            break;
+        }
+    }
+
+    VisitSection(neighborChunkIndex, neighborSection, ChunkFaceConnectivity::GetOppositeFace(p_exitFace), p_walkedDirections);
+}
+
+void ChunkManager::WalkFromSky()
+{
+    if (_isSkyReached)
+        return;
+
+    _isSkyReached = true;
+
+    const int topSection = ChunkVisibility::GetSectionCount(ChunkSize) - 1;
+
+    // NOTE : Coming from the sky, the only direction walked is going down
+    for (size_t chunkIndex = 0; chunkIndex < _generatedChunks.size(); ++chunkIndex)
+        VisitSection(chunkIndex, topSection, PositiveY, 1 << NegativeY);
+}
+
+void ChunkManager::VisitSection(const size_t p_chunkIndex, const int p_section, const FaceDirections p_entryFace, const unsigned char p_walkedDirections)
+{
+    unsigned char& visitedFaces = _visitedSectionFaces[p_chunkIndex * ChunkVisibility::GetSectionCount(ChunkSize) + p_section];
+
+    if ((visitedFaces >> p_entryFace) & 1)
+        return;
+
+    visitedFaces |= 1 << p_entryFace;
+    _isChunkPotentiallyVisible[p_chunkIndex] = 1;
+
+    VisibilityStep step;
+    step.ChunkIndex = p_chunkIndex;
+    step.Section = p_section;
+    step.EntryFace = p_entryFace;
+    step.WalkedDirections = p_walkedDirections;
+
+    _visibilitySteps.push_back(step);
+}
+
+#pragma endregion
+
+void ChunkManager::SortChunkDrawOrder()
+{
+    _lastSortMoveCount = 0;
+
+    for (size_t i = 1; i < _chunkDrawOrder.size(); ++i)
+    {
+        // Already at its place (the common case, the order of the last frame is kept)
+        if (_chunkDrawOrder[i - 1].Depth <= _chunkDrawOrder[i].Depth)
+            continue;
+
+        const ChunkDrawEntry movedChunkDrawEntry = _chunkDrawOrder[i];
+        size_t j = i;
+
+        while (j > 0 && _chunkDrawOrder[j - 1].Depth > movedChunkDrawEntry.Depth)
+        {
+            _chunkDrawOrder[j] = _chunkDrawOrder[j - 1];
+            j--;
+        }
+
+        _chunkDrawOrder[j] = movedChunkDrawEntry;
+        _lastSortMoveCount++;
+    }
+}
+
+void ChunkManager::SetBlockType(const Vector3Int& p_worldBlockPosition, const BlockTypes p_newBlockType)
+{
+    const Vector2Int chunkGridPosition = Vector2Int(
+        FloorDivide(p_worldBlockPosition.X, ChunkSize.X),
+        FloorDivide(p_worldBlockPosition.Z, ChunkSize.Z)
+    );
+
+    GreedyChunk* chunk = GetChunkAtGridPosition(chunkGridPosition);
+
+    #pragma region Security
+
+    if (chunk == nullptr || p_worldBlockPosition.Y < 0 || p_worldBlockPosition.Y >= ChunkSize.Y)
+    {
+        std::stringstream errorMessage;
+        errorMessage << "The given block position ("
+        << p_worldBlockPosition.X << ", " << p_worldBlockPosition.Y << ", " << p_worldBlockPosition.Z << ") is outside the generated chunks";
+
+        PRINT_ERROR_RUNTIME(true, errorMessage.str())
+        return;
+    }
+    #pragma endregion
+
+    const Vector3Int chunkBlockPosition = Vector3Int(
+        p_worldBlockPosition.X - chunkGridPosition.X * ChunkSize.X,
+        p_worldBlockPosition.Y,
+        p_worldBlockPosition.Z - chunkGridPosition.Y * ChunkSize.Z
+    );
+
+    const size_t chunkIndex = static_cast<size_t>(GetChunkIndexAtGridPosition(chunkGridPosition));
+
+    // NOTE : Without the storage (IsPersistenceEnabled false, like in the benchmark) nothing would ever save and clear the edits
+    if (_chunkStorage != nullptr && PersistenceMode == PersistenceModes::EditJournal)
+    {
+        ChunkEditJournal::BlockEdit blockEdit;
+        blockEdit.BlockIndex = chunk->GetVoxelData().GetBlockIndex(chunkBlockPosition);
+        blockEdit.OldType = chunk->GetVoxelData().GetBlock(chunkBlockPosition);
+        blockEdit.NewType = p_newBlockType;
+
+        ChunkEditJournal::MergeEdit(_pendingChunkEdits[chunkIndex], blockEdit);
+    }
+
+    chunk->SetBlockType(chunkBlockPosition, p_newBlockType, false);
+    RequestChunkMesh(chunkGridPosition);
+
+    _isChunkModified[chunkIndex] = 1;
+
+    // - Neighbors touching the block - //
+
+    Vector2Int neighborGridPositions[2];
+    int neighborCount = 0;
+
+    if (chunkBlockPosition.X == 0)
+        neighborGridPositions[neighborCount++] = Vector2Int(chunkGridPosition.X - 1, chunkGridPosition.Y);
+    else if (chunkBlockPosition.X == ChunkSize.X - 1)
+        neighborGridPositions[neighborCount++] = Vector2Int(chunkGridPosition.X + 1, chunkGridPosition.Y);
+
+    if (chunkBlockPosition.Z == 0)
+        neighborGridPositions[neighborCount++] = Vector2Int(chunkGridPosition.X, chunkGridPosition.Y - 1);
+    else if (chunkBlockPosition.Z == ChunkSize.Z - 1)
+        neighborGridPositions[neighborCount++] = Vector2Int(chunkGridPosition.X, chunkGridPosition.Y + 1);
+
+    for (int i = 0; i < neighborCount; ++i)
+    {
+        GreedyChunk* neighborChunk = GetChunkAtGridPosition(neighborGridPositions[i]);
+
+        if (neighborChunk == nullptr)
+            continue;
+
+        // The blocks of the neighbor did not change, but the mesh jobs already running for it read the old border
+        neighborChunk->MarkMeshOutdated();
+        RequestChunkMesh(neighborGridPositions[i]);
+    }
+}
+
+void ChunkManager::WaitForMeshJobs()
+{
+    if (_meshingThreadPool != nullptr)
+        _meshingThreadPool->WaitForIdle();
+
+    Update();
+}
+
+void ChunkManager::SaveModifiedChunks()
+{
+    if (_chunkStorage == nullptr)
+        return;
+
+    const std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < _generatedChunks.size(); ++i)
+    {
+        if (!_isChunkModified[i])
+            continue;
+
+        // NOTE : The chunks are never unloaded, the write does not have to be finished before the next edits
+        _chunkStorage->RequestChunkSave(GetChunkGridPosition(i), _generatedChunks[i]->GetVoxelData(), _pendingChunkEdits[i],
+            PersistenceMode == PersistenceModes::EditJournal);
+
+        _isChunkModified[i] = 0;
+        _pendingChunkEdits[i].clear();
+    }
+
+    _chunkStorage->RequestCommit();
+
+    _lastSaveMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+    _maximumSaveMilliseconds = std::max(_maximumSaveMilliseconds, _lastSaveMilliseconds);
 }
 
 GreedyChunk* ChunkManager::GetChunk(const Vector2Int& p_chunkIndex) const
@@ -106,4 +740,156 @@ bool ChunkManager::IsOutsideChunks(const Vector2Int& p_chunkIndex) const
     }
     
     return false;
+}
+
+GreedyChunk* ChunkManager::GetChunkAtGridPosition(const Vector2Int& p_chunkGridPosition) const
+{
+    const long long chunkIndex = GetChunkIndexAtGridPosition(p_chunkGridPosition);
+
+    return chunkIndex >= 0 ? _generatedChunks[static_cast<size_t>(chunkIndex)] : nullptr;
+}
+
+long long ChunkManager::GetChunkIndexAtGridPosition(const Vector2Int& p_chunkGridPosition) const
+{
+    if (p_chunkGridPosition.X < -ChunkCount.X || p_chunkGridPosition.X >= ChunkCount.X ||
+        p_chunkGridPosition.Y < -ChunkCount.Y || p_chunkGridPosition.Y >= ChunkCount.Y)
+    {
+        return -1;
+    }
+
+    // Same order as the creation in Init()
+    const long long chunkIndex = static_cast<long long>(p_chunkGridPosition.X + ChunkCount.X) * (ChunkCount.Y * 2) + (p_chunkGridPosition.Y + ChunkCount.Y);
+
+    return chunkIndex < static_cast<long long>(_generatedChunks.size()) ? chunkIndex : -1;
+}
+
+Vector2Int ChunkManager::GetChunkGridPosition(const size_t p_chunkIndex) const
+{
+    // Same order as the creation in Init()
+    const int gridRowSize = ChunkCount.Y * 2;
+
+    return Vector2Int(
+        static_cast<int>(p_chunkIndex / gridRowSize) - ChunkCount.X,
+        static_cast<int>(p_chunkIndex % gridRowSize) - ChunkCount.Y
+    );
+}
+
+void ChunkManager::RequestChunkMesh(const Vector2Int& p_chunkGridPosition)
+{
+    GreedyChunk* chunk = GetChunkAtGridPosition(p_chunkGridPosition);
+
+    if (chunk == nullptr)
+        return;
+
+    if (!chunk->HasVoxelData())
+        chunk->GenerateBlocks();
+
+    // - Taking the snapshots (main thread) - //
+
+    // NOTE : Only a reference is taken, the blocks are copied only if the chunk is edited before the end of the job
+    const ChunkVoxelData voxelDataSnapshot = chunk->GetVoxelData();
+
+    const int levelOfDetail = chunk->GetLevelOfDetail();
+
+    // Same order as the ChunkBorderPlanes::Sides enum
+    const Vector2Int neighborOffsets[ChunkBorderPlanes::SideCount] =
+    {
+        Vector2Int(-1, 0), Vector2Int(1, 0), Vector2Int(0, -1), Vector2Int(0, 1)
+    };
+
+    ChunkBorderPlanes borderPlanes(ChunkSize);
+
+    for (int side = 0; side < ChunkBorderPlanes::SideCount; ++side)
+    {
+        const GreedyChunk* neighborChunk = GetChunkAtGridPosition(Vector2Int(
+            p_chunkGridPosition.X + neighborOffsets[side].X,
+            p_chunkGridPosition.Y + neighborOffsets[side].Y
+        ));
+
+        // NOTE : The downsampled meshes keep their border faces, they are the skirts hiding the cracks with the neighbors
+        if (levelOfDetail == 0 && neighborChunk != nullptr && neighborChunk->HasVoxelData())
+            borderPlanes.CaptureSide(static_cast<ChunkBorderPlanes::Sides>(side), neighborChunk->GetVoxelData());
+    }
+
+    // - Meshing (worker thread) - //
+
+    const unsigned int version = chunk->GetVersion();
+    const int blockSize = chunk->BlockSize;
+
+    _pendingMeshJobCount++;
+    _requestedMeshCount++;
+
+    _meshingThreadPool->Submit([this, chunk, version, blockSize, levelOfDetail, voxelDataSnapshot, borderPlanes]
+    {
+        MeshJobResult meshJobResult;
+        meshJobResult.Chunk = chunk;
+        meshJobResult.Version = version;
+
+        // NOTE : The key is made from the snapshot, a chunk edited since its mesh was cached gets another key (it's meshed again)
+        const uint64_t meshCacheKey = _meshCache != nullptr ?
+            ChunkMeshCache::ComputeKey(voxelDataSnapshot, levelOfDetail > 0 ? nullptr : &borderPlanes, levelOfDetail, blockSize) : 0;
+
+        const Vector3 chunkOrigin = voxelDataSnapshot.WorldPosition * blockSize;
+
+        if (_meshCache == nullptr || !_meshCache->Load(meshCacheKey, chunkOrigin, meshJobResult.MeshData))
+        {
+            if (levelOfDetail > 0)
+                GreedyMesher::GenerateLevelOfDetailMesh(voxelDataSnapshot, blockSize, levelOfDetail, MeshingContext::GetThreadContext(), meshJobResult.MeshData);
+            else
+                GreedyMesher::GenerateMesh(voxelDataSnapshot, blockSize, MeshingContext::GetThreadContext(), meshJobResult.MeshData, &borderPlanes);
+
+            if (_meshCache != nullptr)
+                _meshCache->Store(meshCacheKey, chunkOrigin, meshJobResult.MeshData);
+        }
+
+        std::lock_guard<std::mutex> lock(_finishedMeshJobsMutex);
+        _finishedMeshJobs.push_back(std::move(meshJobResult));
+    });
+}
+
+int ChunkManager::GetLevelOfDetailChunkCount(const int p_levelOfDetail) const
+{
+    if (p_levelOfDetail < 0 || p_levelOfDetail >= static_cast<int>(_levelOfDetailChunkCounts.size()))
+        return 0;
+
+    return _levelOfDetailChunkCounts[p_levelOfDetail];
+}
+
+void ChunkManager::UpdateLevelsOfDetail(const glm::dvec3& p_cameraPosition)
+{
+    std::fill(_levelOfDetailChunkCounts.begin(), _levelOfDetailChunkCounts.end(), 0);
+
+    for (size_t i = 0; i < _generatedChunks.size(); ++i)
+    {
+        GreedyChunk* chunk = _generatedChunks[i];
+
+        const int currentLevelOfDetail = chunk->GetLevelOfDetail();
+        const int levelOfDetail = IsLevelOfDetailEnabled ? ChooseLevelOfDetail(currentLevelOfDetail, chunk->GetDistanceTo(p_cameraPosition)) : 0;
+
+        if (levelOfDetail != currentLevelOfDetail)
+        {
+            // The old mesh stays drawn until the new one is applied by Update()
+            chunk->SetLevelOfDetail(levelOfDetail);
+            RequestChunkMesh(GetChunkGridPosition(i));
+
+            _levelOfDetailChangeCount++;
+        }
+
+        _levelOfDetailChunkCounts[chunk->GetMeshLevelOfDetail()]++;
+    }
+}
+
+int ChunkManager::ChooseLevelOfDetail(int p_currentLevelOfDetail, const float p_distance) const
+{
+    p_currentLevelOfDetail = std::min(p_currentLevelOfDetail, _maximumLevelOfDetail);
+
+    // Going to a coarser level once past the threshold, plus the hysteresis
+    while (p_currentLevelOfDetail < _maximumLevelOfDetail && p_distance > CHUNK_LEVEL_OF_DETAIL_DISTANCES[p_currentLevelOfDetail] + CHUNK_LEVEL_OF_DETAIL_HYSTERESIS)
+        p_currentLevelOfDetail++;
+
+    // Going back to a finer level once before the threshold, minus the hysteresis
+    while (p_currentLevelOfDetail > 0 && p_distance < CHUNK_LEVEL_OF_DETAIL_DISTANCES[p_currentLevelOfDetail - 1] - CHUNK_LEVEL_OF_DETAIL_HYSTERESIS)
+        p_currentLevelOfDetail--;
+
+    return p_currentLevelOfDetail;
 }
\ No newline at end of file
@@ -1,16 +1,42 @@
 #pragma once
 
+#include <chrono>
+#include <mutex>
+#include <string>
 #include <vector>
 
+#include "GLM/glm.hpp"
+
 #include "Vector.h"
 
+#include "../ChunkMeshData.h"
+#include "../EnvironmentEnums.h"
+
+#include "../ChunkStorage/ChunkEditJournal.h"
+
+class ChunkMeshCache;
+class ChunkStorage;
 class Shader;
 class GreedyChunk;
+class OcclusionCuller;
+class ThreadPool;
+class WorldGenerator;
 
 class ChunkManager
 {
     
 public:
+
+    enum class PersistenceModes
+    {
+        /// <summary> The whole blocks of the generated and edited chunks are saved inside the region files. </summary>
+        Snapshots,
+
+        /// <summary>
+        /// Only the edited blocks are saved (see ChunkEditJournal), the chunks are generated again and the edits replayed on them.
+        /// <para> A chunk with too many edits is saved as a snapshot instead, its edits are cleared. </para> </summary>
+        EditJournal
+    };
     
     /// <summary> The world seed, changing it change how the word is generated. </summary>
     int WorldSeed = 1789;
@@ -35,9 +61,158 @@ public:
     /// <para> The shader that will be used to render chunk's vertices. </para> </summary>
     Shader* RenderingShader = nullptr;
 
+    /// <summary> Draws the closest chunks first, so the depth test rejects the hidden fragments before they are shaded (early-Z). </summary>
+    bool IsSortingFrontToBack = true;
+
+    /// <summary> Skips the chunks hidden behind the closest ones, tested on the CPU (see OcclusionCuller). </summary>
+    bool IsOcclusionCullingEnabled = true;
+
+    /// <summary> Only draws the chunks reachable from the camera through the air (see ChunkVisibility), tested before the occlusion culling. </summary>
+    bool IsCaveCullingEnabled = true;
+
+    /// <summary> Meshes the chunks far from the camera from downsampled blocks (see GreedyMesher::GenerateLevelOfDetailMesh()). </summary>
+    bool IsLevelOfDetailEnabled = true;
+
+    /// <summary>
+    /// Loads the saved chunks instead of generating them, and saves the modified ones (see ChunkStorage and PersistenceMode).
+    /// <para> Must be set before Init(), like SaveDirectoryPath. </para> </summary>
+    bool IsPersistenceEnabled = true;
+
+    /// <summary> Must be set before Init(), falls back to Snapshots if the edit journal can't be opened. </summary>
+    PersistenceModes PersistenceMode = PersistenceModes::EditJournal;
+
+    /// <summary> The directory of the saved world, a saved world keeps its own WorldSeed and NoiseFrequency. </summary>
+    std::string SaveDirectoryPath;
+
+    /// <summary> Saves the modified chunks every AutosaveIntervalSeconds (see Update()), they are written in the background. </summary>
+    bool IsAutosaveEnabled = true;
+    float AutosaveIntervalSeconds;
+
+    /// <summary>
+    /// Keeps the finished meshes inside the save directory (see ChunkMeshCache), the next launches only mesh the chunks that changed.
+    /// <para> Must be set before Init(), only used when IsPersistenceEnabled is true. </para> </summary>
+    bool IsMeshCacheEnabled = true;
+
 private:
 
+    /// <summary> A chunk and its distance to the camera during the last DrawChunks(). </summary>
+    struct ChunkDrawEntry
+    {
+        GreedyChunk* Chunk = nullptr;
+        float Depth = 0.0f;
+
+        /// <summary> The index of the chunk inside _generatedChunks. </summary>
+        size_t ChunkIndex = 0;
+    };
+
+    /// <summary> One step of the cave culling walk : a chunk section entered through one of its faces. </summary>
+    struct VisibilityStep
+    {
+        size_t ChunkIndex;
+        int Section;
+        FaceDirections EntryFace;
+
+        /// <summary> The directions already walked (one bit per FaceDirections), the walk never turns back toward the camera. </summary>
+        unsigned char WalkedDirections;
+    };
+
+    /// <summary> The mesh created by a mesh job, waiting to be applied by Update() on the main thread. </summary>
+    struct MeshJobResult
+    {
+        GreedyChunk* Chunk = nullptr;
+
+        /// <summary> The version of the chunk when the job was created (see GreedyChunk::GetVersion()). </summary>
+        unsigned int Version = 0;
+
+        ChunkMeshData MeshData;
+    };
+
+    /// <summary> Created by Init() with the WorldSeed and NoiseFrequency, shared by all the chunks. </summary>
+    WorldGenerator* _worldGenerator;
+
+    /// <summary> Runs the mesh jobs, created by Init(). </summary>
+    ThreadPool* _meshingThreadPool;
+
+    /// <summary> Created by Init(), used by DrawChunks() when IsOcclusionCullingEnabled is true. </summary>
+    OcclusionCuller* _occlusionCuller;
+
+    /// <summary> Created by Init() when IsPersistenceEnabled is true, nullptr otherwise. </summary>
+    ChunkStorage* _chunkStorage;
+
+    /// <summary> Created by Init() when IsPersistenceEnabled and IsMeshCacheEnabled are true (and the file can be used), nullptr otherwise. </summary>
+    ChunkMeshCache* _meshCache;
+
+    /// <summary> The location of the RenderingShader's 'u_ChunkOffset', looked up once by Init() instead of once per chunk drawn. </summary>
+    int _chunkOffsetUniformLocation;
+
+    // NOTE : Stored x by x (the z of the same x are next to each other), see GetChunkAtGridPosition()
     std::vector<GreedyChunk*> _generatedChunks;
+
+    // NOTE : Kept sorted from frame to frame, the camera moves a little each frame so the order barely changes
+    std::vector<ChunkDrawEntry> _chunkDrawOrder;
+    
+    // The number of chunks moved by the last sort (0 when the order did not change)
+    int _lastSortMoveCount;
+
+    // - Cave culling - //
+
+    // NOTE : Indexed like _generatedChunks, refreshed by each DrawChunks()
+    std::vector<unsigned char> _isChunkPotentiallyVisible;
+
+    /// <summary> The faces each section was already entered through (one bit per FaceDirections), sections of a chunk are next to each other. </summary>
+    std::vector<unsigned char> _visitedSectionFaces;
+
+    /// <summary> The walk queue (only grows, read with an index), kept to not allocate each frame. </summary>
+    std::vector<VisibilityStep> _visibilitySteps;
+
+    bool _isSkyReached;
+    int _potentiallyVisibleChunkCount;
+
+    // - Levels of detail - //
+
+    /// <summary> The last level usable with the ChunkSize (a 4x downsampling needs a size divisible by 4), set by Init(). </summary>
+    int _maximumLevelOfDetail;
+
+    // NOTE : One count per level of the meshes on the GPU, refreshed by each DrawChunks()
+    std::vector<int> _levelOfDetailChunkCounts;
+
+    unsigned long long _levelOfDetailChangeCount;
+
+    // - Persistence - //
+
+    // NOTE : Indexed like _generatedChunks, 1 if the chunk was edited since it was last saved
+    std::vector<unsigned char> _isChunkModified;
+
+    // NOTE : Indexed like _generatedChunks, the edits since the last save (EditJournal mode with the persistence enabled only)
+    std::vector<std::vector<ChunkEditJournal::BlockEdit>> _pendingChunkEdits;
+
+    int _replayedEditCount;
+
+    std::chrono::steady_clock::time_point _lastAutosaveTime;
+    int _autosaveCount;
+
+    // NOTE : The time SaveModifiedChunks() blocks the main thread (the snapshots and the requests), the writes are not included
+    double _lastSaveMilliseconds;
+    double _maximumSaveMilliseconds;
+
+    int _loadedChunkCount;
+    int _generatedChunkCount;
+    double _initializationMilliseconds;
+
+    // - Mesh jobs - //
+
+    std::mutex _finishedMeshJobsMutex;
+
+    /// <summary> Filled by the worker threads, emptied by Update(). </summary>
+    std::vector<MeshJobResult> _finishedMeshJobs;
+
+    // NOTE : Only used on the main thread
+    int _pendingMeshJobCount;
+    unsigned long long _discardedMeshCount;
+
+    // NOTE : Since Init(), the benchmark counts them per frame
+    unsigned long long _requestedMeshCount;
+    unsigned long long _uploadedMeshCount;
     
 public:
     
@@ -48,12 +223,123 @@ public:
 
     void Init();
 
-    void DrawChunks() const;
+    /// <summary> Sends the meshes finished by the worker threads to the GPU (the outdated ones are discarded), call it once per frame.
+    /// <para> Also starts the autosave when it is time (see IsAutosaveEnabled). </para> </summary>
+    void Update();
+
+    /// <summary> Queues the chunks inside the Renderer, they are drawn by Renderer::FlushQueue().
+    /// <para> The chunks are drawn relative to the given camera position, see Camera::GetRotationViewMatrix(). </para>
+    /// <para> With IsSortingFrontToBack the closest chunks are drawn first. </para>
+    /// <para> With IsCaveCullingEnabled the chunks that can't be reached from the camera through the air are not queued. </para>
+    /// <para> With IsOcclusionCullingEnabled the closest chunks are rasterized as occluders first, the hidden chunks are not queued. </para> </summary>
+    /// <param name = "p_cameraRelativeViewProjectionMatrix"> The projection and the camera rotation only (see FrameUniformData) </param>
+    void DrawChunks(const glm::dvec3& p_cameraPosition, const glm::mat4& p_cameraRelativeViewProjectionMatrix);
+
+    /// <summary>
+    /// Changes a block (the position is in blocks, in world space), its chunk is re-meshed by a mesh job.
+    /// <para> The neighbor chunks touching the block are re-meshed too, because the block can hide one of their faces. </para> </summary>
+    void SetBlockType(const Vector3Int& p_worldBlockPosition, const BlockTypes p_newBlockType);
+
+    /// <summary> Blocks the main thread until all the mesh jobs are finished and applied. </summary>
+    void WaitForMeshJobs();
+
+    /// <summary>
+    /// Saves the chunks edited since their last save, as edits or as snapshots (see PersistenceMode), done by the autosave and by the destructor too.
+    /// <para> Only takes snapshots of the chunks (copy-on-write, see ChunkVoxelData) : the storage's I/O thread compresses and writes them,
+    /// then commits them as one save (see ChunkStorage). </para> </summary>
+    void SaveModifiedChunks();
+
+    /// <summary> nullptr when IsPersistenceEnabled was false during Init(). </summary>
+    ChunkStorage* GetChunkStorage() const { return _chunkStorage; }
+
+    /// <summary> nullptr when the mesh cache is disabled, or if its file can't be used. </summary>
+    ChunkMeshCache* GetMeshCache() const { return _meshCache; }
+
+    /// <summary> The chunks loaded from the disk and the ones generated by Init(). </summary>
+    int GetLoadedChunkCount() const { return _loadedChunkCount; }
+    int GetGeneratedChunkCount() const { return _generatedChunkCount; }
+
+    int GetAutosaveCount() const { return _autosaveCount; }
+
+    /// <summary> The time the last SaveModifiedChunks() call (and the slowest one) blocked the main thread. </summary>
+    double GetLastSaveMilliseconds() const { return _lastSaveMilliseconds; }
+    double GetMaximumSaveMilliseconds() const { return _maximumSaveMilliseconds; }
+
+    /// <summary> The edits of the journal replayed on the generated chunks by Init(). </summary>
+    int GetReplayedEditCount() const { return _replayedEditCount; }
+
+    /// <summary> The time Init() took to load or generate all the chunks and to mesh them. </summary>
+    double GetInitializationMilliseconds() const { return _initializationMilliseconds; }
+
+    int GetPendingMeshJobCount() const { return _pendingMeshJobCount; }
+
+    /// <summary> The number of meshes thrown away because their chunk changed during the job. </summary>
+    unsigned long long GetDiscardedMeshCount() const { return _discardedMeshCount; }
+
+    /// <summary> The mesh jobs created since Init() (a chunk generated, edited or changing its level of detail), and the meshes sent to the GPU. </summary>
+    unsigned long long GetRequestedMeshCount() const { return _requestedMeshCount; }
+    unsigned long long GetUploadedMeshCount() const { return _uploadedMeshCount; }
+
+    int GetLastSortMoveCount() const { return _lastSortMoveCount; }
+
+    /// <summary> Gives the statistics of the last DrawChunks() and the depth buffer resolution, nullptr before Init(). </summary>
+    OcclusionCuller* GetOcclusionCuller() const { return _occlusionCuller; }
+
+    /// <summary> The chunks kept by the cave culling during the last DrawChunks() (all of them when it's disabled). </summary>
+    int GetPotentiallyVisibleChunkCount() const { return _potentiallyVisibleChunkCount; }
+
+    /// <summary> The number of section faces walked through by the last cave culling. </summary>
+    int GetVisitedSectionCount() const { return static_cast<int>(_visibilitySteps.size()); }
+
+    /// <summary> The number of chunks drawn with the given level of detail during the last DrawChunks() (their mesh, not the requested level). </summary>
+    int GetLevelOfDetailChunkCount(const int p_levelOfDetail) const;
+
+    /// <summary> The number of times a chunk changed its level of detail (each one re-meshed it). </summary>
+    unsigned long long GetLevelOfDetailChangeCount() const { return _levelOfDetailChangeCount; }
     
     GreedyChunk* GetChunk(const Vector2Int& p_chunkIndex) const;
+
+    const WorldGenerator* GetWorldGenerator() const { return _worldGenerator; }
     
 private:
     
     static int GetRandomNumberInRange(const int p_minimum, const int p_maximum);
     bool IsOutsideChunks(const Vector2Int& p_chunkIndex) const;
+
+    /// <summary> The grid position goes from -ChunkCount to ChunkCount - 1, returns nullptr outside. </summary>
+    GreedyChunk* GetChunkAtGridPosition(const Vector2Int& p_chunkGridPosition) const;
+
+    /// <summary> Returns the index of the chunk inside _generatedChunks, -1 outside. </summary>
+    long long GetChunkIndexAtGridPosition(const Vector2Int& p_chunkGridPosition) const;
+
+    /// <summary> The opposite of GetChunkIndexAtGridPosition(). </summary>
+    Vector2Int GetChunkGridPosition(const size_t p_chunkIndex) const;
+
+    /// <summary> Takes a snapshot of the chunk and of its neighbors' border blocks, then meshes it on a worker thread (or takes its cached mesh). </summary>
+    void RequestChunkMesh(const Vector2Int& p_chunkGridPosition);
+
+    // - Levels of detail - //
+
+    /// <summary> Picks the level of each chunk from its distance to the camera, the chunks changing level are re-meshed by a mesh job. </summary>
+    void UpdateLevelsOfDetail(const glm::dvec3& p_cameraPosition);
+
+    /// <summary> The level of detail for the given distance, with a hysteresis around the thresholds (see CHUNK_LEVEL_OF_DETAIL_HYSTERESIS). </summary>
+    int ChooseLevelOfDetail(int p_currentLevelOfDetail, const float p_distance) const;
+
+    // - Cave culling - //
+
+    /// <summary> Walks from the camera's section to the next ones through the connected faces (breadth first), fills _isChunkPotentiallyVisible. </summary>
+    void UpdatePotentiallyVisibleChunks(const glm::dvec3& p_cameraPosition);
+
+    /// <summary> Leaves the section through the given face, the section behind it is added to the walk (if it was not entered through that face yet). </summary>
+    void WalkThroughFace(size_t p_chunkIndex, int p_section, FaceDirections p_exitFace, unsigned char p_walkedDirections);
+
+    /// <summary> Going out of the top of the world : all the chunks can be entered from the sky (done once per walk). </summary>
+    void WalkFromSky();
+
+    /// <summary> Marks the section as entered through the given face and adds it to the walk, does nothing if it already was. </summary>
+    void VisitSection(size_t p_chunkIndex, int p_section, FaceDirections p_entryFace, unsigned char p_walkedDirections);
+
+    /// <summary> Insertion sort by depth, close to O(n) because the order of the last frame is almost right. </summary>
+    void SortChunkDrawOrder();
 };
\ No newline at end of file
@@ -3,19 +3,123 @@
 #include <vector>
 
 #include "Vertex.h"
-#include "IndexBufferObject.h"
 
+/// <summary> The direction a quad is facing, the index buffer of a chunk mesh is split into one range per direction. </summary>
+enum FaceDirections
+{
+    PositiveX,
+    NegativeX,
+    PositiveY,
+    NegativeY,
+    PositiveZ,
+    NegativeZ,
+    
+    FaceDirectionCount
+};
+
+/// <summary> Which faces of a chunk section can see each other through the non-solid blocks (see ChunkVisibility). </summary>
+struct ChunkFaceConnectivity
+{
+    /// <summary> The bit N of the entry F is set if the face F is connected to the face N (both are FaceDirections). </summary>
+    unsigned char ConnectedFaces[FaceDirectionCount] = {};
+
+    static constexpr unsigned char ALL_FACES = (1 << FaceDirectionCount) - 1;
+
+    bool AreConnected(const FaceDirections p_face1, const FaceDirections p_face2) const { return (ConnectedFaces[p_face1] >> p_face2) & 1; }
+
+    /// <summary> Connects all the given faces together (one bit per FaceDirections). </summary>
+    void ConnectFaces(const unsigned char p_faces)
+    {
+        for (int face = 0; face < FaceDirectionCount; ++face)
+        {
+            if ((p_faces >> face) & 1)
+                ConnectedFaces[face] |= p_faces;
+        }
+    }
+
+    void Clear()
+    {
+        for (int face = 0; face < FaceDirectionCount; ++face)
+            ConnectedFaces[face] = 0;
+    }
+
+    static FaceDirections GetOppositeFace(const FaceDirections p_face)
+    {
+        // The two faces of an axis are next to each other (PositiveX, NegativeX, ...)
+        return static_cast<FaceDirections>(p_face ^ 1);
+    }
+};
+
+/// <summary>
+/// The CPU mesh of a chunk (vertices, draw order and bounds), created by the GreedyMesher.
+/// <para> It does not use OpenGL, it's the ChunkRenderObject that sends it to the GPU. </para> </summary>
 struct ChunkMeshData
 {
+    /// <summary> The positions are relative to the chunk origin (the chunk's world position * block size). </summary>
     std::vector<Vertex> Vertices;
 
-    /// <summary> The vertices draw order. </summary>
+    /// <summary> The vertices draw order, sorted by face direction (see FaceIndexOffsets). </summary>
     std::vector<unsigned int> VerticesIndices;
 
+    /// <summary> The range of VerticesIndices used by the quads of each FaceDirections, so a whole direction can be skipped when drawing. </summary>
+    unsigned int FaceIndexOffsets[FaceDirectionCount] = {};
+    unsigned int FaceIndexCounts[FaceDirectionCount] = {};
+
+    /// <summary> The world space box containing all the vertices (only valid if the mesh is not empty). </summary>
+    Vector3 MinimumBounds = Vector3::Zero();
+    Vector3 MaximumBounds = Vector3::Zero();
+
+    /// <summary> One per section of the chunk, from the bottom to the top (see ChunkVisibility), empty if unknown. </summary>
+    std::vector<ChunkFaceConnectivity> SectionConnectivities;
+
+    bool IsEmpty() const { return VerticesIndices.empty(); }
+
+    /// <param name = "p_axis"> 0 = X, 1 = Y, 2 = Z </param>
+    /// <param name = "p_normal"> 1 = facing the positive side of the axis, -1 = the negative side </param>
+    static FaceDirections GetFaceDirection(const int p_axis, const int p_normal)
+    {
+        return static_cast<FaceDirections>(p_axis * 2 + (p_normal > 0 ? 0 : 1));
+    }
+
+    /// <summary> Removes the vertices but keeps the memory, so the mesh can be re-generated without allocations. </summary>
     void Clear()
     {
         Vertices.clear();
         VerticesIndices.clear();
+        SectionConnectivities.clear();
+        ClearFaceIndexRanges();
+
+        MinimumBounds = Vector3::Zero();
+        MaximumBounds = Vector3::Zero();
+    }
+
+    /// <summary> Removes the vertices AND frees the memory. </summary>
+    void Release()
+    {
+        // NOTE : clear() keeps the capacity, swapping with an empty vector really frees the memory
+        std::vector<Vertex>().swap(Vertices);
+        std::vector<unsigned int>().swap(VerticesIndices);
+        std::vector<ChunkFaceConnectivity>().swap(SectionConnectivities);
+        ClearFaceIndexRanges();
+
+        MinimumBounds = Vector3::Zero();
+        MaximumBounds = Vector3::Zero();
+    }
+
+    void ClearFaceIndexRanges()
+    {
+        for (int i = 0; i < FaceDirectionCount; ++i)
+        {
+            FaceIndexOffsets[i] = 0;
+            FaceIndexCounts[i] = 0;
+        }
+    }
+
+    /// <summary> Returns the number of bytes used by the vertices, the vertices indices and the sections connectivity. </summary>
+    size_t GetMemoryUsage() const
+    {
+        return Vertices.capacity() * sizeof(Vertex) + VerticesIndices.capacity() * sizeof(unsigned int) +
+            SectionConnectivities.capacity() * sizeof(ChunkFaceConnectivity);
     }
 
     /// <summary>
@@ -0,0 +1,153 @@
+#include "ChunkRenderObject.h"
+
+#include <iostream>
+
+#include "Renderer.h"
+
+#include "../ChunkMeshData.h"
+
+#include "DebuggingConstants.h"
+
+// Defining static variables
+bool ChunkRenderObject::IsFaceDirectionCullingEnabled = true;
+
+ChunkRenderObject::ChunkRenderObject(const ChunkMeshData& p_meshData)
+{
+	#pragma region Debugging
+	
+	if (IS_PRINTING_ALL_VERTICES_CREATED)
+	{
+		for (const Vertex vertex : p_meshData.Vertices)
+		{
+			std::cout << "Vertex(Vector3(" << vertex.Position.X << ", " << vertex.Position.Y << ", " << vertex.Position.Z
+			<< "), Vector3(" << vertex.Normal.X << ", " << vertex.Normal.Y << ", " << vertex.Normal.Z
+			<< "), Vector4(" << vertex.Color.X << ", " << vertex.Color.Y << ", " << vertex.Color.Z << ", " << vertex.Color.W 
+			<< "), Vector3(" << vertex.TexturePosition.X  << ", " << vertex.TexturePosition.Y << ", " << vertex.TexturePosition.Z << "))," << std::endl;
+		}
+	}
+
+	if (IS_PRINTING_ALL_VERTICES_INDICES_CREATED)
+	{
+		for (int i = 0; i + 6 <= static_cast<int>(p_meshData.VerticesIndices.size()); i += 6)
+		{
+			std::cout << p_meshData.VerticesIndices[i] << ", " << p_meshData.VerticesIndices[i + 1] << ", " << p_meshData.VerticesIndices[i + 2] << ",\n"
+			<< p_meshData.VerticesIndices[i + 3] << ", " << p_meshData.VerticesIndices[i + 4] << ", " << p_meshData.VerticesIndices[i + 5] << ",\n" << std::endl;
+		}
+	}
+
+	#pragma endregion
+
+	_minimumBounds = p_meshData.MinimumBounds;
+	_maximumBounds = p_meshData.MaximumBounds;
+
+	for (int faceDirection = 0; faceDirection < FaceDirectionCount; ++faceDirection)
+	{
+		_faceIndexOffsets[faceDirection] = p_meshData.FaceIndexOffsets[faceDirection];
+		_faceIndexCounts[faceDirection] = p_meshData.FaceIndexCounts[faceDirection];
+	}
+	
+	// - Creating the VertexArrayObject - //
+	
+	VertexBufferLayoutObject vertexBufferLayoutObject;
+	vertexBufferLayoutObject.PushBack<float>(3, false); // Represent the position
+	vertexBufferLayoutObject.PushBack<float>(3, false); // Represent the normal
+	vertexBufferLayoutObject.PushBack<float>(4, false); // Represent the color
+	vertexBufferLayoutObject.PushBack<float>(3, false); // Represent the texture position (UV) and TextureIndex (Layer)
+														// [the index of which texture will be drawn]
+
+	_vertexBufferObject = new VertexBufferObject(
+		ConvertVerticesToFloatArray(p_meshData.Vertices).data(),
+		sizeof(Vertex) * static_cast<unsigned int>(p_meshData.Vertices.size())
+	);
+
+	_vertexArrayObject = new VertexArrayObject();
+	_vertexArrayObject->AddBuffer(*_vertexBufferObject, vertexBufferLayoutObject);
+
+	// - Creating the IndexBufferObject - //
+	
+	unsigned int verticesIndicesCount = 0;
+	const unsigned int* verticesIndices = ChunkMeshData::ConvertVectorToArray(p_meshData.VerticesIndices, verticesIndicesCount);
+	
+	_indexBufferObject = new IndexBufferObject(verticesIndices, verticesIndicesCount);
+	
+	// - Avoiding memory leaks (my beloved <3) - //
+	delete[] verticesIndices;
+}
+
+ChunkRenderObject::~ChunkRenderObject()
+{
+	delete _vertexArrayObject;
+	delete _indexBufferObject;
+
+	delete _vertexBufferObject;
+}
+
+void ChunkRenderObject::Submit(const Shader& p_shader, const int p_offsetUniformLocation, const glm::vec3& p_offset, const float p_depth,
+	const glm::dvec3& p_cameraPosition) const
+{
+	RenderQueueItem renderQueueItem;
+	renderQueueItem.VertexArray = _vertexArrayObject;
+	renderQueueItem.IndexBuffer = _indexBufferObject;
+	renderQueueItem.RenderingShader = &p_shader;
+	renderQueueItem.Depth = p_depth;
+	renderQueueItem.OffsetUniformLocation = p_offsetUniformLocation;
+	renderQueueItem.Offset = p_offset;
+
+	if (IsFaceDirectionCullingEnabled)
+	{
+		unsigned int culledIndexCount = 0;
+		
+		for (int faceDirection = 0; faceDirection < FaceDirectionCount; ++faceDirection)
+		{
+			const unsigned int faceIndexCount = _faceIndexCounts[faceDirection];
+			
+			if (faceIndexCount == 0)
+				continue;
+
+			if (!IsFaceDirectionVisible(static_cast<FaceDirections>(faceDirection), p_cameraPosition))
+			{
+				culledIndexCount += faceIndexCount;
+				continue;
+			}
+
+			const int lastRange = renderQueueItem.IndexRangeCount - 1;
+
+			// The directions are stored one after the other, so two visible neighbor directions are drawn as one range
+			if (lastRange >= 0 &&
+				renderQueueItem.IndexRangeOffsets[lastRange] + renderQueueItem.IndexRangeCounts[lastRange] == _faceIndexOffsets[faceDirection])
+			{
+				renderQueueItem.IndexRangeCounts[lastRange] += static_cast<int>(faceIndexCount);
+				continue;
+			}
+
+			renderQueueItem.IndexRangeOffsets[lastRange + 1] = _faceIndexOffsets[faceDirection];
+			renderQueueItem.IndexRangeCounts[lastRange + 1] = static_cast<int>(faceIndexCount);
+			renderQueueItem.IndexRangeCount++;
+		}
+
+		Renderer::AddCulledTriangles(culledIndexCount / 3);
+
+		// Nothing faces the camera (an IndexRangeCount of 0 would draw the whole chunk)
+		if (renderQueueItem.IndexRangeCount == 0)
+			return;
+	}
+
+	Renderer::Submit(renderQueueItem);
+}
+
+bool ChunkRenderObject::IsFaceDirectionVisible(const FaceDirections p_faceDirection, const glm::dvec3& p_cameraPosition) const
+{
+	// NOTE : The quads of a direction all lie inside the chunk's bounds, a quad facing +X is only visible
+	//        if the camera is beyond its plane on the +X side, so if the camera is before the minimum X, none of them is
+	switch (p_faceDirection)
+	{
+		case PositiveX: return p_cameraPosition.x > _minimumBounds.X;
+		case NegativeX: return p_cameraPosition.x < _maximumBounds.X;
+		case PositiveY: return p_cameraPosition.y > _minimumBounds.Y;
+		case NegativeY: return p_cameraPosition.y < _maximumBounds.Y;
+		case PositiveZ: return p_cameraPosition.z > _minimumBounds.Z;
+		case NegativeZ: return p_cameraPosition.z < _maximumBounds.Z;
+
+		default: return true;
+	}
+}
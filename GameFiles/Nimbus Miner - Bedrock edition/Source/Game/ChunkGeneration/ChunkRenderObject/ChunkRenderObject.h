@@ -0,0 +1,55 @@
+#pragma once
+
+#include "GLM/glm.hpp"
+
+#include "IndexBufferObject.h"
+#include "Shader.h"
+#include "Vector.h"
+#include "VertexArrayObject.h"
+
+#include "../ChunkMeshData.h"
+
+/// <summary>
+/// The GPU side of a chunk : the VAO, VBO and IBO created from a ChunkMeshData.
+///
+/// <para> <b> Needs an OpenGL context </b> to be created, drawn and deleted (so only on the OpenGL thread). </para>
+/// <para> Once created, the ChunkMeshData is not needed anymore and can be released. </para> </summary>
+class ChunkRenderObject
+{
+
+private:
+
+    VertexArrayObject* _vertexArrayObject;
+    VertexBufferObject* _vertexBufferObject;
+    IndexBufferObject* _indexBufferObject;
+
+    // Copied from the mesh, so they stay available when the mesh is released
+    Vector3 _minimumBounds;
+    Vector3 _maximumBounds;
+
+    unsigned int _faceIndexOffsets[FaceDirectionCount];
+    unsigned int _faceIndexCounts[FaceDirectionCount];
+
+public:
+
+    /// <summary> Skips the face directions that can't face the camera (e.g. the +X faces of a chunk entirely on the +X side of the camera). </summary>
+    static bool IsFaceDirectionCullingEnabled;
+
+    /// <summary> Sends the given mesh to the GPU. </summary>
+    explicit ChunkRenderObject(const ChunkMeshData& p_meshData);
+    ~ChunkRenderObject();
+
+    /// <summary> Queues the chunk inside the Renderer (see Renderer::Submit()), only with the face directions that can face the camera. </summary>
+    /// <param name = "p_offsetUniformLocation"> The location of the vec3 uniform receiving p_offset, -1 if not used </param>
+    void Submit(const Shader& p_shader, int p_offsetUniformLocation, const glm::vec3& p_offset, float p_depth, const glm::dvec3& p_cameraPosition) const;
+
+    int GetIndexCount() const { return _indexBufferObject->GetIndexesCount(); }
+
+    const Vector3& GetMinimumBounds() const { return _minimumBounds; }
+    const Vector3& GetMaximumBounds() const { return _maximumBounds; }
+
+private:
+
+    /// <summary> False if all the quads of the given direction face away from the camera (it's on the back side of all of them). </summary>
+    bool IsFaceDirectionVisible(FaceDirections p_faceDirection, const glm::dvec3& p_cameraPosition) const;
+};
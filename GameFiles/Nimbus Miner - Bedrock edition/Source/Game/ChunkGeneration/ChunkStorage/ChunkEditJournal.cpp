@@ -0,0 +1,437 @@
+#include "ChunkEditJournal.h"
+
+#include <cstring>
+
+#include "ChunkSerializer.h"
+#include "ChunkStorage.h"
+
+#include "MessageDebugger/MessageDebugger.h"
+
+static constexpr char EDIT_JOURNAL_MAGIC[4] = { 'N', 'M', 'E', 'J' };
+
+// Incremented every time the layout of the header or of the batches changes
+static constexpr uint32_t EDIT_JOURNAL_VERSION = 2;
+
+// The chunk position and the edit count before the edits, the checksum after them
+static constexpr size_t BATCH_HEADER_BYTE_SIZE = 3 * sizeof(uint32_t);
+static constexpr size_t BATCH_CHECKSUM_BYTE_SIZE = sizeof(uint32_t);
+
+// The edit count of a commit batch, its save number is stored instead of the chunk's x
+static constexpr uint32_t COMMIT_BATCH_EDIT_COUNT = 0xFFFFFFFFu;
+
+// The block index, the old type and the new type
+static constexpr size_t EDIT_BYTE_SIZE = sizeof(uint32_t) + 2 * sizeof(BlockTypes);
+
+// Below this size, the overwritten edits are kept (a compaction rewrites the whole file)
+static constexpr size_t COMPACTION_MINIMUM_FILE_BYTE_SIZE = 64 * 1024;
+
+ChunkEditJournal::ChunkEditJournal(const std::string& p_filePath, const int p_worldSeed, const float p_noiseFrequency, const Vector3Int& p_chunkSize,
+    const uint32_t p_committedSaveNumber) :
+    _editCount(0), _fileByteSize(0)
+{
+    // Initialising class' variables
+    _filePath = p_filePath;
+    _chunkBlockCount = static_cast<size_t>(p_chunkSize.X) * p_chunkSize.Y * p_chunkSize.Z;
+    _committedSaveNumber = p_committedSaveNumber;
+    _hasUncommittedBatches = false;
+    _isDamaged = false;
+
+    memcpy(_header.Magic, EDIT_JOURNAL_MAGIC, sizeof(EDIT_JOURNAL_MAGIC));
+    _header.Version = EDIT_JOURNAL_VERSION;
+    _header.WorldSeed = p_worldSeed;
+    _header.NoiseFrequency = p_noiseFrequency;
+    _header.ChunkSizeX = p_chunkSize.X;
+    _header.ChunkSizeY = p_chunkSize.Y;
+    _header.ChunkSizeZ = p_chunkSize.Z;
+
+    // - Existing journal - //
+
+    bool isRepairNeeded = false;
+
+    {
+        std::ifstream inputStream(_filePath, std::ios::binary | std::ios::ate);
+
+        if (inputStream.is_open() && inputStream.tellg() > 0)
+        {
+            std::vector<uint8_t> bytes(static_cast<size_t>(inputStream.tellg()));
+
+            inputStream.seekg(0);
+            inputStream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+            // NOTE : The file is left untouched, the edits of another world would be replayed on the wrong blocks
+            if (!inputStream || bytes.size() < sizeof(FileHeader) || memcmp(bytes.data(), &_header, sizeof(FileHeader)) != 0)
+            {
+                PRINT_ERROR_RUNTIME(true, "The file '" + _filePath + "' is not the edit journal of this world, the edits will not be saved")
+                return;
+            }
+
+            isRepairNeeded = ReadBatches(bytes, p_committedSaveNumber) < bytes.size();
+            _fileByteSize = bytes.size();
+        }
+    }
+
+    _stream.open(_filePath, std::ios::binary | std::ios::app);
+
+    if (!_stream.is_open())
+    {
+        PRINT_ERROR_RUNTIME(true, "The edit journal '" + _filePath + "' could not be opened, the edits will not be saved")
+        return;
+    }
+
+    if (_fileByteSize == 0)
+    {
+        const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&_header);
+
+        if (!AppendBytes(std::vector<uint8_t>(headerBytes, headerBytes + sizeof(FileHeader))))
+        {
+            PRINT_ERROR_RUNTIME(true, "The edit journal '" + _filePath + "' could not be created, the edits will not be saved")
+            _stream.close();
+        }
+
+        // NOTE : The header alone is not a save, it needs no commit batch
+        _hasUncommittedBatches = false;
+    }
+
+    // NOTE : Rewritten right away, the next batches would be appended after the dropped ones (and dropped with them)
+    if (isRepairNeeded)
+    {
+        PRINT_WARNING_RUNTIME(true, "The end of the edit journal '" + _filePath + "' is damaged or belongs to an unfinished save, its last edits are ignored")
+        Compact();
+    }
+}
+
+ChunkEditJournal::~ChunkEditJournal()
+{
+    if (IsOpen() && !_hasUncommittedBatches && !_isDamaged && _fileByteSize > GetCompactedByteSize())
+        Compact();
+}
+
+void ChunkEditJournal::GetChunkEdits(const Vector2Int& p_chunkPosition, std::vector<BlockEdit>& p_outEdits) const
+{
+    std::lock_guard<std::mutex> lock(_chunkEditsMutex);
+
+    const std::unordered_map<long long, std::vector<BlockEdit>>::const_iterator foundChunkEdits = _chunkEdits.find(GetChunkKey(p_chunkPosition));
+
+    if (foundChunkEdits != _chunkEdits.end())
+        p_outEdits.insert(p_outEdits.end(), foundChunkEdits->second.begin(), foundChunkEdits->second.end());
+}
+
+size_t ChunkEditJournal::GetChunkEditCount(const Vector2Int& p_chunkPosition) const
+{
+    std::lock_guard<std::mutex> lock(_chunkEditsMutex);
+
+    const std::unordered_map<long long, std::vector<BlockEdit>>::const_iterator foundChunkEdits = _chunkEdits.find(GetChunkKey(p_chunkPosition));
+
+    return foundChunkEdits != _chunkEdits.end() ? foundChunkEdits->second.size() : 0;
+}
+
+bool ChunkEditJournal::AppendEdits(const Vector2Int& p_chunkPosition, const std::vector<BlockEdit>& p_edits)
+{
+    if (!IsOpen() || _isDamaged || p_edits.empty())
+        return false;
+
+    std::vector<uint8_t> bytes;
+    WriteBatch(p_chunkPosition, p_edits.data(), p_edits.size(), bytes);
+
+    if (!AppendBytes(bytes))
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(_chunkEditsMutex);
+
+        std::vector<BlockEdit>& chunkEdits = _chunkEdits[GetChunkKey(p_chunkPosition)];
+        const size_t previousEditCount = chunkEdits.size();
+
+        for (const BlockEdit& edit : p_edits)
+            MergeEdit(chunkEdits, edit);
+
+        _editCount += chunkEdits.size();
+        _editCount -= previousEditCount;
+
+        if (chunkEdits.empty())
+            _chunkEdits.erase(GetChunkKey(p_chunkPosition));
+    }
+
+    return true;
+}
+
+bool ChunkEditJournal::ClearChunk(const Vector2Int& p_chunkPosition)
+{
+    if (!IsOpen() || GetChunkEditCount(p_chunkPosition) == 0)
+        return true;
+
+    if (_isDamaged)
+        return false;
+
+    std::vector<uint8_t> bytes;
+    WriteBatch(p_chunkPosition, nullptr, 0, bytes);
+
+    if (!AppendBytes(bytes))
+        return false;
+
+    std::lock_guard<std::mutex> lock(_chunkEditsMutex);
+
+    const std::unordered_map<long long, std::vector<BlockEdit>>::iterator foundChunkEdits = _chunkEdits.find(GetChunkKey(p_chunkPosition));
+    _editCount -= foundChunkEdits->second.size();
+    _chunkEdits.erase(foundChunkEdits);
+
+    return true;
+}
+
+bool ChunkEditJournal::Commit(const uint32_t p_saveNumber)
+{
+    if (!IsOpen() || _isDamaged)
+        return false;
+
+    if (!_hasUncommittedBatches)
+        return true;
+
+    std::vector<uint8_t> bytes;
+    WriteBatch(Vector2Int(static_cast<int>(p_saveNumber), 0), nullptr, COMMIT_BATCH_EDIT_COUNT, bytes);
+
+    if (!AppendBytes(bytes))
+        return false;
+
+    // NOTE : On the disk before the storage writes the manifest, otherwise after a power loss the manifest could name a save
+    //        whose batches (and the ClearChunk() batches of its snapshots) are lost, and old edits would be replayed over newer snapshots
+    if (!ChunkStorage::FlushFileToDisk(_filePath))
+    {
+        PRINT_ERROR_RUNTIME(true, "The edit journal '" + _filePath + "' could not be flushed to the disk, the save is not committed")
+        return false;
+    }
+
+    _committedSaveNumber = p_saveNumber;
+    _hasUncommittedBatches = false;
+
+    return true;
+}
+
+void ChunkEditJournal::CompactIfNeeded()
+{
+    if (!IsOpen() || _hasUncommittedBatches || _isDamaged)
+        return;
+
+    // Most of the file is overwritten edits
+    if (_fileByteSize > COMPACTION_MINIMUM_FILE_BYTE_SIZE && _fileByteSize > 2 * GetCompactedByteSize())
+        Compact();
+}
+
+bool ChunkEditJournal::Compact()
+{
+    if (!IsOpen())
+        return false;
+
+    const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&_header);
+    std::vector<uint8_t> bytes(headerBytes, headerBytes + sizeof(FileHeader));
+
+    {
+        std::lock_guard<std::mutex> lock(_chunkEditsMutex);
+
+        for (const std::pair<const long long, std::vector<BlockEdit>>& chunkEdits : _chunkEdits)
+        {
+            const Vector2Int chunkPosition = Vector2Int(static_cast<int>(chunkEdits.first >> 32), static_cast<int>(static_cast<uint32_t>(chunkEdits.first)));
+
+            WriteBatch(chunkPosition, chunkEdits.second.data(), chunkEdits.second.size(), bytes);
+        }
+    }
+
+    // NOTE : Without it, the edits would be dropped as an unfinished save
+    WriteBatch(Vector2Int(static_cast<int>(_committedSaveNumber), 0), nullptr, COMMIT_BATCH_EDIT_COUNT, bytes);
+
+    // NOTE : Closed during the move, Windows can't replace an open file
+    _stream.close();
+
+    const bool isReplaced = ChunkStorage::WriteFileAtomically(_filePath, bytes);
+
+    if (isReplaced)
+        _fileByteSize = bytes.size();
+    else
+        PRINT_WARNING_RUNTIME(true, "The edit journal '" + _filePath + "' could not be compacted, the old one is kept")
+
+    _stream.open(_filePath, std::ios::binary | std::ios::app);
+
+    if (!_stream.is_open())
+        PRINT_ERROR_RUNTIME(true, "The edit journal '" + _filePath + "' could not be opened again, the next edits will not be saved")
+
+    return isReplaced && _stream.is_open();
+}
+
+void ChunkEditJournal::MergeEdit(std::vector<BlockEdit>& p_edits, const BlockEdit& p_edit)
+{
+    for (size_t i = 0; i < p_edits.size(); ++i)
+    {
+        if (p_edits[i].BlockIndex != p_edit.BlockIndex)
+            continue;
+
+        p_edits[i].NewType = p_edit.NewType;
+
+        // Back to the generated block, nothing to replay
+        if (p_edits[i].NewType == p_edits[i].OldType)
+        {
+            p_edits[i] = p_edits.back();
+            p_edits.pop_back();
+        }
+
+        return;
+    }
+
+    if (p_edit.NewType != p_edit.OldType)
+        p_edits.push_back(p_edit);
+}
+
+size_t ChunkEditJournal::ReadBatches(const std::vector<uint8_t>& p_bytes, const uint32_t p_committedSaveNumber)
+{
+    // - Committed batches - //
+
+    size_t committedEnd = sizeof(FileHeader);
+
+    for (size_t position = sizeof(FileHeader); position < p_bytes.size(); )
+    {
+        if (p_bytes.size() - position < BATCH_HEADER_BYTE_SIZE)
+            break;
+
+        uint32_t batchValue = 0;
+        uint32_t editCount = 0;
+
+        memcpy(&batchValue, p_bytes.data() + position, sizeof(uint32_t));
+        memcpy(&editCount, p_bytes.data() + position + 2 * sizeof(uint32_t), sizeof(uint32_t));
+
+        const bool isCommitBatch = editCount == COMMIT_BATCH_EDIT_COUNT;
+
+        // A chunk has at most one edit per block
+        if (!isCommitBatch && editCount > _chunkBlockCount)
+            break;
+
+        const size_t batchByteSize = BATCH_HEADER_BYTE_SIZE + (isCommitBatch ? 0 : editCount * EDIT_BYTE_SIZE);
+
+        if (p_bytes.size() - position < batchByteSize + BATCH_CHECKSUM_BYTE_SIZE)
+            break;
+
+        uint32_t checksum = 0;
+        memcpy(&checksum, p_bytes.data() + position + batchByteSize, sizeof(uint32_t));
+
+        if (checksum != ChunkSerializer::ComputeChecksum(p_bytes.data() + position, batchByteSize))
+            break;
+
+        position += batchByteSize + BATCH_CHECKSUM_BYTE_SIZE;
+
+        if (isCommitBatch)
+        {
+            // NOTE : The regions of that save were not committed, the edits must match their blocks
+            if (batchValue > p_committedSaveNumber)
+                break;
+
+            committedEnd = position;
+        }
+    }
+
+    // - Edits - //
+
+    for (size_t position = sizeof(FileHeader); position < committedEnd; )
+    {
+        int32_t chunkX = 0;
+        int32_t chunkZ = 0;
+        uint32_t editCount = 0;
+
+        memcpy(&chunkX, p_bytes.data() + position, sizeof(int32_t));
+        memcpy(&chunkZ, p_bytes.data() + position + sizeof(int32_t), sizeof(int32_t));
+        memcpy(&editCount, p_bytes.data() + position + 2 * sizeof(int32_t), sizeof(uint32_t));
+
+        if (editCount == COMMIT_BATCH_EDIT_COUNT)
+        {
+            position += BATCH_HEADER_BYTE_SIZE + BATCH_CHECKSUM_BYTE_SIZE;
+            continue;
+        }
+
+        const long long chunkKey = GetChunkKey(Vector2Int(chunkX, chunkZ));
+        std::vector<BlockEdit>& chunkEdits = _chunkEdits[chunkKey];
+
+        _editCount -= chunkEdits.size();
+
+        if (editCount == 0)
+            chunkEdits.clear();
+
+        for (uint32_t i = 0; i < editCount; ++i)
+        {
+            const uint8_t* editBytes = p_bytes.data() + position + BATCH_HEADER_BYTE_SIZE + i * EDIT_BYTE_SIZE;
+
+            BlockEdit edit;
+            memcpy(&edit.BlockIndex, editBytes, sizeof(uint32_t));
+            edit.OldType = static_cast<BlockTypes>(editBytes[sizeof(uint32_t)]);
+            edit.NewType = static_cast<BlockTypes>(editBytes[sizeof(uint32_t) + 1]);
+
+            if (edit.BlockIndex < _chunkBlockCount)
+                MergeEdit(chunkEdits, edit);
+        }
+
+        _editCount += chunkEdits.size();
+
+        if (chunkEdits.empty())
+            _chunkEdits.erase(chunkKey);
+
+        position += BATCH_HEADER_BYTE_SIZE + editCount * EDIT_BYTE_SIZE + BATCH_CHECKSUM_BYTE_SIZE;
+    }
+
+    return committedEnd;
+}
+
+size_t ChunkEditJournal::GetCompactedByteSize() const
+{
+    std::lock_guard<std::mutex> lock(_chunkEditsMutex);
+
+    // The batch of each chunk, then the commit batch
+    return sizeof(FileHeader) + (_chunkEdits.size() + 1) * (BATCH_HEADER_BYTE_SIZE + BATCH_CHECKSUM_BYTE_SIZE) + _editCount * EDIT_BYTE_SIZE;
+}
+
+void ChunkEditJournal::WriteBatch(const Vector2Int& p_chunkPosition, const BlockEdit* p_edits, const size_t p_editCount, std::vector<uint8_t>& p_outBytes)
+{
+    // NOTE : A commit batch has no edits, p_editCount is only its marker
+    const size_t storedEditCount = p_editCount == COMMIT_BATCH_EDIT_COUNT ? 0 : p_editCount;
+
+    const size_t batchPosition = p_outBytes.size();
+    p_outBytes.resize(batchPosition + BATCH_HEADER_BYTE_SIZE + storedEditCount * EDIT_BYTE_SIZE);
+
+    const int32_t chunkX = p_chunkPosition.X;
+    const int32_t chunkZ = p_chunkPosition.Y;
+    const uint32_t editCount = static_cast<uint32_t>(p_editCount);
+
+    memcpy(p_outBytes.data() + batchPosition, &chunkX, sizeof(int32_t));
+    memcpy(p_outBytes.data() + batchPosition + sizeof(int32_t), &chunkZ, sizeof(int32_t));
+    memcpy(p_outBytes.data() + batchPosition + 2 * sizeof(int32_t), &editCount, sizeof(uint32_t));
+
+    for (size_t i = 0; i < storedEditCount; ++i)
+    {
+        uint8_t* editBytes = p_outBytes.data() + batchPosition + BATCH_HEADER_BYTE_SIZE + i * EDIT_BYTE_SIZE;
+
+        memcpy(editBytes, &p_edits[i].BlockIndex, sizeof(uint32_t));
+        editBytes[sizeof(uint32_t)] = static_cast<uint8_t>(p_edits[i].OldType);
+        editBytes[sizeof(uint32_t) + 1] = static_cast<uint8_t>(p_edits[i].NewType);
+    }
+
+    const uint32_t checksum = ChunkSerializer::ComputeChecksum(p_outBytes.data() + batchPosition, p_outBytes.size() - batchPosition);
+    const uint8_t* checksumBytes = reinterpret_cast<const uint8_t*>(&checksum);
+
+    p_outBytes.insert(p_outBytes.end(), checksumBytes, checksumBytes + sizeof(uint32_t));
+}
+
+bool ChunkEditJournal::AppendBytes(const std::vector<uint8_t>& p_bytes)
+{
+    _stream.write(reinterpret_cast<const char*>(p_bytes.data()), static_cast<std::streamsize>(p_bytes.size()));
+    _stream.flush();
+
+    if (!_stream)
+    {
+        PRINT_ERROR_RUNTIME(true, "Some edits could not be written inside '" + _filePath + "', the next saves will not be committed")
+
+        // NOTE : The part of the batch that reached the file hides the next batches, it is dropped when the journal is opened again
+        _stream.clear();
+        _isDamaged = true;
+
+        return false;
+    }
+
+    _fileByteSize += p_bytes.size();
+    _hasUncommittedBatches = true;
+
+    return true;
+}
\ No newline at end of file
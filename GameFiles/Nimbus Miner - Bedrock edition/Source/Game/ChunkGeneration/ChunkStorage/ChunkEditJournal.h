@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Vector.h"
+
+#include "../EnvironmentEnums.h"
+
+/// <summary>
+/// Stores only the blocks edited by the player, chunk by chunk : a chunk is generated again from the noise (see WorldGenerator),
+/// then its edits are replayed on it. Most chunks are never edited and take no space at all.
+///
+/// <para> <b> Layout : </b> a header (a magic number, the version, the world seed, the noise frequency and the chunk size), then batches
+/// appended one after the other. A batch is the chunk position, the edits of one save (block index, old type, new type) and its checksum.
+/// A batch without edits clears the chunk : its blocks were saved as a snapshot inside its region file (see ChunkStorage).
+/// A commit batch ends each save, with its number : the batches after the last committed save (see ChunkStorage) are dropped when the
+/// journal is opened, so a save cut by a crash is ignored as a whole. A batch cut in the middle fails its checksum. </para>
+/// <para> The file is only appended to, so the overwritten edits stay inside it until it is compacted (rewritten with the current edits
+/// only, inside a temporary file renamed over the old one). </para>
+/// <para> The edits only match the chunks generated with the same seed and frequency, a journal of another world is never overwritten. </para>
+///
+/// <para> The file must only be written by one thread at a time (ChunkStorage's I/O thread), the edits can be read from any thread. </para> </summary>
+class ChunkEditJournal
+{
+
+public:
+
+    struct BlockEdit
+    {
+        /// <summary> See ChunkVoxelData::GetBlockIndex(). </summary>
+        uint32_t BlockIndex;
+
+        /// <summary> The generated type (before the first edit of the block). </summary>
+        BlockTypes OldType;
+        BlockTypes NewType;
+    };
+
+private:
+
+    struct FileHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        int32_t WorldSeed;
+        float NoiseFrequency;
+        int32_t ChunkSizeX;
+        int32_t ChunkSizeY;
+        int32_t ChunkSizeZ;
+    };
+
+    std::string _filePath;
+    FileHeader _header;
+    size_t _chunkBlockCount;
+
+    /// <summary> Opened in append mode, closed if the file can't be used. </summary>
+    std::ofstream _stream;
+
+    /// <summary> The current edits of each chunk (one per block at most), the key is the chunk position. </summary>
+    std::unordered_map<long long, std::vector<BlockEdit>> _chunkEdits;
+    mutable std::mutex _chunkEditsMutex;
+
+    std::atomic<size_t> _editCount;
+
+    /// <summary> The number of the last commit batch (or of the committed save the journal was opened with). </summary>
+    uint32_t _committedSaveNumber;
+
+    /// <summary> True if batches were written after the last commit batch. </summary>
+    bool _hasUncommittedBatches;
+
+    /// <summary> A write failed, a batch may be cut in the middle : no more saves are committed until the journal is opened again (it is repaired then). </summary>
+    bool _isDamaged;
+
+    /// <summary> With the overwritten and cleared edits, compared to the size of the current ones to know when to compact. </summary>
+    std::atomic<size_t> _fileByteSize;
+
+public:
+
+    /// <summary> Opens the journal and reads all its edits, or creates it. If it can't be used (not a journal, another world...),
+    /// an error is printed and IsOpen() returns false. </summary>
+    /// <param name = "p_committedSaveNumber"> The last save committed by the storage, the batches of the later saves are dropped </param>
+    ChunkEditJournal(const std::string& p_filePath, const int p_worldSeed, const float p_noiseFrequency, const Vector3Int& p_chunkSize,
+        const uint32_t p_committedSaveNumber);
+
+    /// <summary> Compacts the file if some of its edits were overwritten (and all its batches are committed). </summary>
+    ~ChunkEditJournal();
+
+    ChunkEditJournal(const ChunkEditJournal&) = delete;
+    ChunkEditJournal& operator=(const ChunkEditJournal&) = delete;
+
+    bool IsOpen() const { return _stream.is_open(); }
+
+    /// <summary> Gives the current edits of the chunk (the position is in chunks), in no particular order. </summary>
+    void GetChunkEdits(const Vector2Int& p_chunkPosition, std::vector<BlockEdit>& p_outEdits) const;
+    size_t GetChunkEditCount(const Vector2Int& p_chunkPosition) const;
+
+    /// <summary> Appends the edits as one batch, they replace the previous edits of the same blocks. Returns false on a write error. </summary>
+    bool AppendEdits(const Vector2Int& p_chunkPosition, const std::vector<BlockEdit>& p_edits);
+
+    /// <summary> Forgets the edits of the chunk (appends an empty batch), once its blocks are saved somewhere else. </summary>
+    bool ClearChunk(const Vector2Int& p_chunkPosition);
+
+    /// <summary> Appends the commit batch of the save (nothing if no batch was written since the last one) and flushes the file to the disk.
+    /// Returns false on a write error. </summary>
+    bool Commit(const uint32_t p_saveNumber);
+
+    /// <summary> Compacts the file if most of it is overwritten edits, only once the storage committed the save. </summary>
+    void CompactIfNeeded();
+
+    size_t GetEditCount() const { return _editCount; }
+    size_t GetFileByteSize() const { return _fileByteSize; }
+
+    /// <summary> Adds the edit to the list : it replaces the edit of the same block (keeping its OldType), both are removed if the block is back to its old type. </summary>
+    static void MergeEdit(std::vector<BlockEdit>& p_edits, const BlockEdit& p_edit);
+
+private:
+
+    /// <summary>
+    /// Reads the edits of the batches committed before p_committedSaveNumber, stops at the first damaged batch.
+    /// <para> Returns the end of the last commit batch read, the rest of the file is dropped. </para> </summary>
+    size_t ReadBatches(const std::vector<uint8_t>& p_bytes, const uint32_t p_committedSaveNumber);
+
+    /// <summary> Rewrites the file with the current edits only, then a commit batch. </summary>
+    bool Compact();
+
+    /// <summary> The size the file would have after a compaction. </summary>
+    size_t GetCompactedByteSize() const;
+
+    /// <summary> Appends one batch to p_outBytes (the checksum included), a commit batch if p_editCount is the commit marker (see Commit()). </summary>
+    static void WriteBatch(const Vector2Int& p_chunkPosition, const BlockEdit* p_edits, const size_t p_editCount, std::vector<uint8_t>& p_outBytes);
+
+    /// <summary> Writes the bytes at the end of the file, and hands them to the system right away. </summary>
+    bool AppendBytes(const std::vector<uint8_t>& p_bytes);
+
+    static long long GetChunkKey(const Vector2Int& p_chunkPosition)
+    {
+        return (static_cast<long long>(p_chunkPosition.X) << 32) ^ static_cast<unsigned int>(p_chunkPosition.Y);
+    }
+};
\ No newline at end of file
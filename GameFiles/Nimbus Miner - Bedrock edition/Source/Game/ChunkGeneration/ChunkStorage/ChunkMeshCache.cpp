@@ -0,0 +1,547 @@
+#include "ChunkMeshCache.h"
+
+#include <cstring>
+
+#if defined(_WIN32)
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "../ChunkMeshData.h"
+#include "../ChunkVoxelData/ChunkBorderPlanes.h"
+#include "../ChunkVoxelData/ChunkVoxelData.h"
+
+#include "ProjectConstants.h"
+
+#include "MessageDebugger/MessageDebugger.h"
+
+static constexpr char MESH_CACHE_MAGIC[4] = { 'N', 'M', 'M', 'C' };
+
+// Incremented every time the layout of the header or of the entries changes (the meshes themselves have MESH_CACHE_MESHER_VERSION)
+static constexpr uint32_t MESH_CACHE_FILE_VERSION = 1;
+
+// The primes of xxHash64, they spread the bits of the input over the whole hash
+static constexpr uint64_t HASH_PRIME_1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t HASH_PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t HASH_PRIME_3 = 0x165667B19E3779F9ull;
+
+static uint64_t RotateLeft(const uint64_t p_value, const int p_bitCount)
+{
+    return (p_value << p_bitCount) | (p_value >> (64 - p_bitCount));
+}
+
+ChunkMeshCache::ChunkMeshCache(const std::string& p_filePath, const size_t p_maximumByteSize) :
+    _hitCount(0), _missCount(0), _storedCount(0), _damagedCount(0)
+{
+    // Initialising class' variables
+    _filePath = p_filePath;
+    _mappedBytes = nullptr;
+    _mappedByteSize = 0;
+    _fileByteSize = 0;
+    _maximumByteSize = p_maximumByteSize;
+    _hasWriteFailed = false;
+    _isFull = false;
+
+    // Creates the file if it does not exist yet (its header is written below)
+    {
+        std::ofstream outputStream(_filePath, std::ios::binary | std::ios::app);
+    }
+
+    if (!MapFile())
+    {
+        PRINT_ERROR_RUNTIME(true, "The mesh cache '" + _filePath + "' could not be opened, the chunks will be meshed at each launch")
+        return;
+    }
+
+    FileHeader fileHeader = {};
+
+    if (_mappedByteSize >= sizeof(FileHeader))
+        memcpy(&fileHeader, _mappedBytes, sizeof(FileHeader));
+
+    const bool isSameVersion = _mappedByteSize >= sizeof(FileHeader) && memcmp(fileHeader.Magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC)) == 0 &&
+        fileHeader.Version == MESH_CACHE_FILE_VERSION && fileHeader.MesherVersion == MESH_CACHE_MESHER_VERSION && fileHeader.VertexByteSize == sizeof(Vertex);
+
+    // NOTE : Emptied before it's full, a file kept near the maximum size would refuse most of the new meshes
+    const bool isAlmostFull = static_cast<double>(_mappedByteSize) >= static_cast<double>(_maximumByteSize) * MESH_CACHE_EMPTYING_FILL_RATIO;
+
+    if (isSameVersion && !isAlmostFull)
+    {
+        _fileByteSize = ReadEntryLocations();
+
+        // NOTE : The last entry was cut by the end of the game (the entries are not flushed to the disk), the next ones are appended after the cut
+        if (_fileByteSize < _mappedByteSize)
+        {
+            UnmapFile();
+
+            if (!TruncateFile(_fileByteSize) || !MapFile())
+            {
+                PRINT_ERROR_RUNTIME(true, "The damaged end of the mesh cache '" + _filePath + "' could not be removed, the chunks will be meshed at each launch")
+
+                UnmapFile();
+                return;
+            }
+        }
+    }
+    else
+    {
+        // It's only a cache, the meshes of another version (or too many old meshes) are thrown away
+        if (_mappedByteSize > 0)
+            PRINT_MESSAGE_RUNTIME("The mesh cache '" + _filePath + "' is emptied (another version of the meshes, or almost full)")
+
+        UnmapFile();
+        _entryLocations.clear();
+
+        if (!InitializeFile())
+        {
+            PRINT_ERROR_RUNTIME(true, "The mesh cache '" + _filePath + "' could not be created, the chunks will be meshed at each launch")
+            return;
+        }
+
+        _fileByteSize = sizeof(FileHeader);
+    }
+
+    _stream.open(_filePath, std::ios::binary | std::ios::in | std::ios::out);
+
+    if (!_stream.is_open())
+    {
+        PRINT_ERROR_RUNTIME(true, "The mesh cache '" + _filePath + "' could not be opened for writing, the chunks will be meshed at each launch")
+        UnmapFile();
+    }
+}
+
+ChunkMeshCache::~ChunkMeshCache()
+{
+    UnmapFile();
+}
+
+bool ChunkMeshCache::Load(const uint64_t p_key, const Vector3& p_chunkOrigin, ChunkMeshData& p_outMeshData)
+{
+    if (!IsOpen())
+        return false;
+
+    EntryLocation entryLocation;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const std::unordered_map<uint64_t, EntryLocation>::const_iterator entryIterator = _entryLocations.find(p_key);
+
+        if (entryIterator == _entryLocations.end())
+        {
+            _missCount++;
+            return false;
+        }
+
+        entryLocation = entryIterator->second;
+    }
+
+    // NOTE : Only used by the entries written after the mapping, one per thread so the mesh jobs never allocate it again
+    static thread_local std::vector<uint8_t> payloadBuffer;
+
+    const uint8_t* payload = GetPayload(entryLocation, payloadBuffer);
+
+    PayloadHeader payloadHeader = {};
+    bool isValid = payload != nullptr && ComputeHash(payload, entryLocation.PayloadByteSize, p_key) == entryLocation.Checksum;
+
+    if (isValid)
+    {
+        memcpy(&payloadHeader, payload, sizeof(PayloadHeader));
+
+        isValid = entryLocation.PayloadByteSize == sizeof(PayloadHeader) +
+            static_cast<uint64_t>(payloadHeader.VertexCount) * sizeof(Vertex) + static_cast<uint64_t>(payloadHeader.VertexIndexCount) * sizeof(uint32_t) +
+            static_cast<uint64_t>(payloadHeader.SectionCount) * sizeof(ChunkFaceConnectivity);
+    }
+
+    if (!isValid)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // The chunk is meshed again, its new mesh replaces the entry (unless another mesh job already did it)
+        const std::unordered_map<uint64_t, EntryLocation>::const_iterator entryIterator = _entryLocations.find(p_key);
+
+        if (entryIterator != _entryLocations.end() && entryIterator->second.PayloadOffset == entryLocation.PayloadOffset)
+            _entryLocations.erase(entryIterator);
+
+        _damagedCount++;
+        _missCount++;
+
+        return false;
+    }
+
+    // - Copying the mesh - //
+
+    const uint8_t* vertices = payload + sizeof(PayloadHeader);
+    const uint8_t* verticesIndices = vertices + payloadHeader.VertexCount * sizeof(Vertex);
+    const uint8_t* sectionConnectivities = verticesIndices + payloadHeader.VertexIndexCount * sizeof(uint32_t);
+
+    p_outMeshData.Vertices.resize(payloadHeader.VertexCount);
+    p_outMeshData.VerticesIndices.resize(payloadHeader.VertexIndexCount);
+    p_outMeshData.SectionConnectivities.resize(payloadHeader.SectionCount);
+
+    // NOTE : The vertices are stored in the layout sent to the GPU, so they are copied as they are
+    memcpy(p_outMeshData.Vertices.data(), vertices, payloadHeader.VertexCount * sizeof(Vertex));
+    memcpy(p_outMeshData.VerticesIndices.data(), verticesIndices, payloadHeader.VertexIndexCount * sizeof(uint32_t));
+    memcpy(p_outMeshData.SectionConnectivities.data(), sectionConnectivities, payloadHeader.SectionCount * sizeof(ChunkFaceConnectivity));
+
+    for (int faceDirection = 0; faceDirection < FaceDirectionCount; ++faceDirection)
+    {
+        p_outMeshData.FaceIndexOffsets[faceDirection] = payloadHeader.FaceIndexOffsets[faceDirection];
+        p_outMeshData.FaceIndexCounts[faceDirection] = payloadHeader.FaceIndexCounts[faceDirection];
+    }
+
+    // The same blocks can be anywhere in the world, only the bounds depend on it
+    p_outMeshData.MinimumBounds = Vector3(payloadHeader.MinimumBounds[0], payloadHeader.MinimumBounds[1], payloadHeader.MinimumBounds[2]) + p_chunkOrigin;
+    p_outMeshData.MaximumBounds = Vector3(payloadHeader.MaximumBounds[0], payloadHeader.MaximumBounds[1], payloadHeader.MaximumBounds[2]) + p_chunkOrigin;
+
+    _hitCount++;
+
+    return true;
+}
+
+void ChunkMeshCache::Store(const uint64_t p_key, const Vector3& p_chunkOrigin, const ChunkMeshData& p_meshData)
+{
+    if (!IsOpen())
+        return;
+
+    // - Creating the entry (outside the lock) - //
+
+    PayloadHeader payloadHeader = {};
+    payloadHeader.VertexCount = static_cast<uint32_t>(p_meshData.Vertices.size());
+    payloadHeader.VertexIndexCount = static_cast<uint32_t>(p_meshData.VerticesIndices.size());
+    payloadHeader.SectionCount = static_cast<uint32_t>(p_meshData.SectionConnectivities.size());
+
+    for (int faceDirection = 0; faceDirection < FaceDirectionCount; ++faceDirection)
+    {
+        payloadHeader.FaceIndexOffsets[faceDirection] = p_meshData.FaceIndexOffsets[faceDirection];
+        payloadHeader.FaceIndexCounts[faceDirection] = p_meshData.FaceIndexCounts[faceDirection];
+    }
+
+    // NOTE : Relative to the chunk origin, like the vertices, so another chunk with the same blocks can use the mesh
+    payloadHeader.MinimumBounds[0] = p_meshData.MinimumBounds.X - p_chunkOrigin.X;
+    payloadHeader.MinimumBounds[1] = p_meshData.MinimumBounds.Y - p_chunkOrigin.Y;
+    payloadHeader.MinimumBounds[2] = p_meshData.MinimumBounds.Z - p_chunkOrigin.Z;
+    payloadHeader.MaximumBounds[0] = p_meshData.MaximumBounds.X - p_chunkOrigin.X;
+    payloadHeader.MaximumBounds[1] = p_meshData.MaximumBounds.Y - p_chunkOrigin.Y;
+    payloadHeader.MaximumBounds[2] = p_meshData.MaximumBounds.Z - p_chunkOrigin.Z;
+
+    const size_t payloadByteSize = sizeof(PayloadHeader) + p_meshData.Vertices.size() * sizeof(Vertex) +
+        p_meshData.VerticesIndices.size() * sizeof(uint32_t) + p_meshData.SectionConnectivities.size() * sizeof(ChunkFaceConnectivity);
+
+    std::vector<uint8_t> entryBytes(sizeof(EntryHeader) + payloadByteSize);
+    uint8_t* payload = entryBytes.data() + sizeof(EntryHeader);
+
+    memcpy(payload, &payloadHeader, sizeof(PayloadHeader));
+    payload += sizeof(PayloadHeader);
+
+    memcpy(payload, p_meshData.Vertices.data(), p_meshData.Vertices.size() * sizeof(Vertex));
+    payload += p_meshData.Vertices.size() * sizeof(Vertex);
+
+    memcpy(payload, p_meshData.VerticesIndices.data(), p_meshData.VerticesIndices.size() * sizeof(uint32_t));
+    payload += p_meshData.VerticesIndices.size() * sizeof(uint32_t);
+
+    memcpy(payload, p_meshData.SectionConnectivities.data(), p_meshData.SectionConnectivities.size() * sizeof(ChunkFaceConnectivity));
+
+    EntryHeader entryHeader = {};
+    entryHeader.Key = p_key;
+    entryHeader.Checksum = ComputeHash(entryBytes.data() + sizeof(EntryHeader), payloadByteSize, p_key);
+    entryHeader.PayloadByteSize = static_cast<uint32_t>(payloadByteSize);
+
+    memcpy(entryBytes.data(), &entryHeader, sizeof(EntryHeader));
+
+    // - Appending it - //
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_hasWriteFailed || _isFull)
+        return;
+
+    if (_fileByteSize + entryBytes.size() > _maximumByteSize)
+    {
+        PRINT_MESSAGE_RUNTIME("The mesh cache '" + _filePath + "' is full, the next meshes will be cached once it is emptied at the next launch")
+
+        _isFull = true;
+        return;
+    }
+
+    _stream.seekp(static_cast<std::streamoff>(_fileByteSize));
+    _stream.write(reinterpret_cast<const char*>(entryBytes.data()), static_cast<std::streamsize>(entryBytes.size()));
+
+    if (!_stream)
+    {
+        // NOTE : The entries already written are still read, a cut entry is removed at the next launch
+        PRINT_ERROR_RUNTIME(true, "A mesh could not be written inside the mesh cache '" + _filePath + "', the next meshes will not be cached")
+
+        _stream.clear();
+        _hasWriteFailed = true;
+
+        return;
+    }
+
+    EntryLocation entryLocation;
+    entryLocation.PayloadOffset = _fileByteSize + sizeof(EntryHeader);
+    entryLocation.PayloadByteSize = entryHeader.PayloadByteSize;
+    entryLocation.Checksum = entryHeader.Checksum;
+
+    _entryLocations[p_key] = entryLocation;
+    _fileByteSize += entryBytes.size();
+
+    _storedCount++;
+}
+
+uint64_t ChunkMeshCache::ComputeKey(const ChunkVoxelData& p_voxelData, const ChunkBorderPlanes* p_borderPlanes, const int p_levelOfDetail, const int p_blockSize)
+{
+    // NOTE : The mesher version is the seed, so the meshes of an older mesher are never found
+    uint64_t key = ComputeHash(reinterpret_cast<const uint8_t*>(p_voxelData.GetBlocks()), p_voxelData.GetBlockCount() * sizeof(BlockTypes), MESH_CACHE_MESHER_VERSION);
+
+    const int32_t settings[5] = { p_voxelData.Size.X, p_voxelData.Size.Y, p_voxelData.Size.Z, p_levelOfDetail, p_blockSize };
+    key = ComputeHash(reinterpret_cast<const uint8_t*>(settings), sizeof(settings), key);
+
+    // A side without neighbor has no solid blocks, the mesher sees it as Air in both cases
+    if (p_borderPlanes != nullptr)
+    {
+        const std::vector<uint64_t>& borderOccupancy = p_borderPlanes->GetOccupancy();
+        key = ComputeHash(reinterpret_cast<const uint8_t*>(borderOccupancy.data()), borderOccupancy.size() * sizeof(uint64_t), key);
+    }
+
+    return key;
+}
+
+uint64_t ChunkMeshCache::ComputeHash(const uint8_t* p_bytes, const size_t p_byteCount, const uint64_t p_seed)
+{
+    uint64_t hash = p_seed + HASH_PRIME_3 + static_cast<uint64_t>(p_byteCount) * HASH_PRIME_1;
+
+    size_t byteIndex = 0;
+
+    // NOTE : memcpy() because the bytes are not always aligned, the compilers turn it into a single load
+    for (; byteIndex + sizeof(uint64_t) <= p_byteCount; byteIndex += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, p_bytes + byteIndex, sizeof(uint64_t));
+
+        hash ^= RotateLeft(word * HASH_PRIME_2, 31) * HASH_PRIME_1;
+        hash = RotateLeft(hash, 27) * HASH_PRIME_1 + HASH_PRIME_3;
+    }
+
+    for (; byteIndex < p_byteCount; ++byteIndex)
+    {
+        hash ^= p_bytes[byteIndex] * HASH_PRIME_3;
+        hash = RotateLeft(hash, 11) * HASH_PRIME_1;
+    }
+
+    // Each bit of the input changes about half of the bits of the hash
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+size_t ChunkMeshCache::GetEntryCount()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _entryLocations.size();
+}
+
+size_t ChunkMeshCache::GetFileByteSize()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _fileByteSize;
+}
+
+size_t ChunkMeshCache::ReadEntryLocations()
+{
+    size_t offset = sizeof(FileHeader);
+
+    while (offset + sizeof(EntryHeader) <= _mappedByteSize)
+    {
+        EntryHeader entryHeader;
+        memcpy(&entryHeader, _mappedBytes + offset, sizeof(EntryHeader));
+
+        if (entryHeader.PayloadByteSize < sizeof(PayloadHeader) || entryHeader.PayloadByteSize > _mappedByteSize - offset - sizeof(EntryHeader))
+            break;
+
+        // NOTE : The checksum is only checked by Load(), reading the whole file here would slow down the launch
+        EntryLocation entryLocation;
+        entryLocation.PayloadOffset = offset + sizeof(EntryHeader);
+        entryLocation.PayloadByteSize = entryHeader.PayloadByteSize;
+        entryLocation.Checksum = entryHeader.Checksum;
+
+        // The last entry of a key is the newest one
+        _entryLocations[entryHeader.Key] = entryLocation;
+
+        offset += sizeof(EntryHeader) + entryHeader.PayloadByteSize;
+    }
+
+    return offset;
+}
+
+bool ChunkMeshCache::InitializeFile()
+{
+    FileHeader fileHeader = {};
+    memcpy(fileHeader.Magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC));
+    fileHeader.Version = MESH_CACHE_FILE_VERSION;
+    fileHeader.MesherVersion = MESH_CACHE_MESHER_VERSION;
+    fileHeader.VertexByteSize = sizeof(Vertex);
+
+    std::ofstream outputStream(_filePath, std::ios::binary | std::ios::trunc);
+    outputStream.write(reinterpret_cast<const char*>(&fileHeader), sizeof(FileHeader));
+
+    return static_cast<bool>(outputStream);
+}
+
+const uint8_t* ChunkMeshCache::GetPayload(const EntryLocation& p_entryLocation, std::vector<uint8_t>& p_buffer)
+{
+    // NOTE : The mapping never changes once the file is opened, it's read without the lock
+    if (p_entryLocation.PayloadOffset + p_entryLocation.PayloadByteSize <= _mappedByteSize)
+        return _mappedBytes + p_entryLocation.PayloadOffset;
+
+    p_buffer.resize(p_entryLocation.PayloadByteSize);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _stream.seekg(static_cast<std::streamoff>(p_entryLocation.PayloadOffset));
+    _stream.read(reinterpret_cast<char*>(p_buffer.data()), static_cast<std::streamsize>(p_buffer.size()));
+
+    if (!_stream)
+    {
+        _stream.clear();
+        return nullptr;
+    }
+
+    return p_buffer.data();
+}
+
+#pragma region Platform
+
+bool ChunkMeshCache::MapFile()
+{
+    #if defined(_WIN32)
+
+        // NOTE : The file stays writable by _stream, the entries are appended after the mapped part
+        HANDLE fileHandle = CreateFileA(_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileByteSize;
+
+        if (!GetFileSizeEx(fileHandle, &fileByteSize))
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        _mappedByteSize = static_cast<size_t>(fileByteSize.QuadPart);
+
+        // An empty file can't be mapped, there is nothing to read anyway
+        if (_mappedByteSize == 0)
+        {
+            CloseHandle(fileHandle);
+            return true;
+        }
+
+        HANDLE fileMappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (fileMappingHandle != nullptr)
+            _mappedBytes = static_cast<const uint8_t*>(MapViewOfFile(fileMappingHandle, FILE_MAP_READ, 0, 0, _mappedByteSize));
+
+        // NOTE : The view keeps the mapping (and the file) open by itself
+        if (fileMappingHandle != nullptr)
+            CloseHandle(fileMappingHandle);
+
+        CloseHandle(fileHandle);
+
+    #else
+
+        const int fileDescriptor = open(_filePath.c_str(), O_RDONLY);
+
+        if (fileDescriptor < 0)
+            return false;
+
+        struct stat fileStatus;
+
+        if (fstat(fileDescriptor, &fileStatus) != 0)
+        {
+            close(fileDescriptor);
+            return false;
+        }
+
+        _mappedByteSize = static_cast<size_t>(fileStatus.st_size);
+
+        if (_mappedByteSize == 0)
+        {
+            close(fileDescriptor);
+            return true;
+        }
+
+        void* mappedBytes = mmap(nullptr, _mappedByteSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+
+        if (mappedBytes != MAP_FAILED)
+            _mappedBytes = static_cast<const uint8_t*>(mappedBytes);
+
+        // NOTE : The mapping keeps the file open by itself
+        close(fileDescriptor);
+
+    #endif
+
+    if (_mappedBytes == nullptr)
+    {
+        _mappedByteSize = 0;
+        return false;
+    }
+
+    return true;
+}
+
+void ChunkMeshCache::UnmapFile()
+{
+    #if defined(_WIN32)
+
+        if (_mappedBytes != nullptr)
+            UnmapViewOfFile(_mappedBytes);
+
+    #else
+
+        if (_mappedBytes != nullptr)
+            munmap(const_cast<uint8_t*>(_mappedBytes), _mappedByteSize);
+
+    #endif
+
+    _mappedBytes = nullptr;
+    _mappedByteSize = 0;
+}
+
+bool ChunkMeshCache::TruncateFile(const size_t p_byteSize) const
+{
+    #if defined(_WIN32)
+
+        HANDLE fileHandle = CreateFileA(_filePath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileByteSize;
+        fileByteSize.QuadPart = static_cast<LONGLONG>(p_byteSize);
+
+        const bool isTruncated = SetFilePointerEx(fileHandle, fileByteSize, nullptr, FILE_BEGIN) && SetEndOfFile(fileHandle);
+
+        CloseHandle(fileHandle);
+
+        return isTruncated;
+
+    #else
+
+        return truncate(_filePath.c_str(), static_cast<off_t>(p_byteSize)) == 0;
+
+    #endif
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Vector.h"
+
+class ChunkBorderPlanes;
+class ChunkVoxelData;
+struct ChunkMeshData;
+
+/// <summary>
+/// Keeps the finished chunk meshes on the disk, so the next launches don't mesh the same chunks again (see ChunkManager::RequestChunkMesh()).
+///
+/// <para> A mesh is found by the hash of everything it is made from : the blocks of the chunk, the border planes of its neighbors,
+/// the level of detail, the block size and the version of the mesher (see MESH_CACHE_MESHER_VERSION). An edited chunk gets another key,
+/// its old mesh is never found again : a missing or damaged entry only means the chunk is meshed as usual. </para>
+/// <para> <b> Layout : </b> a header (a magic number, the version, the mesher version and the size of a Vertex), then the entries appended
+/// one after the other. An entry is its key, the checksum and the size of its payload, then the payload : the vertices (in the layout sent
+/// to the GPU), the vertices indices, the face ranges, the bounds (relative to the chunk origin) and the sections connectivity. </para>
+/// <para> The file is memory-mapped when it's opened, the meshes of the previous launches are copied from the mapping.
+/// The entries written since are read back from the file. </para>
+/// <para> No entry is written past the maximum size (MESH_CACHE_MAXIMUM_BYTE_SIZE for the game), and the entries are never removed while the file
+/// is opened (the mapping is read without lock). A file of another version, or filled above MESH_CACHE_EMPTYING_FILL_RATIO of the maximum size,
+/// is emptied when it's opened : the dead meshes of the edited chunks don't keep the cache full forever. </para>
+///
+/// <para> Load() and Store() can be called from any thread (the mesh jobs). </para> </summary>
+class ChunkMeshCache
+{
+
+private:
+
+    struct FileHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t MesherVersion;
+        uint32_t VertexByteSize;
+    };
+
+    struct EntryHeader
+    {
+        uint64_t Key;
+
+        /// <summary> See ComputeHash(), the key is its seed. </summary>
+        uint64_t Checksum;
+
+        uint32_t PayloadByteSize;
+        uint32_t Padding;
+    };
+
+    /// <summary> The beginning of a payload, followed by the vertices, the vertices indices and the sections connectivity. </summary>
+    struct PayloadHeader
+    {
+        uint32_t VertexCount;
+        uint32_t VertexIndexCount;
+        uint32_t SectionCount;
+        uint32_t FaceIndexOffsets[6];
+        uint32_t FaceIndexCounts[6];
+        float MinimumBounds[3];
+        float MaximumBounds[3];
+    };
+
+    /// <summary> Where the payload of an entry is inside the file. </summary>
+    struct EntryLocation
+    {
+        uint64_t PayloadOffset;
+        uint32_t PayloadByteSize;
+        uint64_t Checksum;
+    };
+
+    std::string _filePath;
+
+    /// <summary> The file as it was when it was opened (read only), nullptr if it could not be mapped. </summary>
+    const uint8_t* _mappedBytes;
+    size_t _mappedByteSize;
+
+    /// <summary> Used for the entries written after the mapping (appended, then read back), closed if the file can't be used. </summary>
+    std::fstream _stream;
+
+    /// <summary> Protects _stream, _entryLocations and _fileByteSize. </summary>
+    std::mutex _mutex;
+
+    std::unordered_map<uint64_t, EntryLocation> _entryLocations;
+
+    size_t _fileByteSize;
+    size_t _maximumByteSize;
+
+    /// <summary> No more entries are written after a write error (the file may be full). </summary>
+    bool _hasWriteFailed;
+
+    /// <summary> An entry did not fit under the maximum size, the next ones are not written until the file is emptied (at the next launch). </summary>
+    bool _isFull;
+
+    // - Statistics - //
+
+    std::atomic<unsigned long long> _hitCount;
+    std::atomic<unsigned long long> _missCount;
+    std::atomic<unsigned long long> _storedCount;
+    std::atomic<unsigned long long> _damagedCount;
+
+public:
+
+    /// <summary> Opens the cache and reads where its entries are, or creates it. If it can't be used, an error is printed and IsOpen() returns false. </summary>
+    /// <param name = "p_maximumByteSize"> No entry is written past it, the file is emptied when it's opened filled above MESH_CACHE_EMPTYING_FILL_RATIO of it </param>
+    ChunkMeshCache(const std::string& p_filePath, const size_t p_maximumByteSize);
+    ~ChunkMeshCache();
+
+    ChunkMeshCache(const ChunkMeshCache&) = delete;
+    ChunkMeshCache& operator=(const ChunkMeshCache&) = delete;
+
+    bool IsOpen() const { return _stream.is_open(); }
+
+    /// <summary>
+    /// Fills the mesh with the cached one, returns false if there is none (or if it is damaged, the entry is forgotten then).
+    /// <para> The bounds are moved to the chunk origin (the chunk's world position * block size), the mesh is the same as the GreedyMesher's one. </para> </summary>
+    bool Load(const uint64_t p_key, const Vector3& p_chunkOrigin, ChunkMeshData& p_outMeshData);
+
+    /// <summary> Appends the mesh at the end of the file (nothing once the file reached its maximum size, until it is emptied at the next launch). </summary>
+    void Store(const uint64_t p_key, const Vector3& p_chunkOrigin, const ChunkMeshData& p_meshData);
+
+    /// <summary> The key of the mesh GreedyMesher would create from these blocks, border planes and settings. </summary>
+    /// <param name = "p_borderPlanes"> The ones given to the mesher (nullptr for the levels of detail) </param>
+    static uint64_t ComputeKey(const ChunkVoxelData& p_voxelData, const ChunkBorderPlanes* p_borderPlanes, const int p_levelOfDetail, const int p_blockSize);
+
+    /// <summary> A fast 64 bits hash (8 bytes at a time, in the spirit of xxHash), not a cryptographic one. </summary>
+    static uint64_t ComputeHash(const uint8_t* p_bytes, const size_t p_byteCount, const uint64_t p_seed);
+
+    size_t GetEntryCount();
+    size_t GetFileByteSize();
+
+    unsigned long long GetHitCount() const { return _hitCount; }
+    unsigned long long GetMissCount() const { return _missCount; }
+    unsigned long long GetStoredCount() const { return _storedCount; }
+    unsigned long long GetDamagedCount() const { return _damagedCount; }
+
+private:
+
+    /// <summary> Reads where the entries of the mapped file are, returns the end of the last complete one (the rest is cut off). </summary>
+    size_t ReadEntryLocations();
+
+    /// <summary> Writes the header into a new (or emptied) file. </summary>
+    bool InitializeFile();
+
+    /// <summary> Reads the payload from the mapping, or from the file if it was written after the mapping. Returns nullptr on a read error. </summary>
+    const uint8_t* GetPayload(const EntryLocation& p_entryLocation, std::vector<uint8_t>& p_buffer);
+
+    // - Platform - //
+
+    /// <summary> Maps the whole file in memory (read only), gives its size. </summary>
+    bool MapFile();
+    void UnmapFile();
+
+    /// <summary> Cuts the file at the given size, it must not be mapped. </summary>
+    bool TruncateFile(const size_t p_byteSize) const;
+};
\ No newline at end of file
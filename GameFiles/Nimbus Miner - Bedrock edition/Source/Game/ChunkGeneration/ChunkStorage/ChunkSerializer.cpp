@@ -0,0 +1,372 @@
+#include "ChunkSerializer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../ChunkVoxelData/ChunkVoxelData.h"
+
+// Incremented every time the layout of the bytes changes, the chunks stored with another version are regenerated
+static constexpr uint8_t SERIALIZATION_VERSION = 1;
+
+// A block type is one byte, so a palette never has more entries
+static constexpr int MAXIMUM_PALETTE_SIZE = 256;
+
+// A shorter copy would take more bytes than the literals it replaces
+static constexpr size_t COMPRESSION_MINIMUM_MATCH_LENGTH = 4;
+
+// The offset is stored on 2 bytes
+static constexpr size_t COMPRESSION_MAXIMUM_OFFSET = 65535;
+
+static constexpr int COMPRESSION_HASH_BIT_COUNT = 12;
+
+void ChunkSerializer::Serialize(const ChunkVoxelData& p_voxelData, std::vector<uint8_t>& p_outBytes)
+{
+    const BlockTypes* blocks = p_voxelData.GetBlocks();
+    const size_t blockCount = p_voxelData.GetBlockCount();
+
+    // - Palette - //
+
+    int paletteIndices[MAXIMUM_PALETTE_SIZE];
+    std::fill(paletteIndices, paletteIndices + MAXIMUM_PALETTE_SIZE, -1);
+
+    std::vector<uint8_t> palette;
+
+    for (size_t i = 0; i < blockCount; ++i)
+    {
+        const uint8_t blockType = static_cast<uint8_t>(blocks[i]);
+
+        if (paletteIndices[blockType] >= 0)
+            continue;
+
+        paletteIndices[blockType] = static_cast<int>(palette.size());
+        palette.push_back(blockType);
+    }
+
+    p_outBytes.push_back(SERIALIZATION_VERSION);
+
+    // NOTE : Stored minus one, so the 256 entries still fit inside one byte (an allocated chunk has at least one block)
+    p_outBytes.push_back(static_cast<uint8_t>(palette.empty() ? 0 : palette.size() - 1));
+    p_outBytes.insert(p_outBytes.end(), palette.begin(), palette.end());
+
+    // - Runs - //
+
+    std::vector<uint8_t> runs;
+    size_t runStart = 0;
+
+    while (runStart < blockCount)
+    {
+        size_t runEnd = runStart + 1;
+
+        // NOTE : A run can go on into the next column (a column of air under the world's ceiling, for example)
+        while (runEnd < blockCount && blocks[runEnd] == blocks[runStart] && runEnd - runStart < UINT32_MAX)
+            runEnd++;
+
+        WriteVariableInteger(static_cast<uint32_t>(runEnd - runStart), runs);
+        runs.push_back(static_cast<uint8_t>(paletteIndices[static_cast<uint8_t>(blocks[runStart])]));
+
+        runStart = runEnd;
+    }
+
+    WriteVariableInteger(static_cast<uint32_t>(runs.size()), p_outBytes);
+    CompressBytes(runs, p_outBytes);
+}
+
+bool ChunkSerializer::Deserialize(const uint8_t* p_bytes, const size_t p_byteCount, ChunkVoxelData& p_outVoxelData)
+{
+    if (p_byteCount < 2 || p_bytes[0] != SERIALIZATION_VERSION)
+        return false;
+
+    const size_t paletteSize = static_cast<size_t>(p_bytes[1]) + 1;
+    size_t position = 2;
+
+    if (position + paletteSize > p_byteCount)
+        return false;
+
+    const uint8_t* palette = p_bytes + position;
+    position += paletteSize;
+
+    // - Runs - //
+
+    const Vector3Int& size = p_outVoxelData.Size;
+    const size_t blockCount = static_cast<size_t>(size.X) * size.Y * size.Z;
+
+    uint32_t runsByteSize = 0;
+
+    // NOTE : A run takes 6 bytes at most, a bigger size can only come from damaged bytes
+    if (!ReadVariableInteger(p_bytes, p_byteCount, position, runsByteSize) || runsByteSize > blockCount * 6)
+        return false;
+
+    std::vector<uint8_t> runs(runsByteSize);
+
+    if (!DecompressBytes(p_bytes + position, p_byteCount - position, runs))
+        return false;
+
+    // - Blocks - //
+
+    p_outVoxelData.Allocate();
+
+    // NOTE : The columns are next to each other in memory, so all the blocks are written through the first one
+    BlockTypes* blocks = p_outVoxelData.GetColumn(0, 0);
+
+    size_t blockIndex = 0;
+    size_t runsPosition = 0;
+
+    // NOTE : The solid runs next to each other (the strata) get their occupancy together, when the next air run is found
+    size_t solidBlocksStart = blockCount;
+
+    while (runsPosition < runs.size())
+    {
+        uint32_t runLength = 0;
+
+        if (!ReadVariableInteger(runs.data(), runs.size(), runsPosition, runLength) || runsPosition >= runs.size())
+            return false;
+
+        const uint8_t paletteIndex = runs[runsPosition++];
+
+        if (paletteIndex >= paletteSize || runLength > blockCount - blockIndex)
+            return false;
+
+        const BlockTypes blockType = static_cast<BlockTypes>(palette[paletteIndex]);
+        std::fill(blocks + blockIndex, blocks + blockIndex + runLength, blockType);
+
+        if (IsSolidBlockType(blockType))
+        {
+            if (solidBlocksStart == blockCount)
+                solidBlocksStart = blockIndex;
+        }
+        else if (solidBlocksStart != blockCount)
+        {
+            SetSolidBlocks(solidBlocksStart, blockIndex, p_outVoxelData);
+            solidBlocksStart = blockCount;
+        }
+
+        blockIndex += runLength;
+    }
+
+    if (solidBlocksStart != blockCount)
+        SetSolidBlocks(solidBlocksStart, blockIndex, p_outVoxelData);
+
+    // The runs have to cover the whole chunk
+    return blockIndex == blockCount;
+}
+
+uint32_t ChunkSerializer::ComputeChecksum(const uint8_t* p_bytes, const size_t p_byteCount)
+{
+    // The remainder of each byte value, computed once
+    static const std::vector<uint32_t> table = []
+    {
+        std::vector<uint32_t> values(256);
+
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t value = i;
+
+            for (int bit = 0; bit < 8; ++bit)
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+
+            values[i] = value;
+        }
+
+        return values;
+    }();
+
+    uint32_t checksum = 0xFFFFFFFFu;
+
+    for (size_t i = 0; i < p_byteCount; ++i)
+        checksum = table[(checksum ^ p_bytes[i]) & 0xFF] ^ (checksum >> 8);
+
+    return checksum ^ 0xFFFFFFFFu;
+}
+
+void ChunkSerializer::SetSolidBlocks(const size_t p_firstBlockIndex, const size_t p_endBlockIndex, ChunkVoxelData& p_outVoxelData)
+{
+    const Vector3Int& size = p_outVoxelData.Size;
+
+    // The blocks can go on into the next columns
+    for (size_t blockIndex = p_firstBlockIndex; blockIndex < p_endBlockIndex; )
+    {
+        const size_t column = blockIndex / size.Y;
+        const int firstY = static_cast<int>(blockIndex % size.Y);
+        const int count = static_cast<int>(std::min<size_t>(p_endBlockIndex - blockIndex, static_cast<size_t>(size.Y - firstY)));
+
+        p_outVoxelData.SetColumnOccupancy(static_cast<int>(column % size.X), static_cast<int>(column / size.X), firstY, count, true);
+        blockIndex += count;
+    }
+}
+
+void ChunkSerializer::CompressBytes(const std::vector<uint8_t>& p_bytes, std::vector<uint8_t>& p_outBytes)
+{
+    const size_t byteCount = p_bytes.size();
+
+    // The last position of each 4 bytes sequence (by hash), -1 if none
+    std::vector<int> lastPositions(static_cast<size_t>(1) << COMPRESSION_HASH_BIT_COUNT, -1);
+
+    size_t literalStart = 0;
+    size_t position = 0;
+
+    while (position + COMPRESSION_MINIMUM_MATCH_LENGTH <= byteCount)
+    {
+        uint32_t sequence;
+        std::memcpy(&sequence, p_bytes.data() + position, sizeof(sequence));
+
+        const uint32_t hash = (sequence * 2654435761u) >> (32 - COMPRESSION_HASH_BIT_COUNT);
+        const int matchPosition = lastPositions[hash];
+        lastPositions[hash] = static_cast<int>(position);
+
+        if (matchPosition < 0 || position - matchPosition > COMPRESSION_MAXIMUM_OFFSET ||
+            std::memcmp(p_bytes.data() + matchPosition, p_bytes.data() + position, COMPRESSION_MINIMUM_MATCH_LENGTH) != 0)
+        {
+            position++;
+            continue;
+        }
+
+        // NOTE : The match can overlap the bytes it copies (a repeated pattern), they are copied one by one
+        size_t matchLength = COMPRESSION_MINIMUM_MATCH_LENGTH;
+
+        while (position + matchLength < byteCount && p_bytes[matchPosition + matchLength] == p_bytes[position + matchLength])
+            matchLength++;
+
+        WriteSequence(p_bytes.data() + literalStart, position - literalStart, position - matchPosition, matchLength, p_outBytes);
+
+        position += matchLength;
+        literalStart = position;
+    }
+
+    // The last sequence only has literals (it can have none)
+    WriteSequence(p_bytes.data() + literalStart, byteCount - literalStart, 0, 0, p_outBytes);
+}
+
+bool ChunkSerializer::DecompressBytes(const uint8_t* p_bytes, const size_t p_byteCount, std::vector<uint8_t>& p_outBytes)
+{
+    size_t position = 0;
+    size_t outPosition = 0;
+
+    while (position < p_byteCount)
+    {
+        const uint8_t token = p_bytes[position++];
+
+        // - Literals - //
+
+        size_t literalCount = token >> 4;
+
+        if (!ReadSequenceLength(p_bytes, p_byteCount, position, literalCount))
+            return false;
+
+        if (literalCount > p_byteCount - position || literalCount > p_outBytes.size() - outPosition)
+            return false;
+
+        std::memcpy(p_outBytes.data() + outPosition, p_bytes + position, literalCount);
+        position += literalCount;
+        outPosition += literalCount;
+
+        // The last sequence has no match
+        if (position == p_byteCount)
+            break;
+
+        // - Match - //
+
+        if (position + 2 > p_byteCount)
+            return false;
+
+        const size_t offset = p_bytes[position] | (static_cast<size_t>(p_bytes[position + 1]) << 8);
+        position += 2;
+
+        size_t matchLength = token & 0x0F;
+
+        if (!ReadSequenceLength(p_bytes, p_byteCount, position, matchLength))
+            return false;
+
+        matchLength += COMPRESSION_MINIMUM_MATCH_LENGTH;
+
+        if (offset == 0 || offset > outPosition || matchLength > p_outBytes.size() - outPosition)
+            return false;
+
+        for (size_t i = 0; i < matchLength; ++i, ++outPosition)
+            p_outBytes[outPosition] = p_outBytes[outPosition - offset];
+    }
+
+    return outPosition == p_outBytes.size();
+}
+
+void ChunkSerializer::WriteSequence(const uint8_t* p_literals, const size_t p_literalCount, const size_t p_matchOffset, const size_t p_matchLength,
+    std::vector<uint8_t>& p_outBytes)
+{
+    // The two lengths share the token, 15 means that the rest of the length follows
+    const size_t matchLengthCode = p_matchLength > 0 ? p_matchLength - COMPRESSION_MINIMUM_MATCH_LENGTH : 0;
+
+    p_outBytes.push_back(static_cast<uint8_t>((std::min<size_t>(p_literalCount, 15) << 4) | std::min<size_t>(matchLengthCode, 15)));
+
+    WriteSequenceLength(p_literalCount, p_outBytes);
+    p_outBytes.insert(p_outBytes.end(), p_literals, p_literals + p_literalCount);
+
+    if (p_matchLength == 0)
+        return;
+
+    p_outBytes.push_back(static_cast<uint8_t>(p_matchOffset & 0xFF));
+    p_outBytes.push_back(static_cast<uint8_t>(p_matchOffset >> 8));
+
+    WriteSequenceLength(matchLengthCode, p_outBytes);
+}
+
+void ChunkSerializer::WriteSequenceLength(size_t p_length, std::vector<uint8_t>& p_outBytes)
+{
+    if (p_length < 15)
+        return;
+
+    // The first 15 are inside the token, then the bytes are added until one is not 255
+    for (p_length -= 15; p_length >= 255; p_length -= 255)
+        p_outBytes.push_back(255);
+
+    p_outBytes.push_back(static_cast<uint8_t>(p_length));
+}
+
+bool ChunkSerializer::ReadSequenceLength(const uint8_t* p_bytes, const size_t p_byteCount, size_t& p_position, size_t& p_length)
+{
+    if (p_length < 15)
+        return true;
+
+    uint8_t byte;
+
+    do
+    {
+        if (p_position >= p_byteCount)
+            return false;
+
+        byte = p_bytes[p_position++];
+        p_length += byte;
+    }
+    while (byte == 255);
+
+    return true;
+}
+
+void ChunkSerializer::WriteVariableInteger(uint32_t p_value, std::vector<uint8_t>& p_outBytes)
+{
+    while (p_value >= 0x80)
+    {
+        p_outBytes.push_back(static_cast<uint8_t>(p_value | 0x80));
+        p_value >>= 7;
+    }
+
+    p_outBytes.push_back(static_cast<uint8_t>(p_value));
+}
+
+bool ChunkSerializer::ReadVariableInteger(const uint8_t* p_bytes, const size_t p_byteCount, size_t& p_position, uint32_t& p_outValue)
+{
+    p_outValue = 0;
+
+    // NOTE : 5 bytes at most, 7 bits each hold the 32 bits
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (p_position >= p_byteCount)
+            return false;
+
+        const uint8_t byte = p_bytes[p_position++];
+        p_outValue |= static_cast<uint32_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
\ No newline at end of file
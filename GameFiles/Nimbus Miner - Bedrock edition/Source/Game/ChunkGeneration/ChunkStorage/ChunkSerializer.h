@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ChunkVoxelData;
+
+/// <summary>
+/// Converts the blocks of a chunk to bytes and back, used to store the chunks inside the region files (see RegionFile).
+///
+/// <para> The blocks are read in their memory order, column by column (see ChunkVoxelData::GetBlockIndex()), so a column is
+/// only a few runs : the strata, then the air above the surface. Each block type is replaced by its index inside a palette
+/// of the types used by the chunk, then the runs of the same index are stored as (length, index) pairs. </para>
+/// <para> The next columns have the same strata with a few different lengths, so the runs are compressed again by an LZ77 pass
+/// (the same sequences as the LZ4 block format) : a column is mostly a copy of the previous one. </para>
+/// <para> A generated 32x64x32 chunk (64 KB of blocks) takes a few KB. </para>
+/// <para> Does not use OpenGL, so it can be used on any thread. </para> </summary>
+class ChunkSerializer
+{
+
+public:
+
+    /// <summary> Appends the compressed blocks to p_outBytes (the position and the size are not stored, the region file knows them). </summary>
+    static void Serialize(const ChunkVoxelData& p_voxelData, std::vector<uint8_t>& p_outBytes);
+
+    /// <summary>
+    /// Fills the blocks (and their occupancy) of p_outVoxelData, its position and size must already be set.
+    /// <para> Returns false if the bytes are not a valid chunk of that size, the blocks are then undefined. </para> </summary>
+    static bool Deserialize(const uint8_t* p_bytes, const size_t p_byteCount, ChunkVoxelData& p_outVoxelData);
+
+    /// <summary> CRC-32 (the one used by zip files), detects the payloads damaged on the disk. </summary>
+    static uint32_t ComputeChecksum(const uint8_t* p_bytes, const size_t p_byteCount);
+
+private:
+
+    /// <summary> Sets the occupancy of the blocks [p_firstBlockIndex, p_endBlockIndex[ (see ChunkVoxelData::GetBlockIndex()), column by column. </summary>
+    static void SetSolidBlocks(const size_t p_firstBlockIndex, const size_t p_endBlockIndex, ChunkVoxelData& p_outVoxelData);
+
+    /// <summary> Appends the LZ77 sequences of the bytes : literals, then a copy of earlier bytes (offset, length). </summary>
+    static void CompressBytes(const std::vector<uint8_t>& p_bytes, std::vector<uint8_t>& p_outBytes);
+
+    /// <summary> Fills p_outBytes (its size is the decompressed size), returns false if the sequences don't fill it exactly. </summary>
+    static bool DecompressBytes(const uint8_t* p_bytes, const size_t p_byteCount, std::vector<uint8_t>& p_outBytes);
+
+    /// <summary> Appends one sequence : the token (both lengths, 4 bits each), the literals, then the match offset (2 bytes). No match if p_matchLength is 0. </summary>
+    static void WriteSequence(const uint8_t* p_literals, const size_t p_literalCount, const size_t p_matchOffset, const size_t p_matchLength,
+        std::vector<uint8_t>& p_outBytes);
+
+    /// <summary> The part of a length that does not fit inside the token (15 or more). </summary>
+    static void WriteSequenceLength(size_t p_length, std::vector<uint8_t>& p_outBytes);
+    static bool ReadSequenceLength(const uint8_t* p_bytes, const size_t p_byteCount, size_t& p_position, size_t& p_length);
+
+    /// <summary> Appends the value 7 bits per byte, the high bit tells if another byte follows (LEB128). </summary>
+    static void WriteVariableInteger(uint32_t p_value, std::vector<uint8_t>& p_outBytes);
+
+    /// <summary> Returns false if the bytes end before the value does. </summary>
+    static bool ReadVariableInteger(const uint8_t* p_bytes, const size_t p_byteCount, size_t& p_position, uint32_t& p_outValue);
+};
\ No newline at end of file
@@ -0,0 +1,587 @@
+#include "ChunkStorage.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#if defined(_WIN32)
+    #include <Windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "../../../Engine/Threading/ThreadPool.h"
+
+#include "ChunkSerializer.h"
+
+#include "ProjectConstants.h"
+#include "MessageDebugger/MessageDebugger.h"
+
+static constexpr const char* WORLD_SETTINGS_FILE_NAME = "World.txt";
+static constexpr const char* EDIT_JOURNAL_FILE_NAME = "Edits.journal";
+static constexpr const char* MANIFEST_FILE_NAME = "Manifest.txt";
+
+ChunkStorage::ChunkStorage(const std::string& p_directoryPath, const Vector3Int& p_chunkSize, ThreadPool* p_decompressionThreadPool) :
+    _finishedWriteCount(0), _pendingRequestCount(0), _loadedChunkCount(0), _savedChunkCount(0), _corruptedChunkCount(0), _savedByteCount(0), _savedUncompressedByteCount(0),
+    _savedEditCount(0), _failedCommitCount(0), _lastCommitMilliseconds(0.0)
+{
+    // Initialising class' variables
+    _directoryPath = p_directoryPath;
+    _chunkSize = p_chunkSize;
+    _decompressionThreadPool = p_decompressionThreadPool;
+    _editJournal = nullptr;
+
+    if (!CreateDirectories(_directoryPath))
+        PRINT_ERROR_RUNTIME(true, "The save directory '" + _directoryPath + "' could not be created, the chunks will not be saved")
+
+    _hasUncommittedWrites = false;
+    _uncommittedChunkCount = 0;
+    _uncommittedEditCount = 0;
+    _requestedWriteCount = 0;
+
+    // NOTE : Read before any region file is opened, they ignore the saves after it
+    _committedSaveNumber = ReadManifest();
+    _nextSaveNumber = _committedSaveNumber + 1;
+
+    _ioThread = new ThreadPool(1);
+}
+
+ChunkStorage::~ChunkStorage()
+{
+    // NOTE : The thread pool drops the jobs that did not start, the saves have to be finished first
+    RequestCommit();
+    WaitForIdle();
+    delete _ioThread;
+
+    delete _editJournal;
+
+    for (const std::pair<const long long, RegionFile*>& regionFile : _regionFiles)
+        delete regionFile.second;
+
+    _regionFiles.clear();
+}
+
+bool ChunkStorage::HasChunk(const Vector2Int& p_chunkPosition)
+{
+    const RegionFile* regionFile = GetRegionFile(p_chunkPosition);
+
+    if (regionFile == nullptr)
+        return false;
+
+    const Vector2Int localPosition = RegionFile::GetLocalPosition(p_chunkPosition);
+
+    return regionFile->HasChunk(localPosition.X, localPosition.Y);
+}
+
+void ChunkStorage::RequestLoad(const Vector2Int& p_chunkPosition, const Vector3& p_worldPosition)
+{
+    _pendingRequestCount++;
+
+    _ioThread->Submit([this, p_chunkPosition, p_worldPosition]
+    {
+        LoadResult loadResult;
+        loadResult.ChunkPosition = p_chunkPosition;
+        loadResult.VoxelData.WorldPosition = p_worldPosition;
+        loadResult.VoxelData.Size = _chunkSize;
+
+        RegionFile* regionFile = GetRegionFile(p_chunkPosition);
+        const Vector2Int localPosition = RegionFile::GetLocalPosition(p_chunkPosition);
+
+        std::vector<uint8_t> payload;
+        const RegionFile::ReadResults readResult = regionFile != nullptr ?
+            regionFile->ReadChunk(localPosition.X, localPosition.Y, payload) : RegionFile::ReadResults::Missing;
+
+        // NOTE : Only the read has to stay in order with the saves, the decompression can run beside the next reads
+        if (_decompressionThreadPool == nullptr)
+        {
+            FinishLoad(loadResult, readResult, payload);
+            return;
+        }
+
+        _decompressionThreadPool->Submit([this, loadResult, readResult, payload]() mutable
+        {
+            FinishLoad(loadResult, readResult, payload);
+        });
+    });
+}
+
+void ChunkStorage::RequestSave(const Vector2Int& p_chunkPosition, const ChunkVoxelData& p_voxelData)
+{
+    if (!p_voxelData.IsGenerated())
+        return;
+
+    _pendingRequestCount++;
+    _requestedWriteCount++;
+
+    // NOTE : Only a reference is taken, the blocks are copied only if the chunk is edited before the end of the save
+    const ChunkVoxelData voxelDataSnapshot = p_voxelData;
+
+    _ioThread->Submit([this, p_chunkPosition, voxelDataSnapshot]
+    {
+        RegionFile* regionFile = GetRegionFile(p_chunkPosition);
+
+        if (regionFile != nullptr)
+        {
+            std::vector<uint8_t> payload;
+            ChunkSerializer::Serialize(voxelDataSnapshot, payload);
+
+            const Vector2Int localPosition = RegionFile::GetLocalPosition(p_chunkPosition);
+
+            if (regionFile->WriteChunk(localPosition.X, localPosition.Y, payload.data(), payload.size()))
+            {
+                _savedChunkCount++;
+                _savedByteCount += payload.size();
+                _savedUncompressedByteCount += voxelDataSnapshot.GetBlockCount() * sizeof(BlockTypes);
+
+                _hasUncommittedWrites = true;
+                _uncommittedChunkCount++;
+
+                // NOTE : Only once the snapshot is on the disk, the edits are replayed on it until then
+                if (_editJournal != nullptr)
+                    _editJournal->ClearChunk(p_chunkPosition);
+            }
+        }
+
+        _finishedWriteCount++;
+        _pendingRequestCount--;
+    });
+}
+
+void ChunkStorage::RequestEditsSave(const Vector2Int& p_chunkPosition, const std::vector<ChunkEditJournal::BlockEdit>& p_edits)
+{
+    if (_editJournal == nullptr || p_edits.empty())
+        return;
+
+    _pendingRequestCount++;
+    _requestedWriteCount++;
+
+    _ioThread->Submit([this, p_chunkPosition, p_edits]
+    {
+        if (_editJournal->AppendEdits(p_chunkPosition, p_edits))
+        {
+            _savedEditCount += p_edits.size();
+
+            _hasUncommittedWrites = true;
+            _uncommittedEditCount += p_edits.size();
+        }
+
+        _finishedWriteCount++;
+        _pendingRequestCount--;
+    });
+}
+
+unsigned long long ChunkStorage::RequestChunkSave(const Vector2Int& p_chunkPosition, const ChunkVoxelData& p_voxelData,
+    const std::vector<ChunkEditJournal::BlockEdit>& p_pendingEdits, const bool p_isEditJournalUsed)
+{
+    // NOTE : The saved edits and the pending ones can touch the same blocks, the count is an upper bound
+    const bool isSavedAsEdits = p_isEditJournalUsed && _editJournal != nullptr &&
+        _editJournal->GetChunkEditCount(p_chunkPosition) + p_pendingEdits.size() <= CHUNK_EDIT_JOURNAL_SNAPSHOT_EDIT_COUNT;
+
+    // NOTE : Only a snapshot is given, the chunk can be edited again during the write
+    if (isSavedAsEdits)
+        RequestEditsSave(p_chunkPosition, p_pendingEdits);
+    else
+        RequestSave(p_chunkPosition, p_voxelData);
+
+    return _requestedWriteCount;
+}
+
+void ChunkStorage::RequestCommit()
+{
+    _pendingRequestCount++;
+
+    const std::chrono::high_resolution_clock::time_point requestTime = std::chrono::high_resolution_clock::now();
+
+    _ioThread->Submit([this, requestTime]
+    {
+        if (!_hasUncommittedWrites)
+        {
+            _pendingRequestCount--;
+            return;
+        }
+
+        const uint32_t saveNumber = _nextSaveNumber++;
+
+        // - Region files and edit journal - //
+
+        std::vector<RegionFile*> writtenRegionFiles;
+
+        {
+            std::lock_guard<std::mutex> lock(_regionFilesMutex);
+
+            for (const std::pair<const long long, RegionFile*>& regionFile : _regionFiles)
+            {
+                if (regionFile.second != nullptr && regionFile.second->HasUncommittedWrites())
+                    writtenRegionFiles.push_back(regionFile.second);
+            }
+        }
+
+        bool isPrepared = true;
+
+        for (RegionFile* regionFile : writtenRegionFiles)
+            isPrepared = regionFile->PrepareCommit(saveNumber) && isPrepared;
+
+        if (_editJournal != nullptr)
+            isPrepared = _editJournal->Commit(saveNumber) && isPrepared;
+
+        // - Manifest - //
+
+        // NOTE : Nothing is committed if a file failed, the next launch loads the previous save (the next commit tries again)
+        if (!isPrepared || !WriteManifest(saveNumber))
+        {
+            std::stringstream errorMessage;
+            errorMessage << "The save " << saveNumber << " could not be written inside '" << _directoryPath << "', it will be tried again by the next save";
+
+            PRINT_ERROR_RUNTIME(true, errorMessage.str())
+            _failedCommitCount++;
+            _pendingRequestCount--;
+            return;
+        }
+
+        for (RegionFile* regionFile : writtenRegionFiles)
+            regionFile->FinishCommit();
+
+        _committedSaveNumber = saveNumber;
+        _hasUncommittedWrites = false;
+        _uncommittedChunkCount = 0;
+        _uncommittedEditCount = 0;
+
+        if (_editJournal != nullptr)
+            _editJournal->CompactIfNeeded();
+
+        _lastCommitMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - requestTime).count();
+        _pendingRequestCount--;
+    });
+}
+
+bool ChunkStorage::IsAutosaveDue(const std::chrono::steady_clock::time_point& p_lastSaveTime, const float p_intervalSeconds) const
+{
+    return std::chrono::duration<float>(std::chrono::steady_clock::now() - p_lastSaveTime).count() >= p_intervalSeconds && _pendingRequestCount == 0;
+}
+
+void ChunkStorage::TakeFinishedLoads(std::vector<LoadResult>& p_outLoads)
+{
+    std::lock_guard<std::mutex> lock(_finishedLoadsMutex);
+
+    for (LoadResult& finishedLoad : _finishedLoads)
+        p_outLoads.push_back(std::move(finishedLoad));
+
+    _finishedLoads.clear();
+}
+
+void ChunkStorage::WaitForIdle()
+{
+    // The I/O thread first, it submits the decompressions
+    _ioThread->WaitForIdle();
+
+    if (_decompressionThreadPool != nullptr)
+        _decompressionThreadPool->WaitForIdle();
+}
+
+bool ChunkStorage::LoadWorldSettings(int& p_outWorldSeed, float& p_outNoiseFrequency) const
+{
+    std::ifstream stream(_directoryPath + "/" + WORLD_SETTINGS_FILE_NAME);
+
+    if (!stream.is_open())
+        return false;
+
+    int worldSeed = 0;
+    float noiseFrequency = 0.0f;
+    bool hasWorldSeed = false;
+    bool hasNoiseFrequency = false;
+
+    // One "name value" pair per line
+    std::string line;
+
+    while (getline(stream, line))
+    {
+        std::stringstream lineStream(line);
+        std::string name;
+        lineStream >> name;
+
+        if (name == "seed")
+            hasWorldSeed = static_cast<bool>(lineStream >> worldSeed);
+        else if (name == "noiseFrequency")
+            hasNoiseFrequency = static_cast<bool>(lineStream >> noiseFrequency);
+    }
+
+    if (!hasWorldSeed || !hasNoiseFrequency)
+    {
+        PRINT_WARNING_RUNTIME(true, "The world settings of '" + _directoryPath + "' are incomplete, they have been ignored")
+        return false;
+    }
+
+    p_outWorldSeed = worldSeed;
+    p_outNoiseFrequency = noiseFrequency;
+
+    return true;
+}
+
+void ChunkStorage::SaveWorldSettings(const int p_worldSeed, const float p_noiseFrequency) const
+{
+    std::ofstream stream(_directoryPath + "/" + WORLD_SETTINGS_FILE_NAME, std::ios::trunc);
+
+    if (!stream.is_open())
+    {
+        PRINT_ERROR_RUNTIME(true, "The world settings could not be written inside '" + _directoryPath + "'")
+        return;
+    }
+
+    // NOTE : Written with all its digits, the same frequency has to be read back (the terrain depends on it)
+    stream.precision(9);
+    stream << "seed " << p_worldSeed << "\n";
+    stream << "noiseFrequency " << p_noiseFrequency << "\n";
+}
+
+bool ChunkStorage::OpenEditJournal(const int p_worldSeed, const float p_noiseFrequency)
+{
+    if (_editJournal == nullptr)
+        _editJournal = new ChunkEditJournal(_directoryPath + "/" + EDIT_JOURNAL_FILE_NAME, p_worldSeed, p_noiseFrequency, _chunkSize, _committedSaveNumber);
+
+    if (!_editJournal->IsOpen())
+    {
+        delete _editJournal;
+        _editJournal = nullptr;
+    }
+
+    return _editJournal != nullptr;
+}
+
+float ChunkStorage::GetCompressionRatio() const
+{
+    if (_savedUncompressedByteCount == 0)
+        return 0.0f;
+
+    return static_cast<float>(static_cast<double>(_savedByteCount) / static_cast<double>(_savedUncompressedByteCount));
+}
+
+bool ChunkStorage::WriteFileAtomically(const std::string& p_filePath, const std::vector<uint8_t>& p_bytes)
+{
+    const std::string temporaryFilePath = p_filePath + ".tmp";
+
+    #if defined(_WIN32)
+
+        HANDLE fileHandle = CreateFileA(temporaryFilePath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        DWORD writtenByteCount = 0;
+
+        // NOTE : On the disk before the rename, the new file must be complete once it replaces the old one
+        bool isWritten = WriteFile(fileHandle, p_bytes.data(), static_cast<DWORD>(p_bytes.size()), &writtenByteCount, nullptr) &&
+            writtenByteCount == p_bytes.size() && FlushFileBuffers(fileHandle);
+
+        CloseHandle(fileHandle);
+
+        isWritten = isWritten && MoveFileExA(temporaryFilePath.c_str(), p_filePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+
+    #else
+
+        const int fileDescriptor = open(temporaryFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fileDescriptor < 0)
+            return false;
+
+        size_t writtenByteCount = 0;
+
+        while (writtenByteCount < p_bytes.size())
+        {
+            const ssize_t result = write(fileDescriptor, p_bytes.data() + writtenByteCount, p_bytes.size() - writtenByteCount);
+
+            if (result <= 0)
+                break;
+
+            writtenByteCount += static_cast<size_t>(result);
+        }
+
+        // NOTE : On the disk before the rename, the new file must be complete once it replaces the old one
+        bool isWritten = writtenByteCount == p_bytes.size() && fsync(fileDescriptor) == 0;
+
+        close(fileDescriptor);
+
+        isWritten = isWritten && rename(temporaryFilePath.c_str(), p_filePath.c_str()) == 0;
+
+        // The rename itself is written with the directory
+        if (isWritten)
+        {
+            const size_t separator = p_filePath.find_last_of('/');
+            const int directoryDescriptor = open(separator == std::string::npos ? "." : p_filePath.substr(0, separator).c_str(), O_RDONLY);
+
+            if (directoryDescriptor >= 0)
+            {
+                fsync(directoryDescriptor);
+                close(directoryDescriptor);
+            }
+        }
+
+    #endif
+
+    if (!isWritten)
+        remove(temporaryFilePath.c_str());
+
+    return isWritten;
+}
+
+bool ChunkStorage::FlushFileToDisk(const std::string& p_filePath)
+{
+    #if defined(_WIN32)
+
+        // NOTE : Shared, the file is still open by its owner (a std::ofstream does not deny the writes)
+        HANDLE fileHandle = CreateFileA(p_filePath.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        const bool isFlushed = FlushFileBuffers(fileHandle) != 0;
+
+        CloseHandle(fileHandle);
+
+    #else
+
+        // NOTE : fsync() writes the data of the file, whichever descriptor wrote it
+        const int fileDescriptor = open(p_filePath.c_str(), O_WRONLY);
+
+        if (fileDescriptor < 0)
+            return false;
+
+        const bool isFlushed = fsync(fileDescriptor) == 0;
+
+        close(fileDescriptor);
+
+    #endif
+
+    return isFlushed;
+}
+
+uint32_t ChunkStorage::ReadManifest() const
+{
+    std::ifstream stream(_directoryPath + "/" + MANIFEST_FILE_NAME);
+
+    if (!stream.is_open())
+    {
+        // NOTE : The region files and the edit journal of the saves are ignored without it
+        if (std::ifstream(_directoryPath + "/" + WORLD_SETTINGS_FILE_NAME).is_open())
+            PRINT_WARNING_RUNTIME(true, "The manifest of '" + _directoryPath + "' is missing, the saved chunks will be generated again")
+        else
+            WriteManifest(0);
+
+        return 0;
+    }
+
+    // One "name value" pair per line, like the world settings
+    std::string line;
+
+    while (getline(stream, line))
+    {
+        std::stringstream lineStream(line);
+        std::string name;
+        lineStream >> name;
+
+        uint32_t saveNumber = 0;
+
+        if (name == "save" && lineStream >> saveNumber)
+            return saveNumber;
+    }
+
+    PRINT_WARNING_RUNTIME(true, "The manifest of '" + _directoryPath + "' is damaged, the saved chunks will be generated again")
+
+    return 0;
+}
+
+bool ChunkStorage::WriteManifest(const uint32_t p_saveNumber) const
+{
+    std::stringstream stream;
+    stream << "save " << p_saveNumber << "\n";
+    stream << "chunks " << _uncommittedChunkCount << "\n";
+    stream << "edits " << _uncommittedEditCount << "\n";
+
+    const std::string text = stream.str();
+
+    return WriteFileAtomically(_directoryPath + "/" + MANIFEST_FILE_NAME, std::vector<uint8_t>(text.begin(), text.end()));
+}
+
+void ChunkStorage::FinishLoad(LoadResult& p_loadResult, const RegionFile::ReadResults p_readResult, const std::vector<uint8_t>& p_payload)
+{
+    if (p_readResult == RegionFile::ReadResults::Loaded)
+        p_loadResult.IsLoaded = ChunkSerializer::Deserialize(p_payload.data(), p_payload.size(), p_loadResult.VoxelData);
+
+    if (p_readResult == RegionFile::ReadResults::Corrupted || (p_readResult == RegionFile::ReadResults::Loaded && !p_loadResult.IsLoaded))
+    {
+        std::stringstream warningMessage;
+        warningMessage << "The saved chunk (" << p_loadResult.ChunkPosition.X << ", " << p_loadResult.ChunkPosition.Y << ") is damaged, it will be generated again";
+
+        PRINT_WARNING_RUNTIME(true, warningMessage.str())
+        _corruptedChunkCount++;
+    }
+
+    if (p_loadResult.IsLoaded)
+        _loadedChunkCount++;
+    else
+        p_loadResult.VoxelData.Release();
+
+    {
+        std::lock_guard<std::mutex> lock(_finishedLoadsMutex);
+        _finishedLoads.push_back(std::move(p_loadResult));
+    }
+
+    _pendingRequestCount--;
+}
+
+RegionFile* ChunkStorage::GetRegionFile(const Vector2Int& p_chunkPosition)
+{
+    const Vector2Int regionPosition = RegionFile::GetRegionPosition(p_chunkPosition);
+    const long long regionKey = (static_cast<long long>(regionPosition.X) << 32) ^ static_cast<unsigned int>(regionPosition.Y);
+
+    std::lock_guard<std::mutex> lock(_regionFilesMutex);
+
+    const std::unordered_map<long long, RegionFile*>::iterator foundRegionFile = _regionFiles.find(regionKey);
+
+    if (foundRegionFile != _regionFiles.end())
+        return foundRegionFile->second;
+
+    std::stringstream filePath;
+    filePath << _directoryPath << "/r." << regionPosition.X << "." << regionPosition.Y << ".region";
+
+    RegionFile* regionFile = new RegionFile(filePath.str(), _chunkSize, _committedSaveNumber);
+
+    // NOTE : Kept as nullptr when it can't be used, so it is not opened again (and the error not printed again) for each chunk
+    if (!regionFile->IsOpen())
+    {
+        delete regionFile;
+        regionFile = nullptr;
+    }
+
+    _regionFiles[regionKey] = regionFile;
+
+    return regionFile;
+}
+
+bool ChunkStorage::CreateDirectories(const std::string& p_directoryPath)
+{
+    // Each parent first ("Saves", then "Saves/World"...)
+    for (size_t separator = p_directoryPath.find_first_of("/\\"); ; separator = p_directoryPath.find_first_of("/\\", separator + 1))
+    {
+        const std::string directoryPath = p_directoryPath.substr(0, separator);
+
+        if (!directoryPath.empty())
+        {
+            #if defined(_WIN32)
+                const bool isCreated = CreateDirectoryA(directoryPath.c_str(), nullptr) || GetLastError() == ERROR_ALREADY_EXISTS;
+            #else
+                const bool isCreated = mkdir(directoryPath.c_str(), 0755) == 0 || errno == EEXIST;
+            #endif
+
+            if (!isCreated)
+                return false;
+        }
+
+        if (separator == std::string::npos)
+            return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Vector.h"
+
+#include "../ChunkVoxelData/ChunkVoxelData.h"
+
+#include "ChunkEditJournal.h"
+#include "RegionFile.h"
+
+class ThreadPool;
+
+/// <summary>
+/// Saves and loads the blocks of the chunks inside region files (see RegionFile), in a directory of its own.
+///
+/// <para> The reads, the compression and the writes are done by one I/O thread, in the order they were requested :
+/// a load requested after a save of the same chunk gets the saved blocks. The decompression of the loaded chunks can be given
+/// to a thread pool (they are decompressed in parallel), they are given back to the main thread through TakeFinishedLoads(). </para>
+/// <para> The region files are opened the first time one of their chunks is used, and stay open until the storage is deleted. </para>
+/// <para> <b> Saves : </b> the writes requested before RequestCommit() are one save. The commit flushes the region files and the edit journal
+/// (each one keeps the previous save too), then writes the manifest (the number of the last complete save) into a temporary file renamed
+/// over the old one. The next launches only read what the manifest commits : if the game stops in the middle of a save, the previous one is loaded. </para>
+/// <para> The directory also holds the world settings (the seed and the noise frequency the saved chunks were generated with),
+/// and the edit journal if it is opened (see ChunkEditJournal) : a snapshot of a chunk clears its edits once it is written. </para> </summary>
+class ChunkStorage
+{
+
+public:
+
+    /// <summary> A chunk read by the I/O thread, waiting for the main thread. </summary>
+    struct LoadResult
+    {
+        Vector2Int ChunkPosition = Vector2Int(0, 0);
+
+        /// <summary> False if the chunk was missing or damaged, it has to be generated instead. </summary>
+        bool IsLoaded = false;
+
+        ChunkVoxelData VoxelData = ChunkVoxelData(Vector3(0.0f, 0.0f, 0.0f), Vector3Int(0, 0, 0));
+    };
+
+private:
+
+    std::string _directoryPath;
+    Vector3Int _chunkSize;
+
+    /// <summary> One thread only, so the region files never have two readers or writers at once. </summary>
+    ThreadPool* _ioThread;
+
+    /// <summary> Not owned, decompresses the loaded chunks (the I/O thread does it when nullptr). </summary>
+    ThreadPool* _decompressionThreadPool;
+
+    /// <summary> Opened by the I/O thread or by HasChunk() (main thread), nullptr for the regions that could not be opened. </summary>
+    std::unordered_map<long long, RegionFile*> _regionFiles;
+    std::mutex _regionFilesMutex;
+
+    /// <summary> nullptr until OpenEditJournal(), written by the I/O thread. </summary>
+    ChunkEditJournal* _editJournal;
+
+    std::mutex _finishedLoadsMutex;
+
+    /// <summary> Filled by the I/O thread (or by the decompression jobs), emptied by TakeFinishedLoads(). </summary>
+    std::vector<LoadResult> _finishedLoads;
+
+    // - Saves (written by the I/O thread only) - //
+
+    /// <summary> Read from the manifest, 0 for a new world. </summary>
+    std::atomic<uint32_t> _committedSaveNumber;
+
+    /// <summary> Always after all the save numbers written (a failed commit keeps its number). </summary>
+    uint32_t _nextSaveNumber;
+
+    bool _hasUncommittedWrites;
+    unsigned long long _uncommittedChunkCount;
+    unsigned long long _uncommittedEditCount;
+
+    /// <summary> The number of the last write requested (RequestSave() and RequestEditsSave()), only used by the main thread. </summary>
+    unsigned long long _requestedWriteCount;
+
+    /// <summary> The number of writes done by the I/O thread (written or failed), in the order they were requested. </summary>
+    std::atomic<unsigned long long> _finishedWriteCount;
+
+    // - Statistics (written by the I/O thread and the decompression jobs) - //
+
+    std::atomic<int> _pendingRequestCount;
+    std::atomic<unsigned long long> _loadedChunkCount;
+    std::atomic<unsigned long long> _savedChunkCount;
+    std::atomic<unsigned long long> _corruptedChunkCount;
+    std::atomic<unsigned long long> _savedByteCount;
+    std::atomic<unsigned long long> _savedUncompressedByteCount;
+    std::atomic<unsigned long long> _savedEditCount;
+    std::atomic<unsigned long long> _failedCommitCount;
+
+    /// <summary> From the RequestCommit() call to the manifest write. </summary>
+    std::atomic<double> _lastCommitMilliseconds;
+
+public:
+
+    /// <summary> Creates the directory if it does not exist yet. </summary>
+    /// <param name = "p_decompressionThreadPool"> Shared with other jobs (e.g. the mesh jobs), it must outlive the storage </param>
+    ChunkStorage(const std::string& p_directoryPath, const Vector3Int& p_chunkSize, ThreadPool* p_decompressionThreadPool = nullptr);
+
+    /// <summary> Commits the last writes and waits for all the requests (the saves are never dropped), then closes the region files. </summary>
+    ~ChunkStorage();
+
+    ChunkStorage(const ChunkStorage&) = delete;
+    ChunkStorage& operator=(const ChunkStorage&) = delete;
+
+    /// <summary> Returns true if the chunk was saved (only reads the memory-mapped table of its region). The position is in chunks. </summary>
+    bool HasChunk(const Vector2Int& p_chunkPosition);
+
+    /// <summary> Reads the chunk on the I/O thread, the result is given by TakeFinishedLoads(). </summary>
+    /// <param name = "p_worldPosition"> The position given to the loaded ChunkVoxelData (see ChunkVoxelData::WorldPosition) </param>
+    void RequestLoad(const Vector2Int& p_chunkPosition, const Vector3& p_worldPosition);
+
+    /// <summary> Compresses and writes the blocks on the I/O thread. Only a snapshot is taken, the chunk can be edited right after. </summary>
+    void RequestSave(const Vector2Int& p_chunkPosition, const ChunkVoxelData& p_voxelData);
+
+    /// <summary> Appends the edits to the edit journal on the I/O thread. </summary>
+    void RequestEditsSave(const Vector2Int& p_chunkPosition, const std::vector<ChunkEditJournal::BlockEdit>& p_edits);
+
+    /// <summary> Saves a modified chunk : its pending edits are appended to the edit journal, or a snapshot of its blocks is written if the journal
+    /// is not used (or not opened) or if the chunk would have more than CHUNK_EDIT_JOURNAL_SNAPSHOT_EDIT_COUNT edits. Call RequestCommit() after the last chunk.
+    /// <para> Returns the number of the write : a chunk generated again before IsWriteFinished() would replay the journal without these edits. </para> </summary>
+    unsigned long long RequestChunkSave(const Vector2Int& p_chunkPosition, const ChunkVoxelData& p_voxelData,
+        const std::vector<ChunkEditJournal::BlockEdit>& p_pendingEdits, const bool p_isEditJournalUsed);
+
+    /// <summary> Returns true once the write of that number (see RequestChunkSave()) is done, always true for 0. </summary>
+    bool IsWriteFinished(const unsigned long long p_writeNumber) const { return _finishedWriteCount >= p_writeNumber; }
+
+    /// <summary> Makes the writes requested so far the new save, on the I/O thread (nothing if there are none). </summary>
+    void RequestCommit();
+
+    /// <summary> Returns true once the interval passed since the last save and all the requests are done (the saves would pile up on a slow disk). </summary>
+    bool IsAutosaveDue(const std::chrono::steady_clock::time_point& p_lastSaveTime, const float p_intervalSeconds) const;
+
+    /// <summary> Moves the chunks loaded since the last call into p_outLoads. </summary>
+    void TakeFinishedLoads(std::vector<LoadResult>& p_outLoads);
+
+    /// <summary> Blocks the calling thread until all the requests are done (and all the other jobs of the decompression thread pool). </summary>
+    void WaitForIdle();
+
+    /// <summary> Gives the settings the saved world was created with, returns false if there is no saved world yet. </summary>
+    bool LoadWorldSettings(int& p_outWorldSeed, float& p_outNoiseFrequency) const;
+    void SaveWorldSettings(const int p_worldSeed, const float p_noiseFrequency) const;
+
+    /// <summary> Opens (or creates) the edit journal of the world, returns false if it can't be used. Must be called before any request. </summary>
+    bool OpenEditJournal(const int p_worldSeed, const float p_noiseFrequency);
+
+    /// <summary> nullptr if OpenEditJournal() was not called or failed. </summary>
+    const ChunkEditJournal* GetEditJournal() const { return _editJournal; }
+
+    const std::string& GetDirectoryPath() const { return _directoryPath; }
+
+    int GetPendingRequestCount() const { return _pendingRequestCount; }
+    unsigned long long GetLoadedChunkCount() const { return _loadedChunkCount; }
+    unsigned long long GetSavedChunkCount() const { return _savedChunkCount; }
+    unsigned long long GetCorruptedChunkCount() const { return _corruptedChunkCount; }
+    unsigned long long GetSavedEditCount() const { return _savedEditCount; }
+    unsigned long long GetFailedCommitCount() const { return _failedCommitCount; }
+    uint32_t GetCommittedSaveNumber() const { return _committedSaveNumber; }
+    double GetLastCommitMilliseconds() const { return _lastCommitMilliseconds; }
+
+    /// <summary> The compressed size of the saved chunks divided by the size of their blocks. </summary>
+    float GetCompressionRatio() const;
+
+    /// <summary> Writes the bytes into a temporary file, flushes it to the disk, then renames it over p_filePath : the file is always
+    /// either the old one or the new one, even if the game stops in the middle. </summary>
+    static bool WriteFileAtomically(const std::string& p_filePath, const std::vector<uint8_t>& p_bytes);
+
+    /// <summary> Asks the system to write the cached data of the file to the disk now (FlushFileBuffers / fsync), the file can be open elsewhere. </summary>
+    static bool FlushFileToDisk(const std::string& p_filePath);
+
+private:
+
+    /// <summary> Returns the number of the last committed save (0 if there is no manifest). </summary>
+    uint32_t ReadManifest() const;
+    bool WriteManifest(const uint32_t p_saveNumber) const;
+
+    /// <summary> Decompresses the payload into the load result, then gives it to the main thread. </summary>
+    void FinishLoad(LoadResult& p_loadResult, const RegionFile::ReadResults p_readResult, const std::vector<uint8_t>& p_payload);
+
+    /// <summary> Opens the region file the first time, returns nullptr if it can't be used. </summary>
+    RegionFile* GetRegionFile(const Vector2Int& p_chunkPosition);
+
+    /// <summary> Creates the directory and its parents (does nothing for the ones that exist). </summary>
+    static bool CreateDirectories(const std::string& p_directoryPath);
+};
\ No newline at end of file
@@ -0,0 +1,587 @@
+#include "RegionFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#if defined(_WIN32)
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "ChunkSerializer.h"
+
+#include "MessageDebugger/MessageDebugger.h"
+
+static constexpr char REGION_FILE_MAGIC[4] = { 'N', 'M', 'R', 'G' };
+
+// Incremented every time the layout of the header or of the table changes
+static constexpr uint32_t REGION_FILE_VERSION = 2;
+
+RegionFile::RegionFile(const std::string& p_filePath, const Vector3Int& p_chunkSize, const uint32_t p_committedSaveNumber)
+{
+    // Initialising class' variables
+    _filePath = p_filePath;
+    _chunkSize = p_chunkSize;
+    _mappedSectors = nullptr;
+    _committedTableCopy = 0;
+    _hasUncommittedWrites = false;
+
+    #if defined(_WIN32)
+        _fileHandle = nullptr;
+        _fileMappingHandle = nullptr;
+    #else
+        _fileDescriptor = -1;
+    #endif
+
+    size_t fileByteSize = 0;
+
+    if (!OpenFile(fileByteSize))
+    {
+        PRINT_ERROR_RUNTIME(true, "The region file '" + _filePath + "' could not be opened, its chunks will not be saved")
+        return;
+    }
+
+    if (fileByteSize == 0)
+    {
+        if (!InitializeFile())
+        {
+            PRINT_ERROR_RUNTIME(true, "The region file '" + _filePath + "' could not be created, its chunks will not be saved")
+            CloseFile();
+            return;
+        }
+
+        fileByteSize = RESERVED_SECTOR_COUNT * SECTOR_BYTE_SIZE;
+    }
+
+    // NOTE : The file is left untouched, it may be a save of another version of the game
+    if (fileByteSize < RESERVED_SECTOR_COUNT * SECTOR_BYTE_SIZE || !MapReservedSectors() || !ReadTable(fileByteSize, p_committedSaveNumber))
+    {
+        PRINT_ERROR_RUNTIME(true, "The file '" + _filePath + "' is not a region file of this version or chunk size (or both copies of its table are damaged), its chunks will be generated instead")
+
+        UnmapReservedSectors();
+        CloseFile();
+    }
+}
+
+RegionFile::~RegionFile()
+{
+    UnmapReservedSectors();
+    CloseFile();
+}
+
+bool RegionFile::HasChunk(const int p_localX, const int p_localZ) const
+{
+    if (!IsOpen())
+        return false;
+
+    std::lock_guard<std::mutex> lock(_tableMutex);
+
+    return _table[p_localX + p_localZ * CHUNKS_PER_SIDE].SectorCount != 0;
+}
+
+RegionFile::ReadResults RegionFile::ReadChunk(const int p_localX, const int p_localZ, std::vector<uint8_t>& p_outPayload)
+{
+    if (!IsOpen())
+        return ReadResults::Missing;
+
+    TableEntry tableEntry;
+
+    {
+        std::lock_guard<std::mutex> lock(_tableMutex);
+        tableEntry = _table[p_localX + p_localZ * CHUNKS_PER_SIDE];
+    }
+
+    if (tableEntry.SectorCount == 0)
+        return ReadResults::Missing;
+
+    p_outPayload.resize(tableEntry.PayloadByteSize);
+
+    if (!ReadAt(static_cast<uint64_t>(tableEntry.FirstSector) * SECTOR_BYTE_SIZE, p_outPayload.data(), p_outPayload.size()))
+        return ReadResults::Corrupted;
+
+    if (ChunkSerializer::ComputeChecksum(p_outPayload.data(), p_outPayload.size()) != tableEntry.Checksum)
+        return ReadResults::Corrupted;
+
+    return ReadResults::Loaded;
+}
+
+bool RegionFile::WriteChunk(const int p_localX, const int p_localZ, const uint8_t* p_payload, const size_t p_payloadByteSize)
+{
+    if (!IsOpen())
+        return false;
+
+    const uint32_t sectorCount = p_payloadByteSize == 0 ? 1 : static_cast<uint32_t>((p_payloadByteSize + SECTOR_BYTE_SIZE - 1) / SECTOR_BYTE_SIZE);
+
+    // NOTE : Never the sectors of the current payload, nor the ones of the committed save (a crash before the next commit goes back to it)
+    const uint32_t firstSector = FindFreeSectors(sectorCount);
+
+    if (!WriteAt(static_cast<uint64_t>(firstSector) * SECTOR_BYTE_SIZE, p_payload, p_payloadByteSize))
+    {
+        PRINT_ERROR_RUNTIME(true, "A chunk could not be written inside the region file '" + _filePath + "'")
+        return false;
+    }
+
+    TableEntry newTableEntry;
+    newTableEntry.FirstSector = firstSector;
+    newTableEntry.SectorCount = sectorCount;
+    newTableEntry.PayloadByteSize = static_cast<uint32_t>(p_payloadByteSize);
+    newTableEntry.Checksum = ChunkSerializer::ComputeChecksum(p_payload, p_payloadByteSize);
+
+    TableEntry oldTableEntry;
+
+    {
+        std::lock_guard<std::mutex> lock(_tableMutex);
+
+        TableEntry& tableEntry = _table[p_localX + p_localZ * CHUNKS_PER_SIDE];
+        oldTableEntry = tableEntry;
+        tableEntry = newTableEntry;
+    }
+
+    const TableEntry& committedTableEntry = _committedTable[p_localX + p_localZ * CHUNKS_PER_SIDE];
+
+    // Written since the last commit, nothing else points to it
+    if (oldTableEntry.SectorCount != 0 && std::memcmp(&oldTableEntry, &committedTableEntry, sizeof(TableEntry)) != 0)
+        SetSectorsUsed(oldTableEntry.FirstSector, oldTableEntry.SectorCount, false);
+
+    SetSectorsUsed(firstSector, sectorCount, true);
+
+    _hasUncommittedWrites = true;
+
+    return true;
+}
+
+bool RegionFile::PrepareCommit(const uint32_t p_saveNumber)
+{
+    if (!IsOpen())
+        return false;
+
+    // NOTE : The payloads first, the table must never point to sectors that are not on the disk yet
+    if (!FlushFile(false))
+        return false;
+
+    const int preparedTableCopy = (_committedTableCopy + 1) % TABLE_COPY_COUNT;
+
+    {
+        std::lock_guard<std::mutex> lock(_tableMutex);
+        std::memcpy(GetTableEntries(preparedTableCopy), _table.data(), TABLE_ENTRY_COUNT * sizeof(TableEntry));
+    }
+
+    GetTableHeader(preparedTableCopy)->SaveNumber = p_saveNumber;
+    GetTableHeader(preparedTableCopy)->Checksum = ComputeTableChecksum(preparedTableCopy);
+
+    return FlushFile(true);
+}
+
+void RegionFile::FinishCommit()
+{
+    if (!IsOpen())
+        return;
+
+    _committedTableCopy = (_committedTableCopy + 1) % TABLE_COPY_COUNT;
+
+    std::lock_guard<std::mutex> lock(_tableMutex);
+
+    for (int i = 0; i < TABLE_ENTRY_COUNT; ++i)
+    {
+        const TableEntry& committedTableEntry = _committedTable[i];
+
+        // Replaced during the save, only the previous save pointed to it
+        if (committedTableEntry.SectorCount != 0 && std::memcmp(&committedTableEntry, &_table[i], sizeof(TableEntry)) != 0)
+            SetSectorsUsed(committedTableEntry.FirstSector, committedTableEntry.SectorCount, false);
+    }
+
+    _committedTable = _table;
+    _hasUncommittedWrites = false;
+}
+
+int RegionFile::GetChunkCount() const
+{
+    if (!IsOpen())
+        return 0;
+
+    std::lock_guard<std::mutex> lock(_tableMutex);
+
+    int chunkCount = 0;
+
+    for (int i = 0; i < TABLE_ENTRY_COUNT; ++i)
+    {
+        if (_table[i].SectorCount != 0)
+            chunkCount++;
+    }
+
+    return chunkCount;
+}
+
+size_t RegionFile::GetUsedSectorCount() const
+{
+    size_t usedSectorCount = 0;
+
+    for (const unsigned char isUsed : _usedSectors)
+        usedSectorCount += isUsed;
+
+    return usedSectorCount;
+}
+
+Vector2Int RegionFile::GetRegionPosition(const Vector2Int& p_chunkPosition)
+{
+    return Vector2Int(FloorDivide(p_chunkPosition.X, CHUNKS_PER_SIDE), FloorDivide(p_chunkPosition.Y, CHUNKS_PER_SIDE));
+}
+
+Vector2Int RegionFile::GetLocalPosition(const Vector2Int& p_chunkPosition)
+{
+    const Vector2Int regionPosition = GetRegionPosition(p_chunkPosition);
+
+    return Vector2Int(p_chunkPosition.X - regionPosition.X * CHUNKS_PER_SIDE, p_chunkPosition.Y - regionPosition.Y * CHUNKS_PER_SIDE);
+}
+
+bool RegionFile::InitializeFile()
+{
+    // NOTE : An empty table is only zeros (no sectors), the second copy stays invalid (its checksum does not match)
+    std::vector<uint8_t> reservedSectors(RESERVED_SECTOR_COUNT * SECTOR_BYTE_SIZE, 0);
+
+    FileHeader header;
+    std::memcpy(header.Magic, REGION_FILE_MAGIC, sizeof(header.Magic));
+    header.Version = REGION_FILE_VERSION;
+    header.ChunkSizeX = _chunkSize.X;
+    header.ChunkSizeY = _chunkSize.Y;
+    header.ChunkSizeZ = _chunkSize.Z;
+
+    std::memcpy(reservedSectors.data(), &header, sizeof(header));
+
+    TableHeader tableHeader;
+    tableHeader.SaveNumber = 0;
+    tableHeader.Checksum = ChunkSerializer::ComputeChecksum(reservedSectors.data() + SECTOR_BYTE_SIZE + sizeof(uint32_t),
+        sizeof(uint32_t) + TABLE_ENTRY_COUNT * sizeof(TableEntry));
+
+    std::memcpy(reservedSectors.data() + SECTOR_BYTE_SIZE, &tableHeader, sizeof(tableHeader));
+
+    return WriteAt(0, reservedSectors.data(), reservedSectors.size());
+}
+
+bool RegionFile::ReadTable(const size_t p_fileByteSize, const uint32_t p_committedSaveNumber)
+{
+    FileHeader header;
+    std::memcpy(&header, _mappedSectors, sizeof(header));
+
+    if (std::memcmp(header.Magic, REGION_FILE_MAGIC, sizeof(header.Magic)) != 0 || header.Version != REGION_FILE_VERSION ||
+        header.ChunkSizeX != _chunkSize.X || header.ChunkSizeY != _chunkSize.Y || header.ChunkSizeZ != _chunkSize.Z)
+    {
+        return false;
+    }
+
+    // - Last committed copy - //
+
+    int committedTableCopy = -1;
+
+    for (int tableCopy = 0; tableCopy < TABLE_COPY_COUNT; ++tableCopy)
+    {
+        const TableHeader* tableHeader = GetTableHeader(tableCopy);
+
+        // A save that was not committed by the storage, or a copy cut in the middle of its write
+        if (tableHeader->SaveNumber > p_committedSaveNumber || tableHeader->Checksum != ComputeTableChecksum(tableCopy))
+            continue;
+
+        if (committedTableCopy < 0 || tableHeader->SaveNumber > GetTableHeader(committedTableCopy)->SaveNumber)
+            committedTableCopy = tableCopy;
+    }
+
+    if (committedTableCopy < 0)
+        return false;
+
+    _committedTableCopy = committedTableCopy;
+    _committedTable.assign(GetTableEntries(committedTableCopy), GetTableEntries(committedTableCopy) + TABLE_ENTRY_COUNT);
+
+    // - Entries - //
+
+    // NOTE : The last sector can be incomplete, a payload does not fill its last sector
+    const size_t fileSectorCount = (p_fileByteSize + SECTOR_BYTE_SIZE - 1) / SECTOR_BYTE_SIZE;
+
+    _usedSectors.assign(fileSectorCount, 0);
+    SetSectorsUsed(0, RESERVED_SECTOR_COUNT, true);
+
+    int removedEntryCount = 0;
+
+    for (int i = 0; i < TABLE_ENTRY_COUNT; ++i)
+    {
+        TableEntry& tableEntry = _committedTable[i];
+
+        if (tableEntry.SectorCount == 0)
+            continue;
+
+        bool isValid = tableEntry.FirstSector >= RESERVED_SECTOR_COUNT &&
+            static_cast<size_t>(tableEntry.FirstSector) + tableEntry.SectorCount <= fileSectorCount &&
+            tableEntry.PayloadByteSize <= tableEntry.SectorCount * SECTOR_BYTE_SIZE;
+
+        // Two chunks can't share a sector
+        for (uint32_t sector = tableEntry.FirstSector; isValid && sector < tableEntry.FirstSector + tableEntry.SectorCount; ++sector)
+            isValid = _usedSectors[sector] == 0;
+
+        if (!isValid)
+        {
+            // The chunk will be generated again, then written somewhere else
+            std::memset(&tableEntry, 0, sizeof(tableEntry));
+            removedEntryCount++;
+            continue;
+        }
+
+        SetSectorsUsed(tableEntry.FirstSector, tableEntry.SectorCount, true);
+    }
+
+    if (removedEntryCount > 0)
+    {
+        std::stringstream warningMessage;
+        warningMessage << removedEntryCount << " invalid chunk entries were removed from the region file '" << _filePath << "'";
+
+        PRINT_WARNING_RUNTIME(true, warningMessage.str())
+    }
+
+    _table = _committedTable;
+
+    return true;
+}
+
+uint32_t RegionFile::ComputeTableChecksum(const int p_tableCopy) const
+{
+    return ChunkSerializer::ComputeChecksum(reinterpret_cast<const uint8_t*>(&GetTableHeader(p_tableCopy)->SaveNumber),
+        sizeof(uint32_t) + TABLE_ENTRY_COUNT * sizeof(TableEntry));
+}
+
+uint32_t RegionFile::FindFreeSectors(const uint32_t p_sectorCount) const
+{
+    uint32_t runStart = RESERVED_SECTOR_COUNT;
+    uint32_t runLength = 0;
+
+    for (uint32_t sector = RESERVED_SECTOR_COUNT; sector < _usedSectors.size(); ++sector)
+    {
+        if (_usedSectors[sector])
+        {
+            runStart = sector + 1;
+            runLength = 0;
+            continue;
+        }
+
+        if (++runLength == p_sectorCount)
+            return runStart;
+    }
+
+    // NOTE : The free sectors at the end of the file are used too, the file grows by the missing ones
+    return runStart;
+}
+
+void RegionFile::SetSectorsUsed(const uint32_t p_firstSector, const uint32_t p_sectorCount, const bool p_isUsed)
+{
+    const size_t lastSector = static_cast<size_t>(p_firstSector) + p_sectorCount;
+
+    if (lastSector > _usedSectors.size())
+        _usedSectors.resize(lastSector, 0);
+
+    std::fill(_usedSectors.begin() + p_firstSector, _usedSectors.begin() + lastSector, static_cast<unsigned char>(p_isUsed ? 1 : 0));
+}
+
+#pragma region Platform
+
+bool RegionFile::OpenFile(size_t& p_outFileByteSize)
+{
+    #if defined(_WIN32)
+
+        HANDLE fileHandle = CreateFileA(_filePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileByteSize;
+
+        if (!GetFileSizeEx(fileHandle, &fileByteSize))
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        _fileHandle = fileHandle;
+        p_outFileByteSize = static_cast<size_t>(fileByteSize.QuadPart);
+
+        return true;
+
+    #else
+
+        _fileDescriptor = open(_filePath.c_str(), O_RDWR | O_CREAT, 0644);
+
+        if (_fileDescriptor < 0)
+            return false;
+
+        struct stat fileStatus;
+
+        if (fstat(_fileDescriptor, &fileStatus) != 0)
+        {
+            CloseFile();
+            return false;
+        }
+
+        p_outFileByteSize = static_cast<size_t>(fileStatus.st_size);
+
+        return true;
+
+    #endif
+}
+
+bool RegionFile::FlushFile(const bool p_isTableFlushed)
+{
+    #if defined(_WIN32)
+
+        if (p_isTableFlushed && !FlushViewOfFile(_mappedSectors, RESERVED_SECTOR_COUNT * SECTOR_BYTE_SIZE))
+            return false;
+
+        return FlushFileBuffers(_fileHandle) != 0;
+
+    #else
+
+        if (p_isTableFlushed && msync(_mappedSectors, RESERVED_SECTOR_COUNT * SECTOR_BYTE_SIZE, MS_SYNC) != 0)
+            return false;
+
+        return fsync(_fileDescriptor) == 0;
+
+    #endif
+}
+
+void RegionFile::CloseFile()
+{
+    #if defined(_WIN32)
+
+        if (_fileHandle != nullptr)
+            CloseHandle(_fileHandle);
+
+        _fileHandle = nullptr;
+
+    #else
+
+        if (_fileDescriptor >= 0)
+            close(_fileDescriptor);
+
+        _fileDescriptor = -1;
+
+    #endif
+}
+
+bool RegionFile::ReadAt(const uint64_t p_offset, void* p_outBytes, const size_t p_byteCount) const
+{
+    #if defined(_WIN32)
+
+        // NOTE : The offset is given through the OVERLAPPED structure, the file pointer is not used
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(p_offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(p_offset >> 32);
+
+        DWORD readByteCount = 0;
+
+        return ReadFile(_fileHandle, p_outBytes, static_cast<DWORD>(p_byteCount), &readByteCount, &overlapped) && readByteCount == p_byteCount;
+
+    #else
+
+        size_t readByteCount = 0;
+
+        // A read can stop before the end (a signal), the rest is read by the next one
+        while (readByteCount < p_byteCount)
+        {
+            const ssize_t result = pread(_fileDescriptor, static_cast<uint8_t*>(p_outBytes) + readByteCount, p_byteCount - readByteCount,
+                static_cast<off_t>(p_offset + readByteCount));
+
+            if (result <= 0)
+                return false;
+
+            readByteCount += static_cast<size_t>(result);
+        }
+
+        return true;
+
+    #endif
+}
+
+bool RegionFile::WriteAt(const uint64_t p_offset, const void* p_bytes, const size_t p_byteCount)
+{
+    #if defined(_WIN32)
+
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(p_offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(p_offset >> 32);
+
+        DWORD writtenByteCount = 0;
+
+        return WriteFile(_fileHandle, p_bytes, static_cast<DWORD>(p_byteCount), &writtenByteCount, &overlapped) && writtenByteCount == p_byteCount;
+
+    #else
+
+        size_t writtenByteCount = 0;
+
+        while (writtenByteCount < p_byteCount)
+        {
+            const ssize_t result = pwrite(_fileDescriptor, static_cast<const uint8_t*>(p_bytes) + writtenByteCount, p_byteCount - writtenByteCount,
+                static_cast<off_t>(p_offset + writtenByteCount));
+
+            if (result <= 0)
+                return false;
+
+            writtenByteCount += static_cast<size_t>(result);
+        }
+
+        return true;
+
+    #endif
+}
+
+bool RegionFile::MapReservedSectors()
+{
+    const size_t mappedByteSize = RESERVED_SECTOR_COUNT * SECTOR_BYTE_SIZE;
+
+    #if defined(_WIN32)
+
+        _fileMappingHandle = CreateFileMappingA(_fileHandle, nullptr, PAGE_READWRITE, 0, static_cast<DWORD>(mappedByteSize), nullptr);
+
+        if (_fileMappingHandle == nullptr)
+            return false;
+
+        _mappedSectors = static_cast<uint8_t*>(MapViewOfFile(_fileMappingHandle, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, mappedByteSize));
+
+        return _mappedSectors != nullptr;
+
+    #else
+
+        void* mappedSectors = mmap(nullptr, mappedByteSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+
+        if (mappedSectors == MAP_FAILED)
+            return false;
+
+        _mappedSectors = static_cast<uint8_t*>(mappedSectors);
+
+        return true;
+
+    #endif
+}
+
+void RegionFile::UnmapReservedSectors()
+{
+    #if defined(_WIN32)
+
+        if (_mappedSectors != nullptr)
+            UnmapViewOfFile(_mappedSectors);
+
+        if (_fileMappingHandle != nullptr)
+            CloseHandle(_fileMappingHandle);
+
+        _fileMappingHandle = nullptr;
+
+    #else
+
+        if (_mappedSectors != nullptr)
+            munmap(_mappedSectors, RESERVED_SECTOR_COUNT * SECTOR_BYTE_SIZE);
+
+    #endif
+
+    _mappedSectors = nullptr;
+}
+
+#pragma endregion
\ No newline at end of file
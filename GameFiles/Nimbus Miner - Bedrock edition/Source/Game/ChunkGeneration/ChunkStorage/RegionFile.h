@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Vector.h"
+
+/// <summary>
+/// One file storing the blocks of 32x32 chunks (a region), each one as a compressed payload (see ChunkSerializer).
+///
+/// <para> <b> Layout : </b> the file is split into sectors of 4 KB. The first sector is the header (a magic number, the version and
+/// the chunk size), then two copies of the table (where the payload of each chunk is, its size and its checksum), then the payloads. </para>
+/// <para> The tables are memory-mapped, they are only read when the file is opened and written by Commit(). </para>
+/// <para> <b> Saves : </b> a payload is always written inside free sectors, the table in memory points to it. Commit() writes that table
+/// over the older copy with the number of the save (see ChunkStorage), the other copy is the previous save. Each copy has a checksum :
+/// if the game stops in the middle of a save, the file is opened with the last complete copy whose save was committed, and the sectors
+/// of its payloads were never written over (they are only re-used once the next save is committed). </para>
+/// <para> The integers are stored in the machine's byte order (little endian on all our targets). </para>
+///
+/// <para> The payloads must only be read and written by one thread at a time (ChunkStorage's I/O thread),
+/// HasChunk() can be called from any thread. </para> </summary>
+class RegionFile
+{
+
+public:
+
+    /// <summary> The number of chunks along each side of a region. </summary>
+    static constexpr int CHUNKS_PER_SIDE = 32;
+
+    static constexpr size_t SECTOR_BYTE_SIZE = 4096;
+
+    enum class ReadResults
+    {
+        Loaded,
+
+        /// <summary> The chunk was never written. </summary>
+        Missing,
+
+        /// <summary> The payload could not be read, or its checksum does not match. </summary>
+        Corrupted
+    };
+
+private:
+
+    struct FileHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        int32_t ChunkSizeX;
+        int32_t ChunkSizeY;
+        int32_t ChunkSizeZ;
+    };
+
+    /// <summary> Where the payload of one chunk is, a SectorCount of 0 means the chunk was never written. </summary>
+    struct TableEntry
+    {
+        uint32_t FirstSector;
+        uint32_t SectorCount;
+        uint32_t PayloadByteSize;
+        uint32_t Checksum;
+    };
+
+    /// <summary> Before the entries of each copy of the table, the checksum covers the save number and the entries. </summary>
+    struct TableHeader
+    {
+        uint32_t Checksum;
+        uint32_t SaveNumber;
+    };
+
+    static constexpr int TABLE_ENTRY_COUNT = CHUNKS_PER_SIDE * CHUNKS_PER_SIDE;
+    static constexpr int TABLE_COPY_COUNT = 2;
+
+    static constexpr uint32_t TABLE_SECTOR_COUNT = static_cast<uint32_t>((sizeof(TableHeader) + TABLE_ENTRY_COUNT * sizeof(TableEntry) + SECTOR_BYTE_SIZE - 1) / SECTOR_BYTE_SIZE);
+
+    // The header, then the copies of the table
+    static constexpr uint32_t RESERVED_SECTOR_COUNT = 1 + TABLE_COPY_COUNT * TABLE_SECTOR_COUNT;
+
+    std::string _filePath;
+    Vector3Int _chunkSize;
+
+    #if defined(_WIN32)
+        // NOTE : HANDLE, kept as void* so Windows.h is not included everywhere
+        void* _fileHandle;
+        void* _fileMappingHandle;
+    #else
+        int _fileDescriptor;
+    #endif
+
+    /// <summary> The reserved sectors, mapped in memory (nullptr if the file could not be opened). </summary>
+    uint8_t* _mappedSectors;
+
+    /// <summary> The chunks written since the file was opened included, the one read by HasChunk() and ReadChunk(). </summary>
+    std::vector<TableEntry> _table;
+
+    /// <summary> Protects _table, written by the I/O thread and read by HasChunk(). </summary>
+    mutable std::mutex _tableMutex;
+
+    /// <summary> The table of the last committed save (the copy _committedTableCopy of the file, without its invalid entries). </summary>
+    std::vector<TableEntry> _committedTable;
+    int _committedTableCopy;
+
+    bool _hasUncommittedWrites;
+
+    /// <summary> One entry per sector of the file, 1 if a payload of _table or of _committedTable (or the header and the tables) uses it. </summary>
+    std::vector<unsigned char> _usedSectors;
+
+public:
+
+    /// <summary> Opens the region file, or creates it. If it can't be used (not a region file, another chunk size, no rights...),
+    /// an error is printed and IsOpen() returns false : the file is never overwritten. </summary>
+    /// <param name = "p_committedSaveNumber"> The last save committed by the storage, the copies of the table written by a later save are ignored </param>
+    RegionFile(const std::string& p_filePath, const Vector3Int& p_chunkSize, const uint32_t p_committedSaveNumber);
+
+    /// <summary> The chunks written since the last Commit() are lost. </summary>
+    ~RegionFile();
+
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    bool IsOpen() const { return _mappedSectors != nullptr; }
+
+    /// <summary> Only looks at the memory-mapped table. The position is relative to the region (0 to CHUNKS_PER_SIDE - 1). </summary>
+    bool HasChunk(const int p_localX, const int p_localZ) const;
+
+    /// <summary> Reads the payload of the chunk and checks its checksum. </summary>
+    ReadResults ReadChunk(const int p_localX, const int p_localZ, std::vector<uint8_t>& p_outPayload);
+
+    /// <summary> Writes the payload inside free sectors (or at the end of the file), then points the table to it. Returns false on a write error. </summary>
+    bool WriteChunk(const int p_localX, const int p_localZ, const uint8_t* p_payload, const size_t p_payloadByteSize);
+
+    bool HasUncommittedWrites() const { return _hasUncommittedWrites; }
+
+    /// <summary>
+    /// First step of a commit : flushes the payloads, then writes the table over the older copy with the save number, and flushes it.
+    /// <para> The save is only used by the next launches once the storage commits it (see ChunkStorage), FinishCommit() must be called then. </para> </summary>
+    bool PrepareCommit(const uint32_t p_saveNumber);
+
+    /// <summary> The prepared copy becomes the committed one, the sectors only used by the previous save are free again. </summary>
+    void FinishCommit();
+
+    int GetChunkCount() const;
+    size_t GetSectorCount() const { return _usedSectors.size(); }
+    size_t GetUsedSectorCount() const;
+
+    /// <summary> The region containing the chunk (the chunk position is in chunks, see ChunkManager). </summary>
+    static Vector2Int GetRegionPosition(const Vector2Int& p_chunkPosition);
+
+    /// <summary> The position of the chunk inside its region (0 to CHUNKS_PER_SIDE - 1 on each axis). </summary>
+    static Vector2Int GetLocalPosition(const Vector2Int& p_chunkPosition);
+
+private:
+
+    /// <summary> Writes the header and an empty table (of the save 0) into the new (empty) file. </summary>
+    bool InitializeFile();
+
+    /// <summary> Checks the header, picks the last copy of the table committed before p_committedSaveNumber
+    /// and marks the sectors used by its entries, the invalid entries are removed. </summary>
+    bool ReadTable(const size_t p_fileByteSize, const uint32_t p_committedSaveNumber);
+
+    TableHeader* GetTableHeader(const int p_tableCopy) const { return reinterpret_cast<TableHeader*>(_mappedSectors + (1 + p_tableCopy * TABLE_SECTOR_COUNT) * SECTOR_BYTE_SIZE); }
+    TableEntry* GetTableEntries(const int p_tableCopy) const { return reinterpret_cast<TableEntry*>(GetTableHeader(p_tableCopy) + 1); }
+
+    /// <summary> The checksum of the save number and the entries of the copy. </summary>
+    uint32_t ComputeTableChecksum(const int p_tableCopy) const;
+
+    /// <summary> Returns the first sector of p_sectorCount free sectors in a row (after the last used one if there are none). </summary>
+    uint32_t FindFreeSectors(const uint32_t p_sectorCount) const;
+
+    void SetSectorsUsed(const uint32_t p_firstSector, const uint32_t p_sectorCount, const bool p_isUsed);
+
+    // - Platform - //
+
+    /// <summary> Opens (or creates) the file, gives its size. </summary>
+    bool OpenFile(size_t& p_outFileByteSize);
+    void CloseFile();
+
+    /// <summary> Asks the system to write the payloads (and the mapped tables if p_isTableFlushed) to the disk now, they are in its cache until then. </summary>
+    bool FlushFile(const bool p_isTableFlushed);
+
+    bool ReadAt(const uint64_t p_offset, void* p_outBytes, const size_t p_byteCount) const;
+    bool WriteAt(const uint64_t p_offset, const void* p_bytes, const size_t p_byteCount);
+
+    /// <summary> Maps the reserved sectors (the header and the table) in memory. </summary>
+    bool MapReservedSectors();
+    void UnmapReservedSectors();
+};
\ No newline at end of file
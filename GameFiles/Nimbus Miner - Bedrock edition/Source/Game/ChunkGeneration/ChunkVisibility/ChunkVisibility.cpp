@@ -0,0 +1,215 @@
+#include "ChunkVisibility.h"
+
+#include <algorithm>
+
+#include "../ChunkVoxelData/ChunkVoxelData.h"
+#include "../GreedyMesher/MeshingContext.h"
+
+#include "ProjectConstants.h"
+
+int ChunkVisibility::GetSectionCount(const Vector3Int& p_chunkSize)
+{
+    return (p_chunkSize.Y + CHUNK_VISIBILITY_SECTION_HEIGHT - 1) / CHUNK_VISIBILITY_SECTION_HEIGHT;
+}
+
+void ChunkVisibility::ComputeFaceConnectivities(const ChunkVoxelData& p_voxelData, MeshingContext& p_context, std::vector<ChunkFaceConnectivity>& p_outSectionConnectivities)
+{
+    const int sectionCount = GetSectionCount(p_voxelData.Size);
+
+    // NOTE : assign() re-uses the memory when the chunk is re-meshed
+    p_outSectionConnectivities.assign(sectionCount, ChunkFaceConnectivity());
+
+    const std::vector<AirRun>& airRuns = p_context.GetAirRuns();
+
+    for (int section = 0; section < sectionCount; ++section)
+    {
+        const int firstY = section * CHUNK_VISIBILITY_SECTION_HEIGHT;
+        const int endY = std::min(firstY + CHUNK_VISIBILITY_SECTION_HEIGHT, p_voxelData.Size.Y);
+
+        BuildSectionRegions(p_voxelData, firstY, endY, p_context);
+
+        // All the faces touched by a region can see each other through it
+        for (size_t i = 0; i < airRuns.size(); ++i)
+        {
+            if (airRuns[i].Parent == static_cast<int>(i))
+                p_outSectionConnectivities[section].ConnectFaces(airRuns[i].Faces);
+        }
+    }
+}
+
+unsigned char ChunkVisibility::GetFacesReachableFrom(const ChunkVoxelData& p_voxelData, const Vector3Int& p_blockPosition, MeshingContext& p_context)
+{
+    if (p_voxelData.IsBlockOutsideChunk(p_blockPosition) || p_voxelData.IsSolid(p_blockPosition))
+        return ChunkFaceConnectivity::ALL_FACES;
+
+    const int firstY = (p_blockPosition.Y / CHUNK_VISIBILITY_SECTION_HEIGHT) * CHUNK_VISIBILITY_SECTION_HEIGHT;
+    const int endY = std::min(firstY + CHUNK_VISIBILITY_SECTION_HEIGHT, p_voxelData.Size.Y);
+
+    BuildSectionRegions(p_voxelData, firstY, endY, p_context);
+
+    std::vector<AirRun>& airRuns = p_context.GetAirRuns();
+    const std::vector<unsigned int>& columnFirstAirRuns = p_context.GetColumnFirstAirRuns();
+
+    const size_t columnIndex = static_cast<size_t>(p_blockPosition.X) + static_cast<size_t>(p_voxelData.Size.X) * p_blockPosition.Z;
+
+    for (unsigned int i = columnFirstAirRuns[columnIndex]; i < columnFirstAirRuns[columnIndex + 1]; ++i)
+    {
+        if (p_blockPosition.Y >= airRuns[i].FirstY && p_blockPosition.Y < airRuns[i].EndY)
+            return airRuns[FindRegionRoot(airRuns, static_cast<int>(i))].Faces;
+    }
+
+    // NOTE : Never reached, a non-solid block is always inside a run
+    return ChunkFaceConnectivity::ALL_FACES;
+}
+
+void ChunkVisibility::BuildSectionRegions(const ChunkVoxelData& p_voxelData, const int p_firstY, const int p_endY, MeshingContext& p_context)
+{
+    const Vector3Int size = p_voxelData.Size;
+
+    std::vector<AirRun>& airRuns = p_context.GetAirRuns();
+    std::vector<unsigned int>& columnFirstAirRuns = p_context.GetColumnFirstAirRuns();
+
+    airRuns.clear();
+    columnFirstAirRuns.resize(static_cast<size_t>(size.X) * size.Z + 1);
+
+    // - Creating the runs, same columns order as the blocks (x by x, then z by z) - //
+
+    for (int z = 0; z < size.Z; ++z)
+    {
+        for (int x = 0; x < size.X; ++x)
+        {
+            unsigned char columnFaces = 0;
+
+            if (x == 0)          columnFaces |= 1 << NegativeX;
+            if (x == size.X - 1) columnFaces |= 1 << PositiveX;
+            if (z == 0)          columnFaces |= 1 << NegativeZ;
+            if (z == size.Z - 1) columnFaces |= 1 << PositiveZ;
+
+            columnFirstAirRuns[x + static_cast<size_t>(size.X) * z] = static_cast<unsigned int>(airRuns.size());
+
+            AddColumnAirRuns(p_voxelData, x, z, p_firstY, p_endY, columnFaces, airRuns);
+        }
+    }
+
+    columnFirstAirRuns.back() = static_cast<unsigned int>(airRuns.size());
+
+    // - Merging the runs touching the previous columns - //
+
+    for (int z = 0; z < size.Z; ++z)
+    {
+        for (int x = 0; x < size.X; ++x)
+        {
+            const size_t columnIndex = x + static_cast<size_t>(size.X) * z;
+
+            if (x > 0)
+            {
+                MergeColumnsAirRuns(airRuns, columnFirstAirRuns[columnIndex - 1], columnFirstAirRuns[columnIndex],
+                    columnFirstAirRuns[columnIndex], columnFirstAirRuns[columnIndex + 1]);
+            }
+
+            if (z > 0)
+            {
+                MergeColumnsAirRuns(airRuns, columnFirstAirRuns[columnIndex - size.X], columnFirstAirRuns[columnIndex - size.X + 1],
+                    columnFirstAirRuns[columnIndex], columnFirstAirRuns[columnIndex + 1]);
+            }
+        }
+    }
+}
+
+void ChunkVisibility::AddColumnAirRuns(const ChunkVoxelData& p_voxelData, const int p_x, const int p_z, const int p_firstY, const int p_endY,
+    const unsigned char p_columnFaces, std::vector<AirRun>& p_outAirRuns)
+{
+    int runFirstY = -1;
+
+    const auto addAirRun = [&](const int p_runEndY)
+    {
+        unsigned char faces = p_columnFaces;
+
+        if (runFirstY == p_firstY) faces |= 1 << NegativeY;
+        if (p_runEndY == p_endY)   faces |= 1 << PositiveY;
+
+        p_outAirRuns.push_back(AirRun{ runFirstY, p_runEndY, static_cast<int>(p_outAirRuns.size()), faces });
+        runFirstY = -1;
+    };
+
+    for (int y = p_firstY; y < p_endY;)
+    {
+        const int bitCount = std::min(ChunkVoxelData::OCCUPANCY_WORD_BIT_COUNT, p_endY - y);
+        const uint64_t usedBits = bitCount == ChunkVoxelData::OCCUPANCY_WORD_BIT_COUNT ? ~0ull : (1ull << bitCount) - 1;
+
+        const uint64_t occupancy = p_voxelData.GetColumnOccupancy(p_x, p_z, y) & usedBits;
+
+        // The common cases (under the ground and in the sky) don't need to look at each block
+        if (occupancy == 0)
+        {
+            if (runFirstY < 0)
+                runFirstY = y;
+
+            y += bitCount;
+            continue;
+        }
+
+        if (occupancy == usedBits)
+        {
+            if (runFirstY >= 0)
+                addAirRun(y);
+
+            y += bitCount;
+            continue;
+        }
+
+        for (int bit = 0; bit < bitCount; ++bit, ++y)
+        {
+            const bool isSolid = (occupancy >> bit) & 1;
+
+            if (!isSolid && runFirstY < 0)
+                runFirstY = y;
+            else if (isSolid && runFirstY >= 0)
+                addAirRun(y);
+        }
+    }
+
+    if (runFirstY >= 0)
+        addAirRun(p_endY);
+}
+
+void ChunkVisibility::MergeColumnsAirRuns(std::vector<AirRun>& p_airRuns, unsigned int p_firstRun1, const unsigned int p_endRun1,
+    unsigned int p_firstRun2, const unsigned int p_endRun2)
+{
+    while (p_firstRun1 < p_endRun1 && p_firstRun2 < p_endRun2)
+    {
+        const AirRun& airRun1 = p_airRuns[p_firstRun1];
+        const AirRun& airRun2 = p_airRuns[p_firstRun2];
+
+        // The two runs share at least one block height, the air goes from one column to the other
+        if (airRun1.FirstY < airRun2.EndY && airRun2.FirstY < airRun1.EndY)
+        {
+            const int root1 = FindRegionRoot(p_airRuns, static_cast<int>(p_firstRun1));
+            const int root2 = FindRegionRoot(p_airRuns, static_cast<int>(p_firstRun2));
+
+            if (root1 != root2)
+            {
+                p_airRuns[root2].Parent = root1;
+                p_airRuns[root1].Faces |= p_airRuns[root2].Faces;
+            }
+        }
+
+        // The run ending first can't touch the next runs of the other column
+        if (p_airRuns[p_firstRun1].EndY < p_airRuns[p_firstRun2].EndY)
+            p_firstRun1++;
+        else
+            p_firstRun2++;
+    }
+}
+
+int ChunkVisibility::FindRegionRoot(std::vector<AirRun>& p_airRuns, int p_airRunIndex)
+{
+    while (p_airRuns[p_airRunIndex].Parent != p_airRunIndex)
+    {
+        // Path halving : each visited run now points to its grandparent, the next searches are shorter
+        p_airRuns[p_airRunIndex].Parent = p_airRuns[p_airRuns[p_airRunIndex].Parent].Parent;
+        p_airRunIndex = p_airRuns[p_airRunIndex].Parent;
+    }
+
+    return p_airRunIndex;
+}
\ No newline at end of file
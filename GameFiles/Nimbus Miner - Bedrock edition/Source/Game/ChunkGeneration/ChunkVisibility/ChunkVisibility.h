@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include "Vector.h"
+
+#include "../ChunkMeshData.h"
+
+class ChunkVoxelData;
+class MeshingContext;
+
+/// <summary>
+/// Finds which faces of a chunk are connected through the non-solid blocks (cave culling) : the ChunkManager walks from the camera's chunk
+/// to the next ones only through connected faces, the chunks it never reaches can't be seen.
+///
+/// <para> A chunk is split vertically into sections of CHUNK_VISIBILITY_SECTION_HEIGHT blocks, each one has its own ChunkFaceConnectivity
+/// (a whole chunk column almost always has the sky touching its four sides, it would connect everything). </para>
+/// <para> The flood fill works on the air runs of the columns (the consecutive non-solid blocks of a column) instead of the blocks :
+/// the runs touching each other are merged (union-find), so a section only costs a few runs per column. </para>
+/// <para> Like the GreedyMesher, it only reads the ChunkVoxelData and uses the MeshingContext memory, so it can run on any thread. </para> </summary>
+class ChunkVisibility
+{
+
+public:
+
+    /// <summary> The consecutive non-solid blocks [FirstY, EndY[ of a column, inside one section. </summary>
+    struct AirRun
+    {
+        int FirstY;
+        int EndY;
+
+        /// <summary> The index of the parent run inside the same region (itself for the region's root). </summary>
+        int Parent;
+
+        /// <summary> The faces of the section touched by the run (one bit per FaceDirections), the root has the ones of the whole region. </summary>
+        unsigned char Faces;
+    };
+
+    static int GetSectionCount(const Vector3Int& p_chunkSize);
+
+    /// <summary> Fills one ChunkFaceConnectivity per section of the chunk (from the bottom to the top). </summary>
+    static void ComputeFaceConnectivities(const ChunkVoxelData& p_voxelData, MeshingContext& p_context, std::vector<ChunkFaceConnectivity>& p_outSectionConnectivities);
+
+    /// <summary> Returns the faces of the block's section that can be reached from the given block (one bit per FaceDirections).
+    /// <para> All the faces are returned if the block is solid (e.g. the camera inside the ground), it's the safe answer. </para> </summary>
+    static unsigned char GetFacesReachableFrom(const ChunkVoxelData& p_voxelData, const Vector3Int& p_blockPosition, MeshingContext& p_context);
+
+private:
+
+    /// <summary> Creates the air runs of the section [p_firstY, p_endY[ inside the context, then merges the ones touching each other. </summary>
+    static void BuildSectionRegions(const ChunkVoxelData& p_voxelData, int p_firstY, int p_endY, MeshingContext& p_context);
+
+    static void AddColumnAirRuns(const ChunkVoxelData& p_voxelData, int p_x, int p_z, int p_firstY, int p_endY, unsigned char p_columnFaces,
+        std::vector<AirRun>& p_outAirRuns);
+
+    /// <summary> Merges the overlapping runs of two neighbor columns (both lists are sorted by height). </summary>
+    static void MergeColumnsAirRuns(std::vector<AirRun>& p_airRuns, unsigned int p_firstRun1, unsigned int p_endRun1, unsigned int p_firstRun2, unsigned int p_endRun2);
+
+    /// <summary> Returns the root run of the region (and shortens the path to it). </summary>
+    static int FindRegionRoot(std::vector<AirRun>& p_airRuns, int p_airRunIndex);
+};
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "ChunkBorderPlanes.h"
+
+#include <algorithm>
+
+#include "ChunkVoxelData.h"
+
+// Same words as the chunks occupancy, so the columns can be copied word by word
+static constexpr int WORD_BIT_COUNT = ChunkVoxelData::OCCUPANCY_WORD_BIT_COUNT;
+
+ChunkBorderPlanes::ChunkBorderPlanes(const Vector3Int& p_chunkSize)
+{
+    _size = p_chunkSize;
+
+    const size_t xSideBitCount = static_cast<size_t>(_size.Y) * _size.Z;
+    const size_t zSideBitCount = static_cast<size_t>(_size.Y) * _size.X;
+
+    _sideFirstBits[NegativeX] = 0;
+    _sideFirstBits[PositiveX] = xSideBitCount;
+    _sideFirstBits[NegativeZ] = xSideBitCount * 2;
+    _sideFirstBits[PositiveZ] = xSideBitCount * 2 + zSideBitCount;
+
+    for (bool& hasSide : _hasSide)
+        hasSide = false;
+
+    // NOTE : One allocation for the four planes
+    _occupancy.assign((xSideBitCount * 2 + zSideBitCount * 2 + WORD_BIT_COUNT - 1) / WORD_BIT_COUNT, 0);
+}
+
+void ChunkBorderPlanes::CaptureSide(const Sides p_side, const ChunkVoxelData& p_neighborVoxelData)
+{
+    if (!p_neighborVoxelData.IsGenerated() || p_neighborVoxelData.Size.X != _size.X || p_neighborVoxelData.Size.Y != _size.Y || p_neighborVoxelData.Size.Z != _size.Z)
+        return;
+
+    const bool isXSide = p_side == NegativeX || p_side == PositiveX;
+    const int planeWidth = isXSide ? _size.Z : _size.X;
+
+    // The neighbor's blocks touching the chunk are on the opposite side of the neighbor
+    const int neighborFixedCoordinate = p_side == NegativeX ? _size.X - 1 :
+                                        p_side == NegativeZ ? _size.Z - 1 : 0;
+
+    for (int i = 0; i < planeWidth; ++i)
+    {
+        const int x = isXSide ? neighborFixedCoordinate : i;
+        const int z = isXSide ? i : neighborFixedCoordinate;
+
+        // The columns are contiguous in the occupancy, so they are copied one word (64 blocks) at a time
+        for (int y = 0; y < _size.Y; y += WORD_BIT_COUNT)
+        {
+            const uint64_t columnOccupancy = p_neighborVoxelData.GetColumnOccupancy(x, z, y);
+            const int bitCount = std::min(WORD_BIT_COUNT, _size.Y - y);
+
+            const size_t firstBit = _sideFirstBits[p_side] + y + static_cast<size_t>(_size.Y) * i;
+            const size_t wordIndex = firstBit / WORD_BIT_COUNT;
+            const unsigned int bitOffset = firstBit % WORD_BIT_COUNT;
+
+            _occupancy[wordIndex] |= columnOccupancy << bitOffset;
+
+            // The bits can be split between two words
+            if (bitOffset != 0 && bitOffset + bitCount > WORD_BIT_COUNT)
+                _occupancy[wordIndex + 1] |= columnOccupancy >> (WORD_BIT_COUNT - bitOffset);
+        }
+    }
+
+    _hasSide[p_side] = true;
+}
+
+bool ChunkBorderPlanes::IsSolid(const Vector3Int& p_blockPosition) const
+{
+    if (p_blockPosition.Y < 0 || p_blockPosition.Y >= _size.Y)
+        return false;
+
+    Sides side;
+    int i;
+
+    if (p_blockPosition.X == -1 && p_blockPosition.Z >= 0 && p_blockPosition.Z < _size.Z)
+    {
+        side = NegativeX;
+        i = p_blockPosition.Z;
+    }
+    else if (p_blockPosition.X == _size.X && p_blockPosition.Z >= 0 && p_blockPosition.Z < _size.Z)
+    {
+        side = PositiveX;
+        i = p_blockPosition.Z;
+    }
+    else if (p_blockPosition.Z == -1 && p_blockPosition.X >= 0 && p_blockPosition.X < _size.X)
+    {
+        side = NegativeZ;
+        i = p_blockPosition.X;
+    }
+    else if (p_blockPosition.Z == _size.Z && p_blockPosition.X >= 0 && p_blockPosition.X < _size.X)
+    {
+        side = PositiveZ;
+        i = p_blockPosition.X;
+    }
+    else
+        return false;
+
+    if (!_hasSide[side])
+        return false;
+
+    const size_t bit = _sideFirstBits[side] + p_blockPosition.Y + static_cast<size_t>(_size.Y) * i;
+
+    return (_occupancy[bit / WORD_BIT_COUNT] >> (bit % WORD_BIT_COUNT)) & 1;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Vector.h"
+
+class ChunkVoxelData;
+
+/// <summary>
+/// The occupancy of the blocks touching a chunk inside its four horizontal neighbors (one plane of blocks per side).
+///
+/// <para> Taken with the chunk's snapshot when a mesh job is created : the mesher reads it to not create the faces hidden
+/// by a neighbor, without reading the neighbor itself (it can be edited or destroyed during the job). </para>
+/// <para> A side without neighbor is considered as Air, like before the border planes existed. </para> </summary>
+class ChunkBorderPlanes
+{
+
+public:
+
+    enum Sides
+    {
+        NegativeX = 0,
+        PositiveX,
+        NegativeZ,
+        PositiveZ,
+
+        SideCount
+    };
+
+private:
+
+    /// <summary> The size of the chunk that owns the planes (not the neighbors' one). </summary>
+    Vector3Int _size;
+
+    bool _hasSide[SideCount];
+
+    /// <summary> The first occupancy bit of each side inside _occupancy. </summary>
+    size_t _sideFirstBits[SideCount];
+
+    /// <summary> All the planes, one bit per block : the bit of the block (y, i) is 'y + Size.Y * i', i is z for the X sides and x for the Z sides. </summary>
+    std::vector<uint64_t> _occupancy;
+
+public:
+
+    explicit ChunkBorderPlanes(const Vector3Int& p_chunkSize);
+
+    /// <summary> Copies the plane of the given neighbor touching the chunk, the neighbor must have the same size as the chunk. </summary>
+    void CaptureSide(const Sides p_side, const ChunkVoxelData& p_neighborVoxelData);
+
+    bool HasSide(const Sides p_side) const { return _hasSide[p_side]; }
+
+    /// <summary> The bits of the four planes (0 for the sides that were not captured), hashed by ChunkMeshCache::ComputeKey(). </summary>
+    const std::vector<uint64_t>& GetOccupancy() const { return _occupancy; }
+
+    /// <summary>
+    /// Returns true if the block at the given position (in the chunk's space, so just outside of it) is solid.
+    /// <para> Returns false for the positions that are not right next to one of the four sides, or if the side was not captured. </para> </summary>
+    bool IsSolid(const Vector3Int& p_blockPosition) const;
+};
\ No newline at end of file
@@ -0,0 +1,357 @@
+#include "ChunkVoxelData.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "../../../Engine/Memory/ChunkMemoryPool.h"
+
+// Defining static variables
+std::atomic<unsigned long long> ChunkVoxelData::_forkCount(0);
+
+ChunkVoxelData::ChunkVoxelData(const Vector3& p_worldPosition, const Vector3Int& p_size)
+{
+    // Initialising class' variables
+    _storage = nullptr;
+    _blocks = nullptr;
+    _occupancy = nullptr;
+    _blockCount = 0;
+    _occupancyWordCount = 0;
+
+    // Setting class' public variables
+    WorldPosition = p_worldPosition;
+    Size = p_size;
+}
+
+ChunkVoxelData::~ChunkVoxelData()
+{
+    Release();
+}
+
+ChunkVoxelData::ChunkVoxelData(const ChunkVoxelData& p_other)
+{
+    WorldPosition = p_other.WorldPosition;
+    Size = p_other.Size;
+
+    _storage = p_other._storage;
+    _blocks = p_other._blocks;
+    _occupancy = p_other._occupancy;
+    _blockCount = p_other._blockCount;
+    _occupancyWordCount = p_other._occupancyWordCount;
+
+    // NOTE : Relaxed is enough to add a reference, the slab can't be freed while 'p_other' holds one
+    if (_storage != nullptr)
+        _storage->ReferenceCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+ChunkVoxelData& ChunkVoxelData::operator=(const ChunkVoxelData& p_other)
+{
+    if (this == &p_other)
+        return *this;
+
+    // Taking the reference before releasing ours, in case both already share the same slab
+    if (p_other._storage != nullptr)
+        p_other._storage->ReferenceCount.fetch_add(1, std::memory_order_relaxed);
+
+    Release();
+
+    WorldPosition = p_other.WorldPosition;
+    Size = p_other.Size;
+
+    _storage = p_other._storage;
+    _blocks = p_other._blocks;
+    _occupancy = p_other._occupancy;
+    _blockCount = p_other._blockCount;
+    _occupancyWordCount = p_other._occupancyWordCount;
+
+    return *this;
+}
+
+ChunkVoxelData::ChunkVoxelData(ChunkVoxelData&& p_other) noexcept
+{
+    WorldPosition = p_other.WorldPosition;
+    Size = p_other.Size;
+
+    _storage = p_other._storage;
+    _blocks = p_other._blocks;
+    _occupancy = p_other._occupancy;
+    _blockCount = p_other._blockCount;
+    _occupancyWordCount = p_other._occupancyWordCount;
+
+    p_other._storage = nullptr;
+    p_other._blocks = nullptr;
+    p_other._occupancy = nullptr;
+    p_other._blockCount = 0;
+    p_other._occupancyWordCount = 0;
+}
+
+ChunkVoxelData& ChunkVoxelData::operator=(ChunkVoxelData&& p_other) noexcept
+{
+    if (this == &p_other)
+        return *this;
+
+    Release();
+
+    WorldPosition = p_other.WorldPosition;
+    Size = p_other.Size;
+
+    _storage = p_other._storage;
+    _blocks = p_other._blocks;
+    _occupancy = p_other._occupancy;
+    _blockCount = p_other._blockCount;
+    _occupancyWordCount = p_other._occupancyWordCount;
+
+    p_other._storage = nullptr;
+    p_other._blocks = nullptr;
+    p_other._occupancy = nullptr;
+    p_other._blockCount = 0;
+    p_other._occupancyWordCount = 0;
+
+    return *this;
+}
+
+void ChunkVoxelData::Allocate()
+{
+    const size_t blockCount = static_cast<size_t>(Size.X) * Size.Y * Size.Z;
+
+    // The size changed since the last allocation, or a snapshot still reads the blocks : the slab can't be re-used
+    // NOTE : No need to fork a shared slab here, all the blocks will be generated again
+    if (IsGenerated() && (blockCount != _blockCount || IsShared()))
+        Release();
+
+    if (!IsGenerated())
+    {
+        _blockCount = blockCount;
+
+        // Rounded up, so the last word can be partially used
+        _occupancyWordCount = (blockCount + OCCUPANCY_WORD_BIT_COUNT - 1) / OCCUPANCY_WORD_BIT_COUNT;
+
+        AllocateStorage();
+    }
+
+    std::memset(_occupancy, 0, _occupancyWordCount * sizeof(uint64_t));
+}
+
+void ChunkVoxelData::Release()
+{
+    if (!IsGenerated())
+        return;
+
+    // The last reference frees the slab (it can be a snapshot on a worker thread)
+    if (_storage->ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        _storage->~StorageHeader();
+        ChunkMemoryPool::FreeSlab(_storage, GetPayloadByteSize());
+    }
+
+    _storage = nullptr;
+    _blocks = nullptr;
+    _occupancy = nullptr;
+    _blockCount = 0;
+    _occupancyWordCount = 0;
+}
+
+void ChunkVoxelData::Downsample(const ChunkVoxelData& p_source, const int p_factor)
+{
+    if (!p_source.IsGenerated() || p_factor < 1)
+    {
+        Release();
+        return;
+    }
+
+    WorldPosition = Vector3(p_source.WorldPosition.X / p_factor, p_source.WorldPosition.Y / p_factor, p_source.WorldPosition.Z / p_factor);
+    Size = Vector3Int(p_source.Size.X / p_factor, p_source.Size.Y / p_factor, p_source.Size.Z / p_factor);
+
+    Allocate();
+
+    const BlockTypes* sourceBlocks = p_source.GetBlocks();
+
+    // NOTE : A cell rarely has more than 2 or 3 types, a short list is faster than counting all the types
+    static constexpr int MAXIMUM_CELL_TYPE_COUNT = 64;
+
+    BlockTypes cellTypes[MAXIMUM_CELL_TYPE_COUNT];
+    int cellTypeCounts[MAXIMUM_CELL_TYPE_COUNT];
+    int cellTypeHighestY[MAXIMUM_CELL_TYPE_COUNT];
+
+    for (int z = 0; z < Size.Z; ++z)
+    {
+        for (int x = 0; x < Size.X; ++x)
+        {
+            BlockTypes* column = GetColumn(x, z);
+
+            for (int y = 0; y < Size.Y; ++y)
+            {
+                int cellTypeCount = 0;
+
+                for (int sourceZ = z * p_factor; sourceZ < (z + 1) * p_factor; ++sourceZ)
+                {
+                    for (int sourceX = x * p_factor; sourceX < (x + 1) * p_factor; ++sourceX)
+                    {
+                        // The blocks of a source column are contiguous, only the y changes in the loop below
+                        const BlockTypes* sourceColumn = sourceBlocks + static_cast<size_t>(p_source.Size.Y) * (sourceX + p_source.Size.X * sourceZ);
+
+                        for (int sourceY = y * p_factor; sourceY < (y + 1) * p_factor; ++sourceY)
+                        {
+                            const BlockTypes blockType = sourceColumn[sourceY];
+
+                            if (!IsSolidBlockType(blockType))
+                                continue;
+
+                            int typeIndex = 0;
+
+                            while (typeIndex < cellTypeCount && cellTypes[typeIndex] != blockType)
+                                typeIndex++;
+
+                            if (typeIndex == cellTypeCount)
+                            {
+                                if (cellTypeCount == MAXIMUM_CELL_TYPE_COUNT)
+                                    continue;
+
+                                cellTypes[typeIndex] = blockType;
+                                cellTypeCounts[typeIndex] = 0;
+                                cellTypeHighestY[typeIndex] = sourceY;
+                                cellTypeCount++;
+                            }
+
+                            cellTypeCounts[typeIndex]++;
+                            cellTypeHighestY[typeIndex] = std::max(cellTypeHighestY[typeIndex], sourceY);
+                        }
+                    }
+                }
+
+                // Any solid block makes the cell solid, so the downsampled terrain is never lower than the real one
+                if (cellTypeCount == 0)
+                {
+                    column[y] = BlockTypes::Air;
+                    continue;
+                }
+
+                int chosenTypeIndex = 0;
+
+                for (int typeIndex = 1; typeIndex < cellTypeCount; ++typeIndex)
+                {
+                    if (cellTypeCounts[typeIndex] > cellTypeCounts[chosenTypeIndex] ||
+                        (cellTypeCounts[typeIndex] == cellTypeCounts[chosenTypeIndex] && cellTypeHighestY[typeIndex] > cellTypeHighestY[chosenTypeIndex]))
+                        chosenTypeIndex = typeIndex;
+                }
+
+                column[y] = cellTypes[chosenTypeIndex];
+                SetColumnOccupancy(x, z, y, 1, true);
+            }
+        }
+    }
+}
+
+BlockTypes ChunkVoxelData::GetBlock(const Vector3Int& p_blockPosition) const
+{
+    if (IsBlockOutsideChunk(p_blockPosition))
+        return BlockTypes::Air;
+
+    // Return the type of block at the wanted position
+    return _blocks[GetBlockIndex(p_blockPosition)];
+}
+
+void ChunkVoxelData::SetBlock(const Vector3Int& p_blockPosition, const BlockTypes p_newBlockType)
+{
+    MakeUnique();
+
+    const unsigned int blockIndex = GetBlockIndex(p_blockPosition);
+
+    _blocks[blockIndex] = p_newBlockType;
+
+    const uint64_t blockBit = 1ull << (blockIndex % OCCUPANCY_WORD_BIT_COUNT);
+
+    if (IsSolidBlockType(p_newBlockType))
+        _occupancy[blockIndex / OCCUPANCY_WORD_BIT_COUNT] |= blockBit;
+    else
+        _occupancy[blockIndex / OCCUPANCY_WORD_BIT_COUNT] &= ~blockBit;
+}
+
+void ChunkVoxelData::SetColumnOccupancy(const int p_x, const int p_z, const int p_firstY, const int p_count, const bool p_isSolid)
+{
+    if (p_count <= 0)
+        return;
+
+    MakeUnique();
+
+    SetOccupancyRange(GetBlockIndex(Vector3Int(p_x, p_firstY, p_z)), static_cast<size_t>(p_count), p_isSolid);
+}
+
+uint64_t ChunkVoxelData::GetColumnOccupancy(const int p_x, const int p_z, const int p_firstY) const
+{
+    const size_t firstBit = GetBlockIndex(Vector3Int(p_x, p_firstY, p_z));
+
+    const size_t wordIndex = firstBit / OCCUPANCY_WORD_BIT_COUNT;
+    const unsigned int bitOffset = firstBit % OCCUPANCY_WORD_BIT_COUNT;
+
+    uint64_t occupancy = _occupancy[wordIndex] >> bitOffset;
+
+    // The 64 bits can be split between two words
+    if (bitOffset != 0 && wordIndex + 1 < _occupancyWordCount)
+        occupancy |= _occupancy[wordIndex + 1] << (OCCUPANCY_WORD_BIT_COUNT - bitOffset);
+
+    // Removing the bits of the next column
+    const int remainingBlockCount = Size.Y - p_firstY;
+
+    if (remainingBlockCount < OCCUPANCY_WORD_BIT_COUNT)
+        occupancy &= (1ull << remainingBlockCount) - 1;
+
+    return occupancy;
+}
+
+void ChunkVoxelData::SetOccupancyRange(const size_t p_firstBit, const size_t p_count, const bool p_isSolid)
+{
+    size_t bit = p_firstBit;
+    const size_t endBit = p_firstBit + p_count;
+
+    while (bit < endBit)
+    {
+        const size_t wordIndex = bit / OCCUPANCY_WORD_BIT_COUNT;
+        const unsigned int bitOffset = bit % OCCUPANCY_WORD_BIT_COUNT;
+
+        // The number of bits we can write inside this word
+        const size_t bitCount = std::min(endBit - bit, static_cast<size_t>(OCCUPANCY_WORD_BIT_COUNT - bitOffset));
+
+        const uint64_t rangeMask = (bitCount == OCCUPANCY_WORD_BIT_COUNT ? ~0ull : ((1ull << bitCount) - 1)) << bitOffset;
+
+        if (p_isSolid)
+            _occupancy[wordIndex] |= rangeMask;
+        else
+            _occupancy[wordIndex] &= ~rangeMask;
+
+        bit += bitCount;
+    }
+}
+
+void ChunkVoxelData::AllocateStorage()
+{
+    void* slab = ChunkMemoryPool::AllocateSlab(GetPayloadByteSize());
+
+    _storage = new (slab) StorageHeader();
+    _storage->ReferenceCount.store(1, std::memory_order_relaxed);
+
+    _occupancy = reinterpret_cast<uint64_t*>(static_cast<unsigned char*>(slab) + STORAGE_HEADER_BYTE_SIZE);
+    _blocks = reinterpret_cast<BlockTypes*>(_occupancy + _occupancyWordCount);
+}
+
+void ChunkVoxelData::Fork()
+{
+    const uint64_t* sharedOccupancy = _occupancy;
+    const BlockTypes* sharedBlocks = _blocks;
+    StorageHeader* sharedStorage = _storage;
+
+    AllocateStorage();
+
+    std::memcpy(_occupancy, sharedOccupancy, _occupancyWordCount * sizeof(uint64_t));
+    std::memcpy(_blocks, sharedBlocks, _blockCount * sizeof(BlockTypes));
+
+    // Giving back our reference, the snapshots keep the old slab alive until they are destroyed
+    if (sharedStorage->ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // NOTE : All the snapshots were destroyed since IsShared() was checked
+        sharedStorage->~StorageHeader();
+        ChunkMemoryPool::FreeSlab(sharedStorage, GetPayloadByteSize());
+    }
+
+    _forkCount++;
+}
\ No newline at end of file
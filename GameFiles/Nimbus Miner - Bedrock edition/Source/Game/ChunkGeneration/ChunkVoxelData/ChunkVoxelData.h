@@ -0,0 +1,183 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Vector.h"
+
+#include "../EnvironmentEnums.h"
+
+/// <summary>
+/// The blocks of a chunk, and the metadata needed to read them (position and size).
+///
+/// <para> This is the first layer of a chunk : ChunkVoxelData -> ChunkMeshData (see GreedyMesher) -> ChunkRenderObject. </para>
+/// <para> It does not use OpenGL, so it can be generated on any thread. </para>
+/// <para> The blocks and the occupancy are stored together inside one slab of the ChunkMemoryPool. </para>
+///
+/// <para> <b> Copy-on-write : </b> copying a ChunkVoxelData does not copy the blocks, both copies share the same slab (a snapshot).
+/// The first modification of a shared slab copies it (a fork), so the other copies never see the change.
+/// That way a worker thread can mesh a snapshot while the main thread keeps editing the chunk. </para>
+/// <para> The snapshots can be read and destroyed on any thread, but a ChunkVoxelData must only be copied or modified by one thread at a time. </para> </summary>
+class ChunkVoxelData
+{
+
+public:
+
+    /// <summary> Represents the space position of the chunk in the world. </summary>
+    Vector3 WorldPosition;
+
+    /// <summary> The chunk's 3D size. Enable the possibility to set the chunk's size to not be like a square. </summary>
+    Vector3Int Size;
+
+    /// <summary> The number of blocks stored in one word of the occupancy bitset. </summary>
+    static constexpr int OCCUPANCY_WORD_BIT_COUNT = 64;
+
+private:
+
+    /// <summary> Placed at the beginning of the slab, it counts the ChunkVoxelData sharing the slab. </summary>
+    struct StorageHeader
+    {
+        std::atomic<int> ReferenceCount;
+    };
+
+    // NOTE : The header takes a whole cache line, so the reference count is not on the same line as the blocks
+    static constexpr size_t STORAGE_HEADER_BYTE_SIZE = 64;
+
+    /// <summary> The number of slabs copied because they were shared when modified (all chunks). </summary>
+    static std::atomic<unsigned long long> _forkCount;
+
+    // NOTE : All of them point inside the same slab (header, occupancy, then blocks), nullptr if not allocated
+    StorageHeader* _storage;
+    BlockTypes* _blocks;
+
+    /// <summary> One bit per block (1 = solid), in the same order as the blocks, always kept up to date with them. </summary>
+    uint64_t* _occupancy;
+
+    size_t _blockCount;
+    size_t _occupancyWordCount;
+
+public:
+
+    ChunkVoxelData(const Vector3& p_worldPosition, const Vector3Int& p_size);
+    ~ChunkVoxelData();
+
+    /// <summary> Creates a snapshot : only a reference to the blocks is taken, see the copy-on-write note above. </summary>
+    ChunkVoxelData(const ChunkVoxelData& p_other);
+    ChunkVoxelData& operator=(const ChunkVoxelData& p_other);
+
+    ChunkVoxelData(ChunkVoxelData&& p_other) noexcept;
+    ChunkVoxelData& operator=(ChunkVoxelData&& p_other) noexcept;
+
+    /// <summary> Allocates the memory of all the blocks (their type is not defined until they are generated, see WorldGenerator).
+    /// <para> All the occupancy bits are set to 0 (not solid). </para> </summary>
+    void Allocate();
+
+    /// <summary> Frees the blocks memory (only if no other snapshot uses it), the blocks have to be generated again before reading them. </summary>
+    void Release();
+
+    /// <summary>
+    /// Fills the blocks with the given ones downsampled p_factor times on each axis (a level of detail, see GreedyMesher::GenerateLevelOfDetailMesh()).
+    /// <para> A block is solid if any of its p_factor³ source blocks is solid, its type is the most common solid type among them
+    /// (on a tie, the highest one wins : it's the one seen from above). </para>
+    /// <para> The position and size are in downsampled blocks, the source size must be divisible by p_factor. </para> </summary>
+    void Downsample(const ChunkVoxelData& p_source, const int p_factor);
+
+    /// <summary> Returns true if another ChunkVoxelData (a snapshot) uses the same blocks, the next modification will copy them. </summary>
+    bool IsShared() const { return _storage != nullptr && _storage->ReferenceCount.load(std::memory_order_acquire) > 1; }
+
+    bool IsGenerated() const { return _blocks != nullptr; }
+
+    /// <summary> Returns Air if the given position is outside the chunk. </summary>
+    BlockTypes GetBlock(const Vector3Int& p_blockPosition) const;
+
+    /// <summary> Also updates the occupancy bit of the block.
+    /// <para> <b> Does not check </b> if the given position is inside the chunk, use IsBlockOutsideChunk() before. </para> </summary>
+    void SetBlock(const Vector3Int& p_blockPosition, const BlockTypes p_newBlockType);
+
+    bool IsBlockOutsideChunk(const Vector3Int& p_blockPosition) const
+    {
+        return p_blockPosition.X >= Size.X || p_blockPosition.Y >= Size.Y || p_blockPosition.Z >= Size.Z ||
+            p_blockPosition.X < 0 || p_blockPosition.Y < 0 || p_blockPosition.Z < 0;
+    }
+
+    /// <summary>
+    /// Returns the first block (y = 0) of the column at the given x and z, the next 'Size.Y' blocks are the rest of the column.
+    /// <para> <b> Does not update the occupancy </b>, use SetColumnOccupancy() after writing the blocks. </para>
+    /// <para> <b> Does not check </b> if the given position is inside the chunk. </para> </summary>
+    BlockTypes* GetColumn(const int p_x, const int p_z)
+    {
+        MakeUnique();
+
+        return _blocks + static_cast<size_t>(Size.Y) * (p_x + Size.X * p_z);
+    }
+
+    /// <summary> Returns all the blocks (see GetBlockIndex() for the order), 'GetBlockCount()' blocks can be read. </summary>
+    const BlockTypes* GetBlocks() const { return _blocks; }
+    size_t GetBlockCount() const { return _blockCount; }
+
+    // - Occupancy - //
+
+    /// <summary> Returns true if the block is solid (not Air), false if the given position is outside the chunk. </summary>
+    bool IsSolid(const Vector3Int& p_blockPosition) const
+    {
+        if (IsBlockOutsideChunk(p_blockPosition))
+            return false;
+
+        const unsigned int blockIndex = GetBlockIndex(p_blockPosition);
+
+        return (_occupancy[blockIndex / OCCUPANCY_WORD_BIT_COUNT] >> (blockIndex % OCCUPANCY_WORD_BIT_COUNT)) & 1;
+    }
+
+    /// <summary> Sets the occupancy of 'p_count' blocks of the column at the given x and z, starting at 'p_firstY'. </summary>
+    void SetColumnOccupancy(const int p_x, const int p_z, const int p_firstY, const int p_count, const bool p_isSolid);
+
+    /// <summary>
+    /// Returns the occupancy of up to 64 blocks of the column at the given x and z, starting at 'p_firstY'.
+    /// <para> The bit 0 is the block at 'p_firstY', the bits above the top of the column are 0. </para> </summary>
+    uint64_t GetColumnOccupancy(const int p_x, const int p_z, const int p_firstY) const;
+
+    /// <summary> Returns 64 occupancy bits : the bit N of the word W is the block 'W * 64 + N' (see GetBlockIndex() for the order). </summary>
+    uint64_t GetOccupancyWord(const size_t p_wordIndex) const { return _occupancy[p_wordIndex]; }
+    size_t GetOccupancyWordCount() const { return _occupancyWordCount; }
+
+    static unsigned long long GetForkCount() { return _forkCount; }
+
+    /// <summary> Returns the number of bytes used by the blocks and their occupancy. </summary>
+    size_t GetMemoryUsage() const { return IsGenerated() ? GetPayloadByteSize() : 0; }
+
+    /// <summary> The blocks are stored column by column : the blocks with the same x and z are next to each other in memory. </summary>
+    unsigned int GetBlockIndex(const Vector3Int& p_blockPosition) const
+    {
+        return p_blockPosition.Y + Size.Y * (p_blockPosition.X + Size.X * p_blockPosition.Z);
+    }
+
+    /// <summary> The opposite of GetBlockIndex(). </summary>
+    Vector3Int GetBlockPosition(const unsigned int p_blockIndex) const
+    {
+        return Vector3Int(
+            static_cast<int>(p_blockIndex / Size.Y) % Size.X,
+            static_cast<int>(p_blockIndex % Size.Y),
+            static_cast<int>(p_blockIndex / Size.Y) / Size.X
+        );
+    }
+
+private:
+
+    size_t GetPayloadByteSize() const { return STORAGE_HEADER_BYTE_SIZE + _occupancyWordCount * sizeof(uint64_t) + _blockCount * sizeof(BlockTypes); }
+
+    /// <summary> Takes a new slab (its reference count is 1) for the current _blockCount and _occupancyWordCount. </summary>
+    void AllocateStorage();
+
+    /// <summary> Copies the blocks if they are shared, must be called before any modification. </summary>
+    void MakeUnique()
+    {
+        if (IsShared())
+            Fork();
+    }
+
+    void Fork();
+
+    /// <summary> Sets 'p_count' occupancy bits starting at 'p_firstBit', word by word. </summary>
+    void SetOccupancyRange(const size_t p_firstBit, const size_t p_count, const bool p_isSolid);
+};
@@ -31,4 +31,10 @@ enum class BlockTypes : uint8_t
     // Resources
     HardCloud,
     ElectrifiedCloud
-};
\ No newline at end of file
+};
+
+/// <summary> Returns true if the block type is opaque (the player can't see through it, and can't walk through it). </summary>
+inline bool IsSolidBlockType(const BlockTypes p_blockType)
+{
+    return p_blockType != BlockTypes::Null && p_blockType != BlockTypes::Air;
+}
\ No newline at end of file
@@ -0,0 +1,413 @@
+#include "FarTerrain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "GL/glew.h"
+
+#include "IndexBufferObject.h"
+#include "Renderer.h"
+#include "Shader.h"
+#include "Vector.h"
+#include "VertexArrayObject.h"
+#include "VertexBufferLayoutObject.h"
+#include "VertexBufferObject.h"
+
+#include "ProjectConstants.h"
+
+#include "../GreedyMesher/GreedyMesher.h"
+#include "../WorldGenerator/WorldGenerator.h"
+
+#include "MessageDebugger/MessageDebugger.h"
+
+FarTerrain::FarTerrain(const WorldGenerator* p_worldGenerator, Shader* p_renderingShader, const int p_maximumHeight, const int p_levelCount,
+    const int p_gridSize, const int p_baseSpacing)
+{
+    // Initialising class' variables
+    _worldGenerator = p_worldGenerator;
+    _shader = p_renderingShader;
+    _levelOffsetUniformLocation = -1;
+    _voxelAreaUniformLocation = -1;
+
+    _gridSize = p_gridSize;
+    _maximumHeight = p_maximumHeight;
+
+    _voxelAreaMinimum = glm::dvec2(0.0);
+    _voxelAreaMaximum = glm::dvec2(0.0);
+
+    _lastSampledHeightCount = 0;
+    _lastUpdatedLevelCount = 0;
+    _lastUpdateMilliseconds = 0.0;
+    _drawnLevelCount = 0;
+
+    #pragma region Security
+
+    // The hole of a level is half of the grid, and it can be one quad away from the middle : the grid size has to be divisible by 4
+    if (_gridSize < 4 || _gridSize % 4 != 0)
+    {
+        PRINT_ERROR_RUNTIME(true, "The far terrain grid size (" + std::to_string(_gridSize) + ") must be a multiple of 4, it was rounded up.")
+        _gridSize = std::max(4, (_gridSize + 3) / 4 * 4);
+    }
+
+    #pragma endregion
+
+    const int rowSize = _gridSize + 1;
+    const int vertexCount = rowSize * rowSize;
+
+    // NOTE : Creating an IBO binds it to the current VAO, so no VAO must be bound
+    glBindVertexArray(0);
+
+    // - Index buffers - //
+
+    const std::vector<unsigned int> fullGridIndices = CreateGridIndices(_gridSize, 0, 0, 0);
+    _indexBuffers[0] = new IndexBufferObject(fullGridIndices.data(), static_cast<unsigned int>(fullGridIndices.size()));
+
+    for (int holePosition = 0; holePosition < IndexBufferCount - 1; ++holePosition)
+    {
+        const int holeX = _gridSize / 4 + (holePosition & 1);
+        const int holeZ = _gridSize / 4 + (holePosition >> 1);
+
+        const std::vector<unsigned int> ringIndices = CreateGridIndices(_gridSize, holeX, holeZ, _gridSize / 2);
+        _indexBuffers[holePosition + 1] = new IndexBufferObject(ringIndices.data(), static_cast<unsigned int>(ringIndices.size()));
+    }
+
+    // - Levels - //
+
+    VertexBufferLayoutObject vertexBufferLayoutObject;
+    vertexBufferLayoutObject.PushBack<float>(3, false); // Represent the position (relative to the level origin)
+    vertexBufferLayoutObject.PushBack<float>(1, false); // Represent the texture layer of the slope's sides
+    vertexBufferLayoutObject.PushBack<float>(1, false); // Represent the part of the slope made of sides
+
+    _levels.resize(std::max(1, p_levelCount));
+
+    for (size_t i = 0; i < _levels.size(); ++i)
+    {
+        ClipmapLevel& level = _levels[i];
+
+        level.Spacing = std::max(1, p_baseSpacing) << i;
+
+        level.Heights.assign(vertexCount, 0);
+        level.ShiftedHeights.assign(vertexCount, 0);
+        level.VertexData.assign(static_cast<size_t>(vertexCount) * FloatsPerVertex, 0.0f);
+
+        level.VertexBuffer = new VertexBufferObject(level.VertexData.data(), static_cast<unsigned int>(level.VertexData.size() * sizeof(float)));
+
+        level.VertexArray = new VertexArrayObject();
+        level.VertexArray->AddBuffer(*level.VertexBuffer, vertexBufferLayoutObject);
+    }
+
+    // - Strata - //
+
+    // The side faces of a slope show the blocks below the surface, like the chunks' side faces
+    _sideTextureLayers.resize(static_cast<size_t>(_maximumHeight) + 2);
+
+    for (int depth = 0; depth < static_cast<int>(_sideTextureLayers.size()); ++depth)
+    {
+        const unsigned int textureIndex = GreedyMesher::GetEnvironmentTextureIndex(WorldGenerator::GetBlockTypeAtDepth(depth), Vector3::Right());
+        _sideTextureLayers[depth] = static_cast<float>(std::min(textureIndex, static_cast<unsigned int>(MaximumStrataColorCount - 1)));
+    }
+
+    // - Shader - //
+
+    _shader->Bind();
+    _levelOffsetUniformLocation = _shader->GetUniformLocation("u_LevelOffset");
+    _voxelAreaUniformLocation = _shader->GetUniformLocation("u_RelativeVoxelArea");
+
+    _shader->SetUniform4f("u_TopColor", CHUNK_BLOCK_TOP_TEXTURE_COLOR.r, CHUNK_BLOCK_TOP_TEXTURE_COLOR.g, CHUNK_BLOCK_TOP_TEXTURE_COLOR.b, CHUNK_BLOCK_TOP_TEXTURE_COLOR.a);
+    _shader->SetUniform4f("u_SideColor", CHUNK_BLOCK_SIDE_TEXTURE_COLOR.r, CHUNK_BLOCK_SIDE_TEXTURE_COLOR.g, CHUNK_BLOCK_SIDE_TEXTURE_COLOR.b, CHUNK_BLOCK_SIDE_TEXTURE_COLOR.a);
+
+    _shader->SetUniform4f("u_FogColor", BACKGROUND_COLOR.r, BACKGROUND_COLOR.g, BACKGROUND_COLOR.b, BACKGROUND_COLOR.a);
+    _shader->SetUniform2f("u_FogRange", GetViewDistance() * FAR_TERRAIN_FOG_START, GetViewDistance());
+
+    SetStrataColors(std::vector<glm::vec4>(MaximumStrataColorCount, glm::vec4(1.0f)));
+
+    // The shader and VAO bound here are not known by the Renderer
+    Renderer::InvalidateStateCache();
+}
+
+FarTerrain::~FarTerrain()
+{
+    for (ClipmapLevel& level : _levels)
+    {
+        delete level.VertexArray;
+        delete level.VertexBuffer;
+    }
+
+    for (IndexBufferObject* indexBuffer : _indexBuffers)
+        delete indexBuffer;
+}
+
+void FarTerrain::SetVoxelArea(const glm::dvec2& p_minimum, const glm::dvec2& p_maximum)
+{
+    _voxelAreaMinimum = p_minimum;
+    _voxelAreaMaximum = p_maximum;
+}
+
+void FarTerrain::SetStrataColors(const std::vector<glm::vec4>& p_layerColors)
+{
+    _shader->Bind();
+
+    const int colorCount = std::min(static_cast<int>(p_layerColors.size()), static_cast<int>(MaximumStrataColorCount));
+
+    for (int i = 0; i < colorCount; ++i)
+    {
+        const glm::vec4& color = p_layerColors[i];
+        _shader->SetUniform4f("u_StrataColors[" + std::to_string(i) + "]", color.r, color.g, color.b, color.a);
+    }
+
+    Renderer::InvalidateStateCache();
+}
+
+void FarTerrain::Update(const glm::dvec3& p_cameraPosition)
+{
+    _lastSampledHeightCount = 0;
+    _lastUpdatedLevelCount = 0;
+    _lastUpdateMilliseconds = 0.0;
+
+    if (!IsEnabled)
+        return;
+
+    const std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < _levels.size(); ++i)
+    {
+        ClipmapLevel& level = _levels[i];
+
+        if (!UpdateLevel(level, p_cameraPosition))
+            continue;
+
+        BuildVertexData(level, i + 1 < _levels.size());
+
+        // NOTE : The whole level is uploaded, it's only (GridSize + 1)² vertices and the levels rarely move (the coarser, the rarer)
+        level.VertexBuffer->SetData(level.VertexData.data(), static_cast<unsigned int>(level.VertexData.size() * sizeof(float)));
+
+        _lastUpdatedLevelCount++;
+    }
+
+    _lastUpdateMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+}
+
+void FarTerrain::Submit(const glm::dvec3& p_cameraPosition)
+{
+    _drawnLevelCount = 0;
+
+    if (!IsEnabled)
+        return;
+
+    // Computed in double precision like the ring offsets, a world position rebuilt in float by the shader would make the seam jitter far from the origin
+    const glm::dvec2 cameraPosition = glm::dvec2(p_cameraPosition.x, p_cameraPosition.z);
+    const glm::vec2 relativeVoxelAreaMinimum = glm::vec2(_voxelAreaMinimum - cameraPosition);
+    const glm::vec2 relativeVoxelAreaMaximum = glm::vec2(_voxelAreaMaximum - cameraPosition);
+
+    _shader->Bind();
+    glUniform4f(_voxelAreaUniformLocation, relativeVoxelAreaMinimum.x, relativeVoxelAreaMinimum.y, relativeVoxelAreaMaximum.x, relativeVoxelAreaMaximum.y);
+
+    // The shader bound here is not known by the Renderer
+    Renderer::InvalidateStateCache();
+
+    for (size_t i = 0; i < _levels.size(); ++i)
+    {
+        const ClipmapLevel& level = _levels[i];
+
+        if (!level.IsSampled)
+            continue;
+
+        // NOTE : The height of the voxel column x covers [x, x + 1[, so it's placed at the column center
+        const double levelSize = static_cast<double>(_gridSize) * level.Spacing;
+        const double minimumX = static_cast<double>(level.OriginX) * level.Spacing + 0.5;
+        const double minimumZ = static_cast<double>(level.OriginZ) * level.Spacing + 0.5;
+
+        // Fully covered by the voxel chunks (the hole of the next level is inside them too)
+        if (minimumX >= _voxelAreaMinimum.x && minimumX + levelSize <= _voxelAreaMaximum.x &&
+            minimumZ >= _voxelAreaMinimum.y && minimumZ + levelSize <= _voxelAreaMaximum.y)
+            continue;
+
+        RenderQueueItem renderQueueItem;
+        renderQueueItem.VertexArray = level.VertexArray;
+        renderQueueItem.IndexBuffer = _indexBuffers[GetIndexBufferIndex(static_cast<int>(i))];
+        renderQueueItem.RenderingShader = _shader;
+        renderQueueItem.Depth = static_cast<float>(levelSize); // The finest levels are the closest ones
+        renderQueueItem.OffsetUniformLocation = _levelOffsetUniformLocation;
+
+        // Computed in double precision, the far levels can be thousands of blocks away
+        renderQueueItem.Offset = glm::vec3(glm::dvec3(minimumX, 0.0, minimumZ) - p_cameraPosition);
+
+        Renderer::Submit(renderQueueItem);
+        _drawnLevelCount++;
+    }
+}
+
+float FarTerrain::GetViewDistance() const
+{
+    return static_cast<float>(_gridSize / 2 * _levels.back().Spacing);
+}
+
+size_t FarTerrain::GetMemoryUsage() const
+{
+    size_t byteSize = _sideTextureLayers.capacity() * sizeof(float);
+
+    for (const ClipmapLevel& level : _levels)
+    {
+        byteSize += (level.Heights.capacity() + level.ShiftedHeights.capacity()) * sizeof(int);
+        byteSize += level.VertexData.capacity() * sizeof(float);
+    }
+
+    return byteSize;
+}
+
+size_t FarTerrain::GetGpuMemoryUsage() const
+{
+    size_t byteSize = 0;
+
+    for (const ClipmapLevel& level : _levels)
+        byteSize += level.VertexData.size() * sizeof(float);
+
+    for (const IndexBufferObject* indexBuffer : _indexBuffers)
+        byteSize += static_cast<size_t>(indexBuffer->GetIndexesCount()) * sizeof(unsigned int);
+
+    return byteSize;
+}
+
+bool FarTerrain::UpdateLevel(ClipmapLevel& p_level, const glm::dvec3& p_cameraPosition)
+{
+    // Snapped to 2 * Spacing, the next level (twice as coarse) then always has a vertex on every other vertex of this one
+    const int doubleSpacing = p_level.Spacing * 2;
+    const int originX = FloorDivide(static_cast<int>(std::floor(p_cameraPosition.x)), doubleSpacing) * 2 - _gridSize / 2;
+    const int originZ = FloorDivide(static_cast<int>(std::floor(p_cameraPosition.z)), doubleSpacing) * 2 - _gridSize / 2;
+
+    if (p_level.IsSampled && originX == p_level.OriginX && originZ == p_level.OriginZ)
+        return false;
+
+    const int rowSize = _gridSize + 1;
+    const int shiftX = originX - p_level.OriginX;
+    const int shiftZ = originZ - p_level.OriginZ;
+
+    for (int z = 0; z < rowSize; ++z)
+    {
+        const int previousZ = z + shiftZ;
+
+        for (int x = 0; x < rowSize; ++x)
+        {
+            const int previousX = x + shiftX;
+
+            // The heights still inside the level are only moved, the noise is the expensive part
+            if (p_level.IsSampled && previousX >= 0 && previousX < rowSize && previousZ >= 0 && previousZ < rowSize)
+            {
+                p_level.ShiftedHeights[z * rowSize + x] = p_level.Heights[previousZ * rowSize + previousX];
+                continue;
+            }
+
+            p_level.ShiftedHeights[z * rowSize + x] = SampleHeight(p_level, originX + x, originZ + z);
+            _lastSampledHeightCount++;
+        }
+    }
+
+    p_level.Heights.swap(p_level.ShiftedHeights);
+
+    p_level.OriginX = originX;
+    p_level.OriginZ = originZ;
+    p_level.IsSampled = true;
+
+    return true;
+}
+
+void FarTerrain::BuildVertexData(ClipmapLevel& p_level, const bool p_hasOuterLevel) const
+{
+    const int rowSize = _gridSize + 1;
+    const std::vector<int>& heights = p_level.Heights;
+
+    for (int z = 0; z < rowSize; ++z)
+    {
+        for (int x = 0; x < rowSize; ++x)
+        {
+            float height = static_cast<float>(heights[z * rowSize + x]);
+
+            // The outer level only has the even vertices of this border, its edges go straight from one to the other :
+            // the odd ones are moved onto these edges, otherwise there would be cracks between the two levels
+            if (p_hasOuterLevel)
+            {
+                if ((x == 0 || x == _gridSize) && (z & 1) == 1)
+                    height = (heights[(z - 1) * rowSize + x] + heights[(z + 1) * rowSize + x]) * 0.5f;
+                else if ((z == 0 || z == _gridSize) && (x & 1) == 1)
+                    height = (heights[z * rowSize + x - 1] + heights[z * rowSize + x + 1]) * 0.5f;
+            }
+
+            // - Slope - //
+
+            const int previousX = std::max(x - 1, 0);
+            const int nextX = std::min(x + 1, _gridSize);
+            const int previousZ = std::max(z - 1, 0);
+            const int nextZ = std::min(z + 1, _gridSize);
+
+            // In blocks per block : a slope of 3 is a staircase of 1 block wide and 3 blocks high steps
+            const float xSlope = std::abs(static_cast<float>(heights[z * rowSize + nextX] - heights[z * rowSize + previousX])) / ((nextX - previousX) * p_level.Spacing);
+            const float zSlope = std::abs(static_cast<float>(heights[nextZ * rowSize + x] - heights[previousZ * rowSize + x])) / ((nextZ - previousZ) * p_level.Spacing);
+            const float slope = std::max(xSlope, zSlope);
+
+            // The side of a step shows the blocks from the surface to the step height, the middle one is kept
+            const int exposedDepth = std::min(std::max(static_cast<int>(std::ceil(slope)), 1), _maximumHeight);
+
+            float* vertex = &p_level.VertexData[static_cast<size_t>(z * rowSize + x) * FloatsPerVertex];
+            vertex[0] = static_cast<float>(x * p_level.Spacing);
+            vertex[1] = height;
+            vertex[2] = static_cast<float>(z * p_level.Spacing);
+            vertex[3] = _sideTextureLayers[1 + exposedDepth / 2];
+
+            // Seen from far away, a staircase is made of 1 top face for 'slope' side faces
+            vertex[4] = slope / (1.0f + slope);
+        }
+    }
+}
+
+int FarTerrain::SampleHeight(const ClipmapLevel& p_level, const int p_x, const int p_z) const
+{
+    return _worldGenerator->GetSurfaceHeight(static_cast<float>(p_x * p_level.Spacing), static_cast<float>(p_z * p_level.Spacing), _maximumHeight);
+}
+
+int FarTerrain::GetIndexBufferIndex(const int p_levelIndex) const
+{
+    if (p_levelIndex == 0)
+        return 0;
+
+    const ClipmapLevel& level = _levels[p_levelIndex];
+    const ClipmapLevel& innerLevel = _levels[p_levelIndex - 1];
+
+    // The inner level origin is even, so it's always on a vertex of this level (N / 4 or N / 4 + 1 quads from the border)
+    const int holeX = std::min(std::max(innerLevel.OriginX / 2 - level.OriginX - _gridSize / 4, 0), 1);
+    const int holeZ = std::min(std::max(innerLevel.OriginZ / 2 - level.OriginZ - _gridSize / 4, 0), 1);
+
+    return 1 + holeX + holeZ * 2;
+}
+
+std::vector<unsigned int> FarTerrain::CreateGridIndices(const int p_gridSize, const int p_holeX, const int p_holeZ, const int p_holeSize)
+{
+    const unsigned int rowSize = static_cast<unsigned int>(p_gridSize) + 1;
+
+    std::vector<unsigned int> indices;
+    indices.reserve(static_cast<size_t>(p_gridSize) * p_gridSize * 6);
+
+    for (int z = 0; z < p_gridSize; ++z)
+    {
+        for (int x = 0; x < p_gridSize; ++x)
+        {
+            if (x >= p_holeX && x < p_holeX + p_holeSize && z >= p_holeZ && z < p_holeZ + p_holeSize)
+                continue;
+
+            const unsigned int vertex = static_cast<unsigned int>(z) * rowSize + static_cast<unsigned int>(x);
+
+            // Counter-clockwise seen from above
+            indices.push_back(vertex);
+            indices.push_back(vertex + rowSize);
+            indices.push_back(vertex + 1);
+
+            indices.push_back(vertex + 1);
+            indices.push_back(vertex + rowSize);
+            indices.push_back(vertex + rowSize + 1);
+        }
+    }
+
+    return indices;
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <vector>
+
+#include "GLM/glm.hpp"
+
+class IndexBufferObject;
+class Shader;
+class VertexArrayObject;
+class VertexBufferObject;
+class WorldGenerator;
+
+/// <summary>
+/// Draws the terrain beyond the voxel chunks, as nested clipmap rings of heightmap tiles sampled from the WorldGenerator's noise.
+///
+/// <para> Each ring (level) is a grid of (GridSize + 1)² vertices, twice as large and twice as coarse as the previous one,
+/// with a hole where the previous ring is. The rings follow the camera : when one moves, the heights already known are shifted,
+/// only the new rows and columns are sampled. </para>
+/// <para> The memory used is fixed, it only depends on the level count and the grid size (not on the view distance). </para>
+/// <para> The fragments above the voxel chunks are discarded (see SetVoxelArea()), the chunks take over where they exist. </para>
+/// <para> <b> Needs an OpenGL context </b> to be created, updated and deleted (so only on the OpenGL thread). </para> </summary>
+class FarTerrain
+{
+
+public:
+
+    bool IsEnabled = true;
+
+private:
+
+    /// <summary> One ring of the clipmap. </summary>
+    struct ClipmapLevel
+    {
+        /// <summary> The distance (in blocks) between two vertices. </summary>
+        int Spacing = 1;
+
+        /// <summary> The world position of the vertex (0, 0), in Spacing units. Always even, so the next level has a vertex on every other vertex. </summary>
+        int OriginX = 0;
+        int OriginZ = 0;
+
+        bool IsSampled = false;
+
+        /// <summary> The surface heights of the vertices, row by row (z by z). </summary>
+        std::vector<int> Heights;
+
+        /// <summary> Where the heights are shifted when the level moves, swapped with Heights after. </summary>
+        std::vector<int> ShiftedHeights;
+
+        /// <summary> 5 floats per vertex : the position relative to the origin, the side texture layer and the side fraction. </summary>
+        std::vector<float> VertexData;
+
+        VertexBufferObject* VertexBuffer = nullptr;
+        VertexArrayObject* VertexArray = nullptr;
+    };
+
+    static const int FloatsPerVertex = 5;
+
+    // The full grid (the first level) and the 4 positions the hole of the next levels can have
+    static const int IndexBufferCount = 5;
+
+    // NOTE : Has to be the size of the 'u_StrataColors' array of FarTerrainShader.glsl
+    static const int MaximumStrataColorCount = 8;
+
+    const WorldGenerator* _worldGenerator;
+    Shader* _shader;
+    int _levelOffsetUniformLocation;
+    int _voxelAreaUniformLocation;
+
+    int _gridSize;
+    int _maximumHeight;
+
+    std::vector<ClipmapLevel> _levels;
+    IndexBufferObject* _indexBuffers[IndexBufferCount];
+
+    /// <summary> The texture layer shown by the side faces of a slope, indexed by the depth below the surface. </summary>
+    std::vector<float> _sideTextureLayers;
+
+    // The XZ rectangle (in world space) covered by the voxel chunks, empty by default
+    // NOTE : In double precision, the shader gets it relative to the camera (see Submit())
+    glm::dvec2 _voxelAreaMinimum;
+    glm::dvec2 _voxelAreaMaximum;
+
+    // - Statistics - //
+
+    int _lastSampledHeightCount;
+    int _lastUpdatedLevelCount;
+    double _lastUpdateMilliseconds;
+    int _drawnLevelCount;
+
+public:
+
+    /// <param name = "p_renderingShader"> The far terrain shader (see FarTerrainShader.glsl), its 'FrameData' block has to be bound already </param>
+    /// <param name = "p_maximumHeight"> The chunks' height, the same as the one given to WorldGenerator::GetSurfaceHeight() </param>
+    /// <param name = "p_levelCount"> The number of rings, the view distance doubles with each one </param>
+    /// <param name = "p_gridSize"> The number of quads along one side of a ring, a multiple of 4 </param>
+    /// <param name = "p_baseSpacing"> The distance (in blocks) between two vertices of the finest ring </param>
+    FarTerrain(const WorldGenerator* p_worldGenerator, Shader* p_renderingShader, int p_maximumHeight, int p_levelCount, int p_gridSize, int p_baseSpacing);
+    ~FarTerrain();
+
+    // The rings own OpenGL objects, copying them would delete them twice
+    FarTerrain(const FarTerrain&) = delete;
+    FarTerrain& operator=(const FarTerrain&) = delete;
+
+    /// <summary> The XZ rectangle (in world space) where the voxel chunks are drawn, the far terrain is not drawn inside. </summary>
+    void SetVoxelArea(const glm::dvec2& p_minimum, const glm::dvec2& p_maximum);
+
+    /// <summary> Gives the color of each texture layer (see Texture2DArray::GetLayerAverageColors()), only the first 8 are used. </summary>
+    void SetStrataColors(const std::vector<glm::vec4>& p_layerColors);
+
+    /// <summary> Moves the rings with the camera, only samples the heights that were not known yet and uploads the moved rings. Call it once per frame. </summary>
+    void Update(const glm::dvec3& p_cameraPosition);
+
+    /// <summary> Queues the rings inside the Renderer (see Renderer::Submit()), the ones fully inside the voxel area are skipped.
+    /// <para> Also gives the voxel area to the shader, relative to the camera. </para> </summary>
+    void Submit(const glm::dvec3& p_cameraPosition);
+
+    /// <summary> The distance (in blocks) from the camera to the border of the last ring. </summary>
+    float GetViewDistance() const;
+
+    int GetLevelCount() const { return static_cast<int>(_levels.size()); }
+
+    /// <summary> The heights sampled from the noise by the last Update() (0 when the camera did not move enough). </summary>
+    int GetLastSampledHeightCount() const { return _lastSampledHeightCount; }
+    int GetLastUpdatedLevelCount() const { return _lastUpdatedLevelCount; }
+    double GetLastUpdateMilliseconds() const { return _lastUpdateMilliseconds; }
+
+    int GetDrawnLevelCount() const { return _drawnLevelCount; }
+
+    /// <summary> The CPU memory used by the rings (heights and vertices). </summary>
+    size_t GetMemoryUsage() const;
+
+    /// <summary> The GPU memory used by the vertex and index buffers. </summary>
+    size_t GetGpuMemoryUsage() const;
+
+private:
+
+    /// <summary> Moves the level to the camera (shifting the known heights), returns false if it did not move. </summary>
+    bool UpdateLevel(ClipmapLevel& p_level, const glm::dvec3& p_cameraPosition);
+
+    /// <summary> Fills the VertexData of the level from its Heights. </summary>
+    /// <param name = "p_hasOuterLevel"> The border vertices between two vertices of the next level are moved onto its edges (no T-junction cracks) </param>
+    void BuildVertexData(ClipmapLevel& p_level, bool p_hasOuterLevel) const;
+
+    int SampleHeight(const ClipmapLevel& p_level, int p_x, int p_z) const;
+
+    /// <summary> The index buffer to use for the given level (the position of the previous level inside it), 0 for the first level. </summary>
+    int GetIndexBufferIndex(int p_levelIndex) const;
+
+    /// <summary> The triangles of the grid, without the ones inside the hole (p_holeSize = 0 for no hole). </summary>
+    static std::vector<unsigned int> CreateGridIndices(int p_gridSize, int p_holeX, int p_holeZ, int p_holeSize);
+};
\ No newline at end of file
@@ -1,41 +1,38 @@
 #pragma once
 
+#include "Shader.h"
+
 #include <vector>
 
-#include "Shader.h"
-#include "VertexArrayObject.h"
+#include "../../../Engine/Culling/OcclusionCuller.h"
 
 #include "../ChunkMeshData.h"
 #include "../EnvironmentEnums.h"
-
-// Forward declaration
-class FastNoiseLite;
-
+#include "../ChunkVoxelData/ChunkVoxelData.h"
+
+// Forward declarations
+class ChunkRenderObject;
+class WorldGenerator;
+
+/// <summary>
+/// A chunk of the world, made of three layers that each have their own lifetime :
+/// <para> - ChunkVoxelData : the blocks (CPU, no OpenGL) </para>
+/// <para> - ChunkMeshData : the greedy mesh created by the GreedyMesher (CPU, no OpenGL) </para>
+/// <para> - ChunkRenderObject : the VAO, VBO and IBO (GPU, needs an OpenGL context) </para>
+///
+/// <para> Each layer can be released independently (for example the mesh once it's sent to the GPU). </para> </summary>
 class GreedyChunk
 {
     
 public:
-    
-    /// <summary>
-    /// The Mask struct weight exactly 8 bytes, the same size as an address,
-    /// that means you don't have to pass it as a reference. </summary>
-    struct Mask
-    {
-        BlockTypes BlockType;
-        int Normal;
-    };
 
     // -- Chunk properties -- //  
 
     /// <summary> Represents the space position of the chunk in the world. </summary>
     Vector3 WorldPosition;
     
-    /// <summary> The world seed, changing it change how the word is generated. </summary>
-    int WorldSeed = 1789;
-    
-    /// <summary> Frequency is used to create noise, which influences the steepness of slopes : the lower the frequency,
-    /// the gentler the slopes, and the higher the frequency, the steeper the slopes. </summary>
-    float NoiseFrequency = 0.03f;
+    /// <summary> The generator shared by all the world's chunks (owned by the ChunkManager, it must outlive the chunk). </summary>
+    const WorldGenerator* Generator;
 
     /// <summary> The chunk's 3D size. Enable the possibility to set the chunk's size to not be like a square. </summary>
     Vector3Int Size = Vector3Int(32, 32, 32);
@@ -45,67 +42,137 @@ public:
 
     // - Rendering - //
     
-    /// <summary> The VertexArrayObject that will be used to render chunk's vertices. </summary>
-    VertexArrayObject* RenderingVertexArrayObject;
-
-    /// <summary> The IndexBufferObject that will be used to render chunk's vertices. </summary>
-    IndexBufferObject* RenderingIndexBufferObject;
-    
     /// <summary> The shader that will be used to render chunk's vertices. </summary>
     Shader* RenderingShader;
 
 private:
-    
-    FastNoiseLite* _noise;
 
+    ChunkVoxelData _voxelData;
     ChunkMeshData _meshData;
-    std::vector<BlockTypes> _blocks;
 
-    int	_vertexCount = 0;
+    ChunkRenderObject* _renderObject;
+
+    /// <summary> Incremented every time the data the mesh is made from changes (the blocks, or the border blocks of a neighbor),
+    /// a mesh created from an older version is outdated. </summary>
+    unsigned int _version;
+
+    /// <summary> Solid boxes inside the chunk (world space), used as occluders by the ChunkManager (see UpdateOccluderBoxes()). </summary>
+    std::vector<OccluderBox> _occluderBoxes;
 
-    VertexBufferObject* _vertexBufferObject;
+    /// <summary> Copied from the mesh data when it's sent to the GPU, so it's kept when the mesh data is released. </summary>
+    std::vector<ChunkFaceConnectivity> _sectionConnectivities;
+
+    /// <summary> The level of detail the next meshes are created with (see GreedyMesher::GenerateLevelOfDetailMesh()). </summary>
+    int _levelOfDetail;
+
+    /// <summary> The level of detail of the mesh on the GPU. </summary>
+    int _meshLevelOfDetail;
     
 public:
     
     GreedyChunk(const Vector3& p_worldPosition,
-        const int p_worldSeed, const float p_noiseFrequency, const Vector3Int& p_size, Shader* p_renderingShader,
+        const WorldGenerator* p_worldGenerator, const Vector3Int& p_size, Shader* p_renderingShader,
         const int p_blockPixelSize = 1, const bool p_doesInit = true);
     ~GreedyChunk();
     
     void Init();
 
-    void Draw() const;
+    /// <summary> Queues the chunk inside the Renderer (drawn by Renderer::FlushQueue()), does nothing if the mesh was not sent to the GPU (see UpdateDrawData()).
+    /// <para> The chunk is placed relative to the given camera position (the shader's 'u_ChunkOffset'). </para> </summary>
+    /// <param name = "p_depth"> Used to order the draws inside the Renderer's queue (see GetDistanceTo()) </param>
+    /// <param name = "p_offsetUniformLocation"> The location of the RenderingShader's 'u_ChunkOffset' (the same for all the chunks, so looked up once by the caller) </param>
+    void Draw(const glm::dvec3& p_cameraPosition, float p_depth, int p_offsetUniformLocation) const;
+
+    /// <summary> The distance between the given position and the chunk's center (computed in double precision). </summary>
+    float GetDistanceTo(const glm::dvec3& p_position) const;
+
+    /// <summary> Returns false if the chunk has no mesh on the GPU, else the bounds of its mesh (world space). </summary>
+    bool GetMeshBounds(glm::vec3& p_outMinimum, glm::vec3& p_outMaximum) const;
+
+    /// <summary> Conservative solid boxes of the chunk (world space), updated every time the blocks change. </summary>
+    const std::vector<OccluderBox>& GetOccluderBoxes() const { return _occluderBoxes; }
+
+    /// <summary> Which faces of each section can see each other (see ChunkVisibility), empty until the first mesh is sent to the GPU. </summary>
+    const std::vector<ChunkFaceConnectivity>& GetSectionConnectivities() const { return _sectionConnectivities; }
+
+    /// <summary> Returns the faces of the block's section reachable from the given block (the position is in blocks, relative to the chunk).
+    /// <para> All the faces if the blocks were released (it's the safe answer). </para> </summary>
+    unsigned char GetFacesReachableFrom(const Vector3Int& p_blockPosition) const;
     
-    void SetBlockType(const Vector3Int& p_blockPosition, const BlockTypes p_newBlockType);
+    /// <param name = "p_doesRegenerateMesh"> False when the mesh is created by a mesh job (see ChunkManager), the chunk is only marked as outdated. </param>
+    void SetBlockType(const Vector3Int& p_blockPosition, const BlockTypes p_newBlockType, const bool p_doesRegenerateMesh = true);
 
     bool IsBlockOutsideChunk(const Vector3Int& p_blockPosition) const;
 
-private:
+    // - Generation steps - //
+
+    // NOTE : The three methods below don't use OpenGL, so they can be called without any OpenGL context
+    //        (that's what the WorldGenerationBenchmark project does). Init() calls them, then UpdateDrawData().
 
+    /// <summary> Fills the chunk's blocks using the world generator. </summary>
     void GenerateBlocks();
 
+    /// <summary> Takes the given blocks (loaded from the disk, see ChunkStorage) instead of generating them, they must have the chunk's size. </summary>
+    void SetVoxelData(ChunkVoxelData&& p_voxelData);
+
     void ClearMesh();
-    
+
+    /// <summary> Creates the greedy mesh (vertices and vertices indices) from the chunk's blocks.
+    /// <para> If the blocks were released, they are generated again first. </para> </summary>
     void GenerateMesh();
-    
+
+    /// <summary> Sends the mesh data to the GPU (replacing the last one), <b> needs an OpenGL context. </b> </summary>
     void UpdateDrawData();
 
+    // - Mesh jobs - //
 
-    // NOTE : The Mask struct weight exactly 8 bytes, the same size as an address,
-    //        it's for this reason we don't pass it by const reference
+    // NOTE : A mesh job takes a snapshot of the voxel data (a copy of GetVoxelData(), see ChunkVoxelData) with the current version,
+    //        the chunk can be edited during the job, the result is only used if the version did not change
 
-    void CreateQuad(const Mask p_mask, const Vector3Int& p_maskAxis, const unsigned int p_width, const unsigned int p_height,
-        const Vector3& p_vertexPosition1, const Vector3& p_vertexPosition2, const Vector3& p_vertexPosition3, const Vector3& p_vertexPosition4);
+    unsigned int GetVersion() const { return _version; }
 
-    void SetBlockTypeData(const Vector3Int& p_blockPosition, const BlockTypes p_newBlockType);
-    
-    
-    BlockTypes GetBlock(const Vector3Int& p_blockPosition) const;
-    
-    unsigned int GetBlockIndex(const Vector3Int& p_blockPosition) const;
-    
-    /// <summary> Returns the index of a texture inside a Texture array. </summary>
-    unsigned int GetEnvironmentTextureIndex(const BlockTypes p_blockType, const Vector3& p_normal) const;
-    
-    bool IsSameMask(const Mask p_mask1, const Mask p_mask2) const;
+    /// <summary> Used when a neighbor's border blocks changed, the current mesh is outdated even if our blocks did not change. </summary>
+    void MarkMeshOutdated() { _version++; }
+
+    // - Levels of detail - //
+
+    /// <summary>
+    /// Changes the level of detail of the next meshes (0 = full resolution, 1 = 2x downsampled, 2 = 4x downsampled), the current mesh is outdated.
+    /// <para> The current mesh is still drawn until the new one is applied (see ApplyMeshData()). </para> </summary>
+    void SetLevelOfDetail(const int p_levelOfDetail);
+
+    int GetLevelOfDetail() const { return _levelOfDetail; }
+    int GetMeshLevelOfDetail() const { return _meshLevelOfDetail; }
+
+    /// <summary>
+    /// Takes the mesh created by a mesh job (the given mesh data gets the old one) and sends it to the GPU, <b> needs an OpenGL context. </b>
+    /// <para> Returns false and does nothing if the mesh was created from an older version of the chunk. </para> </summary>
+    bool ApplyMeshData(ChunkMeshData& p_meshData, const unsigned int p_version);
+
+    // - Layers releasing - //
+
+    // NOTE : Useful under memory pressure, a released layer can always be re-created from the previous one
+
+    void ReleaseVoxelData();
+    void ReleaseMeshData();
+
+    /// <summary> <b> Needs an OpenGL context. </b> </summary>
+    void ReleaseRenderObject();
+
+    bool HasVoxelData() const { return _voxelData.IsGenerated(); }
+    bool HasMeshData() const { return !_meshData.IsEmpty(); }
+    bool HasRenderObject() const { return _renderObject != nullptr; }
+
+    const ChunkVoxelData& GetVoxelData() const { return _voxelData; }
+    const ChunkMeshData& GetMeshData() const { return _meshData; }
+
+    /// <summary> Returns the number of bytes used on the CPU by the blocks and the mesh. </summary>
+    size_t GetMemoryUsage() const { return _voxelData.GetMemoryUsage() + _meshData.GetMemoryUsage(); }
+
+private:
+
+    /// <summary>
+    /// Creates one box per group of OCCLUDER_BOX_COLUMN_COUNT x OCCLUDER_BOX_COLUMN_COUNT columns, from the bottom of the chunk
+    /// to the lowest height where all of them are still solid (the terrain is a heightfield, so it hides most of the chunk). </summary>
+    void UpdateOccluderBoxes();
 };
\ No newline at end of file
@@ -0,0 +1,463 @@
+#include "GreedyMesher.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "MeshingContext.h"
+#include "../ChunkVisibility/ChunkVisibility.h"
+#include "../ChunkVoxelData/ChunkBorderPlanes.h"
+#include "../ChunkVoxelData/ChunkVoxelData.h"
+
+#include "ProjectConstants.h"
+#include "MessageDebugger/MessageDebugger.h"
+
+void GreedyMesher::GenerateMesh(const ChunkVoxelData& p_voxelData, const int p_blockSize, ChunkMeshData& p_outMeshData)
+{
+	GenerateMesh(p_voxelData, p_blockSize, MeshingContext::GetThreadContext(), p_outMeshData);
+}
+
+void GreedyMesher::GenerateMesh(const ChunkVoxelData& p_voxelData, const int p_blockSize, MeshingContext& p_context, ChunkMeshData& p_outMeshData,
+	const ChunkBorderPlanes* p_borderPlanes)
+{
+	BuildMesh(p_voxelData, p_blockSize, p_context, p_outMeshData, p_borderPlanes);
+
+	if (!p_voxelData.IsGenerated())
+		return;
+
+	// - Cave culling - //
+
+	// NOTE : Computed with the mesh so it's always up to date with it (re-meshing after a SetBlockType() also updates it)
+	ChunkVisibility::ComputeFaceConnectivities(p_voxelData, p_context, p_outMeshData.SectionConnectivities);
+}
+
+void GreedyMesher::BuildMesh(const ChunkVoxelData& p_voxelData, const int p_blockSize, MeshingContext& p_context, ChunkMeshData& p_outMeshData,
+	const ChunkBorderPlanes* p_borderPlanes)
+{
+	p_outMeshData.Clear();
+
+	// Nothing to mesh (the blocks were never generated or were released)
+	if (!p_voxelData.IsGenerated())
+		return;
+
+	// NOTE : The quads are added into the staging mesh, it keeps its memory between two chunks so it does not grow again every time
+	ChunkMeshData& stagingMesh = p_context.GetStagingMesh();
+	stagingMesh.Clear();
+
+	// NOTE : Each quad writes its indices in the list of its direction, so the directions end up in contiguous ranges
+	for (int faceDirection = 0; faceDirection < FaceDirectionCount; ++faceDirection)
+		p_context.GetFaceIndices(static_cast<FaceDirections>(faceDirection)).clear();
+
+	const Vector3Int size = p_voxelData.Size;
+
+	// We go through each axis
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		// - Setting up locals variables - //
+
+		// Returns the horizontal axis
+		const int axis1 = (axis + 1) % 3;
+		// Returns the vertical axis
+		const int axis2 = (axis + 2) % 3; 
+
+		const int mainAxisLimit = size[axis];
+		const int axis1Limit = size[axis1];
+		const int axis2Limit = size[axis2];
+
+		Vector3Int deltaAxis1 = Vector3Int::Zero();
+		Vector3Int deltaAxis2 = Vector3Int::Zero();
+
+		Vector3Int chunkIteration = Vector3Int::Zero();
+		Vector3Int axisMask = Vector3Int::Zero();
+
+		axisMask[axis] = 1;
+
+		// NOTE : Every mask of the plane is written before being read, so the values of the last slice don't need to be reset
+		Mask* masks = p_context.GetMaskPlane(static_cast<size_t>(axis1Limit) * axis2Limit);
+
+		// Generating the slices
+		for (chunkIteration[axis] = -1; chunkIteration[axis] < mainAxisLimit;)
+		{
+			int maskIteration = 0;
+
+			// The first slice compares the blocks before the chunk, the last one the blocks after it (read from the border planes)
+			const bool isCurrentSliceOutside = chunkIteration[axis] < 0;
+			const bool isComparedSliceOutside = chunkIteration[axis] + 1 >= mainAxisLimit;
+
+			// Filling the mask for the current slice
+			for (chunkIteration[axis2] = 0; chunkIteration[axis2] < axis2Limit; ++chunkIteration[axis2])
+			{	
+				for (chunkIteration[axis1] = 0; chunkIteration[axis1] < axis1Limit; ++chunkIteration[axis1])
+				{
+					// NOTE : We only read the occupancy bits here, the block type is only read when a quad is needed
+					const bool isCurrentBlockOpaque = isCurrentSliceOutside ?
+						IsBorderBlockSolid(p_borderPlanes, chunkIteration) : p_voxelData.IsSolid(chunkIteration);
+					const bool isComparedBlockOpaque = isComparedSliceOutside ?
+						IsBorderBlockSolid(p_borderPlanes, chunkIteration + axisMask) : p_voxelData.IsSolid(chunkIteration + axisMask);
+
+					// If two opaque blocks are side by side we don't need to render the quad between them
+					// because the player can't see it anyway #optimization
+					if (isCurrentBlockOpaque == isComparedBlockOpaque)
+					{
+						masks[maskIteration++] = Mask{ BlockTypes::Null, 0 };
+					}
+					// The opaque block is inside a neighbor, it's the neighbor's mesh that has this face
+					else if ((isCurrentBlockOpaque && isCurrentSliceOutside) || (isComparedBlockOpaque && isComparedSliceOutside))
+					{
+						masks[maskIteration++] = Mask{ BlockTypes::Null, 0 };
+					}
+					// If ONLY one of the two blocks are opaque we need to render the quad between them
+					else if (isCurrentBlockOpaque)
+					{
+						// 1 = Forward
+						masks[maskIteration++] = Mask{ p_voxelData.GetBlock(chunkIteration), 1 };
+					}
+					else
+					{
+						// -1 = Backward
+						masks[maskIteration++] = Mask{ p_voxelData.GetBlock(chunkIteration + axisMask), -1 };
+					}
+				}
+			}
+
+			++chunkIteration[axis];
+
+			// NOTE : We will need to iterate throw the mash again so we reset the 'maskIteration' variable
+			maskIteration = 0;
+
+			// Generate the mesh from the mask
+			
+			for (int y = 0; y < axis2Limit; ++y)
+			{
+				// NOTE :
+				// Here the 'x' value will be increase manually
+				for (int x = 0; x < axis1Limit;)
+				{
+					if (masks[maskIteration].Normal != 0)
+					{
+						const Mask currentMask = masks[maskIteration];
+
+						chunkIteration[axis1] = x;
+						chunkIteration[axis2] = y;
+
+						// Represent the X size of the quad, over iteration this value will grow
+						int width;
+						int height;
+						bool maxQuadSizeReached = false;
+
+						#pragma region Documentation
+						
+						// EXAMPLE :
+						// Lexicon :
+						// - | = Chunk border
+						// - ' = Air block type
+						// - C = Cloud block type
+						// - H = Hard cloud block type
+						// - Q = Current quad that will be drawn as one block
+						//		 (The quad as the Cloud block type)
+
+						// 1.
+						// | ' ' ' ' ' ' ' ' |
+						// | ' ' ' ' ' H ' ' |
+						// | ' ' ' C C C ' ' |
+						// | ' ' H C C Q ' ' |
+						
+						// 2.
+						// | ' ' ' ' ' ' ' ' |
+						// | ' ' ' ' ' H ' ' |
+						// | ' ' ' C C C ' ' |
+						// | ' ' H C Q Q ' ' |
+
+						// 3.
+						// | ' ' ' ' ' ' ' ' |
+						// | ' ' ' ' ' H ' ' |
+						// | ' ' ' C C C ' ' |
+						// | ' ' H Q Q Q ' ' |
+						
+						// 4.
+						// | ' ' ' ' ' ' ' ' |
+						// | ' ' ' ' ' H ' ' |
+						// | ' ' ' C C C ' ' |
+						// | ' ' H Q Q Q ' ' |
+
+						#pragma endregion
+						
+						// All the logic appends in the for loop, it's normal if he doesn't have code inside
+						for (width = 1; x + width < axis1Limit && IsSameMask(masks[maskIteration + width], currentMask); ++width) {}
+
+						#pragma region Documentation
+						
+						// EXAMPLE :
+						// Lexicon :
+						// - | = Chunk border
+						// - ' = Air block type
+						// - C = Cloud block type
+						// - H = Hard cloud block type
+						// - Q = Current quad that will be drawn as one block
+						//		 (The quad as the Cloud block type)
+
+						// 1.
+						// | ' ' ' ' ' ' ' ' |
+						// | ' ' ' ' ' H ' ' |
+						// | ' ' ' C C C ' ' |
+						// | ' ' H Q Q Q ' ' |
+						
+						// 2.
+						// | ' ' ' ' ' ' ' ' |
+						// | ' ' ' ' ' H ' ' |
+						// | ' ' ' Q Q Q ' ' |
+						// | ' ' H Q Q Q ' ' |
+
+						// 3.
+						// | ' ' ' ' ' ' ' ' |
+						// | ' ' ' ' ' H ' ' |
+						// | ' ' ' Q Q Q ' ' |
+						// | ' ' H Q Q Q ' ' |
+
+						#pragma endregion
+						
+						for (height = 1; y + height < axis2Limit; ++height)
+						{
+							for (int i = 0; i < width; i++)
+							{
+								if (IsSameMask(masks[maskIteration + i + height * axis1Limit], currentMask))
+									continue;
+
+								maxQuadSizeReached = true;
+								break;
+							}
+
+							if (maxQuadSizeReached)
+								break;
+						}
+
+						deltaAxis1[axis1] = width;
+						deltaAxis2[axis2] = height;
+
+						CreateQuad(stagingMesh, p_context.GetFaceIndices(ChunkMeshData::GetFaceDirection(axis, currentMask.Normal)),
+							p_voxelData.WorldPosition, p_blockSize,
+							currentMask, axisMask,
+							width,
+							height,
+							chunkIteration,
+							chunkIteration + deltaAxis1,
+							chunkIteration + deltaAxis2,
+							chunkIteration + deltaAxis1 + deltaAxis2
+						);
+
+						// - Cleaning variables - //
+						
+						deltaAxis1 = Vector3Int::Zero();
+						deltaAxis2 = Vector3Int::Zero();
+
+						for (int j = 0; j < height; j++)
+						{
+							for (int i = 0; i < width; i++)
+							{
+								masks[maskIteration + i + j * axis1Limit] = Mask { BlockTypes::Null, 0 };
+							}
+						}
+						//
+
+						x += width;
+						maskIteration += width;	
+					}
+					else
+					{
+						x++;
+						maskIteration++;
+					}
+				}
+			}
+		}
+	}
+
+	// - Copying the staging mesh at its exact size - //
+
+	// NOTE : assign() re-uses the memory of the chunk mesh when it's big enough (when the chunk is re-meshed)
+	p_outMeshData.Vertices.assign(stagingMesh.Vertices.begin(), stagingMesh.Vertices.end());
+
+	// The directions are put one after the other, their ranges are kept to skip the ones facing away from the camera
+	p_outMeshData.VerticesIndices.clear();
+
+	for (int faceDirection = 0; faceDirection < FaceDirectionCount; ++faceDirection)
+	{
+		const std::vector<unsigned int>& faceIndices = p_context.GetFaceIndices(static_cast<FaceDirections>(faceDirection));
+
+		p_outMeshData.FaceIndexOffsets[faceDirection] = static_cast<unsigned int>(p_outMeshData.VerticesIndices.size());
+		p_outMeshData.FaceIndexCounts[faceDirection] = static_cast<unsigned int>(faceIndices.size());
+
+		p_outMeshData.VerticesIndices.insert(p_outMeshData.VerticesIndices.end(), faceIndices.begin(), faceIndices.end());
+	}
+
+	p_outMeshData.MinimumBounds = stagingMesh.MinimumBounds;
+	p_outMeshData.MaximumBounds = stagingMesh.MaximumBounds;
+}
+
+void GreedyMesher::GenerateLevelOfDetailMesh(const ChunkVoxelData& p_voxelData, const int p_blockSize, const int p_levelOfDetail, MeshingContext& p_context,
+	ChunkMeshData& p_outMeshData)
+{
+	if (p_levelOfDetail <= 0)
+	{
+		GenerateMesh(p_voxelData, p_blockSize, p_context, p_outMeshData);
+		return;
+	}
+
+	const int factor = 1 << p_levelOfDetail;
+
+	ChunkVoxelData& downsampledVoxelData = p_context.GetDownsampledVoxelData();
+	downsampledVoxelData.Downsample(p_voxelData, factor);
+
+	// NOTE : The downsampled position is divided by the factor, and the block size multiplied by it,
+	//		  so the vertices and the bounds end up at the same place as the full resolution ones
+	BuildMesh(downsampledVoxelData, p_blockSize * factor, p_context, p_outMeshData, nullptr);
+
+	// The cave culling sections have the full resolution height (so the downsampled blocks are never used for them)
+	ChunkVisibility::ComputeFaceConnectivities(p_voxelData, p_context, p_outMeshData.SectionConnectivities);
+}
+
+bool GreedyMesher::IsBorderBlockSolid(const ChunkBorderPlanes* p_borderPlanes, const Vector3Int& p_blockPosition)
+{
+	return p_borderPlanes != nullptr && p_borderPlanes->IsSolid(p_blockPosition);
+}
+
+void GreedyMesher::CreateQuad(ChunkMeshData& p_meshData, std::vector<unsigned int>& p_outVerticesIndices, const Vector3& p_chunkWorldPosition, const int p_blockSize,
+	const Mask p_mask, const Vector3Int& p_maskAxis, const unsigned int p_width, const unsigned int p_height,
+    const Vector3& p_vertexPosition1, const Vector3& p_vertexPosition2, const Vector3& p_vertexPosition3, const Vector3& p_vertexPosition4)
+{
+	const Vector3Int quadNormal = Vector3Int(p_maskAxis * p_mask.Normal);
+
+	const unsigned int textureIndex = GetEnvironmentTextureIndex(p_mask.BlockType, quadNormal);
+
+	// -- Computing the texture color -- //
+
+	// Depending on the quad orientation we will change the texture color (making it darker)
+
+	// Top
+    Vector4 color = CHUNK_BLOCK_TOP_TEXTURE_COLOR;
+
+	// Left, right, forward, backward
+	if (quadNormal.Y == 0)
+		color = CHUNK_BLOCK_SIDE_TEXTURE_COLOR;
+
+	// Down
+	if (quadNormal.Y == -1)
+		color = CHUNK_BLOCK_BOTTOM_TEXTURE_COLOR;
+
+	// - Computing texture positions - //
+	
+	Vector3Uint texturePosition1;
+	Vector3Uint texturePosition2;
+	Vector3Uint texturePosition3;
+	Vector3Uint texturePosition4;
+	
+	// To avoid having our sprite rotated (it's because of the way we handle the vertices indices)
+	// we adapt our texture positions (UVs)
+	if (quadNormal.X == 1 || quadNormal.X == -1)
+	{
+		texturePosition1 = Vector3Uint(p_width,		p_height,	 textureIndex);
+		texturePosition2 = Vector3Uint(0,			p_height,	 textureIndex);
+		texturePosition3 = Vector3Uint(p_width,		0,			 textureIndex);
+		texturePosition4 = Vector3Uint(0,			0,			 textureIndex);
+	}
+	else
+	{
+		texturePosition1 = Vector3Uint(p_height,	p_width,	 textureIndex);
+		texturePosition2 = Vector3Uint(p_height,	0,			 textureIndex);
+		texturePosition3 = Vector3Uint(0,			p_width,	 textureIndex);
+		texturePosition4 = Vector3Uint(0,			0,			 textureIndex);
+	}
+
+	// - Updating the mesh bounds - //
+
+	// NOTE : The first vertex is always the minimum corner of the quad, and the last one the maximum corner
+	const Vector3 quadMinimum = (p_vertexPosition1 + p_chunkWorldPosition) * p_blockSize;
+	const Vector3 quadMaximum = (p_vertexPosition4 + p_chunkWorldPosition) * p_blockSize;
+
+	if (p_meshData.Vertices.empty())
+	{
+		p_meshData.MinimumBounds = quadMinimum;
+		p_meshData.MaximumBounds = quadMaximum;
+	}
+	else
+	{
+		p_meshData.MinimumBounds = Vector3(
+			std::min(p_meshData.MinimumBounds.X, quadMinimum.X),
+			std::min(p_meshData.MinimumBounds.Y, quadMinimum.Y),
+			std::min(p_meshData.MinimumBounds.Z, quadMinimum.Z)
+		);
+
+		p_meshData.MaximumBounds = Vector3(
+			std::max(p_meshData.MaximumBounds.X, quadMaximum.X),
+			std::max(p_meshData.MaximumBounds.Y, quadMaximum.Y),
+			std::max(p_meshData.MaximumBounds.Z, quadMaximum.Z)
+		);
+	}
+
+	// - Adding vertices into the mesh data - //
+
+	// The index of the first vertex of the quad
+	const unsigned int vertexCount = static_cast<unsigned int>(p_meshData.Vertices.size());
+
+	// NOTE : The positions are relative to the chunk origin (the chunk offset is given to the shader when the chunk is drawn),
+	//        so they stay small and precise wherever the chunk is in the world
+	p_meshData.Vertices.emplace_back(p_vertexPosition1 * p_blockSize, quadNormal, color, texturePosition1);
+	p_meshData.Vertices.emplace_back(p_vertexPosition2 * p_blockSize, quadNormal, color, texturePosition2);
+	p_meshData.Vertices.emplace_back(p_vertexPosition3 * p_blockSize, quadNormal, color, texturePosition3);
+	p_meshData.Vertices.emplace_back(p_vertexPosition4 * p_blockSize, quadNormal, color, texturePosition4);
+	
+	// - Computing vertices drawing order - //
+	
+	// First triangle
+	p_outVerticesIndices.push_back(vertexCount);						// down-left
+	p_outVerticesIndices.push_back(vertexCount + 2 - p_mask.Normal);	// down-right
+	p_outVerticesIndices.push_back(vertexCount + 2 + p_mask.Normal);	// up-right
+	// Second triangle
+	p_outVerticesIndices.push_back(vertexCount + 3);					// up-right
+	p_outVerticesIndices.push_back(vertexCount + 1 + p_mask.Normal);	// up-left
+	p_outVerticesIndices.push_back(vertexCount + 1 - p_mask.Normal);	// down-left
+
+	// NOTES :
+	// - We use 'p_mask.Normal' to get the correct orientation for our quad
+	// - When the chunk will be fully generated,
+	// the ChunkRenderObject will use the 'VerticesIndices' to create a IndexBufferObject and pass it to the Renderer class
+	// - The indices are written in the list of the quad's direction (see ChunkMeshData::FaceIndexOffsets)
+}
+
+unsigned int GreedyMesher::GetEnvironmentTextureIndex(const BlockTypes p_blockType, const Vector3& p_normal)
+{
+	switch (p_blockType)
+	{
+		// Environment
+		case BlockTypes::Null:	return 0;
+		case BlockTypes::Air:	return 0;
+		
+		case BlockTypes::LightCloud:
+	
+			if (p_normal == Vector3::Down())
+				return 1;
+			
+			return 0;
+	
+		case BlockTypes::NormalCloud:		return 1;
+		case BlockTypes::DarkCloud:			return 2;
+		case BlockTypes::VeryDarkCloud:		return 3;
+		case BlockTypes::VeryVeryDarkCloud: return 4;
+	
+		// Ores
+		case BlockTypes::HardCloud:			return 5;
+		case BlockTypes::ElectrifiedCloud:	return 6;
+	
+		default:
+			std::stringstream errorMessage;
+			errorMessage << "The given block's type '" << static_cast<int>(p_blockType) << "' (enum ID) in not planned the switch";
+	
+			PRINT_ERROR_RUNTIME(true, errorMessage.str())
+			return 255; // Why 255 ? Because for colors 255 is the maximum number you can pass
+
+	}
+}
+
+bool GreedyMesher::IsSameMask(const Mask p_mask1, const Mask p_mask2)
+{
+	return p_mask1.BlockType == p_mask2.BlockType && p_mask1.Normal == p_mask2.Normal;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../ChunkMeshData.h"
+#include "../EnvironmentEnums.h"
+
+class ChunkBorderPlanes;
+class ChunkVoxelData;
+class MeshingContext;
+
+/// <summary>
+/// Creates the greedy mesh of a chunk : all the faces of the same block type on the same plane are merged into bigger quads.
+///
+/// <para> It only reads the ChunkVoxelData and writes into a ChunkMeshData, no OpenGL is used,
+/// so it can run on any thread as long as nobody modifies the voxel data at the same time. </para> </summary>
+class GreedyMesher
+{
+
+public:
+
+    /// <summary>
+    /// The Mask struct weight exactly 8 bytes, the same size as an address,
+    /// that means you don't have to pass it as a reference. </summary>
+    struct Mask
+    {
+        BlockTypes BlockType;
+        int Normal;
+    };
+
+    /// <summary> Clears the given mesh, then fills it with the greedy mesh of the given voxel data (uses the MeshingContext of the calling thread). </summary>
+    /// <param name = "p_blockSize"> The size of the block (does not have a unit, but you can consider it has a meter). </param>
+    static void GenerateMesh(const ChunkVoxelData& p_voxelData, const int p_blockSize, ChunkMeshData& p_outMeshData);
+
+    /// <summary>
+    /// Same as above, but all the temporary memory comes from the given context.
+    /// <para> Once the context is warmed up, the only allocation is the output mesh (and none if it is re-used and big enough). </para> </summary>
+    /// <param name = "p_borderPlanes"> The blocks of the neighbors touching the chunk (optional, without them the outside of the chunk is Air).
+    /// A face hidden by a neighbor is not created, and the faces of the neighbors' blocks are never created (the neighbors create them). </param>
+    static void GenerateMesh(const ChunkVoxelData& p_voxelData, const int p_blockSize, MeshingContext& p_context, ChunkMeshData& p_outMeshData,
+        const ChunkBorderPlanes* p_borderPlanes = nullptr);
+
+    /// <summary>
+    /// Meshes the blocks downsampled 2^p_levelOfDetail times (see ChunkVoxelData::Downsample()), for the chunks far from the camera.
+    /// <para> No border planes are used : the sides of the chunk are closed down to its bottom, these walls are skirts hiding the cracks
+    /// with the neighbors of another level of detail. </para>
+    /// <para> The section connectivities (cave culling) are computed from the full resolution blocks, like for the level 0. </para> </summary>
+    /// <param name = "p_levelOfDetail"> 0 = the full resolution mesh (same as GenerateMesh()), 1 = 2x downsampled, 2 = 4x downsampled, etc... </param>
+    static void GenerateLevelOfDetailMesh(const ChunkVoxelData& p_voxelData, const int p_blockSize, const int p_levelOfDetail, MeshingContext& p_context,
+        ChunkMeshData& p_outMeshData);
+
+    /// <summary> Returns the index of a texture inside a Texture array (also used by the FarTerrain to color the far away strata). </summary>
+    static unsigned int GetEnvironmentTextureIndex(const BlockTypes p_blockType, const Vector3& p_normal);
+
+private:
+
+    /// <summary> The greedy meshing of GenerateMesh() without the section connectivities, the levels of detail compute them from other blocks. </summary>
+    static void BuildMesh(const ChunkVoxelData& p_voxelData, const int p_blockSize, MeshingContext& p_context, ChunkMeshData& p_outMeshData,
+        const ChunkBorderPlanes* p_borderPlanes);
+
+    /// <summary> Reads a block right outside the chunk from the border planes, Air if there is no border planes. </summary>
+    static bool IsBorderBlockSolid(const ChunkBorderPlanes* p_borderPlanes, const Vector3Int& p_blockPosition);
+
+    // NOTE : The Mask struct weight exactly 8 bytes, the same size as an address,
+    //        it's for this reason we don't pass it by const reference
+
+    /// <param name = "p_outVerticesIndices"> The indices list of the quad's face direction (the vertices are added into p_meshData) </param>
+    static void CreateQuad(ChunkMeshData& p_meshData, std::vector<unsigned int>& p_outVerticesIndices, const Vector3& p_chunkWorldPosition, const int p_blockSize,
+        const Mask p_mask, const Vector3Int& p_maskAxis, const unsigned int p_width, const unsigned int p_height,
+        const Vector3& p_vertexPosition1, const Vector3& p_vertexPosition2, const Vector3& p_vertexPosition3, const Vector3& p_vertexPosition4);
+
+    static bool IsSameMask(const Mask p_mask1, const Mask p_mask2);
+};
@@ -0,0 +1,34 @@
+#include "MeshingContext.h"
+
+MeshingContext::MeshingContext() : _downsampledVoxelData(Vector3(0.0f, 0.0f, 0.0f), Vector3Int(0, 0, 0))
+{
+}
+
+MeshingContext& MeshingContext::GetThreadContext()
+{
+	static thread_local MeshingContext threadContext;
+
+	return threadContext;
+}
+
+GreedyMesher::Mask* MeshingContext::GetMaskPlane(const size_t p_maskCount)
+{
+	// NOTE : Never shrinks, the next chunks will most likely have the same size
+	if (_maskPlane.size() < p_maskCount)
+		_maskPlane.resize(p_maskCount);
+
+	return _maskPlane.data();
+}
+
+size_t MeshingContext::GetMemoryUsage() const
+{
+	size_t memoryUsage = _maskPlane.capacity() * sizeof(GreedyMesher::Mask) + _stagingMesh.GetMemoryUsage();
+
+	for (const std::vector<unsigned int>& faceIndices : _faceIndices)
+		memoryUsage += faceIndices.capacity() * sizeof(unsigned int);
+
+	memoryUsage += _airRuns.capacity() * sizeof(ChunkVisibility::AirRun) + _columnFirstAirRuns.capacity() * sizeof(unsigned int);
+	memoryUsage += _downsampledVoxelData.GetMemoryUsage();
+
+	return memoryUsage;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+
+#include "GreedyMesher.h"
+#include "../ChunkMeshData.h"
+#include "../ChunkVisibility/ChunkVisibility.h"
+#include "../ChunkVoxelData/ChunkVoxelData.h"
+
+/// <summary>
+/// The temporary memory used by the GreedyMesher : the masks of the current slice, and the mesh being built
+/// (and the air runs of ChunkVisibility, computed with the mesh, and the downsampled blocks of the levels of detail).
+///
+/// <para> The buffers are never freed, they only grow until they reach the size of the biggest chunk meshed with them,
+/// so once every worker thread has its context warmed up, meshing a chunk does not allocate anything. </para>
+/// <para> A context must only be used by one thread at a time, use GetThreadContext() to get the one of the calling thread. </para> </summary>
+class MeshingContext
+{
+
+private:
+
+    std::vector<GreedyMesher::Mask> _maskPlane;
+
+    /// <summary> The mesh is built here, then copied at its exact size into the mesh of the chunk. </summary>
+    ChunkMeshData _stagingMesh;
+
+    /// <summary> The indices of the staging mesh, one list per face direction (they are put one after the other at the end). </summary>
+    std::vector<unsigned int> _faceIndices[FaceDirectionCount];
+
+    // - ChunkVisibility - //
+
+    std::vector<ChunkVisibility::AirRun> _airRuns;
+
+    /// <summary> The first air run of each column, plus the end of the last column. </summary>
+    std::vector<unsigned int> _columnFirstAirRuns;
+
+    // - Levels of detail - //
+
+    /// <summary> Its slab is re-used by the next chunk of the same level of detail (see ChunkVoxelData::Allocate()). </summary>
+    ChunkVoxelData _downsampledVoxelData;
+
+public:
+
+    MeshingContext();
+
+    MeshingContext(const MeshingContext&) = delete;
+    MeshingContext& operator=(const MeshingContext&) = delete;
+
+    /// <summary> Returns the context of the calling thread (created the first time). </summary>
+    static MeshingContext& GetThreadContext();
+
+    /// <summary> Returns at least 'p_maskCount' masks. <b> The masks are not reset</b>, they contain the values of the last slice. </summary>
+    GreedyMesher::Mask* GetMaskPlane(const size_t p_maskCount);
+
+    ChunkMeshData& GetStagingMesh() { return _stagingMesh; }
+
+    std::vector<unsigned int>& GetFaceIndices(const FaceDirections p_faceDirection) { return _faceIndices[p_faceDirection]; }
+
+    std::vector<ChunkVisibility::AirRun>& GetAirRuns() { return _airRuns; }
+    std::vector<unsigned int>& GetColumnFirstAirRuns() { return _columnFirstAirRuns; }
+
+    ChunkVoxelData& GetDownsampledVoxelData() { return _downsampledVoxelData; }
+
+    /// <summary> Returns the number of bytes kept by the context (masks, staging mesh, face indices, air runs and downsampled blocks). </summary>
+    size_t GetMemoryUsage() const;
+};
\ No newline at end of file
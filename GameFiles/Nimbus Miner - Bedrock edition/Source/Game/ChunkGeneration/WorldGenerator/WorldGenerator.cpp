@@ -0,0 +1,125 @@
+#include "WorldGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "FastNoiseLite/FastNoiseLite.h"
+
+#include "../ChunkVoxelData/ChunkVoxelData.h"
+
+/// <summary> A range of blocks below the surface of a column that have the same type. </summary>
+struct Stratum
+{
+    /// <summary> 1 is the surface block (the highest solid block of the column). Both depths are included. </summary>
+    int MinimumDepth;
+    int MaximumDepth;
+
+    BlockTypes BlockType;
+};
+
+// The strata of all the columns, from the surface to the bottom of the world (they have to be sorted and must not overlap)
+static constexpr Stratum STRATA[] =
+{
+    {  1,  1, BlockTypes::LightCloud        },  // Environment
+    {  2,  4, BlockTypes::NormalCloud       },  // Environment
+    {  5,  7, BlockTypes::DarkCloud         },  // Environment
+    {  8, 10, BlockTypes::VeryDarkCloud     },  // Environment
+    { 11, 13, BlockTypes::VeryVeryDarkCloud },  // Environment
+    { 14, 14, BlockTypes::NormalCloud       },  // Environment
+    { 15, 15, BlockTypes::HardCloud         },  // Ore
+    { 16, 16, BlockTypes::NormalCloud       },  // Environment
+    { 17, 17, BlockTypes::DarkCloud         },  // Environment
+    { 18, 20, BlockTypes::VeryDarkCloud     },  // Environment
+    { 21, 25, BlockTypes::VeryVeryDarkCloud },  // Environment
+    { 26, 29, BlockTypes::VeryDarkCloud     },  // Environment
+    { 30, 30, BlockTypes::DarkCloud         },  // Environment
+    { 31, std::numeric_limits<int>::max(), BlockTypes::ElectrifiedCloud }   // Ore
+};
+
+WorldGenerator::WorldGenerator(const int p_worldSeed, const float p_noiseFrequency)
+{
+    _worldSeed = p_worldSeed;
+    _noiseFrequency = p_noiseFrequency;
+
+    // The noise is configured only once, here, it will never be modified after
+    FastNoiseLite* noise = new FastNoiseLite(p_worldSeed);
+    noise->SetFrequency(p_noiseFrequency);
+    noise->SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+    noise->SetFractalType(FastNoiseLite::FractalType_FBm);
+
+    _noise = noise;
+}
+
+WorldGenerator::~WorldGenerator()
+{
+    delete _noise;
+}
+
+void WorldGenerator::GenerateBlocks(ChunkVoxelData& p_voxelData) const
+{
+    p_voxelData.Allocate();
+
+    const Vector3 chunkLocation = p_voxelData.WorldPosition;
+    const Vector3Int size = p_voxelData.Size;
+
+    for (int z = 0; z < size.Z; z++)
+    {
+        for (int x = 0; x < size.X; x++)
+        {
+            const float xWorldPosition = (chunkLocation.X + static_cast<float>(x));
+            const float zWorldPosition = (chunkLocation.Z + static_cast<float>(z));
+
+            const int height = GetSurfaceHeight(xWorldPosition, zWorldPosition, size.Y);
+
+            // NOTE : The blocks of a column are contiguous in memory, so each stratum is written with one fill
+            BlockTypes* column = p_voxelData.GetColumn(x, z);
+
+            for (const Stratum& stratum : STRATA)
+            {
+                // The blocks are ordered from the bottom (y = 0) to the top, so the deepest block has the lowest y
+                const int highestY = height - stratum.MinimumDepth;
+                const int lowestY = std::max(0, height - stratum.MaximumDepth);
+
+                // The column is not deep enough for the next strata
+                if (highestY < 0)
+                    break;
+
+                std::fill(column + lowestY, column + highestY + 1, stratum.BlockType);
+            }
+
+            // Everything that's higher than 'height' become Air
+            std::fill(column + height, column + size.Y, BlockTypes::Air);
+
+            // NOTE : Allocate() set all the occupancy bits to 0, so we only have to set the solid ones
+            p_voxelData.SetColumnOccupancy(x, z, 0, height, true);
+        }
+    }
+}
+
+int WorldGenerator::GetSurfaceHeight(const float p_xWorldPosition, const float p_zWorldPosition, const int p_maximumHeight) const
+{
+    // Computing the height of the block (the data will be transfer to the const unsigned int "height" variable)
+    const int height = static_cast<int>(std::round((_noise->GetNoise(p_xWorldPosition, p_zWorldPosition) + 1) * static_cast<float>(p_maximumHeight) / 2));
+
+    // Clamping the height
+    if (height < 0)
+        return 0;
+
+    if (height > p_maximumHeight)
+        return p_maximumHeight;
+
+    return height;
+}
+
+
+BlockTypes WorldGenerator::GetBlockTypeAtDepth(const int p_depth)
+{
+    for (const Stratum& stratum : STRATA)
+    {
+        if (p_depth <= stratum.MaximumDepth)
+            return stratum.BlockType;
+    }
+
+    return STRATA[0].BlockType;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../EnvironmentEnums.h"
+
+// Forward declarations
+class FastNoiseLite;
+class ChunkVoxelData;
+
+/// <summary>
+/// Holds everything needed to generate the world (seed, noise frequency and noise configuration), shared by all the chunks.
+///
+/// <para> It is immutable once created, and all its methods are const, so it <b> can be used by many threads at the same time. </b> </para>
+/// <para> The chunks only keep a pointer to it, so the WorldGenerator must outlive them (it's owned by the ChunkManager). </para> </summary>
+class WorldGenerator
+{
+
+private:
+
+    int _worldSeed;
+    float _noiseFrequency;
+
+    // NOTE : FastNoiseLite::GetNoise() is const and does not modify anything, that's what makes the generator thread safe
+    const FastNoiseLite* _noise;
+
+public:
+
+    /// <param name = "p_worldSeed"> The world seed, changing it change how the word is generated. </param>
+    /// <param name = "p_noiseFrequency"> Frequency is used to create noise, which influences the steepness of slopes : the lower the frequency,
+    /// the gentler the slopes, and the higher the frequency, the steeper the slopes. </param>
+    WorldGenerator(const int p_worldSeed, const float p_noiseFrequency);
+    ~WorldGenerator();
+
+    // The noise is owned by the generator, copying it would delete the noise twice
+    WorldGenerator(const WorldGenerator&) = delete;
+    WorldGenerator& operator=(const WorldGenerator&) = delete;
+
+    /// <summary> Fills all the blocks of the given voxel data, depending on its world position and size. </summary>
+    void GenerateBlocks(ChunkVoxelData& p_voxelData) const;
+
+    /// <summary> Returns the number of solid blocks of the column at the given world position, between 0 and 'p_maximumHeight'. </summary>
+    int GetSurfaceHeight(const float p_xWorldPosition, const float p_zWorldPosition, const int p_maximumHeight) const;
+
+    /// <summary> Returns the type of the block at the given depth below the surface of a column (1 is the surface block, see the STRATA). </summary>
+    static BlockTypes GetBlockTypeAtDepth(const int p_depth);
+
+    int GetWorldSeed() const { return _worldSeed; }
+    float GetNoiseFrequency() const { return _noiseFrequency; }
+};
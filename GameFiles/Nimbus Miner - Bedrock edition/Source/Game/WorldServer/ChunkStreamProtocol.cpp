@@ -0,0 +1,265 @@
+#include "ChunkStreamProtocol.h"
+
+#include <cstring>
+
+// The bytes read from the socket at once (on the stack)
+static constexpr size_t RECEIVE_BLOCK_BYTE_SIZE = 16 * 1024;
+
+#pragma region - ChunkStreamMessageReader -
+
+ChunkStreamMessageReader::ChunkStreamMessageReader(const ChunkStreamMessageTypes p_type, const uint8_t* p_payload, const size_t p_payloadByteSize)
+{
+    // Initialising class' variables
+    Type = p_type;
+    _payload = p_payload;
+    _payloadByteSize = p_payloadByteSize;
+    _position = 0;
+    _hasFailed = false;
+}
+
+int32_t ChunkStreamMessageReader::ReadInt32()
+{
+    int32_t value = 0;
+    Read(&value, sizeof(value));
+
+    return value;
+}
+
+uint32_t ChunkStreamMessageReader::ReadUint32()
+{
+    uint32_t value = 0;
+    Read(&value, sizeof(value));
+
+    return value;
+}
+
+uint16_t ChunkStreamMessageReader::ReadUint16()
+{
+    uint16_t value = 0;
+    Read(&value, sizeof(value));
+
+    return value;
+}
+
+uint8_t ChunkStreamMessageReader::ReadUint8()
+{
+    uint8_t value = 0;
+    Read(&value, sizeof(value));
+
+    return value;
+}
+
+float ChunkStreamMessageReader::ReadFloat()
+{
+    float value = 0.0f;
+    Read(&value, sizeof(value));
+
+    return value;
+}
+
+const uint8_t* ChunkStreamMessageReader::ReadBytes(const size_t p_byteCount)
+{
+    if (p_byteCount > GetRemainingByteCount())
+    {
+        _hasFailed = true;
+        return nullptr;
+    }
+
+    const uint8_t* bytes = _payload + _position;
+    _position += p_byteCount;
+
+    return bytes;
+}
+
+void ChunkStreamMessageReader::Read(void* p_outValue, const size_t p_byteCount)
+{
+    const uint8_t* bytes = ReadBytes(p_byteCount);
+
+    // NOTE : The value keeps the 0 it was initialized with
+    if (bytes != nullptr)
+        std::memcpy(p_outValue, bytes, p_byteCount);
+}
+
+#pragma endregion
+
+#pragma region - ChunkStreamConnection -
+
+ChunkStreamConnection::ChunkStreamConnection(Socket&& p_socket)
+{
+    // Initialising class' variables
+    _socket = std::move(p_socket);
+    _receiveOffset = 0;
+    _sendOffset = 0;
+    _messageBeginOffset = 0;
+    _isWritingMessage = false;
+    _isLost = !_socket.IsOpen();
+    _sentByteCount = 0;
+    _receivedByteCount = 0;
+    _sentMessageCount = 0;
+    _receivedMessageCount = 0;
+}
+
+void ChunkStreamConnection::BeginMessage(const ChunkStreamMessageTypes p_type)
+{
+    _messageBeginOffset = _pendingSendBytes.size();
+    _isWritingMessage = true;
+
+    // NOTE : The size is written by EndMessage(), once the payload is known
+    WriteUint32(0);
+    WriteUint8(static_cast<uint8_t>(p_type));
+}
+
+void ChunkStreamConnection::WriteInt32(const int32_t p_value)
+{
+    Write(&p_value, sizeof(p_value));
+}
+
+void ChunkStreamConnection::WriteUint32(const uint32_t p_value)
+{
+    Write(&p_value, sizeof(p_value));
+}
+
+void ChunkStreamConnection::WriteUint16(const uint16_t p_value)
+{
+    Write(&p_value, sizeof(p_value));
+}
+
+void ChunkStreamConnection::WriteUint8(const uint8_t p_value)
+{
+    Write(&p_value, sizeof(p_value));
+}
+
+void ChunkStreamConnection::WriteFloat(const float p_value)
+{
+    Write(&p_value, sizeof(p_value));
+}
+
+void ChunkStreamConnection::WriteBytes(const uint8_t* p_bytes, const size_t p_byteCount)
+{
+    Write(p_bytes, p_byteCount);
+}
+
+void ChunkStreamConnection::EndMessage()
+{
+    // The size counts the type and the payload, not itself
+    const uint32_t messageByteSize = static_cast<uint32_t>(_pendingSendBytes.size() - _messageBeginOffset - sizeof(uint32_t));
+    std::memcpy(_pendingSendBytes.data() + _messageBeginOffset, &messageByteSize, sizeof(messageByteSize));
+
+    _isWritingMessage = false;
+    _sentMessageCount++;
+}
+
+void ChunkStreamConnection::Flush()
+{
+    // NOTE : The message being written can't be sent yet, its size is not known
+    const size_t sendEnd = _isWritingMessage ? _messageBeginOffset : _pendingSendBytes.size();
+
+    while (!_isLost && _sendOffset < sendEnd)
+    {
+        const long long sentByteCount = _socket.Send(_pendingSendBytes.data() + _sendOffset, sendEnd - _sendOffset);
+
+        if (sentByteCount < 0)
+        {
+            _isLost = true;
+            _socket.Close();
+            break;
+        }
+
+        // The system buffer is full, the rest waits for the next call
+        if (sentByteCount == 0)
+            break;
+
+        _sendOffset += static_cast<size_t>(sentByteCount);
+        _sentByteCount += static_cast<unsigned long long>(sentByteCount);
+    }
+
+    // The sent bytes are removed once they are most of the buffer, so they are not moved on every call
+    if (_sendOffset > 0 && _sendOffset * 2 >= _pendingSendBytes.size())
+    {
+        _pendingSendBytes.erase(_pendingSendBytes.begin(), _pendingSendBytes.begin() + static_cast<std::ptrdiff_t>(_sendOffset));
+        _messageBeginOffset -= _isWritingMessage ? _sendOffset : 0;
+        _sendOffset = 0;
+    }
+}
+
+bool ChunkStreamConnection::ReceiveMessage(ChunkStreamMessageReader& p_outMessage)
+{
+    // NOTE : The messages received before the connection was lost are still given
+    if (TakeReceivedMessage(p_outMessage))
+        return true;
+
+    if (_isLost)
+        return false;
+
+    // The messages already read are dropped, the payloads given before are not used anymore
+    if (_receiveOffset > 0)
+    {
+        _receivedBytes.erase(_receivedBytes.begin(), _receivedBytes.begin() + static_cast<std::ptrdiff_t>(_receiveOffset));
+        _receiveOffset = 0;
+    }
+
+    uint8_t receivedBlock[RECEIVE_BLOCK_BYTE_SIZE];
+
+    while (true)
+    {
+        const long long receivedByteCount = _socket.Receive(receivedBlock, RECEIVE_BLOCK_BYTE_SIZE);
+
+        if (receivedByteCount < 0)
+        {
+            _isLost = true;
+            _socket.Close();
+            break;
+        }
+
+        _receivedBytes.insert(_receivedBytes.end(), receivedBlock, receivedBlock + receivedByteCount);
+        _receivedByteCount += static_cast<unsigned long long>(receivedByteCount);
+
+        // Nothing more is waiting inside the system buffer
+        if (receivedByteCount < static_cast<long long>(RECEIVE_BLOCK_BYTE_SIZE))
+            break;
+    }
+
+    return TakeReceivedMessage(p_outMessage);
+}
+
+bool ChunkStreamConnection::TakeReceivedMessage(ChunkStreamMessageReader& p_outMessage)
+{
+    const size_t availableByteCount = _receivedBytes.size() - _receiveOffset;
+
+    if (availableByteCount < MESSAGE_HEADER_BYTE_SIZE)
+        return false;
+
+    uint32_t messageByteSize = 0;
+    std::memcpy(&messageByteSize, _receivedBytes.data() + _receiveOffset, sizeof(messageByteSize));
+
+    // Not a message of this protocol, the rest of the bytes can't be trusted
+    if (messageByteSize == 0 || messageByteSize > MAXIMUM_MESSAGE_BYTE_SIZE)
+    {
+        _isLost = true;
+        _socket.Close();
+        _receivedBytes.clear();
+        _receiveOffset = 0;
+
+        return false;
+    }
+
+    if (availableByteCount < sizeof(uint32_t) + messageByteSize)
+        return false;
+
+    const uint8_t* message = _receivedBytes.data() + _receiveOffset + sizeof(uint32_t);
+
+    p_outMessage = ChunkStreamMessageReader(static_cast<ChunkStreamMessageTypes>(message[0]), message + 1, messageByteSize - 1);
+
+    _receiveOffset += sizeof(uint32_t) + messageByteSize;
+    _receivedMessageCount++;
+
+    return true;
+}
+
+void ChunkStreamConnection::Write(const void* p_value, const size_t p_byteCount)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(p_value);
+    _pendingSendBytes.insert(_pendingSendBytes.end(), bytes, bytes + p_byteCount);
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../../Engine/Networking/Socket.h"
+
+/// <summary>
+/// The messages between the world server and its clients (see WorldServer and WorldClient).
+///
+/// <para> A message is its size (4 bytes, the type included), its type (1 byte), then its payload. The numbers are written in the byte order
+/// of the machine : the server and its clients always run on the same one. </para> </summary>
+enum class ChunkStreamMessageTypes : uint8_t
+{
+    // - Client to server - //
+
+    /// <summary> The first message of a client : the protocol version (uint32). </summary>
+    Hello = 1,
+
+    /// <summary> The chunks the client wants : the chunk under its camera (int32 x, int32 z) and the radius around it (uint16, in chunks). </summary>
+    SetInterest = 2,
+
+    /// <summary> A block changed by the player : its world position (int32 x, y, z) and its new type (uint8). </summary>
+    EditBlock = 3,
+
+    // - Server to client - //
+
+    /// <summary> The answer to Hello : the protocol version (uint32), the world seed (int32), the noise frequency (float) and the chunk size (int32 x, y, z). </summary>
+    Welcome = 64,
+
+    /// <summary> A whole chunk : its position (int32 x, int32 z), then its blocks compressed by ChunkSerializer (the rest of the payload). </summary>
+    ChunkData = 65,
+
+    /// <summary> A chunk that left the interest area of the client : its position (int32 x, int32 z). </summary>
+    ChunkUnload = 66,
+
+    /// <summary> The blocks of a chunk edited since the last server tick : its position (int32 x, int32 z), the count (uint32),
+    /// then each block index (uint32, see ChunkVoxelData::GetBlockIndex()) and its new type (uint8). </summary>
+    BlockDeltas = 67
+};
+
+/// <summary> Reads the payload of a received message, see ChunkStreamConnection::ReceiveMessage(). </summary>
+class ChunkStreamMessageReader
+{
+
+public:
+
+    ChunkStreamMessageTypes Type = ChunkStreamMessageTypes::Hello;
+
+private:
+
+    const uint8_t* _payload = nullptr;
+    size_t _payloadByteSize = 0;
+    size_t _position = 0;
+
+    /// <summary> Set when a read goes past the end of the payload, the values read then are 0. </summary>
+    bool _hasFailed = false;
+
+public:
+
+    ChunkStreamMessageReader() = default;
+    ChunkStreamMessageReader(const ChunkStreamMessageTypes p_type, const uint8_t* p_payload, const size_t p_payloadByteSize);
+
+    int32_t ReadInt32();
+    uint32_t ReadUint32();
+    uint16_t ReadUint16();
+    uint8_t ReadUint8();
+    float ReadFloat();
+
+    /// <summary> Returns the next p_byteCount bytes of the payload (nullptr if there are not enough). </summary>
+    const uint8_t* ReadBytes(const size_t p_byteCount);
+
+    size_t GetRemainingByteCount() const { return _payloadByteSize - _position; }
+
+    /// <summary> False if a read went past the end of the payload : the message is malformed. </summary>
+    bool IsValid() const { return !_hasFailed; }
+
+private:
+
+    void Read(void* p_outValue, const size_t p_byteCount);
+};
+
+/// <summary>
+/// One side of a connection between the world server and a client : cuts the received bytes into messages,
+/// and keeps the messages to send until the socket takes them (see Flush()).
+///
+/// <para> The messages are written in place : BeginMessage(), the Write methods, then EndMessage(). </para>
+/// <para> The connection is lost once the socket fails, or when the other side sends a message bigger than MAXIMUM_MESSAGE_BYTE_SIZE. </para> </summary>
+class ChunkStreamConnection
+{
+
+public:
+
+    /// <summary> Incremented every time a message changes, the server refuses the clients of another version. </summary>
+    static constexpr uint32_t PROTOCOL_VERSION = 1;
+
+    /// <summary> The size (uint32) and the type (uint8) before each payload. </summary>
+    static constexpr size_t MESSAGE_HEADER_BYTE_SIZE = 5;
+
+    static constexpr size_t MAXIMUM_MESSAGE_BYTE_SIZE = 4 * 1024 * 1024;
+
+private:
+
+    Socket _socket;
+
+    /// <summary> The received bytes, the messages before _receiveOffset are already read. </summary>
+    std::vector<uint8_t> _receivedBytes;
+    size_t _receiveOffset;
+
+    /// <summary> The bytes waiting for the socket, the ones before _sendOffset are already sent. </summary>
+    std::vector<uint8_t> _pendingSendBytes;
+    size_t _sendOffset;
+
+    /// <summary> Where the header of the message being written begins (between BeginMessage() and EndMessage()). </summary>
+    size_t _messageBeginOffset;
+    bool _isWritingMessage;
+
+    bool _isLost;
+
+    // - Statistics - //
+
+    unsigned long long _sentByteCount;
+    unsigned long long _receivedByteCount;
+    unsigned long long _sentMessageCount;
+    unsigned long long _receivedMessageCount;
+
+public:
+
+    explicit ChunkStreamConnection(Socket&& p_socket);
+
+    ChunkStreamConnection(const ChunkStreamConnection&) = delete;
+    ChunkStreamConnection& operator=(const ChunkStreamConnection&) = delete;
+
+    // - Sending - //
+
+    void BeginMessage(const ChunkStreamMessageTypes p_type);
+    void WriteInt32(const int32_t p_value);
+    void WriteUint32(const uint32_t p_value);
+    void WriteUint16(const uint16_t p_value);
+    void WriteUint8(const uint8_t p_value);
+    void WriteFloat(const float p_value);
+    void WriteBytes(const uint8_t* p_bytes, const size_t p_byteCount);
+
+    /// <summary> Writes the size of the message into its header, it can be sent from now on. </summary>
+    void EndMessage();
+
+    /// <summary> Gives the finished messages to the socket, as much as it takes without waiting. </summary>
+    void Flush();
+
+    /// <summary> The bytes of the finished messages the socket did not take yet (the client reads slower than the server writes). </summary>
+    size_t GetPendingSendByteCount() const { return _pendingSendBytes.size() - _sendOffset; }
+
+    // - Receiving - //
+
+    /// <summary>
+    /// Gives the next complete message, reads the socket first if there is none. Returns false if no complete message arrived yet.
+    /// <para> The payload given by the reader is valid until the next call. </para> </summary>
+    bool ReceiveMessage(ChunkStreamMessageReader& p_outMessage);
+
+    bool IsLost() const { return _isLost; }
+
+    unsigned long long GetSentByteCount() const { return _sentByteCount; }
+    unsigned long long GetReceivedByteCount() const { return _receivedByteCount; }
+    unsigned long long GetSentMessageCount() const { return _sentMessageCount; }
+    unsigned long long GetReceivedMessageCount() const { return _receivedMessageCount; }
+
+private:
+
+    /// <summary> Returns the next complete message of the received bytes (without reading the socket), false if there is none. </summary>
+    bool TakeReceivedMessage(ChunkStreamMessageReader& p_outMessage);
+
+    void Write(const void* p_value, const size_t p_byteCount);
+};
\ No newline at end of file
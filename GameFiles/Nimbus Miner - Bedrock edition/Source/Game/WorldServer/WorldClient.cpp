@@ -0,0 +1,294 @@
+#include "WorldClient.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "../ChunkGeneration/ChunkStorage/ChunkSerializer.h"
+#include "../ChunkGeneration/ChunkVoxelData/ChunkVoxelData.h"
+
+#include "ChunkStreamProtocol.h"
+
+#include "MessageDebugger/MessageDebugger.h"
+
+WorldClient::WorldClient()
+{
+    // Initialising class' variables
+    _connection = nullptr;
+    _isWelcomed = false;
+    _worldSeed = 0;
+    _noiseFrequency = 0.0f;
+    _chunkSize = Vector3Int(0, 0, 0);
+    _hasInterest = false;
+    _interestCenter = Vector2Int(0, 0);
+    _interestRadius = 0;
+    _receivedChunkCount = 0;
+    _unloadedChunkCount = 0;
+    _receivedDeltaCount = 0;
+    _damagedChunkCount = 0;
+}
+
+WorldClient::~WorldClient()
+{
+    Disconnect();
+}
+
+bool WorldClient::Connect(const unsigned short p_port)
+{
+    Disconnect();
+
+    Socket socket;
+
+    if (!socket.Connect(p_port))
+        return false;
+
+    _connection = new ChunkStreamConnection(std::move(socket));
+
+    _connection->BeginMessage(ChunkStreamMessageTypes::Hello);
+    _connection->WriteUint32(ChunkStreamConnection::PROTOCOL_VERSION);
+    _connection->EndMessage();
+    _connection->Flush();
+
+    return true;
+}
+
+void WorldClient::Disconnect()
+{
+    delete _connection;
+    _connection = nullptr;
+
+    RemoveChunks();
+
+    _isWelcomed = false;
+    _hasInterest = false;
+    _blockChanges.clear();
+}
+
+void WorldClient::SetInterest(const Vector2Int& p_centerChunkPosition, const int p_radius)
+{
+    if (_connection == nullptr)
+        return;
+
+    if (_hasInterest && _interestCenter.X == p_centerChunkPosition.X && _interestCenter.Y == p_centerChunkPosition.Y && _interestRadius == p_radius)
+        return;
+
+    _hasInterest = true;
+    _interestCenter = p_centerChunkPosition;
+    _interestRadius = p_radius;
+
+    _connection->BeginMessage(ChunkStreamMessageTypes::SetInterest);
+    _connection->WriteInt32(p_centerChunkPosition.X);
+    _connection->WriteInt32(p_centerChunkPosition.Y);
+    _connection->WriteUint16(static_cast<uint16_t>(std::min(std::max(p_radius, 0), 0xFFFF)));
+    _connection->EndMessage();
+}
+
+void WorldClient::RequestBlockEdit(const Vector3Int& p_worldBlockPosition, const BlockTypes p_newBlockType)
+{
+    if (_connection == nullptr)
+        return;
+
+    _connection->BeginMessage(ChunkStreamMessageTypes::EditBlock);
+    _connection->WriteInt32(p_worldBlockPosition.X);
+    _connection->WriteInt32(p_worldBlockPosition.Y);
+    _connection->WriteInt32(p_worldBlockPosition.Z);
+    _connection->WriteUint8(static_cast<uint8_t>(p_newBlockType));
+    _connection->EndMessage();
+}
+
+void WorldClient::Update()
+{
+    if (_connection == nullptr)
+        return;
+
+    _connection->Flush();
+
+    ChunkStreamMessageReader message;
+
+    while (_connection->ReceiveMessage(message))
+    {
+        switch (message.Type)
+        {
+            case ChunkStreamMessageTypes::Welcome:
+            {
+                const uint32_t protocolVersion = message.ReadUint32();
+                _worldSeed = message.ReadInt32();
+                _noiseFrequency = message.ReadFloat();
+                _chunkSize.X = message.ReadInt32();
+                _chunkSize.Y = message.ReadInt32();
+                _chunkSize.Z = message.ReadInt32();
+
+                _isWelcomed = message.IsValid() && protocolVersion == ChunkStreamConnection::PROTOCOL_VERSION &&
+                    _chunkSize.X > 0 && _chunkSize.Y > 0 && _chunkSize.Z > 0;
+
+                if (!_isWelcomed)
+                    PRINT_ERROR_RUNTIME(true, "The world server sent invalid world settings, its chunks will be ignored")
+
+                break;
+            }
+
+            case ChunkStreamMessageTypes::ChunkData:
+            {
+                // NOTE : Read one by one, the order of the arguments of a call is not defined
+                const int x = message.ReadInt32();
+                const int z = message.ReadInt32();
+                const Vector2Int chunkPosition = Vector2Int(x, z);
+                const size_t serializedByteCount = message.GetRemainingByteCount();
+                const uint8_t* serializedBytes = message.ReadBytes(serializedByteCount);
+
+                if (!_isWelcomed || !message.IsValid())
+                    break;
+
+                const Vector3 worldPosition = Vector3(
+                    static_cast<float>(chunkPosition.X * _chunkSize.X),
+                    0.0f,
+                    static_cast<float>(chunkPosition.Y * _chunkSize.Z)
+                );
+
+                ChunkVoxelData* voxelData = new ChunkVoxelData(worldPosition, _chunkSize);
+
+                if (!ChunkSerializer::Deserialize(serializedBytes, serializedByteCount, *voxelData))
+                {
+                    std::stringstream warningMessage;
+                    warningMessage << "The chunk (" << chunkPosition.X << ", " << chunkPosition.Y << ") sent by the world server is damaged, it has been ignored";
+
+                    PRINT_WARNING_RUNTIME(true, warningMessage.str())
+
+                    delete voxelData;
+                    _damagedChunkCount++;
+                    break;
+                }
+
+                // NOTE : A chunk sent again (it left the interest area, then came back) replaces the old one
+                ChunkVoxelData*& chunk = _chunks[GetChunkKey(chunkPosition)];
+                delete chunk;
+                chunk = voxelData;
+
+                _receivedChunkCount++;
+                break;
+            }
+
+            case ChunkStreamMessageTypes::ChunkUnload:
+            {
+                const int x = message.ReadInt32();
+                const int z = message.ReadInt32();
+                const Vector2Int chunkPosition = Vector2Int(x, z);
+                const std::unordered_map<long long, ChunkVoxelData*>::iterator chunkIterator = _chunks.find(GetChunkKey(chunkPosition));
+
+                if (!message.IsValid() || chunkIterator == _chunks.end())
+                    break;
+
+                delete chunkIterator->second;
+                _chunks.erase(chunkIterator);
+
+                _unloadedChunkCount++;
+                break;
+            }
+
+            case ChunkStreamMessageTypes::BlockDeltas:
+            {
+                const int x = message.ReadInt32();
+                const int z = message.ReadInt32();
+                const Vector2Int chunkPosition = Vector2Int(x, z);
+                const uint32_t blockDeltaCount = message.ReadUint32();
+
+                // NOTE : Each delta is a block index (4 bytes) and a type (1 byte)
+                if (!message.IsValid() || message.GetRemainingByteCount() != static_cast<size_t>(blockDeltaCount) * 5)
+                    break;
+
+                const std::unordered_map<long long, ChunkVoxelData*>::iterator chunkIterator = _chunks.find(GetChunkKey(chunkPosition));
+
+                if (chunkIterator == _chunks.end())
+                    break;
+
+                ChunkVoxelData* chunk = chunkIterator->second;
+
+                for (uint32_t i = 0; i < blockDeltaCount; ++i)
+                {
+                    const uint32_t blockIndex = message.ReadUint32();
+                    const BlockTypes newBlockType = static_cast<BlockTypes>(message.ReadUint8());
+
+                    if (blockIndex >= chunk->GetBlockCount())
+                        continue;
+
+                    const Vector3Int blockPosition = chunk->GetBlockPosition(blockIndex);
+                    chunk->SetBlock(blockPosition, newBlockType);
+
+                    BlockChange blockChange;
+                    blockChange.WorldBlockPosition = Vector3Int(
+                        chunkPosition.X * _chunkSize.X + blockPosition.X,
+                        blockPosition.Y,
+                        chunkPosition.Y * _chunkSize.Z + blockPosition.Z
+                    );
+                    blockChange.NewType = newBlockType;
+
+                    _blockChanges.push_back(blockChange);
+                    _receivedDeltaCount++;
+                }
+
+                break;
+            }
+
+            // NOTE : The messages of a newer server are skipped, the ones already known keep working
+            default:
+                break;
+        }
+    }
+}
+
+bool WorldClient::IsConnected() const
+{
+    return _connection != nullptr && !_connection->IsLost();
+}
+
+const ChunkVoxelData* WorldClient::GetChunk(const Vector2Int& p_chunkPosition) const
+{
+    const std::unordered_map<long long, ChunkVoxelData*>::const_iterator chunkIterator = _chunks.find(GetChunkKey(p_chunkPosition));
+
+    return chunkIterator != _chunks.end() ? chunkIterator->second : nullptr;
+}
+
+BlockTypes WorldClient::GetBlock(const Vector3Int& p_worldBlockPosition) const
+{
+    if (!_isWelcomed)
+        return BlockTypes::Null;
+
+    const Vector2Int chunkPosition = Vector2Int(
+        FloorDivide(p_worldBlockPosition.X, _chunkSize.X),
+        FloorDivide(p_worldBlockPosition.Z, _chunkSize.Z)
+    );
+
+    const ChunkVoxelData* chunk = GetChunk(chunkPosition);
+
+    if (chunk == nullptr)
+        return BlockTypes::Null;
+
+    return chunk->GetBlock(Vector3Int(
+        p_worldBlockPosition.X - chunkPosition.X * _chunkSize.X,
+        p_worldBlockPosition.Y,
+        p_worldBlockPosition.Z - chunkPosition.Y * _chunkSize.Z
+    ));
+}
+
+void WorldClient::TakeBlockChanges(std::vector<BlockChange>& p_outBlockChanges)
+{
+    p_outBlockChanges.insert(p_outBlockChanges.end(), _blockChanges.begin(), _blockChanges.end());
+    _blockChanges.clear();
+}
+
+unsigned long long WorldClient::GetReceivedByteCount() const
+{
+    return _connection != nullptr ? _connection->GetReceivedByteCount() : 0;
+}
+
+unsigned long long WorldClient::GetSentByteCount() const
+{
+    return _connection != nullptr ? _connection->GetSentByteCount() : 0;
+}
+
+void WorldClient::RemoveChunks()
+{
+    for (const std::pair<const long long, ChunkVoxelData*>& chunk : _chunks)
+        delete chunk.second;
+
+    _chunks.clear();
+}
\ No newline at end of file
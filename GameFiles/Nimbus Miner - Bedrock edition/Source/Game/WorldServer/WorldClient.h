@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Vector.h"
+
+#include "../ChunkGeneration/EnvironmentEnums.h"
+
+class ChunkStreamConnection;
+class ChunkVoxelData;
+
+/// <summary>
+/// A connection to a world server of the same machine (see WorldServer) : keeps the chunks it streams around the camera,
+/// and sends the edited blocks to it.
+///
+/// <para> The server decides what the client has : the chunks arrive (and are forgotten) when the interest area moves (see SetInterest()),
+/// an edit only changes the blocks once the server sent it back (see TakeBlockChanges()), so all the clients always see the same world. </para>
+/// <para> The chunks are ChunkVoxelData, without OpenGL : they can be given to the GreedyMesher like the generated ones. </para>
+/// <para> Must be used by one thread only. </para> </summary>
+class WorldClient
+{
+
+public:
+
+    /// <summary> A block changed by the server (edited by this client or by another one). </summary>
+    struct BlockChange
+    {
+        Vector3Int WorldBlockPosition;
+        BlockTypes NewType;
+    };
+
+private:
+
+    /// <summary> nullptr until Connect(). </summary>
+    ChunkStreamConnection* _connection;
+
+    /// <summary> True once the Welcome message gave the world settings, the chunks can't be read before. </summary>
+    bool _isWelcomed;
+
+    int _worldSeed;
+    float _noiseFrequency;
+    Vector3Int _chunkSize;
+
+    /// <summary> The key is the chunk position (see GetChunkKey()). </summary>
+    std::unordered_map<long long, ChunkVoxelData*> _chunks;
+
+    /// <summary> Filled by Update(), emptied by TakeBlockChanges(). </summary>
+    std::vector<BlockChange> _blockChanges;
+
+    bool _hasInterest;
+    Vector2Int _interestCenter;
+    int _interestRadius;
+
+    // - Statistics - //
+
+    unsigned long long _receivedChunkCount;
+    unsigned long long _unloadedChunkCount;
+    unsigned long long _receivedDeltaCount;
+    unsigned long long _damagedChunkCount;
+
+public:
+
+    WorldClient();
+    ~WorldClient();
+
+    WorldClient(const WorldClient&) = delete;
+    WorldClient& operator=(const WorldClient&) = delete;
+
+    /// <summary> Connects to the server listening on the port, then says hello. Returns false if there is no server. </summary>
+    bool Connect(const unsigned short p_port);
+
+    /// <summary> Closes the connection and forgets the chunks. </summary>
+    void Disconnect();
+
+    /// <summary> Asks for the chunks around the given one (the one under the camera), nothing is sent if the area did not change. </summary>
+    void SetInterest(const Vector2Int& p_centerChunkPosition, const int p_radius);
+
+    /// <summary> Asks the server to change the block, the change arrives through TakeBlockChanges() (see the class documentation). </summary>
+    void RequestBlockEdit(const Vector3Int& p_worldBlockPosition, const BlockTypes p_newBlockType);
+
+    /// <summary> Sends the requests, then applies all the messages received since the last call. </summary>
+    void Update();
+
+    bool IsConnected() const;
+    bool IsWelcomed() const { return _isWelcomed; }
+
+    /// <summary> nullptr if the client does not have the chunk (the position is in chunks). </summary>
+    const ChunkVoxelData* GetChunk(const Vector2Int& p_chunkPosition) const;
+    size_t GetChunkCount() const { return _chunks.size(); }
+
+    /// <summary> Returns Null if the client does not have the chunk of the block. </summary>
+    BlockTypes GetBlock(const Vector3Int& p_worldBlockPosition) const;
+
+    /// <summary> Moves the blocks changed since the last call into p_outBlockChanges (the chunks to mesh again). </summary>
+    void TakeBlockChanges(std::vector<BlockChange>& p_outBlockChanges);
+
+    int GetWorldSeed() const { return _worldSeed; }
+    float GetNoiseFrequency() const { return _noiseFrequency; }
+    const Vector3Int& GetChunkSize() const { return _chunkSize; }
+
+    unsigned long long GetReceivedChunkCount() const { return _receivedChunkCount; }
+    unsigned long long GetUnloadedChunkCount() const { return _unloadedChunkCount; }
+    unsigned long long GetReceivedDeltaCount() const { return _receivedDeltaCount; }
+    unsigned long long GetDamagedChunkCount() const { return _damagedChunkCount; }
+
+    unsigned long long GetReceivedByteCount() const;
+    unsigned long long GetSentByteCount() const;
+
+private:
+
+    void RemoveChunks();
+
+    static long long GetChunkKey(const Vector2Int& p_chunkPosition)
+    {
+        return (static_cast<long long>(p_chunkPosition.X) << 32) ^ static_cast<unsigned int>(p_chunkPosition.Y);
+    }
+};
\ No newline at end of file
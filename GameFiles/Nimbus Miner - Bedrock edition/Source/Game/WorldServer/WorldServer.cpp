@@ -0,0 +1,769 @@
+#include "WorldServer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#include "ProjectConstants.h"
+
+#include "../../Engine/Threading/ThreadPool.h"
+
+#include "../ChunkGeneration/ChunkStorage/ChunkSerializer.h"
+#include "../ChunkGeneration/ChunkStorage/ChunkStorage.h"
+#include "../ChunkGeneration/WorldGenerator/WorldGenerator.h"
+
+#include "ChunkStreamProtocol.h"
+
+#include "MessageDebugger/MessageDebugger.h"
+
+// The time between two statistics messages of Run()
+static constexpr float STATUS_INTERVAL_SECONDS = 10.0f;
+
+WorldServer::ServerChunk::ServerChunk(const Vector2Int& p_position, const Vector3& p_worldPosition, const Vector3Int& p_size)
+    : VoxelData(p_worldPosition, p_size)
+{
+    // Initialising class' variables
+    Position = p_position;
+    IsReady = false;
+    AreSerializedBytesOutdated = true;
+    IsModified = false;
+    SaveWriteNumber = 0;
+}
+
+WorldServer::WorldServer(const WorldServerSettings& p_settings)
+{
+    // Initialising class' variables
+    _settings = p_settings;
+    _worldGenerator = nullptr;
+    _generationThreadPool = nullptr;
+    _chunkStorage = nullptr;
+    _isEditJournalUsed = false;
+    _nextClientId = 1;
+    _pendingChunkCount = 0;
+    _lastAutosaveTime = std::chrono::steady_clock::now();
+    _tickCount = 0;
+    _connectedClientCount = 0;
+    _generatedChunkCount = 0;
+    _loadedChunkCount = 0;
+    _unloadedChunkCount = 0;
+    _sentChunkCount = 0;
+    _sentChunkByteCount = 0;
+    _sentDeltaCount = 0;
+    _appliedEditCount = 0;
+    _rejectedEditCount = 0;
+    _disconnectedClientSentByteCount = 0;
+    _lastTickMilliseconds = 0.0;
+    _maximumTickMilliseconds = 0.0;
+    _totalTickMilliseconds = 0.0;
+}
+
+WorldServer::~WorldServer()
+{
+    _listeningSocket.Close();
+
+    for (const ConnectedClient* client : _clients)
+    {
+        delete client->Connection;
+        delete client;
+    }
+
+    _clients.clear();
+
+    // NOTE : Its destructor waits until the edits are written (and for the loads it gave to the generation thread pool)
+    if (_chunkStorage != nullptr)
+    {
+        SaveModifiedChunks();
+        delete _chunkStorage;
+    }
+
+    // NOTE : Deleted before the chunks and the generator, it waits for the running generation jobs
+    delete _generationThreadPool;
+
+    for (const std::pair<const long long, ServerChunk*>& chunk : _chunks)
+        delete chunk.second;
+
+    _chunks.clear();
+
+    delete _worldGenerator;
+}
+
+WorldServerSettings WorldServer::ParseCommandLine(const int p_argumentCount, char* p_arguments[])
+{
+    WorldServerSettings settings;
+    settings.Port = WORLD_SERVER_DEFAULT_PORT;
+    settings.WorldSeed = WORLD_SEED;
+    settings.NoiseFrequency = NOISE_FREQUENCY;
+    settings.SaveDirectoryPath = WORLD_SERVER_SAVE_DIRECTORY_PATH;
+
+    // NOTE : We begin at 1 because the first argument is the executable path
+    for (int i = 1; i < p_argumentCount; ++i)
+    {
+        if (std::strcmp(p_arguments[i], "--server") == 0)
+            settings.IsEnabled = true;
+    }
+
+    // The arguments belong to the game (see RenderBenchmark::ParseCommandLine())
+    if (!settings.IsEnabled)
+        return settings;
+
+    for (int i = 1; i < p_argumentCount; ++i)
+    {
+        const char* argument = p_arguments[i];
+        const bool hasNextArgument = i + 1 < p_argumentCount;
+
+        if (std::strcmp(argument, "--server") == 0)
+            continue;
+
+        if (std::strcmp(argument, "--port") == 0 && hasNextArgument)
+            settings.Port = static_cast<unsigned short>(std::atoi(p_arguments[++i]));
+
+        else if (std::strcmp(argument, "--seed") == 0 && hasNextArgument)
+            settings.WorldSeed = std::atoi(p_arguments[++i]);
+
+        else if (std::strcmp(argument, "--save") == 0 && hasNextArgument)
+            settings.SaveDirectoryPath = p_arguments[++i];
+
+        else if (std::strcmp(argument, "--no-save") == 0)
+            settings.IsPersistenceEnabled = false;
+
+        else if (std::strcmp(argument, "--threads") == 0 && hasNextArgument)
+            settings.ThreadCount = static_cast<unsigned int>(std::max(0, std::atoi(p_arguments[++i])));
+
+        else
+            PRINT_WARNING_RUNTIME(true, std::string("Unknown command line argument '") + argument + "', it has been ignored.")
+    }
+
+    if (settings.Port == 0)
+    {
+        PRINT_WARNING_RUNTIME(true, "The server port must be between 1 and 65535, the default port has been used.")
+        settings.Port = WORLD_SERVER_DEFAULT_PORT;
+    }
+
+    return settings;
+}
+
+bool WorldServer::Start()
+{
+    if (_generationThreadPool == nullptr)
+        _generationThreadPool = new ThreadPool(_settings.ThreadCount);
+
+    if (_settings.IsPersistenceEnabled && _chunkStorage == nullptr)
+    {
+        // The loaded chunks are decompressed by the generation threads
+        _chunkStorage = new ChunkStorage(_settings.SaveDirectoryPath, _settings.ChunkSize, _generationThreadPool);
+
+        // The saved chunks were generated with the settings of their world, the new ones have to match them
+        if (_chunkStorage->LoadWorldSettings(_settings.WorldSeed, _settings.NoiseFrequency))
+        {
+            std::stringstream message;
+            message << "Loading the world saved inside '" << _settings.SaveDirectoryPath << "' (seed " << _settings.WorldSeed << ")";
+
+            PRINT_MESSAGE_RUNTIME(message.str())
+        }
+        else
+            _chunkStorage->SaveWorldSettings(_settings.WorldSeed, _settings.NoiseFrequency);
+
+        _isEditJournalUsed = _chunkStorage->OpenEditJournal(_settings.WorldSeed, _settings.NoiseFrequency);
+
+        if (!_isEditJournalUsed)
+            PRINT_WARNING_RUNTIME(true, "The edit journal can't be used, the edited chunks will be saved as snapshots")
+    }
+
+    // NOTE : Created with the final settings, the ones of the saved world
+    if (_worldGenerator == nullptr)
+        _worldGenerator = new WorldGenerator(_settings.WorldSeed, _settings.NoiseFrequency);
+
+    if (!_listeningSocket.Listen(_settings.Port))
+        return false;
+
+    std::stringstream message;
+    message << "The world server listens on the port " << _settings.Port << " (seed " << _settings.WorldSeed << ", "
+        << _generationThreadPool->GetThreadCount() << " generation threads)";
+
+    PRINT_MESSAGE_RUNTIME(message.str())
+
+    _lastAutosaveTime = std::chrono::steady_clock::now();
+
+    return true;
+}
+
+void WorldServer::Update()
+{
+    const std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+
+    AcceptClients();
+
+    for (ConnectedClient* client : _clients)
+        ReceiveClientMessages(*client);
+
+    TakeFinishedChunks();
+
+    // NOTE : Before the streaming, a chunk sent during this tick already has the edits
+    SendBlockDeltas();
+
+    // The first client gets the pending chunk slots first, so it changes every tick
+    for (size_t i = 0; i < _clients.size(); ++i)
+        StreamChunks(*_clients[(i + _tickCount) % _clients.size()]);
+
+    for (ConnectedClient* client : _clients)
+        client->Connection->Flush();
+
+    RemoveLostClients();
+
+    if (_tickCount % WORLD_SERVER_TICKS_PER_SECOND == 0)
+        UnloadUnusedChunks();
+
+    // - Autosave - //
+
+    if (_chunkStorage != nullptr && _chunkStorage->IsAutosaveDue(_lastAutosaveTime, AUTOSAVE_INTERVAL_SECONDS))
+    {
+        SaveModifiedChunks();
+        _lastAutosaveTime = std::chrono::steady_clock::now();
+    }
+
+    _tickCount++;
+
+    _lastTickMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+    _maximumTickMilliseconds = std::max(_maximumTickMilliseconds, _lastTickMilliseconds);
+    _totalTickMilliseconds += _lastTickMilliseconds;
+}
+
+void WorldServer::Run(const std::atomic<bool>& p_isStopRequested)
+{
+    const std::chrono::steady_clock::duration tickDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / WORLD_SERVER_TICKS_PER_SECOND));
+
+    std::chrono::steady_clock::time_point nextTickTime = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point lastStatusTime = nextTickTime;
+
+    while (!p_isStopRequested)
+    {
+        Update();
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        // A late tick is not caught up with a burst of ticks, the next one is simply later
+        nextTickTime = std::max(nextTickTime + tickDuration, now);
+
+        if (std::chrono::duration<float>(now - lastStatusTime).count() >= STATUS_INTERVAL_SECONDS)
+        {
+            std::stringstream message;
+            message << _clients.size() << " clients, " << _chunks.size() << " chunks in memory (" << _pendingChunkCount << " pending), "
+                << _sentChunkCount << " chunks sent (" << static_cast<double>(GetSentByteCount()) / (1024.0 * 1024.0) << " MB), "
+                << _appliedEditCount << " edits, tick " << GetAverageTickMilliseconds() << " ms (" << _maximumTickMilliseconds << " ms maximum)";
+
+            PRINT_MESSAGE_RUNTIME(message.str())
+
+            lastStatusTime = now;
+        }
+
+        std::this_thread::sleep_until(nextTickTime);
+    }
+}
+
+void WorldServer::SaveModifiedChunks()
+{
+    if (_chunkStorage == nullptr)
+        return;
+
+    for (const std::pair<const long long, ServerChunk*>& chunkEntry : _chunks)
+    {
+        ServerChunk* chunk = chunkEntry.second;
+
+        if (!chunk->IsModified)
+            continue;
+
+        chunk->SaveWriteNumber = _chunkStorage->RequestChunkSave(chunk->Position, chunk->VoxelData, chunk->PendingEdits, _isEditJournalUsed);
+        chunk->IsModified = false;
+        chunk->PendingEdits.clear();
+    }
+
+    _chunkStorage->RequestCommit();
+}
+
+unsigned long long WorldServer::GetSentByteCount() const
+{
+    unsigned long long sentByteCount = 0;
+
+    for (const ConnectedClient* client : _clients)
+        sentByteCount += client->Connection->GetSentByteCount();
+
+    return sentByteCount + _disconnectedClientSentByteCount;
+}
+
+void WorldServer::AcceptClients()
+{
+    Socket socket;
+
+    while (_listeningSocket.Accept(socket))
+    {
+        ConnectedClient* client = new ConnectedClient();
+        client->Connection = new ChunkStreamConnection(std::move(socket));
+        client->Id = _nextClientId++;
+
+        _clients.push_back(client);
+        _connectedClientCount++;
+    }
+}
+
+void WorldServer::ReceiveClientMessages(ConnectedClient& p_client)
+{
+    ChunkStreamMessageReader message;
+
+    while (!p_client.IsRejected && p_client.Connection->ReceiveMessage(message))
+    {
+        switch (message.Type)
+        {
+            case ChunkStreamMessageTypes::Hello:
+            {
+                const uint32_t protocolVersion = message.ReadUint32();
+
+                if (!message.IsValid() || protocolVersion != ChunkStreamConnection::PROTOCOL_VERSION)
+                {
+                    std::stringstream warningMessage;
+                    warningMessage << "The client " << p_client.Id << " uses the protocol version " << protocolVersion
+                        << " instead of " << ChunkStreamConnection::PROTOCOL_VERSION << ", it has been disconnected";
+
+                    PRINT_WARNING_RUNTIME(true, warningMessage.str())
+
+                    p_client.IsRejected = true;
+                    break;
+                }
+
+                ChunkStreamConnection& connection = *p_client.Connection;
+                connection.BeginMessage(ChunkStreamMessageTypes::Welcome);
+                connection.WriteUint32(ChunkStreamConnection::PROTOCOL_VERSION);
+                connection.WriteInt32(_settings.WorldSeed);
+                connection.WriteFloat(_settings.NoiseFrequency);
+                connection.WriteInt32(_settings.ChunkSize.X);
+                connection.WriteInt32(_settings.ChunkSize.Y);
+                connection.WriteInt32(_settings.ChunkSize.Z);
+                connection.EndMessage();
+
+                p_client.IsWelcomed = true;
+                break;
+            }
+
+            case ChunkStreamMessageTypes::SetInterest:
+            {
+                const int x = message.ReadInt32();
+                const int z = message.ReadInt32();
+                const int radius = message.ReadUint16();
+
+                if (message.IsValid() && p_client.IsWelcomed)
+                    SetClientInterest(p_client, Vector2Int(x, z), radius);
+
+                break;
+            }
+
+            case ChunkStreamMessageTypes::EditBlock:
+            {
+                const int x = message.ReadInt32();
+                const int y = message.ReadInt32();
+                const int z = message.ReadInt32();
+                const BlockTypes newBlockType = static_cast<BlockTypes>(message.ReadUint8());
+
+                if (message.IsValid() && p_client.IsWelcomed)
+                    ApplyBlockEdit(Vector3Int(x, y, z), newBlockType);
+
+                break;
+            }
+
+            // NOTE : The server messages are never sent by a client
+            default:
+            {
+                std::stringstream warningMessage;
+                warningMessage << "The client " << p_client.Id << " sent an unknown message (type " << static_cast<int>(message.Type) << "), it has been disconnected";
+
+                PRINT_WARNING_RUNTIME(true, warningMessage.str())
+
+                p_client.IsRejected = true;
+                break;
+            }
+        }
+    }
+}
+
+void WorldServer::SetClientInterest(ConnectedClient& p_client, const Vector2Int& p_centerChunkPosition, const int p_radius)
+{
+    p_client.HasInterest = true;
+    p_client.InterestCenter = p_centerChunkPosition;
+    p_client.InterestRadius = std::min(p_radius, WORLD_SERVER_MAXIMUM_INTEREST_RADIUS);
+
+    // - Chunks to forget - //
+
+    ChunkStreamConnection& connection = *p_client.Connection;
+
+    for (std::unordered_set<long long>::iterator iterator = p_client.SentChunks.begin(); iterator != p_client.SentChunks.end();)
+    {
+        const Vector2Int chunkPosition = GetChunkPosition(*iterator);
+
+        if (IsInsideInterest(chunkPosition, p_client.InterestCenter, p_client.InterestRadius))
+        {
+            ++iterator;
+            continue;
+        }
+
+        connection.BeginMessage(ChunkStreamMessageTypes::ChunkUnload);
+        connection.WriteInt32(chunkPosition.X);
+        connection.WriteInt32(chunkPosition.Y);
+        connection.EndMessage();
+
+        iterator = p_client.SentChunks.erase(iterator);
+    }
+
+    // - Missing chunks, the closest first - //
+
+    const int radius = p_client.InterestRadius;
+
+    p_client.MissingChunks.clear();
+
+    for (int x = -radius; x <= radius; ++x)
+    {
+        for (int z = -radius; z <= radius; ++z)
+        {
+            const Vector2Int chunkPosition = Vector2Int(p_client.InterestCenter.X + x, p_client.InterestCenter.Y + z);
+
+            if (x * x + z * z <= radius * radius && p_client.SentChunks.count(GetChunkKey(chunkPosition)) == 0)
+                p_client.MissingChunks.push_back(chunkPosition);
+        }
+    }
+
+    const Vector2Int center = p_client.InterestCenter;
+
+    std::sort(p_client.MissingChunks.begin(), p_client.MissingChunks.end(), [&center](const Vector2Int& p_first, const Vector2Int& p_second)
+    {
+        const int firstDistance = (p_first.X - center.X) * (p_first.X - center.X) + (p_first.Y - center.Y) * (p_first.Y - center.Y);
+        const int secondDistance = (p_second.X - center.X) * (p_second.X - center.X) + (p_second.Y - center.Y) * (p_second.Y - center.Y);
+
+        return firstDistance < secondDistance;
+    });
+}
+
+void WorldServer::ApplyBlockEdit(const Vector3Int& p_worldBlockPosition, const BlockTypes p_newBlockType)
+{
+    const Vector2Int chunkPosition = Vector2Int(
+        FloorDivide(p_worldBlockPosition.X, _settings.ChunkSize.X),
+        FloorDivide(p_worldBlockPosition.Z, _settings.ChunkSize.Z)
+    );
+
+    const std::unordered_map<long long, ServerChunk*>::iterator chunkIterator = _chunks.find(GetChunkKey(chunkPosition));
+
+    // NOTE : A client can only see the ready chunks, the other edits come from a broken (or late) client
+    if (chunkIterator == _chunks.end() || !chunkIterator->second->IsReady || p_newBlockType == BlockTypes::Null ||
+        static_cast<uint8_t>(p_newBlockType) > static_cast<uint8_t>(BlockTypes::ElectrifiedCloud) ||
+        p_worldBlockPosition.Y < 0 || p_worldBlockPosition.Y >= _settings.ChunkSize.Y)
+    {
+        _rejectedEditCount++;
+        return;
+    }
+
+    ServerChunk* chunk = chunkIterator->second;
+
+    const Vector3Int chunkBlockPosition = Vector3Int(
+        p_worldBlockPosition.X - chunkPosition.X * _settings.ChunkSize.X,
+        p_worldBlockPosition.Y,
+        p_worldBlockPosition.Z - chunkPosition.Y * _settings.ChunkSize.Z
+    );
+
+    const BlockTypes oldBlockType = chunk->VoxelData.GetBlock(chunkBlockPosition);
+
+    if (oldBlockType == p_newBlockType)
+        return;
+
+    const uint32_t blockIndex = chunk->VoxelData.GetBlockIndex(chunkBlockPosition);
+
+    if (_isEditJournalUsed)
+    {
+        ChunkEditJournal::BlockEdit blockEdit;
+        blockEdit.BlockIndex = blockIndex;
+        blockEdit.OldType = oldBlockType;
+        blockEdit.NewType = p_newBlockType;
+
+        ChunkEditJournal::MergeEdit(chunk->PendingEdits, blockEdit);
+    }
+
+    chunk->VoxelData.SetBlock(chunkBlockPosition, p_newBlockType);
+    chunk->AreSerializedBytesOutdated = true;
+    chunk->IsModified = true;
+
+    // - Delta of the tick - //
+
+    if (chunk->TickDeltas.empty())
+        _deltaChunkKeys.push_back(chunkIterator->first);
+
+    // NOTE : A block edited twice during the tick is only sent once, with its last type
+    const std::vector<BlockDelta>::iterator deltaIterator = std::find_if(chunk->TickDeltas.begin(), chunk->TickDeltas.end(),
+        [blockIndex](const BlockDelta& p_blockDelta) { return p_blockDelta.BlockIndex == blockIndex; });
+
+    if (deltaIterator != chunk->TickDeltas.end())
+        deltaIterator->NewType = p_newBlockType;
+    else
+    {
+        BlockDelta blockDelta;
+        blockDelta.BlockIndex = blockIndex;
+        blockDelta.NewType = p_newBlockType;
+
+        chunk->TickDeltas.push_back(blockDelta);
+    }
+
+    _appliedEditCount++;
+}
+
+void WorldServer::TakeFinishedChunks()
+{
+    // - Generated chunks - //
+
+    std::vector<GenerationResult> finishedGenerations;
+
+    {
+        std::lock_guard<std::mutex> lock(_finishedGenerationsMutex);
+        finishedGenerations.swap(_finishedGenerations);
+    }
+
+    for (GenerationResult& finishedGeneration : finishedGenerations)
+    {
+        ServerChunk* chunk = _chunks[GetChunkKey(finishedGeneration.ChunkPosition)];
+
+        chunk->VoxelData = std::move(finishedGeneration.VoxelData);
+        chunk->SerializedBytes = std::move(finishedGeneration.SerializedBytes);
+        chunk->AreSerializedBytesOutdated = false;
+        chunk->IsReady = true;
+
+        _pendingChunkCount--;
+        _generatedChunkCount++;
+    }
+
+    // - Loaded chunks - //
+
+    if (_chunkStorage == nullptr)
+        return;
+
+    std::vector<ChunkStorage::LoadResult> loadResults;
+    _chunkStorage->TakeFinishedLoads(loadResults);
+
+    for (ChunkStorage::LoadResult& loadResult : loadResults)
+    {
+        // Damaged on the disk, the edits are saved again at the next save of the chunk
+        if (!loadResult.IsLoaded)
+        {
+            RequestGeneration(loadResult.ChunkPosition);
+            continue;
+        }
+
+        ServerChunk* chunk = _chunks[GetChunkKey(loadResult.ChunkPosition)];
+
+        // NOTE : The journal only has the edits written after the snapshot
+        ReplayJournalEdits(loadResult.ChunkPosition, loadResult.VoxelData);
+
+        chunk->VoxelData = std::move(loadResult.VoxelData);
+        chunk->AreSerializedBytesOutdated = true;
+        chunk->IsReady = true;
+
+        _pendingChunkCount--;
+        _loadedChunkCount++;
+    }
+}
+
+void WorldServer::SendBlockDeltas()
+{
+    for (const long long chunkKey : _deltaChunkKeys)
+    {
+        ServerChunk* chunk = _chunks[chunkKey];
+
+        for (ConnectedClient* client : _clients)
+        {
+            if (client->SentChunks.count(chunkKey) == 0)
+                continue;
+
+            ChunkStreamConnection& connection = *client->Connection;
+            connection.BeginMessage(ChunkStreamMessageTypes::BlockDeltas);
+            connection.WriteInt32(chunk->Position.X);
+            connection.WriteInt32(chunk->Position.Y);
+            connection.WriteUint32(static_cast<uint32_t>(chunk->TickDeltas.size()));
+
+            for (const BlockDelta& blockDelta : chunk->TickDeltas)
+            {
+                connection.WriteUint32(blockDelta.BlockIndex);
+                connection.WriteUint8(static_cast<uint8_t>(blockDelta.NewType));
+            }
+
+            connection.EndMessage();
+
+            _sentDeltaCount += chunk->TickDeltas.size();
+        }
+
+        chunk->TickDeltas.clear();
+    }
+
+    _deltaChunkKeys.clear();
+}
+
+void WorldServer::StreamChunks(ConnectedClient& p_client)
+{
+    if (!p_client.HasInterest || p_client.IsRejected)
+        return;
+
+    // NOTE : The chunks that can't be sent yet keep their order
+    size_t keptChunkCount = 0;
+
+    for (size_t i = 0; i < p_client.MissingChunks.size(); ++i)
+    {
+        const Vector2Int chunkPosition = p_client.MissingChunks[i];
+        ServerChunk* chunk = GetOrRequestChunk(chunkPosition);
+
+        if (chunk != nullptr && chunk->IsReady && p_client.Connection->GetPendingSendByteCount() < WORLD_SERVER_CLIENT_SEND_BUDGET_BYTE_SIZE)
+            SendChunk(p_client, *chunk);
+        else
+            p_client.MissingChunks[keptChunkCount++] = chunkPosition;
+    }
+
+    p_client.MissingChunks.resize(keptChunkCount);
+}
+
+void WorldServer::SendChunk(ConnectedClient& p_client, ServerChunk& p_chunk)
+{
+    if (p_chunk.AreSerializedBytesOutdated)
+    {
+        p_chunk.SerializedBytes.clear();
+        ChunkSerializer::Serialize(p_chunk.VoxelData, p_chunk.SerializedBytes);
+
+        p_chunk.AreSerializedBytesOutdated = false;
+    }
+
+    ChunkStreamConnection& connection = *p_client.Connection;
+    connection.BeginMessage(ChunkStreamMessageTypes::ChunkData);
+    connection.WriteInt32(p_chunk.Position.X);
+    connection.WriteInt32(p_chunk.Position.Y);
+    connection.WriteBytes(p_chunk.SerializedBytes.data(), p_chunk.SerializedBytes.size());
+    connection.EndMessage();
+
+    p_client.SentChunks.insert(GetChunkKey(p_chunk.Position));
+
+    _sentChunkCount++;
+    _sentChunkByteCount += p_chunk.SerializedBytes.size();
+}
+
+WorldServer::ServerChunk* WorldServer::GetOrRequestChunk(const Vector2Int& p_chunkPosition)
+{
+    const long long chunkKey = GetChunkKey(p_chunkPosition);
+    const std::unordered_map<long long, ServerChunk*>::iterator chunkIterator = _chunks.find(chunkKey);
+
+    if (chunkIterator != _chunks.end())
+        return chunkIterator->second;
+
+    if (_pendingChunkCount >= WORLD_SERVER_MAXIMUM_PENDING_CHUNK_COUNT)
+        return nullptr;
+
+    const Vector3 worldPosition = GetChunkWorldPosition(p_chunkPosition);
+
+    ServerChunk* chunk = new ServerChunk(p_chunkPosition, worldPosition, _settings.ChunkSize);
+    _chunks[chunkKey] = chunk;
+    _pendingChunkCount++;
+
+    // NOTE : The saved chunks are read by the storage's I/O thread, the others are generated by the thread pool
+    if (_chunkStorage != nullptr && _chunkStorage->HasChunk(p_chunkPosition))
+        _chunkStorage->RequestLoad(p_chunkPosition, worldPosition);
+    else
+        RequestGeneration(p_chunkPosition);
+
+    return chunk;
+}
+
+void WorldServer::RequestGeneration(const Vector2Int& p_chunkPosition)
+{
+    const Vector3 worldPosition = GetChunkWorldPosition(p_chunkPosition);
+
+    _generationThreadPool->Submit([this, p_chunkPosition, worldPosition]()
+    {
+        GenerationResult generationResult = { p_chunkPosition, ChunkVoxelData(worldPosition, _settings.ChunkSize), std::vector<uint8_t>() };
+
+        _worldGenerator->GenerateBlocks(generationResult.VoxelData);
+        ReplayJournalEdits(p_chunkPosition, generationResult.VoxelData);
+
+        // NOTE : Serialized here, most chunks are sent without ever being edited
+        ChunkSerializer::Serialize(generationResult.VoxelData, generationResult.SerializedBytes);
+
+        std::lock_guard<std::mutex> lock(_finishedGenerationsMutex);
+        _finishedGenerations.push_back(std::move(generationResult));
+    });
+}
+
+void WorldServer::UnloadUnusedChunks()
+{
+    for (std::unordered_map<long long, ServerChunk*>::iterator iterator = _chunks.begin(); iterator != _chunks.end();)
+    {
+        const ServerChunk* chunk = iterator->second;
+
+        // NOTE : Without persistence the modified chunks are never saved, they stay in memory.
+        //        A saved chunk stays until its write is done, generated again before it would miss the edits of that save
+        bool isUsed = !chunk->IsReady || chunk->IsModified || !chunk->TickDeltas.empty() ||
+            (_chunkStorage != nullptr && !_chunkStorage->IsWriteFinished(chunk->SaveWriteNumber));
+
+        for (size_t i = 0; i < _clients.size() && !isUsed; ++i)
+            isUsed = _clients[i]->HasInterest && IsInsideInterest(chunk->Position, _clients[i]->InterestCenter, _clients[i]->InterestRadius);
+
+        if (isUsed)
+        {
+            ++iterator;
+            continue;
+        }
+
+        delete chunk;
+        iterator = _chunks.erase(iterator);
+
+        _unloadedChunkCount++;
+    }
+}
+
+void WorldServer::RemoveLostClients()
+{
+    for (size_t i = 0; i < _clients.size();)
+    {
+        ConnectedClient* client = _clients[i];
+
+        if (!client->IsRejected && !client->Connection->IsLost())
+        {
+            ++i;
+            continue;
+        }
+
+        _disconnectedClientSentByteCount += client->Connection->GetSentByteCount();
+
+        delete client->Connection;
+        delete client;
+
+        _clients.erase(_clients.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+}
+
+void WorldServer::ReplayJournalEdits(const Vector2Int& p_chunkPosition, ChunkVoxelData& p_voxelData) const
+{
+    if (_chunkStorage == nullptr || _chunkStorage->GetEditJournal() == nullptr || _chunkStorage->GetEditJournal()->GetEditCount() == 0)
+        return;
+
+    std::vector<ChunkEditJournal::BlockEdit> chunkEdits;
+    _chunkStorage->GetEditJournal()->GetChunkEdits(p_chunkPosition, chunkEdits);
+
+    for (const ChunkEditJournal::BlockEdit& chunkEdit : chunkEdits)
+        p_voxelData.SetBlock(p_voxelData.GetBlockPosition(chunkEdit.BlockIndex), chunkEdit.NewType);
+}
+
+Vector3 WorldServer::GetChunkWorldPosition(const Vector2Int& p_chunkPosition) const
+{
+    return Vector3(
+        static_cast<float>(p_chunkPosition.X * _settings.ChunkSize.X),
+        0.0f,
+        static_cast<float>(p_chunkPosition.Y * _settings.ChunkSize.Z)
+    );
+}
+
+bool WorldServer::IsInsideInterest(const Vector2Int& p_chunkPosition, const Vector2Int& p_centerChunkPosition, const int p_radius)
+{
+    const int x = p_chunkPosition.X - p_centerChunkPosition.X;
+    const int z = p_chunkPosition.Y - p_centerChunkPosition.Y;
+
+    return x * x + z * z <= (p_radius + 1) * (p_radius + 1);
+}
\ No newline at end of file
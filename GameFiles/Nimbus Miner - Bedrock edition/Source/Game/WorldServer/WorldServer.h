@@ -0,0 +1,286 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Vector.h"
+
+#include "../../Engine/Networking/Socket.h"
+#include "../ChunkGeneration/ChunkStorage/ChunkEditJournal.h"
+#include "../ChunkGeneration/ChunkVoxelData/ChunkVoxelData.h"
+
+class ChunkStorage;
+class ChunkStreamConnection;
+class ThreadPool;
+class WorldGenerator;
+
+struct WorldServerSettings
+{
+    bool IsEnabled = false;
+
+    unsigned short Port = 0;
+
+    /// <summary> Replaced by the seed and the noise frequency of the saved world, if there is one. </summary>
+    int WorldSeed = 0;
+    float NoiseFrequency = 0.0f;
+
+    Vector3Int ChunkSize = Vector3Int(32, 64, 32);
+
+    /// <summary> False with <c> --no-save </c> : nothing is read nor written, the edits are lost when the server stops. </summary>
+    bool IsPersistenceEnabled = true;
+    std::string SaveDirectoryPath;
+
+    /// <summary> The generation threads, 0 means one per hardware thread minus one (see ThreadPool). </summary>
+    unsigned int ThreadCount = 0;
+};
+
+/// <summary>
+/// Headless world server : generates, loads, edits and saves the chunks without OpenGL (no window), and streams them to the clients
+/// connected on the loopback interface (see WorldClient). Several games of the same machine can share one world this way.
+///
+/// <para> Launch example : <c> "Nimbus Miner - Bedrock edition.exe" --server --port 47800 --save Saves/ServerWorld </c> </para>
+///
+/// <para> <b> Interest areas : </b> each client tells the chunk under its camera and a radius (see ChunkStreamMessageTypes::SetInterest).
+/// The chunks of that circle are sent the closest first, when they are generated (or loaded), as long as the client reads them
+/// (see WORLD_SERVER_CLIENT_SEND_BUDGET_BYTE_SIZE). The client is told to forget the chunks one chunk outside of it, the server forgets
+/// the chunks no client is interested in (the edited ones once they are saved). </para>
+/// <para> <b> Wire format : </b> a chunk is sent with the bytes ChunkSerializer stores in the region files (a palette of its block types,
+/// then the runs of the same type, compressed again by an LZ77 pass), a few KB instead of 64. They are kept until the chunk is edited. </para>
+/// <para> <b> Edits : </b> the clients send the blocks they change, the server applies them and sends only the changed blocks (a delta)
+/// at the end of the tick to every client holding the chunk, the one that edited it included. The edits are saved like the game does
+/// (see ChunkStorage::RequestChunkSave()), inside a ChunkStorage of its own. </para>
+///
+/// <para> Everything but the generation (a thread pool) and the storage I/O runs on the thread calling Update(). </para> </summary>
+class WorldServer
+{
+
+private:
+
+    /// <summary> A block changed during the current tick. </summary>
+    struct BlockDelta
+    {
+        /// <summary> See ChunkVoxelData::GetBlockIndex(). </summary>
+        uint32_t BlockIndex;
+        BlockTypes NewType;
+    };
+
+    struct ServerChunk
+    {
+        Vector2Int Position;
+
+        /// <summary> Not generated while IsReady is false. </summary>
+        ChunkVoxelData VoxelData;
+
+        /// <summary> False while the chunk is generated or loaded. </summary>
+        bool IsReady;
+
+        /// <summary> The ChunkSerializer bytes sent to the clients, serialized again once the chunk was edited. </summary>
+        std::vector<uint8_t> SerializedBytes;
+        bool AreSerializedBytesOutdated;
+
+        /// <summary> Edited since the last save, the chunk stays in memory until it is saved. </summary>
+        bool IsModified;
+
+        /// <summary> The last write of the chunk (see ChunkStorage::RequestChunkSave()), the chunk stays in memory until it is done. </summary>
+        unsigned long long SaveWriteNumber;
+
+        /// <summary> The edits to append to the edit journal at the next save. </summary>
+        std::vector<ChunkEditJournal::BlockEdit> PendingEdits;
+
+        /// <summary> The blocks edited during the current tick, sent to the clients at its end. </summary>
+        std::vector<BlockDelta> TickDeltas;
+
+        ServerChunk(const Vector2Int& p_position, const Vector3& p_worldPosition, const Vector3Int& p_size);
+    };
+
+    /// <summary> A chunk generated by the thread pool, waiting for the server thread. </summary>
+    struct GenerationResult
+    {
+        Vector2Int ChunkPosition;
+        ChunkVoxelData VoxelData;
+        std::vector<uint8_t> SerializedBytes;
+    };
+
+    struct ConnectedClient
+    {
+        ChunkStreamConnection* Connection = nullptr;
+        int Id = 0;
+
+        /// <summary> True once its Hello message was answered, its other messages are ignored before. </summary>
+        bool IsWelcomed = false;
+
+        /// <summary> Set when the client breaks the protocol, it is disconnected at the end of the tick. </summary>
+        bool IsRejected = false;
+
+        bool HasInterest = false;
+        Vector2Int InterestCenter = Vector2Int(0, 0);
+        int InterestRadius = 0;
+
+        /// <summary> The chunks of the interest area the client does not have yet, the closest first. </summary>
+        std::vector<Vector2Int> MissingChunks;
+
+        /// <summary> The chunks the client has (their keys, see GetChunkKey()), they get the deltas of their edits. </summary>
+        std::unordered_set<long long> SentChunks;
+    };
+
+    WorldServerSettings _settings;
+
+    WorldGenerator* _worldGenerator;
+    ThreadPool* _generationThreadPool;
+
+    /// <summary> nullptr without persistence. </summary>
+    ChunkStorage* _chunkStorage;
+
+    /// <summary> False if the edit journal can't be used, the edited chunks are saved as snapshots then. </summary>
+    bool _isEditJournalUsed;
+
+    Socket _listeningSocket;
+
+    std::vector<ConnectedClient*> _clients;
+    int _nextClientId;
+
+    /// <summary> The key is the chunk position (see GetChunkKey()). </summary>
+    std::unordered_map<long long, ServerChunk*> _chunks;
+
+    /// <summary> The chunks being generated or loaded, see WORLD_SERVER_MAXIMUM_PENDING_CHUNK_COUNT. </summary>
+    int _pendingChunkCount;
+
+    std::mutex _finishedGenerationsMutex;
+
+    /// <summary> Filled by the generation jobs, emptied by Update(). </summary>
+    std::vector<GenerationResult> _finishedGenerations;
+
+    /// <summary> The keys of the chunks with TickDeltas. </summary>
+    std::vector<long long> _deltaChunkKeys;
+
+    std::chrono::steady_clock::time_point _lastAutosaveTime;
+
+    // - Statistics - //
+
+    unsigned long long _tickCount;
+    unsigned long long _connectedClientCount;
+    unsigned long long _generatedChunkCount;
+    unsigned long long _loadedChunkCount;
+    unsigned long long _unloadedChunkCount;
+    unsigned long long _sentChunkCount;
+    unsigned long long _sentChunkByteCount;
+    unsigned long long _sentDeltaCount;
+    unsigned long long _appliedEditCount;
+    unsigned long long _rejectedEditCount;
+
+    /// <summary> The bytes sent to the clients that are gone, see GetSentByteCount(). </summary>
+    unsigned long long _disconnectedClientSentByteCount;
+
+    double _lastTickMilliseconds;
+    double _maximumTickMilliseconds;
+    double _totalTickMilliseconds;
+
+public:
+
+    explicit WorldServer(const WorldServerSettings& p_settings);
+
+    /// <summary> Disconnects the clients and saves the modified chunks. </summary>
+    ~WorldServer();
+
+    WorldServer(const WorldServer&) = delete;
+    WorldServer& operator=(const WorldServer&) = delete;
+
+    /// <summary>
+    /// Reads the server arguments : <c> --server </c>, <c> --port N </c>, <c> --seed N </c>, <c> --save directoryPath </c>, <c> --no-save </c> and <c> --threads N </c>.
+    /// <para> The returned settings are disabled if the <c> --server </c> argument is missing (the other arguments are not read then). </para> </summary>
+    static WorldServerSettings ParseCommandLine(const int p_argumentCount, char* p_arguments[]);
+
+    /// <summary> Opens the saved world and starts listening, returns false if the port can't be used (an error is printed). </summary>
+    bool Start();
+
+    /// <summary> One server tick : accepts the new clients, applies their messages, sends the edited blocks and streams the chunks. </summary>
+    void Update();
+
+    /// <summary> Calls Update() WORLD_SERVER_TICKS_PER_SECOND times per second until a stop is requested, prints the statistics from time to time. </summary>
+    void Run(const std::atomic<bool>& p_isStopRequested);
+
+    /// <summary> Writes the edits of the modified chunks as one save (see ChunkStorage), only a snapshot is given to the I/O thread. </summary>
+    void SaveModifiedChunks();
+
+    unsigned short GetPort() const { return _settings.Port; }
+    int GetWorldSeed() const { return _settings.WorldSeed; }
+    float GetNoiseFrequency() const { return _settings.NoiseFrequency; }
+
+    size_t GetClientCount() const { return _clients.size(); }
+    size_t GetChunkCount() const { return _chunks.size(); }
+    int GetPendingChunkCount() const { return _pendingChunkCount; }
+
+    unsigned long long GetTickCount() const { return _tickCount; }
+    unsigned long long GetConnectedClientCount() const { return _connectedClientCount; }
+    unsigned long long GetGeneratedChunkCount() const { return _generatedChunkCount; }
+    unsigned long long GetLoadedChunkCount() const { return _loadedChunkCount; }
+    unsigned long long GetUnloadedChunkCount() const { return _unloadedChunkCount; }
+    unsigned long long GetSentChunkCount() const { return _sentChunkCount; }
+    unsigned long long GetSentChunkByteCount() const { return _sentChunkByteCount; }
+    unsigned long long GetSentDeltaCount() const { return _sentDeltaCount; }
+    unsigned long long GetAppliedEditCount() const { return _appliedEditCount; }
+    unsigned long long GetRejectedEditCount() const { return _rejectedEditCount; }
+
+    /// <summary> All the bytes sent to the clients (the messages headers included). </summary>
+    unsigned long long GetSentByteCount() const;
+
+    double GetLastTickMilliseconds() const { return _lastTickMilliseconds; }
+    double GetMaximumTickMilliseconds() const { return _maximumTickMilliseconds; }
+    double GetAverageTickMilliseconds() const { return _tickCount > 0 ? _totalTickMilliseconds / static_cast<double>(_tickCount) : 0.0; }
+
+private:
+
+    void AcceptClients();
+    void ReceiveClientMessages(ConnectedClient& p_client);
+
+    /// <summary> Sends ChunkUnload for the chunks the client does not need anymore, and lists the missing ones. </summary>
+    void SetClientInterest(ConnectedClient& p_client, const Vector2Int& p_centerChunkPosition, const int p_radius);
+
+    /// <summary> Applies the edit if the chunk is ready, the clients get it at the end of the tick (see SendBlockDeltas()). </summary>
+    void ApplyBlockEdit(const Vector3Int& p_worldBlockPosition, const BlockTypes p_newBlockType);
+
+    /// <summary> Gives the generated and loaded chunks to their ServerChunk. </summary>
+    void TakeFinishedChunks();
+
+    void SendBlockDeltas();
+
+    /// <summary> Sends the ready missing chunks of the client (until its send budget is used), requests the other ones. </summary>
+    void StreamChunks(ConnectedClient& p_client);
+
+    void SendChunk(ConnectedClient& p_client, ServerChunk& p_chunk);
+
+    /// <summary> Returns the chunk, or requests it (nullptr if too many chunks are already pending). </summary>
+    ServerChunk* GetOrRequestChunk(const Vector2Int& p_chunkPosition);
+
+    /// <summary> Generates the chunk on the thread pool, then replays its saved edits. </summary>
+    void RequestGeneration(const Vector2Int& p_chunkPosition);
+
+    /// <summary> Deletes the ready chunks outside all the interest areas (except the modified ones, they wait for the next save). </summary>
+    void UnloadUnusedChunks();
+
+    void RemoveLostClients();
+
+    /// <summary> Replays the edits of the journal on the blocks (nothing without it). Thread safe. </summary>
+    void ReplayJournalEdits(const Vector2Int& p_chunkPosition, ChunkVoxelData& p_voxelData) const;
+
+    Vector3 GetChunkWorldPosition(const Vector2Int& p_chunkPosition) const;
+
+    /// <summary> True if the chunk is inside the circle, or on the ring of one chunk around it (so a camera on a border does not reload the chunks). </summary>
+    static bool IsInsideInterest(const Vector2Int& p_chunkPosition, const Vector2Int& p_centerChunkPosition, const int p_radius);
+
+    static long long GetChunkKey(const Vector2Int& p_chunkPosition)
+    {
+        return (static_cast<long long>(p_chunkPosition.X) << 32) ^ static_cast<unsigned int>(p_chunkPosition.Y);
+    }
+
+    static Vector2Int GetChunkPosition(const long long p_chunkKey)
+    {
+        return Vector2Int(static_cast<int>(p_chunkKey >> 32), static_cast<int>(static_cast<uint32_t>(p_chunkKey)));
+    }
+};
\ No newline at end of file
@@ -24,7 +24,21 @@ layout(location = 2) in vec4 ColorAttribute;
 layout(location = 3) in vec3 TexturePositionAttribute; 
 // -- Contains TexturePosition (UV) AND TextureIndex (Layer) [the index of which texture will be drawn]
  
-uniform mat4 u_ModelViewProjectionMatrix;
+// -- Per-frame camera data, shared by every shader (see FrameUniformData.h, the layout has to stay identical in all shaders)
+layout(std140) uniform FrameData
+{
+    mat4 u_ViewMatrix;
+    mat4 u_ProjectionMatrix;
+    mat4 u_ViewProjectionMatrix;
+    mat4 u_CameraRelativeViewProjectionMatrix;
+    vec4 u_CameraPosition;
+    vec4 u_Time;
+};
+ 
+// -- Only uploaded when the objects are moved
+uniform mat4 u_ModelMatrix;
+// -- The chunk origin minus the camera position (computed in double precision on the CPU), the vertices are relative to the chunk origin
+uniform vec3 u_ChunkOffset;
  
 // -- Transmitting data to the fragment shader
 // -- v stands for "varying"
@@ -33,7 +47,8 @@ out vec4 v_Color;
  
 void main()
 {
-    gl_Position = u_ModelViewProjectionMatrix * PositionAttribute;
+    // -- The chunks are drawn relative to the camera, so only the camera rotation is applied (see Camera::GetRotationViewMatrix())
+    gl_Position = u_CameraRelativeViewProjectionMatrix * u_ModelMatrix * vec4(PositionAttribute.xyz + u_ChunkOffset, 1.0);
     v_Color = ColorAttribute;
     v_TexturePosition = TexturePositionAttribute;
 }
@@ -24,7 +24,19 @@ layout(location = 2) in vec4 ColorAttribute;
 layout(location = 3) in vec3 TexturePositionAttribute;
 // -- Contains TexturePosition (UV) AND TextureIndex (Layer) [the index of which texture will be drawn]
  
-uniform mat4 u_ModelViewProjectionMatrix;
+// -- Per-frame camera data, shared by every shader (see FrameUniformData.h, the layout has to stay identical in all shaders)
+layout(std140) uniform FrameData
+{
+    mat4 u_ViewMatrix;
+    mat4 u_ProjectionMatrix;
+    mat4 u_ViewProjectionMatrix;
+    mat4 u_CameraRelativeViewProjectionMatrix;
+    vec4 u_CameraPosition;
+    vec4 u_Time;
+};
+ 
+// -- Only uploaded when the objects are moved
+uniform mat4 u_ModelMatrix;
  
 // -- Transmitting data to the fragment shader
 // -- v stands for "varying"
@@ -33,7 +45,7 @@ out vec4 v_Color;
  
 void main()
 {
-    gl_Position = u_ModelViewProjectionMatrix * PositionAttribute;
+    gl_Position = u_ViewProjectionMatrix * u_ModelMatrix * PositionAttribute;
     v_Color = ColorAttribute;
     v_TexturePosition = TexturePositionAttribute;
 }
@@ -0,0 +1,101 @@
+// -- DOCUMENTATION : 
+// -- This file contains the vertex and the fragment shader.
+
+// -- A vertex shader is the shader that will place on the screen our vertices
+// -- (called x time | x representing the number of vertex you have)
+
+// -- The shader that will fill out the triangle of colored pixels 
+// -- (called x time | x representing the number of pixels you have to draw)
+
+// -- I decided to put them in the same file because it will be easier to modify them.
+
+// -- But that has for consequences for us to be able to extract only the correct shader, and to not take documentation.
+// -- In order to detect what is a vertex or fragment shader you have the "// SHADER VERTEX
+#version 330 core
+ 
+layout(location = 0) in vec3 PositionAttribute;
+layout(location = 1) in float SideLayerAttribute;
+layout(location = 2) in float SideFractionAttribute;
+// -- The texture layer of the slopes' sides, and how much of the slope is made of sides (0 = flat, only the top faces can be seen)
+ 
+// -- Per-frame camera data, shared by every shader (see FrameUniformData.h, the layout has to stay identical in all shaders)
+layout(std140) uniform FrameData
+{
+    mat4 u_ViewMatrix;
+    mat4 u_ProjectionMatrix;
+    mat4 u_ViewProjectionMatrix;
+    mat4 u_CameraRelativeViewProjectionMatrix;
+    vec4 u_CameraPosition;
+    vec4 u_Time;
+};
+ 
+// -- The ring origin minus the camera position (computed in double precision on the CPU), the vertices are relative to the ring origin
+uniform vec3 u_LevelOffset;
+ 
+out vec3 v_RelativePosition;
+flat out float v_SideLayer;
+out float v_SideFraction;
+ 
+void main()
+{
+    // -- Drawn relative to the camera, like the chunks (see Camera::GetRotationViewMatrix())
+    v_RelativePosition = PositionAttribute + u_LevelOffset;
+    gl_Position = u_CameraRelativeViewProjectionMatrix * vec4(v_RelativePosition, 1.0);
+    
+    v_SideLayer = SideLayerAttribute;
+    v_SideFraction = SideFractionAttribute;
+}
+ 
+// -- ========================== -- //
+// -- ========================== -- //
+// -- ========================== -- //
+ 
+// SHADER FRAGMENT
+#version 330 core
+ 
+// -- Same block as in the vertex shader (not used here, declared so the layout stays identical)
+layout(std140) uniform FrameData
+{
+    mat4 u_ViewMatrix;
+    mat4 u_ProjectionMatrix;
+    mat4 u_ViewProjectionMatrix;
+    mat4 u_CameraRelativeViewProjectionMatrix;
+    vec4 u_CameraPosition;
+    vec4 u_Time;
+};
+ 
+// -- The average color of each layer of the chunks' Texture2DArray (see Texture2DArray::GetLayerAverageColors())
+uniform vec4 u_StrataColors[8];
+ 
+// -- The same shading as the chunks' top and side faces (CHUNK_BLOCK_TOP_TEXTURE_COLOR and CHUNK_BLOCK_SIDE_TEXTURE_COLOR)
+uniform vec4 u_TopColor;
+uniform vec4 u_SideColor;
+ 
+// -- xy = the minimum XZ position of the voxel chunks, zw = the maximum one : the voxels are drawn there instead
+// -- Relative to the camera (computed in double precision on the CPU), like v_RelativePosition
+uniform vec4 u_RelativeVoxelArea;
+ 
+// -- x = the distance where the fog begins, y = the distance where only the fog color is left
+uniform vec2 u_FogRange;
+uniform vec4 u_FogColor;
+ 
+in vec3 v_RelativePosition;
+flat in float v_SideLayer;
+in float v_SideFraction;
+ 
+out vec4 FragmentColor;
+ 
+void main()
+{
+    // -- The hand-off to the voxel chunks : the far terrain is only a stand-in for what is not generated
+    if (all(greaterThan(v_RelativePosition.xz, u_RelativeVoxelArea.xy)) && all(lessThan(v_RelativePosition.xz, u_RelativeVoxelArea.zw)))
+        discard;
+    
+    vec4 topColor = u_StrataColors[0] * u_TopColor;
+    vec4 sideColor = u_StrataColors[int(v_SideLayer)] * u_SideColor;
+    vec3 color = mix(topColor.rgb, sideColor.rgb, v_SideFraction);
+    
+    float fog = smoothstep(u_FogRange.x, u_FogRange.y, length(v_RelativePosition.xz));
+    
+    FragmentColor = vec4(mix(color, u_FogColor.rgb, fog), 1.0);
+}
\ No newline at end of file